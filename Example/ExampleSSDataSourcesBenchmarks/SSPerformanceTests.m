@@ -0,0 +1,380 @@
+#import <XCTest/XCTest.h>
+#import <CoreData/CoreData.h>
+#import <malloc/malloc.h>
+#import <SSDataSources.h>
+#import "Wizard.h"
+
+// Benchmarks for the data source engines, run by the ExampleSSDataSourcesBenchmarks scheme
+// in a Release build. The functional suite in ExampleSSDataSourcesTests doesn't include them.
+//
+// Each -measureBlock: is compared against the baselines checked in under
+// ExampleSSDataSources.xcodeproj/xcshareddata/xcbaselines. A baseline is the test's budget:
+// its per-item budget below times the number of items, so only a real regression trips it.
+// Xcode only compares on a run destination that matches the baseline's; elsewhere it just reports.
+//
+// The scaling tests time each operation from 1k up to 1M items, and fail when it grows
+// faster than n log n or takes longer per item than its budget at any size.
+// The memory tests fail when a data source keeps more bytes per item than its budget.
+//
+// Data sources here have no table or collection view, so only our own bookkeeping is measured.
+
+static const NSUInteger SSSmallestBenchmarkSize = 1000;
+static const NSUInteger SSLargestBenchmarkSize = 1000000;
+
+// Input size for the -measureBlock: benchmarks.
+static const NSUInteger SSBenchmarkSize = 100000;
+
+// Sizes up to this one are timed as the best of three runs; larger ones run once.
+static const NSUInteger SSRepeatedBenchmarkSize = 10000;
+
+// 10x the items may take at most this many times as long. Linear work lands around 10,
+// n log n around 13, n^1.5 around 32 and quadratic work around 100.
+static const double SSMaximumScalingFactor = 20.0;
+
+// Per-item budgets, in seconds, set for a debug build on the simulator,
+// so the optimized benchmark build has plenty of headroom.
+// Each is roughly ten times the current cost, so only a real regression trips it.
+// Benchmarks of section changes budget 100µs per change, and the Core Data change storm 1ms.
+static const NSTimeInterval SSArrayOperationBudget = 20e-6;
+static const NSTimeInterval SSArrayUpdateBudget = 50e-6;
+static const NSTimeInterval SSSectionLookupBudget = 20e-6;
+static const NSTimeInterval SSItemLookupBudget = 10e-6;
+
+// Per-item memory budgets, in bytes, for what a data source keeps beyond its items.
+static const size_t SSArrayBytesPerItem = 128;
+static const size_t SSSectionBytesPerSection = 256;
+
+@interface SSPerformanceTests : XCTestCase
+@end
+
+@implementation SSPerformanceTests
+
+#pragma mark - Helpers
+
+- (NSArray *)numbersUpTo:(NSUInteger)count
+{
+    NSMutableArray *numbers = [NSMutableArray arrayWithCapacity:count];
+
+    for (NSUInteger i = 0; i < count; i++) {
+        [numbers addObject:@(i)];
+    }
+
+    return numbers;
+}
+
+- (NSArray *)sectionsWithCount:(NSUInteger)count itemsPerSection:(NSUInteger)itemsPerSection
+{
+    NSMutableArray *sections = [NSMutableArray arrayWithCapacity:count];
+    NSArray *items = [self numbersUpTo:itemsPerSection];
+
+    for (NSUInteger i = 0; i < count; i++) {
+        [sections addObject:[SSSection sectionWithItems:items
+                                                 header:nil
+                                                 footer:nil
+                                             identifier:@(i)]];
+    }
+
+    return sections;
+}
+
+// Best of three runs for small sizes, in seconds.
+- (NSTimeInterval)timeOf:(void (^)(NSUInteger count))block count:(NSUInteger)count
+{
+    NSTimeInterval best = DBL_MAX;
+    NSUInteger runs = (count <= SSRepeatedBenchmarkSize ? 3 : 1);
+
+    for (NSUInteger run = 0; run < runs; run++) {
+        @autoreleasepool {
+            CFTimeInterval start = CACurrentMediaTime();
+            block(count);
+            best = MIN(best, CACurrentMediaTime() - start);
+        }
+    }
+
+    return best;
+}
+
+- (void)assertScales:(void (^)(NSUInteger count))block withinBudget:(NSTimeInterval)budgetPerItem
+{
+    [self assertScales:block upTo:SSLargestBenchmarkSize withinBudget:budgetPerItem];
+}
+
+- (void)assertScales:(void (^)(NSUInteger count))block
+                upTo:(NSUInteger)maximumCount
+        withinBudget:(NSTimeInterval)budgetPerItem
+{
+    NSTimeInterval previous = 0;
+
+    for (NSUInteger count = SSSmallestBenchmarkSize; count <= maximumCount; count *= 10) {
+        NSTimeInterval time = [self timeOf:block count:count];
+
+        XCTAssertLessThan(time, count * budgetPerItem,
+                          @"%lu items took %.4fs, over budget",
+                          (unsigned long)count, time);
+
+        if (previous > 0) {
+            XCTAssertLessThan(time / previous, SSMaximumScalingFactor,
+                              @"%lu items took %.4fs, %lu items took %.4fs",
+                              (unsigned long)count / 10, previous,
+                              (unsigned long)count, time);
+        }
+
+        previous = MAX(time, 1e-4);
+    }
+}
+
+// Bytes still allocated once the block returns, while the object it returns is alive.
+- (size_t)bytesRetainedBy:(id (^)(void))block
+{
+    malloc_statistics_t before;
+    malloc_statistics_t after;
+    __attribute__((objc_precise_lifetime)) id result;
+
+    malloc_zone_statistics(NULL, &before);
+
+    @autoreleasepool {
+        result = block();
+    }
+
+    malloc_zone_statistics(NULL, &after);
+
+    return (after.size_in_use > before.size_in_use ? after.size_in_use - before.size_in_use : 0);
+}
+
+// Inputs are built outside the measurement, so only what the block adds is counted.
+- (void)assertRetains:(id (^)(id input))block
+            forInputs:(id (^)(NSUInteger count))inputBlock
+                 upTo:(NSUInteger)maximumCount
+         withinBudget:(size_t)bytesPerItem
+{
+    for (NSUInteger count = SSSmallestBenchmarkSize * 10; count <= maximumCount; count *= 10) {
+        id input = inputBlock(count);
+        size_t bytes = [self bytesRetainedBy:^id{
+            return block(input);
+        }];
+
+        XCTAssertLessThan(bytes, count * bytesPerItem,
+                          @"%lu items kept %lu bytes, over budget",
+                          (unsigned long)count, (unsigned long)bytes);
+    }
+}
+
+#pragma mark - SSArrayDataSource
+
+- (void)testArrayAppendPerformance
+{
+    NSArray *numbers = [self numbersUpTo:SSBenchmarkSize];
+
+    [self measureBlock:^{
+        SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:nil];
+
+        for (id number in numbers) {
+            [ds appendItem:number];
+        }
+    }];
+}
+
+- (void)testArrayInsertRemoveMovePerformance
+{
+    NSArray *numbers = [self numbersUpTo:SSBenchmarkSize];
+
+    [self measureBlock:^{
+        SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:numbers];
+
+        for (NSUInteger i = 0; i < 1000; i++) {
+            [ds insertItem:@(i) atIndex:[numbers count] / 2];
+            [ds moveItemAtIndex:0 toIndex:[numbers count] - 1];
+            [ds removeItemAtIndex:[numbers count] / 3];
+        }
+    }];
+}
+
+- (void)testArrayUpdatePerformance
+{
+    NSArray *numbers = [self numbersUpTo:SSBenchmarkSize];
+    NSMutableArray *shuffled = [numbers mutableCopy];
+
+    for (NSUInteger i = 0; i < [shuffled count]; i += 7) {
+        [shuffled exchangeObjectAtIndex:i withObjectAtIndex:[shuffled count] - 1 - i];
+    }
+
+    [self measureBlock:^{
+        SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:numbers];
+        ds.itemIdentifierBlock = ^id(id item) {
+            return item;
+        };
+
+        [ds updateItems:shuffled];
+    }];
+}
+
+- (void)testArrayOperationsScaleLinearly
+{
+    [self assertScales:^(NSUInteger count) {
+        SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:nil];
+
+        for (NSUInteger i = 0; i < count; i++) {
+            [ds appendItem:@(i)];
+        }
+
+        for (NSUInteger i = 0; i < count / 10; i++) {
+            [ds removeItemAtIndex:[ds numberOfItems] - 1];
+        }
+    } withinBudget:SSArrayOperationBudget];
+
+    [self assertScales:^(NSUInteger count) {
+        SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:[self numbersUpTo:count]];
+        ds.itemIdentifierBlock = ^id(id item) {
+            return item;
+        };
+
+        [ds updateItems:[[[self numbersUpTo:count] reverseObjectEnumerator] allObjects]];
+    } withinBudget:SSArrayUpdateBudget];
+}
+
+- (void)testArrayMemoryPerItem
+{
+    [self assertRetains:^id(NSArray *numbers) {
+        SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:numbers];
+        ds.maintainsItemIndex = YES;
+        [ds indexPathForItem:[numbers lastObject]];
+
+        return ds;
+    } forInputs:^id(NSUInteger count) {
+        return [self numbersUpTo:count];
+    } upTo:SSLargestBenchmarkSize withinBudget:SSArrayBytesPerItem];
+}
+
+#pragma mark - SSSectionedDataSource
+
+- (void)testSectionChurnPerformance
+{
+    NSArray *sections = [self sectionsWithCount:1000 itemsPerSection:10];
+
+    [self measureBlock:^{
+        SSSectionedDataSource *ds = [[SSSectionedDataSource alloc] initWithSections:sections];
+
+        for (NSUInteger i = 0; i < 1000; i++) {
+            [ds moveSectionAtIndex:0 toIndex:(NSInteger)[ds numberOfSections] - 1];
+            [ds removeSectionAtIndex:(NSInteger)[ds numberOfSections] / 2];
+            [ds insertSection:[SSSection sectionWithItems:@[ @(i) ]] atIndex:(NSInteger)[ds numberOfSections] / 2];
+        }
+    }];
+}
+
+- (void)testSectionIdentifierLookupPerformance
+{
+    SSSectionedDataSource *ds = [[SSSectionedDataSource alloc] initWithSections:[self sectionsWithCount:1000
+                                                                                        itemsPerSection:1]];
+
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 1000; i++) {
+            [ds indexOfSectionWithIdentifier:@(i)];
+        }
+    }];
+}
+
+- (void)testSectionOperationsScaleLinearly
+{
+    [self assertScales:^(NSUInteger count) {
+        SSSectionedDataSource *ds = [[SSSectionedDataSource alloc] initWithSections:[self sectionsWithCount:count
+                                                                                            itemsPerSection:1]];
+
+        for (NSUInteger i = 0; i < count / 10; i++) {
+            [ds indexOfSectionWithIdentifier:@(count - 1 - i)];
+            [ds indexPathForGlobalIndex:count - 1 - i];
+        }
+    } upTo:SSBenchmarkSize withinBudget:SSSectionLookupBudget];
+}
+
+- (void)testSectionMemoryPerSection
+{
+    [self assertRetains:^id(NSArray *sections) {
+        SSSectionedDataSource *ds = [[SSSectionedDataSource alloc] initWithSections:sections];
+        [ds indexOfSectionWithIdentifier:@([sections count] - 1)];
+        [ds indexPathForGlobalIndex:[sections count] - 1];
+
+        return ds;
+    } forInputs:^id(NSUInteger count) {
+        return [self sectionsWithCount:count itemsPerSection:1];
+    } upTo:SSBenchmarkSize withinBudget:SSSectionBytesPerSection];
+}
+
+#pragma mark - SSExpandingDataSource
+
+- (void)testExpandingTogglePerformance
+{
+    NSArray *sections = [self sectionsWithCount:1000 itemsPerSection:10];
+
+    [self measureBlock:^{
+        SSExpandingDataSource *ds = [[SSExpandingDataSource alloc] initWithSections:sections];
+        ds.collapsedSectionCountBlock = ^NSInteger(SSSection *section, NSInteger sectionIndex) {
+            return 1;
+        };
+
+        for (NSUInteger i = 0; i < 1000; i++) {
+            [ds toggleSectionAtIndex:(NSInteger)((i * 7) % 1000)];
+        }
+    }];
+}
+
+#pragma mark - Item lookup
+
+- (void)testIndexPathForItemPerformance
+{
+    NSArray *numbers = [self numbersUpTo:SSBenchmarkSize];
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:numbers];
+    ds.maintainsItemIndex = YES;
+
+    [self measureBlock:^{
+        for (id number in numbers) {
+            [ds indexPathForItem:number];
+        }
+    }];
+}
+
+- (void)testItemIndexScalesLinearly
+{
+    [self assertScales:^(NSUInteger count) {
+        NSArray *numbers = [self numbersUpTo:count];
+        SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:numbers];
+        ds.maintainsItemIndex = YES;
+
+        for (id number in numbers) {
+            [ds indexPathForItem:number];
+        }
+    } withinBudget:SSItemLookupBudget];
+}
+
+#pragma mark - SSCoreDataSource
+
+- (void)testCoreDataChangeStormPerformance
+{
+    [MagicalRecord setupCoreDataStackWithInMemoryStore];
+
+    NSManagedObjectContext *context = [NSManagedObjectContext MR_defaultContext];
+    SSCoreDataSource *ds = [[SSCoreDataSource alloc] initWithFetchRequest:[Wizard MR_requestAllSortedBy:@"name" ascending:YES]
+                                                                inContext:context
+                                                       sectionNameKeyPath:nil];
+
+    [self measureBlock:^{
+        NSMutableArray *wizards = [NSMutableArray array];
+
+        for (NSUInteger i = 0; i < 1000; i++) {
+            [wizards addObject:[Wizard wizardWithName:[NSString stringWithFormat:@"Wizard %lu", (unsigned long)i]
+                                                realm:@"Benchmark"
+                                            inContext:context]];
+            [context processPendingChanges];
+        }
+
+        for (Wizard *wizard in wizards) {
+            [context deleteObject:wizard];
+        }
+
+        [context processPendingChanges];
+    }];
+
+    XCTAssertEqual(ds.numberOfItems, (NSUInteger)0);
+}
+
+@end
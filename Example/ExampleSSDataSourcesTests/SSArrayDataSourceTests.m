@@ -139,6 +139,48 @@
     expect([ds indexPathForItem:@"baz"]).to.equal([NSIndexPath indexPathForRow:2 inSection:0]);
 }
 
+- (void)testIndexPathForItemWithItemIndex
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[@"foo", @"bar", @"baz"]];
+    ds.maintainsItemIndex = YES;
+    
+    expect([ds indexPathForItem:@"baz"]).to.equal([NSIndexPath indexPathForRow:2 inSection:0]);
+    
+    [ds insertItem:@"qux" atIndex:0];
+    expect([ds indexPathForItem:@"qux"]).to.equal([NSIndexPath indexPathForRow:0 inSection:0]);
+    expect([ds indexPathForItem:@"baz"]).to.equal([NSIndexPath indexPathForRow:3 inSection:0]);
+    
+    [ds moveItemAtIndex:3 toIndex:1];
+    expect([ds indexPathForItem:@"baz"]).to.equal([NSIndexPath indexPathForRow:1 inSection:0]);
+    expect([ds indexPathForItem:@"foo"]).to.equal([NSIndexPath indexPathForRow:2 inSection:0]);
+    
+    [ds removeItemAtIndex:1];
+    expect([ds indexPathForItem:@"baz"]).to.beNil();
+    expect([ds indexPathForItem:@"bar"]).to.equal([NSIndexPath indexPathForRow:2 inSection:0]);
+    
+    [ds replaceItemAtIndex:2 withItem:@"quux"];
+    expect([ds indexPathForItem:@"bar"]).to.beNil();
+    expect([ds indexPathForItem:@"quux"]).to.equal([NSIndexPath indexPathForRow:2 inSection:0]);
+}
+
+- (void)testIndexPathForItemWithIdentifier
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @{ @"id" : @1 }, @{ @"id" : @2 } ]];
+    ds.itemIdentifierBlock = ^id(NSDictionary *item) {
+        return item[@"id"];
+    };
+    
+    expect([ds indexPathForItemWithIdentifier:@2]).to.equal([NSIndexPath indexPathForRow:1 inSection:0]);
+    
+    ds.maintainsItemIndex = YES;
+    expect([ds indexPathForItemWithIdentifier:@2]).to.equal([NSIndexPath indexPathForRow:1 inSection:0]);
+    
+    [ds updateItems:@[ @{ @"id" : @2 }, @{ @"id" : @3 } ]];
+    expect([ds indexPathForItemWithIdentifier:@1]).to.beNil();
+    expect([ds indexPathForItemWithIdentifier:@2]).to.equal([NSIndexPath indexPathForRow:0 inSection:0]);
+    expect([ds indexPathForItemWithIdentifier:@3]).to.equal([NSIndexPath indexPathForRow:1 inSection:0]);
+}
+
 #pragma mark Clearing items
 
 - (void)testClearingTableItems
@@ -200,6 +242,243 @@
     expect(ds.allItems).to.equal(newItems);
 }
 
+- (void)testUpdatingItemsWithIdentifiersAnimatesChangesInTableView
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo", @"bar", @"baz" ]];
+    ds.itemIdentifierBlock = ^id(NSString *item) {
+        return item;
+    };
+    id mockTableView = [OCMockObject mockForClass:UITableView.class];
+    [[mockTableView stub] setDataSource:OCMOCK_ANY];
+    ds.tableView = mockTableView;
+
+    [[mockTableView expect] beginUpdates];
+    [[mockTableView expect] deleteRowsAtIndexPaths:@[[NSIndexPath indexPathForRow:1 inSection:0]]
+                                  withRowAnimation:ds.rowAnimation];
+    [[mockTableView expect] insertRowsAtIndexPaths:@[[NSIndexPath indexPathForRow:0 inSection:0]]
+                                  withRowAnimation:ds.rowAnimation];
+    [[mockTableView expect] endUpdates];
+
+    [ds updateItems:@[ @"iphone", @"foo", @"baz" ]];
+
+    [mockTableView verify];
+    expect(ds.allItems).to.equal((@[ @"iphone", @"foo", @"baz" ]));
+}
+
+- (void)testUpdatingItemsInBackground
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo", @"bar" ]];
+    ds.itemIdentifierBlock = ^id(NSString *item) {
+        return item;
+    };
+    id mockTableView = tableView;
+    ds.tableView = mockTableView;
+    __block BOOL finished = NO;
+
+    [[mockTableView expect] insertRowsAtIndexPaths:@[[NSIndexPath indexPathForRow:2 inSection:0]]
+                                  withRowAnimation:ds.rowAnimation];
+
+    [ds updateItems:@[ @"foo", @"bar", @"baz" ] completion:^(BOOL didFinish) {
+        finished = didFinish;
+    }];
+
+    expect(ds.allItems).to.equal((@[ @"foo", @"bar" ]));
+    expect(finished).will.beTruthy();
+    expect(ds.allItems).to.equal((@[ @"foo", @"bar", @"baz" ]));
+    [mockTableView verify];
+}
+
+- (void)testSupersededBackgroundUpdatesAreDropped
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo" ]];
+    ds.itemIdentifierBlock = ^id(NSString *item) {
+        return item;
+    };
+    NSMutableArray *results = [NSMutableArray array];
+
+    [ds updateItems:@[ @"foo", @"bar" ] completion:^(BOOL finished) {
+        [results addObject:@(finished)];
+    }];
+    [ds updateItems:@[ @"baz" ] completion:^(BOOL finished) {
+        [results addObject:@(finished)];
+    }];
+
+    expect(results).will.haveCountOf(2);
+    expect(results).to.equal((@[ @NO, @YES ]));
+    expect(ds.allItems).to.equal(@[ @"baz" ]);
+}
+
+- (void)testBackgroundUpdateAfterDirectChange
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo" ]];
+    ds.itemIdentifierBlock = ^id(NSString *item) {
+        return item;
+    };
+    __block BOOL finished = NO;
+
+    [ds updateItems:@[ @"foo", @"bar" ] completion:^(BOOL didFinish) {
+        finished = didFinish;
+    }];
+    [ds appendItem:@"baz"];
+
+    expect(finished).will.beTruthy();
+    expect(ds.allItems).to.equal((@[ @"foo", @"bar" ]));
+}
+
+- (void)testUpdatingItemsWithIdentifiersReloadsChangedItems
+{
+    NSArray *items = @[ @{ @"id" : @1, @"name" : @"Merlyn" } ];
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:items];
+    ds.itemIdentifierBlock = ^id(NSDictionary *item) {
+        return item[@"id"];
+    };
+    id mockCollectionView = collectionView;
+    ds.collectionView = mockCollectionView;
+
+    [[[mockCollectionView expect] andDo:^(NSInvocation *invocation) {
+        __unsafe_unretained void (^updates)(void);
+        [invocation getArgument:&updates atIndex:2];
+        updates();
+    }] performBatchUpdates:OCMOCK_ANY completion:OCMOCK_ANY];
+    [[mockCollectionView expect] reloadItemsAtIndexPaths:@[[NSIndexPath indexPathForRow:0 inSection:0]]];
+
+    [ds updateItems:@[ @{ @"id" : @1, @"name" : @"Merlin" } ]];
+
+    [mockCollectionView verify];
+}
+
+#pragma mark Transactions
+
+- (void)testTransactionAppliesMergedChangesInOneBatch
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo", @"bar" ]];
+    id mockTableView = [OCMockObject mockForClass:UITableView.class];
+    [[mockTableView stub] setDataSource:OCMOCK_ANY];
+    ds.tableView = mockTableView;
+    __block BOOL completed = NO;
+
+    [[mockTableView expect] beginUpdates];
+    [[mockTableView expect] deleteRowsAtIndexPaths:@[[NSIndexPath indexPathForRow:0 inSection:0]]
+                                  withRowAnimation:ds.rowAnimation];
+    [[mockTableView expect] insertRowsAtIndexPaths:(@[[NSIndexPath indexPathForRow:1 inSection:0],
+                                                      [NSIndexPath indexPathForRow:2 inSection:0]])
+                                  withRowAnimation:ds.rowAnimation];
+    [[mockTableView expect] endUpdates];
+
+    [ds performUpdates:^{
+        [ds appendItem:@"baz"];
+        [ds appendItem:@"biz"];
+        [ds removeItemAtIndex:0];
+    } completion:^(BOOL finished) {
+        completed = finished;
+    }];
+
+    [mockTableView verify];
+    expect(completed).to.beTruthy();
+    expect(ds.allItems).to.equal((@[ @"bar", @"baz", @"biz" ]));
+}
+
+- (void)testTransactionWithoutNetChangesDoesNotUpdateTableView
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo" ]];
+    id mockTableView = [OCMockObject mockForClass:UITableView.class];
+    [[mockTableView stub] setDataSource:OCMOCK_ANY];
+    ds.tableView = mockTableView;
+    __block NSUInteger completionCount = 0;
+
+    [ds performUpdates:^{
+        [ds appendItem:@"bar"];
+
+        [ds performUpdates:^{
+            [ds removeItemAtIndex:1];
+        } completion:^(BOOL finished) {
+            completionCount++;
+        }];
+    } completion:^(BOOL finished) {
+        completionCount++;
+    }];
+
+    [mockTableView verify];
+    expect(completionCount).to.equal(2);
+}
+
+- (void)testTransactionUpdatesEmptyViewOnce
+{
+    UIView *emptyView = [[UIView alloc] initWithFrame:CGRectMake(0, 0, 100, 100)];
+
+    dataSource.tableView = (UITableView *)tableView;
+    dataSource.emptyView = emptyView;
+
+    [dataSource performUpdates:^{
+        [dataSource appendItem:@"Item"];
+
+        expect(emptyView.hidden).to.beFalsy();
+    } completion:nil];
+
+    expect(emptyView.hidden).to.beTruthy();
+}
+
+- (void)testLargeChangesReloadSectionInsteadOfAnimating
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo" ]];
+    ds.maximumAnimatedChangeCount = 2;
+    id mockTableView = [OCMockObject mockForClass:UITableView.class];
+    [[mockTableView stub] setDataSource:OCMOCK_ANY];
+    ds.tableView = mockTableView;
+
+    [[mockTableView expect] insertRowsAtIndexPaths:(@[[NSIndexPath indexPathForRow:1 inSection:0],
+                                                      [NSIndexPath indexPathForRow:2 inSection:0]])
+                                  withRowAnimation:ds.rowAnimation];
+    [ds appendItems:@[ @"bar", @"baz" ]];
+    [mockTableView verify];
+
+    [[mockTableView expect] reloadSections:[NSIndexSet indexSetWithIndex:0]
+                          withRowAnimation:ds.rowAnimation];
+    [ds appendItems:@[ @"a", @"b", @"c" ]];
+    [mockTableView verify];
+
+    expect(ds.numberOfItems).to.equal(6);
+}
+
+- (void)testLargeTransactionsReloadChangedSections
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo" ]];
+    ds.maximumAnimatedChangeCount = 2;
+    id mockTableView = [OCMockObject mockForClass:UITableView.class];
+    [[mockTableView stub] setDataSource:OCMOCK_ANY];
+    ds.tableView = mockTableView;
+
+    [[mockTableView expect] reloadSections:[NSIndexSet indexSetWithIndex:0]
+                          withRowAnimation:ds.rowAnimation];
+
+    [ds performUpdates:^{
+        [ds appendItem:@"bar"];
+        [ds appendItem:@"baz"];
+        [ds removeItemAtIndex:0];
+    } completion:nil];
+
+    [mockTableView verify];
+}
+
+- (void)testLargeDiffsReloadData
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo" ]];
+    ds.itemIdentifierBlock = ^id(NSString *item) {
+        return item;
+    };
+    ds.maximumAnimatedChangeCount = 2;
+    id mockTableView = [OCMockObject mockForClass:UITableView.class];
+    [[mockTableView stub] setDataSource:OCMOCK_ANY];
+    ds.tableView = mockTableView;
+
+    [[mockTableView expect] reloadData];
+
+    [ds updateItems:@[ @"a", @"b", @"c" ]];
+
+    [mockTableView verify];
+    expect(ds.allItems).to.equal((@[ @"a", @"b", @"c" ]));
+}
+
 #pragma mark Appending items
 
 - (void)testAppendSingleItem
@@ -603,6 +882,343 @@
     expect([dataSource indexPathForItemWithId:[wizard2 objectID]]).to.beNil();
 }
 
+- (void)testFindingManagedObjectByIdWithItemIndex
+{
+    Wizard *wizard = [Wizard wizardWithName:@"Gandalf" realm:@"Middle-Earth" inContext:[NSManagedObjectContext MR_defaultContext]];
+    Wizard *wizard2 = [Wizard wizardWithName:@"Merlyn" realm:@"Arthurian" inContext:[NSManagedObjectContext MR_defaultContext]];
+    
+    dataSource.maintainsItemIndex = YES;
+    [dataSource appendItem:wizard];
+    
+    expect([dataSource indexPathForItemWithId:[wizard objectID]]).to.equal([NSIndexPath indexPathForItem:0 inSection:0]);
+    expect([dataSource indexPathForItemWithId:[wizard2 objectID]]).to.beNil();
+    
+    [dataSource insertItem:wizard2 atIndex:0];
+    expect([dataSource indexPathForItemWithId:[wizard objectID]]).to.equal([NSIndexPath indexPathForItem:1 inSection:0]);
+    expect([dataSource indexPathForItemWithId:[wizard2 objectID]]).to.equal([NSIndexPath indexPathForItem:0 inSection:0]);
+}
+
+#pragma mark - Item sizes
+
+- (void)testCachesItemSizes
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo", @"barbaz" ]];
+    __block NSUInteger sizeCount = 0;
+    ds.itemSizeBlock = ^CGSize(NSString *item, CGFloat width) {
+        sizeCount++;
+        return CGSizeMake(width, [item length] * 10);
+    };
+    NSIndexPath *indexPath = [NSIndexPath indexPathForRow:1 inSection:0];
+    
+    expect([ds sizeForItemAtIndexPath:indexPath width:320]).to.equal(CGSizeMake(320, 60));
+    expect([ds sizeForItemAtIndexPath:indexPath width:320]).to.equal(CGSizeMake(320, 60));
+    expect(sizeCount).to.equal(1);
+    
+    expect([ds sizeForItemAtIndexPath:indexPath width:480]).to.equal(CGSizeMake(480, 60));
+    expect(sizeCount).to.equal(2);
+}
+
+- (void)testReplacingItemInvalidatesSize
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @{ @"id" : @1, @"text" : @"foo" } ]];
+    ds.itemIdentifierBlock = ^id(NSDictionary *item) {
+        return item[@"id"];
+    };
+    ds.itemSizeBlock = ^CGSize(NSDictionary *item, CGFloat width) {
+        return CGSizeMake(width, [item[@"text"] length] * 10);
+    };
+    NSIndexPath *indexPath = [NSIndexPath indexPathForRow:0 inSection:0];
+    
+    expect([ds sizeForItemAtIndexPath:indexPath width:320].height).to.equal(30);
+    
+    [ds replaceItemAtIndex:0 withItem:@{ @"id" : @1, @"text" : @"foobar" }];
+    
+    expect([ds sizeForItemAtIndexPath:indexPath width:320].height).to.equal(60);
+    
+    [ds updateItems:@[ @{ @"id" : @1, @"text" : @"f" } ]];
+    
+    expect([ds sizeForItemAtIndexPath:indexPath width:320].height).to.equal(10);
+}
+
+- (void)testRemovingItemsEvictsSizes
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo", @"bar", @"baz" ]];
+    ds.itemIdentifierBlock = ^id(NSString *item) {
+        return item;
+    };
+    ds.itemSizeBlock = ^CGSize(NSString *item, CGFloat width) {
+        return CGSizeMake(width, 44);
+    };
+    
+    for (NSInteger row = 0; row < 3; row++) {
+        [ds sizeForItemAtIndexPath:[NSIndexPath indexPathForRow:row inSection:0] width:320];
+    }
+    
+    expect([ds.sizeCache count]).to.equal(3);
+    
+    [ds removeItemAtIndex:0];
+    
+    expect([ds.sizeCache count]).to.equal(2);
+    expect([ds.sizeCache getSize:NULL forIdentifier:@"foo" width:320]).to.beFalsy();
+    
+    [ds updateItems:@[ @"baz" ]];
+    
+    expect([ds.sizeCache count]).to.equal(1);
+    expect([ds.sizeCache getSize:NULL forIdentifier:@"bar" width:320]).to.beFalsy();
+    
+    [ds reloadData];
+    
+    expect([ds.sizeCache count]).to.equal(0);
+}
+
+- (void)testRecordingMeasuredSizes
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo" ]];
+    NSIndexPath *indexPath = [NSIndexPath indexPathForRow:0 inSection:0];
+    
+    expect([ds sizeForItemAtIndexPath:indexPath width:320]).to.equal(CGSizeZero);
+    
+    [ds setSize:CGSizeMake(320, 44) forItemAtIndexPath:indexPath width:320];
+    
+    expect([ds sizeForItemAtIndexPath:indexPath width:320]).to.equal(CGSizeMake(320, 44));
+    
+    [ds reloadData];
+    
+    expect([ds sizeForItemAtIndexPath:indexPath width:320]).to.equal(CGSizeZero);
+}
+
+- (void)testPrecomputingSizesInBackground
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo", @"barbaz" ]];
+    ds.itemSizeBlock = ^CGSize(NSString *item, CGFloat width) {
+        return CGSizeMake(width, [item length] * 10);
+    };
+    __block BOOL finished = NO;
+    
+    [ds precomputeSizesForItemsAtIndexPaths:[SSArrayDataSource indexPathArrayWithRange:NSMakeRange(0, 2)
+                                                                             inSection:0]
+                                      width:320
+                                 completion:^{
+                                     finished = YES;
+                                 }];
+    
+    expect(finished).will.beTruthy();
+    
+    CGSize size;
+    expect([ds.sizeCache getSize:&size forIdentifier:@"barbaz" width:320]).to.beTruthy();
+    expect(size).to.equal(CGSizeMake(320, 60));
+}
+
+- (void)testPrecomputingSizesDiscardsOnlyInvalidatedItems
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo", @"barbaz" ]];
+    ds.itemSizeBlock = ^CGSize(NSString *item, CGFloat width) {
+        return CGSizeMake(width, [item length] * 10);
+    };
+    __block BOOL finished = NO;
+    
+    [ds precomputeSizesForItems:@[ @"foo", @"barbaz" ]
+                          width:320
+                     completion:^{
+                         finished = YES;
+                     }];
+    
+    // Invalidated while its size is being computed
+    [ds invalidateSizesForItemsAtIndexPaths:@[ [NSIndexPath indexPathForRow:0 inSection:0] ]];
+    
+    expect(finished).will.beTruthy();
+    
+    expect([ds.sizeCache getSize:NULL forIdentifier:@"foo" width:320]).to.beFalsy();
+    expect([ds.sizeCache getSize:NULL forIdentifier:@"barbaz" width:320]).to.beTruthy();
+}
+
+#pragma mark - Prefetching
+
+- (void)testPrefetchingItems
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo", @"bar" ]];
+    NSMutableArray *prefetched = [NSMutableArray array];
+    NSMutableArray *cancelled = [NSMutableArray array];
+    ds.itemPrefetchBlock = ^id(NSString *item) {
+        [prefetched addObject:item];
+        return [item uppercaseString];
+    };
+    ds.itemCancelPrefetchBlock = ^(NSString *item, NSString *token) {
+        [cancelled addObject:token];
+    };
+    NSArray *indexPaths = [SSArrayDataSource indexPathArrayWithRange:NSMakeRange(0, 2) inSection:0];
+    
+    [ds prefetchItemsAtIndexPaths:indexPaths];
+    [ds prefetchItemsAtIndexPaths:indexPaths];
+    
+    expect(prefetched).to.equal((@[ @"foo", @"bar" ]));
+    
+    [ds cancelPrefetchingItemsAtIndexPaths:@[ indexPaths[1], [NSIndexPath indexPathForRow:5 inSection:0] ]];
+    
+    expect(cancelled).to.equal(@[ @"BAR" ]);
+    
+    [ds prefetchItemsAtIndexPaths:indexPaths];
+    
+    expect(prefetched).to.equal((@[ @"foo", @"bar", @"bar" ]));
+}
+
+- (void)testDisplayedItemsAreNotCancelled
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo" ]];
+    __block BOOL didCancel = NO;
+    ds.itemPrefetchBlock = ^id(NSString *item) {
+        return nil;
+    };
+    ds.itemCancelPrefetchBlock = ^(NSString *item, id token) {
+        didCancel = YES;
+    };
+    ds.cellCreationBlock = ^id(id object, id parentView, NSIndexPath *indexPath) {
+        return [UITableViewCell new];
+    };
+    NSIndexPath *indexPath = [NSIndexPath indexPathForRow:0 inSection:0];
+    
+    [ds prefetchItemsAtIndexPaths:@[ indexPath ]];
+    [ds tableView:tableView cellForRowAtIndexPath:indexPath];
+    [ds cancelPrefetchingItemsAtIndexPaths:@[ indexPath ]];
+    
+    expect(didCancel).to.beFalsy();
+}
+
+- (void)testRemovingOrReloadingItemsCancelsPrefetching
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo", @"bar", @"baz" ]];
+    NSMutableArray *prefetched = [NSMutableArray array];
+    NSMutableArray *cancelled = [NSMutableArray array];
+    ds.itemPrefetchBlock = ^id(NSString *item) {
+        [prefetched addObject:item];
+        return [item uppercaseString];
+    };
+    ds.itemCancelPrefetchBlock = ^(NSString *item, NSString *token) {
+        [cancelled addObject:token];
+    };
+    
+    [ds prefetchItemsAtIndexPaths:[SSArrayDataSource indexPathArrayWithRange:NSMakeRange(0, 3) inSection:0]];
+    [ds removeItemAtIndex:0];
+    
+    expect(cancelled).to.equal(@[ @"FOO" ]);
+    
+    [ds reloadCellsAtIndexes:[NSIndexSet indexSetWithIndex:0] inSection:0];
+    
+    expect(cancelled).to.equal((@[ @"FOO", @"BAR" ]));
+    
+    [ds reloadData];
+    
+    expect(cancelled).to.equal((@[ @"FOO", @"BAR", @"BAZ" ]));
+    
+    [ds prefetchItemsAtIndexPaths:@[ [NSIndexPath indexPathForRow:0 inSection:0] ]];
+    
+    expect(prefetched).to.equal((@[ @"foo", @"bar", @"baz", @"bar" ]));
+}
+
+#pragma mark - Cell preparation
+
+- (void)testAppliesPreparedViewModels
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @{ @"id" : @1, @"text" : @"foo" } ]];
+    __block NSUInteger prepareCount = 0;
+    ds.itemIdentifierBlock = ^id(NSDictionary *item) {
+        return item[@"id"];
+    };
+    ds.itemPrepareBlock = ^id(NSDictionary *item) {
+        prepareCount++;
+        return [item[@"text"] uppercaseString];
+    };
+    ds.cellApplyBlock = ^(UITableViewCell *cell, NSString *viewModel, id parentView, NSIndexPath *indexPath) {
+        cell.textLabel.text = viewModel;
+    };
+    ds.cellCreationBlock = ^id(id object, id parentView, NSIndexPath *indexPath) {
+        return [[UITableViewCell alloc] initWithStyle:UITableViewCellStyleDefault reuseIdentifier:nil];
+    };
+    NSIndexPath *indexPath = [NSIndexPath indexPathForRow:0 inSection:0];
+
+    UITableViewCell *cell = [ds tableView:tableView cellForRowAtIndexPath:indexPath];
+    [ds tableView:tableView cellForRowAtIndexPath:indexPath];
+
+    expect(cell.textLabel.text).to.equal(@"FOO");
+    expect(prepareCount).to.equal(1);
+
+    [ds replaceItemAtIndex:0 withItem:@{ @"id" : @1, @"text" : @"bar" }];
+
+    expect([ds preparedViewModelForItemAtIndexPath:indexPath]).to.equal(@"BAR");
+    expect(prepareCount).to.equal(2);
+}
+
+- (void)testUpdatingItemsReloadsPreparedViewModels
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @{ @"id" : @1, @"text" : @"foo" },
+                                                                        @{ @"id" : @2, @"text" : @"baz" } ]];
+    ds.itemIdentifierBlock = ^id(NSDictionary *item) {
+        return item[@"id"];
+    };
+    ds.itemEqualityBlock = ^BOOL(NSDictionary *item, NSDictionary *otherItem) {
+        return [item isEqualToDictionary:otherItem];
+    };
+    ds.itemPrepareBlock = ^id(NSDictionary *item) {
+        return [item[@"text"] uppercaseString];
+    };
+    NSIndexPath *indexPath = [NSIndexPath indexPathForRow:0 inSection:0];
+
+    expect([ds preparedViewModelForItemAtIndexPath:indexPath]).to.equal(@"FOO");
+
+    // No sizes are cached, but the prepared view model is still stale.
+    [ds updateItems:@[ @{ @"id" : @1, @"text" : @"bar" },
+                       @{ @"id" : @2, @"text" : @"baz" } ]];
+
+    expect([ds preparedViewModelForItemAtIndexPath:indexPath]).to.equal(@"BAR");
+}
+
+- (void)testPreparesViewModelsInBackground
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo", @"bar" ]];
+    __block BOOL preparedOnMainThread = NO;
+    __block BOOL didComplete = NO;
+    ds.itemPrepareBlock = ^id(NSString *item) {
+        preparedOnMainThread = preparedOnMainThread || [NSThread isMainThread];
+        return [item uppercaseString];
+    };
+
+    [ds prefetchItemsAtIndexPaths:[SSArrayDataSource indexPathArrayWithRange:NSMakeRange(0, 2) inSection:0]];
+    [ds prepareViewModelsForItemsAtIndexPaths:@[ [NSIndexPath indexPathForRow:1 inSection:0] ] completion:^{
+        didComplete = YES;
+    }];
+
+    expect(didComplete).will.beTruthy();
+    expect(preparedOnMainThread).to.beFalsy();
+
+    ds.itemPrepareBlock = ^id(NSString *item) {
+        return nil;
+    };
+
+    expect([ds preparedViewModelForItemAtIndexPath:[NSIndexPath indexPathForRow:1 inSection:0]]).to.beNil();
+}
+
+- (void)testKeepsViewModelsPreparedWhileOtherItemsChange
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @"foo", @"bar" ]];
+    __block NSUInteger prepareCount = 0;
+    __block BOOL didComplete = NO;
+    ds.itemPrepareBlock = ^id(NSString *item) {
+        prepareCount++;
+        return [item uppercaseString];
+    };
+
+    [ds prepareViewModelsForItemsAtIndexPaths:@[ [NSIndexPath indexPathForRow:1 inSection:0] ] completion:^{
+        didComplete = YES;
+    }];
+
+    // Neither item has a view model yet, so nothing prepared is made stale.
+    [ds replaceItemAtIndex:0 withItem:@"baz"];
+
+    expect(didComplete).will.beTruthy();
+    expect([ds preparedViewModelForItemAtIndexPath:[NSIndexPath indexPathForRow:1 inSection:0]]).to.equal(@"BAR");
+    expect(prepareCount).to.equal(1);
+}
+
 #pragma mark - Empty View
 
 - (void)testEmptyView
@@ -0,0 +1,103 @@
+#import "SSTestHelper.h"
+#import <SSDataSources.h>
+
+@interface SSArrayDiffTests : XCTestCase
+@end
+
+@implementation SSArrayDiffTests
+
+- (void)testIdenticalArraysHaveNoChanges
+{
+    SSArrayDiff *diff = [SSArrayDiff diffFromArray:@[ @"foo", @"bar" ]
+                                           toArray:@[ @"foo", @"bar" ]
+                                   identifierBlock:nil
+                                     equalityBlock:nil];
+    expect([diff hasChanges]).to.beFalsy();
+    expect(diff.changeCount).to.equal(0);
+}
+
+- (void)testInsertsAndDeletes
+{
+    SSArrayDiff *diff = [SSArrayDiff diffFromArray:@[ @"a", @"b", @"c" ]
+                                           toArray:@[ @"a", @"c", @"d" ]
+                                   identifierBlock:nil
+                                     equalityBlock:nil];
+    expect(diff.deletedIndexes).to.equal([NSIndexSet indexSetWithIndex:1]);
+    expect(diff.insertedIndexes).to.equal([NSIndexSet indexSetWithIndex:2]);
+    expect(diff.moves).to.haveCountOf(0);
+    expect(diff.reloadedIndexes).to.haveCountOf(0);
+}
+
+- (void)testShiftedItemsAreNotMoved
+{
+    SSArrayDiff *diff = [SSArrayDiff diffFromArray:@[ @"b", @"c", @"d" ]
+                                           toArray:@[ @"a", @"b", @"c", @"d" ]
+                                   identifierBlock:nil
+                                     equalityBlock:nil];
+    expect(diff.insertedIndexes).to.equal([NSIndexSet indexSetWithIndex:0]);
+    expect(diff.moves).to.haveCountOf(0);
+}
+
+- (void)testMinimalMoves
+{
+    SSArrayDiff *diff = [SSArrayDiff diffFromArray:@[ @"a", @"b", @"c", @"d" ]
+                                           toArray:@[ @"b", @"c", @"d", @"a" ]
+                                   identifierBlock:nil
+                                     equalityBlock:nil];
+    expect(diff.moves).to.haveCountOf(1);
+    expect([diff.moves[0] fromIndex]).to.equal(0);
+    expect([diff.moves[0] toIndex]).to.equal(3);
+    expect(diff.deletedIndexes).to.haveCountOf(0);
+    expect(diff.insertedIndexes).to.haveCountOf(0);
+}
+
+- (void)testChangedContentsAreReloaded
+{
+    NSArray *old = @[ @{ @"id" : @1, @"name" : @"Merlyn" }, @{ @"id" : @2, @"name" : @"Gandalf" } ];
+    NSArray *new = @[ @{ @"id" : @1, @"name" : @"Merlin" }, @{ @"id" : @2, @"name" : @"Gandalf" } ];
+
+    SSArrayDiff *diff = [SSArrayDiff diffFromArray:old
+                                           toArray:new
+                                   identifierBlock:^id(NSDictionary *item) {
+                                       return item[@"id"];
+                                   }
+                                     equalityBlock:nil];
+    expect(diff.reloadedIndexes).to.equal([NSIndexSet indexSetWithIndex:0]);
+    expect(diff.changeCount).to.equal(1);
+}
+
+- (void)testMovedAndChangedItemsAreDeletedAndInserted
+{
+    NSArray *old = @[ @{ @"id" : @1, @"name" : @"Merlyn" }, @{ @"id" : @2, @"name" : @"Gandalf" } ];
+    NSArray *new = @[ @{ @"id" : @2, @"name" : @"Gandalf" }, @{ @"id" : @1, @"name" : @"Merlin" } ];
+
+    SSArrayDiff *diff = [SSArrayDiff diffFromArray:old
+                                           toArray:new
+                                   identifierBlock:^id(NSDictionary *item) {
+                                       return item[@"id"];
+                                   }
+                                     equalityBlock:nil];
+    expect(diff.deletedIndexes).to.equal([NSIndexSet indexSetWithIndex:0]);
+    expect(diff.insertedIndexes).to.equal([NSIndexSet indexSetWithIndex:1]);
+    expect(diff.moves).to.haveCountOf(0);
+}
+
+- (void)testDuplicateIdentifiers
+{
+    SSArrayDiff *diff = [SSArrayDiff diffFromArray:@[ @"a", @"a", @"b" ]
+                                           toArray:@[ @"a", @"b" ]
+                                   identifierBlock:nil
+                                     equalityBlock:nil];
+    expect(diff.deletedIndexes).to.equal([NSIndexSet indexSetWithIndex:1]);
+    expect(diff.insertedIndexes).to.haveCountOf(0);
+    expect(diff.moves).to.haveCountOf(0);
+}
+
+- (void)testStableElements
+{
+    NSUInteger sequence[] = { 3, 0, 1, 2 };
+    expect([SSArrayDiff indexesOfStableElementsInSequence:sequence count:4])
+        .to.equal([NSIndexSet indexSetWithIndexesInRange:NSMakeRange(1, 3)]);
+}
+
+@end
@@ -0,0 +1,171 @@
+#import "SSTestHelper.h"
+#import <SSDataSources.h>
+
+@interface SSCompositeDataSourceTests : XCTestCase
+@end
+
+@implementation SSCompositeDataSourceTests
+{
+    SSArrayDataSource *arrayDataSource;
+    SSSectionedDataSource *sectionedDataSource;
+    SSCompositeDataSource *ds;
+    OCMockObject *mockTable;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    
+    mockTable = [OCMockObject niceMockForClass:[UITableView class]];
+    arrayDataSource = [[SSArrayDataSource alloc] initWithItems:@[ @"a", @"b" ]];
+    sectionedDataSource = [[SSSectionedDataSource alloc] initWithSections:@[ @[ @1, @2 ], @[ @3 ] ]];
+    ds = [[SSCompositeDataSource alloc] initWithDataSources:@[ arrayDataSource, sectionedDataSource ]];
+    ds.tableView = (UITableView *)mockTable;
+}
+
+- (void)tearDown
+{
+    [super tearDown];
+    ds = nil;
+}
+
+- (void)testConcatenatesSections
+{
+    expect([ds numberOfSections]).to.equal(3);
+    expect([ds numberOfItemsInSection:0]).to.equal(2);
+    expect([ds numberOfItemsInSection:2]).to.equal(1);
+    expect([ds numberOfItems]).to.equal(5);
+    expect([ds itemAtIndexPath:[NSIndexPath indexPathForRow:1 inSection:0]]).to.equal(@"b");
+    expect([ds itemAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:2]]).to.equal(@3);
+    expect([ds itemAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:3]]).to.beNil();
+}
+
+- (void)testMapsSections
+{
+    NSInteger localSection = NSNotFound;
+    
+    expect([ds dataSourceForSection:2 localSection:&localSection]).to.beIdenticalTo(sectionedDataSource);
+    expect(localSection).to.equal(1);
+    expect([ds dataSourceForSection:3 localSection:NULL]).to.beNil();
+    expect([ds sectionForLocalSection:1 inDataSource:sectionedDataSource]).to.equal(2);
+    expect([ds sectionForLocalSection:1 inDataSource:arrayDataSource]).to.equal(NSNotFound);
+    
+    SSBaseDataSource *dataSource = nil;
+    
+    expect([ds localIndexPathForIndexPath:[NSIndexPath indexPathForRow:1 inSection:1] dataSource:&dataSource])
+        .to.equal([NSIndexPath indexPathForRow:1 inSection:0]);
+    expect(dataSource).to.beIdenticalTo(sectionedDataSource);
+    expect([ds indexPathForLocalIndexPath:[NSIndexPath indexPathForRow:0 inSection:1] inDataSource:sectionedDataSource])
+        .to.equal([NSIndexPath indexPathForRow:0 inSection:2]);
+}
+
+- (void)testSkipsChildrenWithoutSections
+{
+    SSSectionedDataSource *emptyDataSource = [[SSSectionedDataSource alloc] initWithSections:@[]];
+    SSCompositeDataSource *composite = [[SSCompositeDataSource alloc] initWithDataSources:@[ emptyDataSource,
+                                                                                              sectionedDataSource ]];
+    
+    expect([composite numberOfSections]).to.equal(2);
+    expect([composite dataSourceForSection:0 localSection:NULL]).to.beIdenticalTo(sectionedDataSource);
+}
+
+- (void)testOffsetsChildItemChanges
+{
+    [[mockTable expect] insertRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:1 inSection:2] ]
+                              withRowAnimation:ds.rowAnimation];
+    [[mockTable reject] reloadData];
+    
+    [sectionedDataSource insertItem:@4 atIndexPath:[NSIndexPath indexPathForRow:1 inSection:1]];
+    
+    [mockTable verify];
+    expect([ds itemAtIndexPath:[NSIndexPath indexPathForRow:1 inSection:2]]).to.equal(@4);
+    
+    [[mockTable expect] deleteRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:0 inSection:0] ]
+                              withRowAnimation:ds.rowAnimation];
+    
+    [arrayDataSource removeItemAtIndex:0];
+    
+    [mockTable verify];
+}
+
+- (void)testOffsetsChildSectionChanges
+{
+    [[mockTable expect] insertSections:[NSIndexSet indexSetWithIndex:3]
+                      withRowAnimation:ds.rowAnimation];
+    [[mockTable reject] reloadData];
+    
+    [sectionedDataSource appendSection:[SSSection sectionWithItems:@[ @5 ]]];
+    
+    [mockTable verify];
+    expect([ds numberOfSections]).to.equal(4);
+    expect([ds itemAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:3]]).to.equal(@5);
+    
+    [[mockTable expect] deleteSections:[NSIndexSet indexSetWithIndex:1]
+                      withRowAnimation:ds.rowAnimation];
+    
+    [sectionedDataSource removeSectionAtIndex:0];
+    
+    [mockTable verify];
+    expect([ds numberOfSections]).to.equal(3);
+    expect([ds itemAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:1]]).to.equal(@3);
+}
+
+- (void)testOffsetsChildBatchUpdates
+{
+    [[mockTable expect] deleteSections:[NSIndexSet indexSetWithIndex:1]
+                      withRowAnimation:ds.rowAnimation];
+    [[mockTable expect] insertRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:1 inSection:1] ]
+                              withRowAnimation:ds.rowAnimation];
+    [[mockTable reject] reloadData];
+    
+    [sectionedDataSource performBatchUpdates:^{
+        [sectionedDataSource removeSectionAtIndex:0];
+        [sectionedDataSource insertItem:@4 atIndexPath:[NSIndexPath indexPathForRow:1 inSection:0]];
+    }];
+    
+    [mockTable verify];
+    expect([ds numberOfSections]).to.equal(2);
+    expect([ds itemAtIndexPath:[NSIndexPath indexPathForRow:1 inSection:1]]).to.equal(@4);
+}
+
+- (void)testReloadsOnlyChildSections
+{
+    [[mockTable expect] reloadSections:[NSIndexSet indexSetWithIndex:0]
+                      withRowAnimation:ds.rowAnimation];
+    [[mockTable reject] reloadData];
+    
+    [arrayDataSource updateItems:@[ @"c", @"d", @"e" ]];
+    
+    [mockTable verify];
+    expect([ds numberOfItemsInSection:0]).to.equal(3);
+    expect([ds numberOfSections]).to.equal(3);
+}
+
+- (void)testIgnoresDataSourcesThatAreNotChildren
+{
+    SSSectionedDataSource *stranger = [[SSSectionedDataSource alloc] initWithItems:@[ @"x" ]];
+    [stranger addObserver:(id <SSDataSourceObserver>)ds];
+    [[mockTable reject] reloadData];
+    
+    [stranger insertItem:@"y" atIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]];
+    [stranger appendSection:[SSSection sectionWithItems:@[ @"z" ]]];
+    [stranger moveSectionAtIndex:1 toIndex:0];
+    [stranger applySections:@[ [SSSection sectionWithItems:@[ @"w" ]] ]];
+    [stranger reloadData];
+    
+    [mockTable verify];
+    expect([ds numberOfSections]).to.equal(3);
+    expect([ds numberOfItems]).to.equal(5);
+    
+    [stranger removeObserver:(id <SSDataSourceObserver>)ds];
+}
+
+- (void)testForwardsSectionTitles
+{
+    [sectionedDataSource sectionAtIndex:1].header = @"Numbers";
+    
+    expect([ds tableView:(UITableView *)mockTable titleForHeaderInSection:2]).to.equal(@"Numbers");
+    expect([ds tableView:(UITableView *)mockTable titleForHeaderInSection:0]).to.beNil();
+}
+
+@end
@@ -276,6 +276,104 @@
     [mockTable verify];
 }
 
+- (void)testCoalescingChangesInsertsRowsOnce
+{
+    id mockTable = tableView;
+    
+    UITableViewRowAnimation animation = UITableViewRowAnimationLeft;
+    
+    dataSource.rowAnimation = animation;
+    dataSource.changeCoalescingInterval = 0.2;
+    
+    [[mockTable expect] insertRowsAtIndexPaths:(@[ [NSIndexPath indexPathForRow:0 inSection:0],
+                                                   [NSIndexPath indexPathForRow:1 inSection:0] ])
+                              withRowAnimation:animation];
+    
+    [MagicalRecord saveWithBlockAndWait:^(NSManagedObjectContext *context) {
+        [Wizard wizardWithName:@"Gandalf" realm:@"Middle-Earth" inContext:context];
+    }];
+    
+    [MagicalRecord saveWithBlockAndWait:^(NSManagedObjectContext *context) {
+        [Wizard wizardWithName:@"Pallando" realm:@"Middle-Earth" inContext:context];
+    }];
+    
+    [mockTable verifyWithDelay:1];
+}
+
+- (void)testCoalescingInsertThenDeleteHasNoChanges
+{
+    id mockTable = tableView;
+    
+    dataSource.changeCoalescingInterval = 0.2;
+    
+    [[mockTable reject] insertRowsAtIndexPaths:OCMOCK_ANY withRowAnimation:dataSource.rowAnimation];
+    [[mockTable reject] deleteRowsAtIndexPaths:OCMOCK_ANY withRowAnimation:dataSource.rowAnimation];
+    
+    Wizard *w = [Wizard wizardWithName:@"Gandalf" realm:@"Middle-Earth" inContext:[NSManagedObjectContext MR_defaultContext]];
+    
+    [[NSManagedObjectContext MR_defaultContext] MR_saveToPersistentStoreAndWait];
+    
+    [w MR_deleteInContext:[NSManagedObjectContext MR_defaultContext]];
+    
+    [[NSManagedObjectContext MR_defaultContext] MR_saveToPersistentStoreAndWait];
+    
+    [dataSource applyPendingChanges];
+    
+    [mockTable verify];
+}
+
+- (void)testCoalescingAnswersWithDisplayedContents
+{
+    Wizard *w = [Wizard wizardWithName:@"Gandalf" realm:@"Middle-Earth" inContext:[NSManagedObjectContext MR_defaultContext]];
+    
+    [[NSManagedObjectContext MR_defaultContext] MR_saveToPersistentStoreAndWait];
+    
+    expect(dataSource.numberOfItems).to.equal(1);
+    
+    dataSource.changeCoalescingInterval = 0.2;
+    
+    [w MR_deleteInContext:[NSManagedObjectContext MR_defaultContext]];
+    
+    [[NSManagedObjectContext MR_defaultContext] MR_saveToPersistentStoreAndWait];
+    
+    // The views keep showing the deleted wizard until the changes are applied.
+    expect(dataSource.numberOfItems).to.equal(1);
+    expect([dataSource itemAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]]).to.equal(w);
+    expect([dataSource itemAtIndexPath:[NSIndexPath indexPathForRow:1 inSection:0]]).to.beNil();
+    expect([dataSource tableView:tableView titleForHeaderInSection:3]).to.beNil();
+    expect([dataSource numberOfItemsInSection:3]).to.equal(0);
+    
+    [dataSource applyPendingChanges];
+    
+    expect(dataSource.numberOfItems).to.equal(0);
+}
+
+- (void)testCoalescingFindsDisplayedObjectsAcrossSaves
+{
+    NSManagedObjectContext *context = [NSManagedObjectContext MR_defaultContext];
+    Wizard *gandalf = [Wizard wizardWithName:@"Gandalf" realm:@"Middle-Earth" inContext:context];
+    Wizard *merlyn = [Wizard wizardWithName:@"Merlyn" realm:@"Arthurian" inContext:context];
+    
+    [context MR_saveToPersistentStoreAndWait];
+    
+    dataSource.changeCoalescingInterval = 0.2;
+    
+    [Wizard wizardWithName:@"Alatar" realm:@"Middle-Earth" inContext:context];
+    [context MR_saveToPersistentStoreAndWait];
+    
+    [gandalf MR_deleteInContext:context];
+    [context MR_saveToPersistentStoreAndWait];
+    
+    // Still Gandalf, then Merlyn, although the controller now has Alatar, then Merlyn.
+    expect(dataSource.numberOfItems).to.equal(2);
+    expect([dataSource itemAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]]).to.equal(gandalf);
+    expect([dataSource itemAtIndexPath:[NSIndexPath indexPathForRow:1 inSection:0]]).to.equal(merlyn);
+    
+    [dataSource applyPendingChanges];
+    
+    expect([dataSource itemAtIndexPath:[NSIndexPath indexPathForRow:1 inSection:0]]).to.equal(merlyn);
+}
+
 - (void)testForwardsMovesToMoveBlock
 {
     __block BOOL didMove = NO;
@@ -302,14 +400,113 @@
 - (void)testFindingManagedObjects
 {
     Wizard *aWizard = [Wizard wizardWithName:@"Gandalf" realm:@"Middle-Earth" inContext:[NSManagedObjectContext MR_defaultContext]];
+    Wizard *deletedWizard = [Wizard wizardWithName:@"Saruman" realm:@"Middle-Earth" inContext:[NSManagedObjectContext MR_defaultContext]];
+    
+    [[NSManagedObjectContext MR_contextForCurrentThread] MR_saveToPersistentStoreAndWait];
     
+    NSManagedObjectID *deletedId = [deletedWizard objectID];
+    
+    [deletedWizard MR_deleteInContext:[NSManagedObjectContext MR_defaultContext]];
     [[NSManagedObjectContext MR_contextForCurrentThread] MR_saveToPersistentStoreAndWait];
     
     expect([dataSource indexPathForItem:aWizard]).to.equal([NSIndexPath indexPathForRow:0 inSection:0]);
     
     expect([dataSource indexPathForItemWithId:[aWizard objectID]]).to.equal([NSIndexPath indexPathForRow:0 inSection:0]);
 
-    expect([dataSource indexPathForItemWithId:[NSManagedObjectID new]]).to.beNil();
+    expect([dataSource indexPathForItemWithId:deletedId]).to.beNil();
+}
+
+- (void)testFindingManyManagedObjects
+{
+    NSManagedObjectContext *context = [NSManagedObjectContext MR_defaultContext];
+    Wizard *gandalf = [Wizard wizardWithName:@"Gandalf" realm:@"Middle-Earth" inContext:context];
+    Wizard *merlyn = [Wizard wizardWithName:@"Merlyn" realm:@"Arthurian" inContext:context];
+    Wizard *saruman = [Wizard wizardWithName:@"Saruman" realm:@"Middle-Earth" inContext:context];
+    
+    [context MR_saveToPersistentStoreAndWait];
+    
+    NSManagedObjectID *deletedId = [saruman objectID];
+    
+    [saruman MR_deleteInContext:context];
+    [context MR_saveToPersistentStoreAndWait];
+    
+    NSDictionary *indexPaths = [dataSource indexPathsForItemsWithIds:@[ [merlyn objectID],
+                                                                        [gandalf objectID],
+                                                                        deletedId ]];
+    
+    expect(indexPaths).to.haveCountOf(2);
+    expect(indexPaths[[gandalf objectID]]).to.equal([NSIndexPath indexPathForRow:0 inSection:0]);
+    expect(indexPaths[[merlyn objectID]]).to.equal([NSIndexPath indexPathForRow:1 inSection:0]);
+}
+
+- (void)testFaultsObjectsOutsideWorkingSet
+{
+    NSManagedObjectContext *context = [NSManagedObjectContext MR_defaultContext];
+    
+    for (NSString *name in @[ @"Alatar", @"Gandalf", @"Merlyn", @"Pallando", @"Radagast" ]) {
+        [Wizard wizardWithName:name realm:@"Middle-Earth" inContext:context];
+    }
+    
+    [context MR_saveToPersistentStoreAndWait];
+    
+    expect([dataSource numberOfItems]).will.equal(5);
+    
+    dataSource.maximumNumberOfRealizedObjects = 2;
+    dataSource.cellCreationBlock = ^id(id object, id parentView, NSIndexPath *indexPath) {
+        return [UITableViewCell new];
+    };
+    
+    for (NSInteger row = 0; row < 5; row++) {
+        NSIndexPath *indexPath = [NSIndexPath indexPathForRow:row inSection:0];
+        [[dataSource itemAtIndexPath:indexPath] willAccessValueForKey:nil];
+        [dataSource tableView:tableView cellForRowAtIndexPath:indexPath];
+    }
+    
+    expect(dataSource.numberOfFaultedObjects).will.equal(3);
+    expect(dataSource.numberOfRealizedObjects).to.equal(2);
+    expect([[dataSource itemAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]] isFault]).to.beTruthy();
+}
+
+- (void)testPreparesManagedObjectsOnMainThread
+{
+    NSManagedObjectContext *context = [NSManagedObjectContext MR_defaultContext];
+    
+    [Wizard wizardWithName:@"Gandalf" realm:@"Middle-Earth" inContext:context];
+    [context MR_saveToPersistentStoreAndWait];
+    
+    expect([dataSource numberOfItems]).will.equal(1);
+    
+    __block BOOL sizedOnMainThread = NO;
+    __block BOOL preparedOnMainThread = NO;
+    __block BOOL didSize = NO;
+    __block BOOL didPrepare = NO;
+    NSIndexPath *indexPath = [NSIndexPath indexPathForRow:0 inSection:0];
+    
+    dataSource.itemSizeBlock = ^CGSize(Wizard *wizard, CGFloat width) {
+        sizedOnMainThread = [NSThread isMainThread];
+        return CGSizeMake(width, [wizard.name length]);
+    };
+    dataSource.itemPrepareBlock = ^id(Wizard *wizard) {
+        preparedOnMainThread = [NSThread isMainThread];
+        return wizard.name;
+    };
+    
+    [dataSource precomputeSizesForItemsAtIndexPaths:@[ indexPath ]
+                                              width:320
+                                         completion:^{
+                                             didSize = YES;
+                                         }];
+    [dataSource prepareViewModelsForItemsAtIndexPaths:@[ indexPath ]
+                                           completion:^{
+                                               didPrepare = YES;
+                                           }];
+    
+    expect(didSize).will.beTruthy();
+    expect(didPrepare).will.beTruthy();
+    expect(sizedOnMainThread).to.beTruthy();
+    expect(preparedOnMainThread).to.beTruthy();
+    expect([dataSource sizeForItemAtIndexPath:indexPath width:320]).to.equal(CGSizeMake(320, 7));
+    expect([dataSource preparedViewModelForItemAtIndexPath:indexPath]).to.equal(@"Gandalf");
 }
 
 #pragma mark - NSFetchedResultsControllerDelegate
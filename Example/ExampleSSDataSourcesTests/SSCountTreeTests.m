@@ -0,0 +1,155 @@
+#import "SSTestHelper.h"
+#import <SSDataSources.h>
+
+@interface SSCountTreeTests : XCTestCase
+@end
+
+@implementation SSCountTreeTests
+{
+    SSCountTree *tree;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    
+    NSUInteger values[] = { 3, 0, 2, 5, 1 };
+    tree = [[SSCountTree alloc] initWithValues:values count:5];
+}
+
+- (NSArray *)valuesInTree:(SSCountTree *)countTree
+{
+    NSMutableArray *values = [NSMutableArray array];
+    
+    for (NSUInteger i = 0; i < countTree.count; i++) {
+        [values addObject:@([countTree valueAtIndex:i])];
+    }
+    
+    return values;
+}
+
+- (void)testEmptyTree
+{
+    SSCountTree *emptyTree = [SSCountTree new];
+    expect(emptyTree.count).to.equal(0);
+    expect(emptyTree.total).to.equal(0);
+    expect([emptyTree prefixSumBeforeIndex:0]).to.equal(0);
+    expect([emptyTree indexForPrefixSum:0 remainder:NULL]).to.equal(NSNotFound);
+}
+
+- (void)testValuesAndTotal
+{
+    expect(tree.count).to.equal(5);
+    expect(tree.total).to.equal(11);
+    expect([self valuesInTree:tree]).to.equal(@[ @3, @0, @2, @5, @1 ]);
+}
+
+- (void)testPrefixSums
+{
+    expect([tree prefixSumBeforeIndex:0]).to.equal(0);
+    expect([tree prefixSumBeforeIndex:1]).to.equal(3);
+    expect([tree prefixSumBeforeIndex:2]).to.equal(3);
+    expect([tree prefixSumBeforeIndex:4]).to.equal(10);
+    expect([tree prefixSumBeforeIndex:5]).to.equal(11);
+}
+
+- (void)testIndexForPrefixSum
+{
+    NSUInteger remainder = 0;
+    
+    expect([tree indexForPrefixSum:0 remainder:&remainder]).to.equal(0);
+    expect(remainder).to.equal(0);
+    
+    // Empty elements are skipped.
+    expect([tree indexForPrefixSum:3 remainder:&remainder]).to.equal(2);
+    expect(remainder).to.equal(0);
+    
+    expect([tree indexForPrefixSum:9 remainder:&remainder]).to.equal(3);
+    expect(remainder).to.equal(4);
+    
+    expect([tree indexForPrefixSum:11 remainder:&remainder]).to.equal(NSNotFound);
+}
+
+- (void)testSettingValues
+{
+    [tree setValue:1 atIndex:3];
+    expect(tree.total).to.equal(7);
+    expect([tree prefixSumBeforeIndex:5]).to.equal(7);
+    
+    [tree setValue:4 atIndex:1];
+    expect(tree.total).to.equal(11);
+    expect([tree prefixSumBeforeIndex:2]).to.equal(7);
+    expect([tree indexForPrefixSum:5 remainder:NULL]).to.equal(1);
+}
+
+- (void)testInsertingValues
+{
+    [tree insertValue:4 atIndex:0];
+    [tree insertValue:6 atIndex:3];
+    [tree insertValue:7 atIndex:tree.count];
+    
+    expect([self valuesInTree:tree]).to.equal(@[ @4, @3, @0, @6, @2, @5, @1, @7 ]);
+    expect(tree.total).to.equal(28);
+    expect([tree prefixSumBeforeIndex:4]).to.equal(13);
+    expect([tree indexForPrefixSum:13 remainder:NULL]).to.equal(4);
+}
+
+- (void)testRemovingValues
+{
+    [tree removeValueAtIndex:3];
+    [tree removeValueAtIndex:0];
+    
+    expect([self valuesInTree:tree]).to.equal(@[ @0, @2, @1 ]);
+    expect(tree.total).to.equal(3);
+    expect([tree indexForPrefixSum:0 remainder:NULL]).to.equal(1);
+    
+    // Removed nodes are reused.
+    [tree insertValue:9 atIndex:1];
+    expect([self valuesInTree:tree]).to.equal(@[ @0, @9, @2, @1 ]);
+    expect(tree.total).to.equal(12);
+}
+
+- (void)testMovingValues
+{
+    [tree moveValueAtIndex:0 toIndex:4];
+    expect([self valuesInTree:tree]).to.equal(@[ @0, @2, @5, @1, @3 ]);
+    
+    [tree moveValueAtIndex:3 toIndex:1];
+    expect([self valuesInTree:tree]).to.equal(@[ @0, @1, @2, @5, @3 ]);
+    expect(tree.total).to.equal(11);
+    expect([tree prefixSumBeforeIndex:3]).to.equal(3);
+}
+
+- (void)testManyChangesMatchAnArray
+{
+    SSCountTree *countTree = [SSCountTree new];
+    NSMutableArray *values = [NSMutableArray array];
+    
+    for (NSUInteger i = 0; i < 500; i++) {
+        NSUInteger value = i % 7;
+        NSUInteger index = (i * 31) % ([values count] + 1);
+    
+        [countTree insertValue:value atIndex:index];
+        [values insertObject:@(value) atIndex:index];
+    
+        if (i % 3 == 0) {
+            NSUInteger removed = (i * 17) % [values count];
+    
+            [countTree removeValueAtIndex:removed];
+            [values removeObjectAtIndex:removed];
+        }
+    }
+    
+    expect([self valuesInTree:countTree]).to.equal(values);
+    
+    NSUInteger sum = 0;
+    
+    for (NSUInteger i = 0; i < [values count]; i++) {
+        expect([countTree prefixSumBeforeIndex:i]).to.equal(sum);
+        sum += [values[i] unsignedIntegerValue];
+    }
+    
+    expect(countTree.total).to.equal(sum);
+}
+
+@end
@@ -0,0 +1,189 @@
+#import "SSTestHelper.h"
+#import <SSDataSources.h>
+
+@interface SSDataSourceChangesetTests : XCTestCase
+@end
+
+@implementation SSDataSourceChangesetTests
+{
+    SSSectionedDataSource *ds;
+    SSDataSourceChangeset *changeset; // system-under-test
+}
+
+- (void)setUp
+{
+    ds = [[SSSectionedDataSource alloc] initWithSections:@[
+        [SSSection sectionWithItems:@[ @"a", @"b", @"c" ]],
+        [SSSection sectionWithItems:@[ @"d", @"e" ]]
+    ]];
+    changeset = [[SSDataSourceChangeset alloc] initWithDataSource:ds];
+}
+
+- (NSIndexPath *)row:(NSInteger)row section:(NSInteger)section
+{
+    return [NSIndexPath indexPathForRow:row inSection:section];
+}
+
+- (void)testNoOperationsHaveNoChanges
+{
+    expect([[changeset diff] hasChanges]).to.beFalsy();
+    expect(changeset.requiresReloadData).to.beFalsy();
+}
+
+- (void)testInsertingThenDeletingHasNoChanges
+{
+    [changeset insertRowsAtIndexPaths:@[ [self row:1 section:0] ]];
+    [changeset deleteRowsAtIndexPaths:@[ [self row:1 section:0] ]];
+
+    expect([[changeset diff] hasChanges]).to.beFalsy();
+}
+
+- (void)testSuccessiveInsertsAreMerged
+{
+    [changeset insertRowsAtIndexPaths:@[ [self row:3 section:0] ]];
+    [changeset insertRowsAtIndexPaths:@[ [self row:4 section:0] ]];
+    [changeset insertRowsAtIndexPaths:@[ [self row:0 section:0] ]];
+
+    SSSectionedDiff *diff = [changeset diff];
+    expect(diff.insertedIndexPaths).to.equal((@[ [self row:0 section:0],
+                                                 [self row:4 section:0],
+                                                 [self row:5 section:0] ]));
+    expect(diff.changeCount).to.equal(3);
+}
+
+- (void)testDeletesUseOriginalIndexPaths
+{
+    [changeset deleteRowsAtIndexPaths:@[ [self row:0 section:0] ]];
+    [changeset deleteRowsAtIndexPaths:@[ [self row:0 section:0] ]];
+
+    SSSectionedDiff *diff = [changeset diff];
+    expect(diff.deletedIndexPaths).to.equal((@[ [self row:0 section:0], [self row:1 section:0] ]));
+    expect(diff.changeCount).to.equal(2);
+}
+
+- (void)testRepeatedMovesBecomeOneMove
+{
+    [changeset moveRowAtIndexPath:[self row:0 section:0] toIndexPath:[self row:1 section:0]];
+    [changeset moveRowAtIndexPath:[self row:1 section:0] toIndexPath:[self row:0 section:1]];
+
+    SSSectionedDiff *diff = [changeset diff];
+    expect(diff.moves).to.haveCountOf(1);
+    expect([diff.moves[0] fromIndexPath]).to.equal([self row:0 section:0]);
+    expect([diff.moves[0] toIndexPath]).to.equal([self row:0 section:1]);
+    expect(diff.changeCount).to.equal(1);
+}
+
+- (void)testBatchUpdatesUseBatchIndexPaths
+{
+    [changeset beginBatchUpdates];
+    [changeset deleteRowsAtIndexPaths:@[ [self row:0 section:0] ]];
+    [changeset insertRowsAtIndexPaths:@[ [self row:2 section:0] ]];
+    [changeset endBatchUpdates];
+
+    SSSectionedDiff *diff = [changeset diff];
+    expect(diff.deletedIndexPaths).to.equal(@[ [self row:0 section:0] ]);
+    expect(diff.insertedIndexPaths).to.equal(@[ [self row:2 section:0] ]);
+}
+
+- (void)testReloadedRowsAreReloaded
+{
+    [changeset insertRowsAtIndexPaths:@[ [self row:0 section:1] ]];
+    [changeset reloadRowsAtIndexPaths:@[ [self row:2 section:1] ]];
+
+    SSSectionedDiff *diff = [changeset diff];
+    expect(diff.insertedIndexPaths).to.equal(@[ [self row:0 section:1] ]);
+    expect(diff.reloadedIndexPaths).to.equal(@[ [self row:1 section:1] ]);
+}
+
+- (void)testDeletedSectionsSwallowRowChanges
+{
+    [changeset insertRowsAtIndexPaths:@[ [self row:0 section:1] ]];
+    [changeset deleteSections:[NSIndexSet indexSetWithIndex:1]];
+
+    SSSectionedDiff *diff = [changeset diff];
+    expect(diff.deletedSections).to.equal([NSIndexSet indexSetWithIndex:1]);
+    expect(diff.changeCount).to.equal(1);
+}
+
+- (void)testInsertedSectionsSwallowRowChanges
+{
+    [changeset insertSections:[NSIndexSet indexSetWithIndex:0]];
+    [changeset moveRowAtIndexPath:[self row:0 section:1] toIndexPath:[self row:0 section:0]];
+
+    SSSectionedDiff *diff = [changeset diff];
+    expect(diff.insertedSections).to.equal([NSIndexSet indexSetWithIndex:0]);
+    expect(diff.deletedIndexPaths).to.equal(@[ [self row:0 section:0] ]);
+    expect(diff.changeCount).to.equal(2);
+}
+
+- (void)testMovedSections
+{
+    [changeset moveSection:1 toSection:0];
+    [changeset deleteRowsAtIndexPaths:@[ [self row:0 section:0] ]];
+
+    SSSectionedDiff *diff = [changeset diff];
+    expect(diff.sectionMoves).to.haveCountOf(1);
+    expect(diff.deletedIndexPaths).to.equal(@[ [self row:0 section:1] ]);
+}
+
+- (void)testRangesOfRows
+{
+    [changeset insertRows:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(3, 10000)] inSection:0];
+    [changeset deleteRows:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)] inSection:0];
+    [changeset reloadRows:[NSIndexSet indexSetWithIndex:0] inSection:1];
+
+    expect(changeset.recordedChangeCount).to.equal(10003);
+    expect(changeset.changedSections).to.equal([NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)]);
+
+    SSSectionedDiff *diff = [changeset diff];
+    expect(diff.insertedIndexPaths).to.haveCountOf(10000);
+    expect([diff.insertedIndexPaths firstObject]).to.equal([self row:1 section:0]);
+    expect(diff.deletedIndexPaths).to.equal((@[ [self row:0 section:0], [self row:1 section:0] ]));
+    expect(diff.reloadedIndexPaths).to.equal(@[ [self row:0 section:1] ]);
+}
+
+- (void)testChangedSectionsAreUnknownAfterSectionChanges
+{
+    [changeset insertRowsAtIndexPaths:@[ [self row:0 section:1] ]];
+    expect(changeset.changedSections).to.equal([NSIndexSet indexSetWithIndex:1]);
+
+    [changeset insertSections:[NSIndexSet indexSetWithIndex:0]];
+    expect(changeset.changedSections).to.beNil();
+}
+
+- (void)testReloadDataRequiresReload
+{
+    [changeset insertRowsAtIndexPaths:@[ [self row:0 section:0] ]];
+    [changeset reloadData];
+
+    expect(changeset.requiresReloadData).to.beTruthy();
+}
+
+- (void)testFindsOriginalIndexPaths
+{
+    [changeset insertRowsAtIndexPaths:@[ [self row:0 section:0] ]];
+    [changeset moveRowAtIndexPath:[self row:3 section:0] toIndexPath:[self row:0 section:1]];
+
+    [changeset beginBatchUpdates];
+    [changeset deleteRowsAtIndexPaths:@[ [self row:1 section:0] ]];
+
+    // Still the contents before the batch
+    expect([changeset originalIndexPathForIndexPath:[self row:0 section:0]]).to.beNil();
+    expect([changeset originalIndexPathForIndexPath:[self row:1 section:0]]).to.equal([self row:0 section:0]);
+    expect([changeset originalIndexPathForIndexPath:[self row:0 section:1]]).to.equal([self row:2 section:0]);
+    expect([changeset originalIndexPathForIndexPath:[self row:2 section:1]]).to.equal([self row:1 section:1]);
+    expect([changeset originalIndexPathForIndexPath:[self row:3 section:1]]).to.beNil();
+
+    [changeset endBatchUpdates];
+
+    expect([changeset originalIndexPathForIndexPath:[self row:1 section:0]]).to.equal([self row:1 section:0]);
+}
+
+- (void)testInconsistentUpdateRequiresReload
+{
+    [changeset deleteRowsAtIndexPaths:@[ [self row:5 section:0] ]];
+
+    expect(changeset.requiresReloadData).to.beTruthy();
+}
+
+@end
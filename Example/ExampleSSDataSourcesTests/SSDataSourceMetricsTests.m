@@ -0,0 +1,126 @@
+#import "SSTestHelper.h"
+#import <SSDataSources.h>
+
+@interface SSDataSourceMetricsTests : XCTestCase
+@end
+
+@implementation SSDataSourceMetricsTests
+{
+    SSDataSourceMetrics *metrics; // system-under-test
+    SSArrayDataSource *ds;
+    UITableView *tableView;
+}
+
+- (void)setUp
+{
+    [super setUp];
+
+    metrics = [SSDataSourceMetrics new];
+    tableView = [OCMockObject niceMockForClass:UITableView.class];
+    ds = [[SSArrayDataSource alloc] initWithItems:@[ @1, @2, @3 ]];
+    ds.metrics = metrics;
+}
+
+- (void)tearDown
+{
+    [super tearDown];
+    ds = nil;
+    metrics = nil;
+}
+
+- (void)testRecordsHistograms
+{
+    [metrics recordValue:0 forMetric:@"test" cellClass:nil];
+    [metrics recordValue:1 forMetric:@"test" cellClass:nil];
+    [metrics recordValue:3 forMetric:@"test" cellClass:UITableViewCell.class];
+
+    NSDictionary *snapshot = [metrics snapshot];
+
+    expect(snapshot[@"histograms"][@"test"]).to.equal((@{ @"count"   : @3,
+                                                          @"sum"     : @4,
+                                                          @"min"     : @0,
+                                                          @"max"     : @3,
+                                                          @"buckets" : @[ @1, @1, @1 ] }));
+    expect(snapshot[@"cellClasses"][@"UITableViewCell"][@"test"][@"count"]).to.equal(1);
+}
+
+- (void)testResetting
+{
+    [metrics incrementCounter:@"test" by:2];
+    expect([metrics snapshot][@"counters"][@"test"]).to.equal(2);
+
+    [metrics reset];
+    expect([metrics snapshot][@"counters"]).to.beEmpty();
+    expect([metrics snapshot][@"histograms"]).to.beEmpty();
+}
+
+- (void)testCountsDequeueMisses
+{
+    UITableViewCell *cell = [UITableViewCell new];
+    ds.cellCreationBlock = ^id(id object, id parentView, NSIndexPath *indexPath) {
+        return cell;
+    };
+    ds.cellConfigureBlock = ^(id c, id object, id parentView, NSIndexPath *indexPath) {};
+
+    for (NSInteger row = 0; row < 3; row++) {
+        [ds tableView:tableView cellForRowAtIndexPath:[NSIndexPath indexPathForRow:row inSection:0]];
+    }
+
+    NSDictionary *snapshot = [metrics snapshot];
+
+    expect(snapshot[@"counters"][SSDataSourceMetricCellRequests]).to.equal(3);
+    expect(snapshot[@"counters"][SSDataSourceMetricCellDequeueMisses]).to.equal(1);
+    expect(snapshot[@"cellClasses"][@"UITableViewCell"][SSDataSourceMetricCellConfiguration][@"count"]).to.equal(3);
+}
+
+- (void)testRecordsBatchUpdateSizes
+{
+    ds.tableView = tableView;
+    ds.itemIdentifierBlock = ^id(id item) {
+        return item;
+    };
+
+    [ds updateItems:@[ @1, @4, @5, @6 ]];
+
+    NSDictionary *sizes = [metrics snapshot][@"histograms"][SSDataSourceMetricBatchUpdateSize];
+
+    expect(sizes[@"count"]).to.equal(1);
+    expect(sizes[@"sum"]).to.equal(5);
+}
+
+- (void)testRecordsStandaloneUpdatesSeparately
+{
+    ds.tableView = tableView;
+    ds.itemIdentifierBlock = ^id(id item) {
+        return item;
+    };
+
+    [ds appendItem:@4];
+    [ds removeItemAtIndex:0];
+
+    NSDictionary *sizes = [metrics snapshot][@"histograms"][SSDataSourceMetricBatchUpdateSize];
+
+    expect(sizes[@"count"]).to.equal(2);
+    expect(sizes[@"sum"]).to.equal(2);
+
+    [ds updateItems:@[ @2, @3, @4, @5 ]];
+
+    sizes = [metrics snapshot][@"histograms"][SSDataSourceMetricBatchUpdateSize];
+
+    expect(sizes[@"count"]).to.equal(3);
+    expect(sizes[@"sum"]).to.equal(3);
+}
+
+- (void)testRecordsNothingWithoutMetrics
+{
+    ds.metrics = nil;
+    ds.cellCreationBlock = ^id(id object, id parentView, NSIndexPath *indexPath) {
+        return [UITableViewCell new];
+    };
+
+    [ds tableView:tableView cellForRowAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]];
+
+    expect([metrics snapshot][@"counters"]).to.beEmpty();
+}
+
+@end
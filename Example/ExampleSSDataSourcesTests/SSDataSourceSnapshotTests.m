@@ -0,0 +1,176 @@
+#import "SSTestHelper.h"
+#import <SSDataSources.h>
+
+@interface SSDataSourceSnapshotTests : XCTestCase
+@end
+
+@implementation SSDataSourceSnapshotTests
+{
+    UITableView *tableView;
+}
+
+- (void)setUp
+{
+    [super setUp];
+
+    tableView = [OCMockObject niceMockForClass:UITableView.class];
+}
+
+- (void)tearDown
+{
+    [super tearDown];
+    tableView = nil;
+}
+
+- (void)testSnapshotOfArrayDataSource
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @1, @2, @3 ]];
+    SSDataSourceSnapshot *snapshot = [ds snapshot];
+
+    expect(snapshot.numberOfSections).to.equal(1);
+    expect(snapshot.numberOfItems).to.equal(3);
+    expect([snapshot itemAtIndexPath:[NSIndexPath indexPathForRow:2 inSection:0]]).to.equal(@3);
+    expect([snapshot itemAtIndexPath:[NSIndexPath indexPathForRow:3 inSection:0]]).to.beNil();
+    expect([snapshot allItems]).to.equal(@[ @1, @2, @3 ]);
+}
+
+- (void)testSnapshotsAreUnaffectedByLaterChanges
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @1, @2, @3 ]];
+    ds.tableView = tableView;
+
+    SSDataSourceSnapshot *first = [ds snapshot];
+
+    [ds insertItem:@0 atIndex:0];
+    [ds removeItemAtIndex:3];
+    [ds replaceItemAtIndex:1 withItem:@10];
+
+    SSDataSourceSnapshot *second = [ds snapshot];
+
+    [ds moveItemAtIndex:0 toIndex:2];
+    [ds appendItems:@[ @4, @5 ]];
+
+    expect([first allItems]).to.equal(@[ @1, @2, @3 ]);
+    expect([second allItems]).to.equal(@[ @0, @10, @2 ]);
+    expect([[ds snapshot] allItems]).to.equal(@[ @10, @2, @0, @4, @5 ]);
+}
+
+- (void)testSnapshotIsSharedUntilItemsChange
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @1, @2 ]];
+
+    expect([[ds snapshot] itemsInSection:0]).to.beIdenticalTo([[ds snapshot] itemsInSection:0]);
+
+    [ds appendItem:@3];
+
+    expect([[ds snapshot] allItems]).to.equal(@[ @1, @2, @3 ]);
+}
+
+- (void)testSnapshotFollowsBatchUpdatesAndReloads
+{
+    SSArrayDataSource *ds = [[SSArrayDataSource alloc] initWithItems:@[ @1, @2 ]];
+    ds.tableView = tableView;
+    [ds snapshot];
+
+    [ds performBatchUpdates:^{
+        [ds removeItemAtIndex:0];
+        [ds appendItem:@3];
+    }];
+
+    expect([[ds snapshot] allItems]).to.equal(@[ @2, @3 ]);
+
+    [ds updateItems:@[ @7 ]];
+
+    expect([[ds snapshot] allItems]).to.equal(@[ @7 ]);
+}
+
+- (void)testSnapshotIsPatchedAfterBatchUpdates
+{
+    SSSectionedDataSource *ds = [[SSSectionedDataSource alloc] initWithSections:@[
+        [SSSection sectionWithItems:@[ @1, @2 ]],
+        [SSSection sectionWithItems:@[ @3 ]],
+        [SSSection sectionWithItems:@[ @4, @5 ]],
+        [SSSection sectionWithItems:@[ @7 ]],
+    ]];
+    ds.tableView = tableView;
+
+    SSDataSourceSnapshot *first = [ds snapshot];
+
+    [ds performBatchUpdates:^{
+        [ds removeItemAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]];
+        [ds removeSectionAtIndex:1];
+        [ds insertItem:@6 atIndexPath:[NSIndexPath indexPathForRow:0 inSection:1]];
+    }];
+
+    SSDataSourceSnapshot *second = [ds snapshot];
+
+    expect(second.numberOfSections).to.equal(3);
+    expect([second itemsInSection:0]).to.equal(@[ @2 ]);
+    expect([second itemsInSection:1]).to.equal(@[ @6, @4, @5 ]);
+    expect([second itemsInSection:2]).to.beIdenticalTo([first itemsInSection:3]);
+}
+
+- (void)testSnapshotIsPatchedAfterTransactions
+{
+    SSSectionedDataSource *ds = [[SSSectionedDataSource alloc] initWithSections:@[
+        [SSSection sectionWithItems:@[ @1, @2 ]],
+        [SSSection sectionWithItems:@[ @3 ]],
+    ]];
+    ds.tableView = tableView;
+
+    SSDataSourceSnapshot *first = [ds snapshot];
+
+    [ds performUpdates:^{
+        [ds appendSection:[SSSection sectionWithItems:@[ @4 ]]];
+        [ds replaceItemAtIndexPath:[NSIndexPath indexPathForRow:1 inSection:0] withItem:@5];
+        [ds insertItem:@0 atIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]];
+    } completion:nil];
+
+    SSDataSourceSnapshot *second = [ds snapshot];
+
+    expect(second.numberOfSections).to.equal(3);
+    expect([second itemsInSection:0]).to.equal(@[ @0, @1, @5 ]);
+    expect([second itemsInSection:1]).to.beIdenticalTo([first itemsInSection:1]);
+    expect([second itemsInSection:2]).to.equal(@[ @4 ]);
+}
+
+- (void)testSnapshotOfSectionedDataSource
+{
+    SSSectionedDataSource *ds = [[SSSectionedDataSource alloc] initWithItems:@[ @1, @2 ]];
+    ds.tableView = tableView;
+
+    SSDataSourceSnapshot *first = [ds snapshot];
+
+    [ds appendSection:[SSSection sectionWithItems:@[ @3 ]]];
+    [ds insertItem:@0 atIndexPath:[NSIndexPath indexPathForRow:0 inSection:1]];
+    [ds moveSectionAtIndex:1 toIndex:0];
+
+    SSDataSourceSnapshot *second = [ds snapshot];
+
+    [ds removeSectionAtIndex:0];
+
+    expect(first.numberOfSections).to.equal(1);
+    expect([first allItems]).to.equal(@[ @1, @2 ]);
+    expect(second.numberOfSections).to.equal(2);
+    expect([second itemsInSection:0]).to.equal(@[ @0, @3 ]);
+    expect([second itemsInSection:1]).to.equal(@[ @1, @2 ]);
+    expect([[ds snapshot] allItems]).to.equal(@[ @1, @2 ]);
+}
+
+- (void)testSnapshotOfExpandingDataSourceHasOnlyVisibleItems
+{
+    SSExpandingDataSource *ds = [[SSExpandingDataSource alloc] initWithSections:@[
+        [SSSection sectionWithItems:@[ @1, @2, @3 ]],
+        [SSSection sectionWithNumberOfItems:3],
+    ]];
+    ds.collapsedSectionCountBlock = ^NSInteger(SSSection *section, NSInteger sectionIndex) {
+        return 1;
+    };
+
+    SSDataSourceSnapshot *snapshot = [ds snapshot];
+
+    expect([snapshot itemsInSection:0]).to.equal(@[ @1 ]);
+    expect([snapshot itemsInSection:1]).to.equal(@[ @0 ]);
+}
+
+@end
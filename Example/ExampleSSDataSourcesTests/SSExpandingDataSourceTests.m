@@ -50,9 +50,7 @@
     id mockTable = tableView;
     ds.tableView = mockTable;
     
-    [[mockTable expect] insertRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:3 inSection:0] ]
-                              withRowAnimation:ds.rowAnimation];
-    [[mockTable expect] insertRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:4 inSection:0] ]
+    [[mockTable expect] insertRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:3 inSection:0], [NSIndexPath indexPathForRow:4 inSection:0] ]
                               withRowAnimation:ds.rowAnimation];
     
     [ds appendItems:@[ @4, @5 ] toSection:0];
@@ -96,6 +94,23 @@
     [mockTable verify];
 }
 
+- (void)testNumberOfItemsTracksCollapsedSections {
+    ds = [[SSExpandingDataSource alloc] initWithItems:@[ @1, @2, @3 ]];
+    [ds appendSection:[SSSection sectionWithItems:@[ @4, @5 ]]];
+    
+    expect([ds numberOfItems]).to.equal(5);
+    
+    [ds setSectionAtIndex:0 expanded:NO];
+    expect([ds numberOfItems]).to.equal(2);
+    expect([ds indexPathForGlobalIndex:0]).to.equal([NSIndexPath indexPathForRow:0 inSection:1]);
+    
+    ds.collapsedSectionCountBlock = ^NSInteger(SSSection *sec, NSInteger sectionIndex) {
+        return 1;
+    };
+    expect([ds numberOfItems]).to.equal(3);
+    expect([ds globalIndexForIndexPath:[NSIndexPath indexPathForRow:1 inSection:1]]).to.equal(2);
+}
+
 - (void)testInsertingRowsInCollapsedSection {
     ds = [[SSExpandingDataSource alloc] initWithItems:@[ @1 ]];
     ds.collapsedSectionCountBlock = ^NSInteger(SSSection *sec, NSInteger sectionIndex) {
@@ -113,9 +128,7 @@
     expect(section.numberOfItems).to.equal(1);
     
     // We allow additional insertions up to our collapsed row count
-    [[mockTable expect] insertRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:1 inSection:0] ]
-                              withRowAnimation:ds.rowAnimation];
-    [[mockTable expect] insertRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:2 inSection:0] ]
+    [[mockTable expect] insertRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:1 inSection:0], [NSIndexPath indexPathForRow:2 inSection:0] ]
                               withRowAnimation:ds.rowAnimation];
     
     [ds appendItems:@[ @2, @3 ] toSection:0];
@@ -0,0 +1,201 @@
+#import "SSTestHelper.h"
+#import <SSDataSources.h>
+
+@interface SSFilteredDataSourceTests : XCTestCase
+@end
+
+@implementation SSFilteredDataSourceTests
+{
+    SSArrayDataSource *source;
+    SSFilteredDataSource *ds;
+    OCMockObject *mockTable;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    
+    mockTable = [OCMockObject niceMockForClass:[UITableView class]];
+    source = [[SSArrayDataSource alloc] initWithItems:@[ @1, @2, @3, @4, @5, @6 ]];
+    ds = [[SSFilteredDataSource alloc] initWithDataSource:source];
+    ds.tableView = (UITableView *)mockTable;
+    ds.filterBlock = ^BOOL(NSNumber *number) {
+        return [number integerValue] % 2 == 0;
+    };
+}
+
+- (void)tearDown
+{
+    [super tearDown];
+    ds = nil;
+    source = nil;
+}
+
+- (NSArray *)filteredItems
+{
+    return [[ds snapshot] allItems];
+}
+
+- (void)testShowsEveryItemWithoutFilter
+{
+    SSFilteredDataSource *unfiltered = [[SSFilteredDataSource alloc] initWithDataSource:source];
+    expect([unfiltered numberOfItems]).to.equal(6);
+    expect([unfiltered itemAtIndexPath:[NSIndexPath indexPathForRow:5 inSection:0]]).to.equal(@6);
+}
+
+- (void)testFiltersItems
+{
+    expect([self filteredItems]).to.equal(@[ @2, @4, @6 ]);
+    expect([ds sourceIndexPathForIndexPath:[NSIndexPath indexPathForRow:1 inSection:0]])
+        .to.equal([NSIndexPath indexPathForRow:3 inSection:0]);
+    expect([ds indexPathForSourceIndexPath:[NSIndexPath indexPathForRow:5 inSection:0]])
+        .to.equal([NSIndexPath indexPathForRow:2 inSection:0]);
+    expect([ds indexPathForSourceIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]]).to.beNil();
+}
+
+- (void)testChangingFilterAnimatesDifferences
+{
+    [[mockTable expect] deleteRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:0 inSection:0] ]
+                              withRowAnimation:ds.rowAnimation];
+    [[mockTable expect] insertRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:1 inSection:0] ]
+                              withRowAnimation:ds.rowAnimation];
+    
+    ds.filterBlock = ^BOOL(NSNumber *number) {
+        return [number integerValue] > 3;
+    };
+    
+    [mockTable verify];
+    expect([self filteredItems]).to.equal(@[ @4, @5, @6 ]);
+}
+
+- (void)testRefiningTestsOnlyMatchingItems
+{
+    NSMutableArray *testedItems = [NSMutableArray array];
+    
+    [ds refineFilterBlock:^BOOL(NSNumber *number) {
+        [testedItems addObject:number];
+        return [number integerValue] > 2;
+    }];
+    
+    expect(testedItems).to.equal(@[ @2, @4, @6 ]);
+    expect([self filteredItems]).to.equal(@[ @4, @6 ]);
+}
+
+- (void)testTranslatesSourceInsertsAndDeletes
+{
+    [[mockTable expect] insertRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:1 inSection:0] ]
+                              withRowAnimation:ds.rowAnimation];
+    [[mockTable reject] insertRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:0 inSection:0] ]
+                              withRowAnimation:ds.rowAnimation];
+    
+    [source insertItem:@7 atIndex:0];
+    [source insertItem:@8 atIndex:3];
+    
+    [mockTable verify];
+    expect([self filteredItems]).to.equal(@[ @2, @8, @4, @6 ]);
+    
+    [[mockTable expect] deleteRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:0 inSection:0] ]
+                              withRowAnimation:ds.rowAnimation];
+    
+    [source removeItemAtIndex:2];
+    [source removeItemAtIndex:0];
+    
+    [mockTable verify];
+    expect([self filteredItems]).to.equal(@[ @8, @4, @6 ]);
+}
+
+- (void)testTranslatesSourceReloads
+{
+    [source replaceItemAtIndex:0 withItem:@10];
+    [source replaceItemAtIndex:1 withItem:@11];
+    [source replaceItemAtIndex:3 withItem:@12];
+    
+    expect([self filteredItems]).to.equal(@[ @10, @12, @6 ]);
+}
+
+- (void)testTranslatesSourceMoves
+{
+    [[mockTable expect] moveRowAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]
+                               toIndexPath:[NSIndexPath indexPathForRow:2 inSection:0]];
+    
+    [source moveItemAtIndex:1 toIndex:5];
+    
+    [mockTable verify];
+    expect([self filteredItems]).to.equal(@[ @4, @6, @2 ]);
+}
+
+- (void)testFollowsSourceBatchUpdates
+{
+    [source updateItems:@[ @8, @9, @10 ]];
+    
+    expect([self filteredItems]).to.equal(@[ @8, @10 ]);
+}
+
+- (void)testTranslatesSourceBatchUpdatesWithoutReloading
+{
+    // @2 is removed and @6 is replaced by an item that no longer matches.
+    [[mockTable expect] deleteRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:0 inSection:0],
+                                                  [NSIndexPath indexPathForRow:2 inSection:0] ]
+                              withRowAnimation:ds.rowAnimation];
+    [[mockTable expect] insertRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:0 inSection:0] ]
+                              withRowAnimation:ds.rowAnimation];
+    [[mockTable reject] reloadData];
+    
+    [source performBatchUpdates:^{
+        [source removeItemAtIndex:1];
+        [source insertItem:@8 atIndex:0];
+        [source replaceItemAtIndex:5 withItem:@7];
+    }];
+    
+    [mockTable verify];
+    expect([self filteredItems]).to.equal(@[ @8, @4 ]);
+}
+
+- (void)testFiltersSectionedDataSource
+{
+    SSSectionedDataSource *sectioned = [[SSSectionedDataSource alloc] initWithSections:@[ @[ @1, @2 ], @[ @3 ] ]];
+    SSFilteredDataSource *filtered = [[SSFilteredDataSource alloc] initWithDataSource:sectioned];
+    filtered.filterBlock = ds.filterBlock;
+    
+    expect([filtered numberOfSections]).to.equal(2);
+    expect([filtered numberOfItemsInSection:1]).to.equal(0);
+    
+    [sectioned appendSection:[SSSection sectionWithItems:@[ @4, @5 ]]];
+    [sectioned moveSectionAtIndex:2 toIndex:0];
+    
+    expect([filtered numberOfSections]).to.equal(3);
+    expect([filtered itemAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]]).to.equal(@4);
+    expect([filtered itemAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:1]]).to.equal(@2);
+}
+
+- (void)testFiltersInBackground
+{
+    __block BOOL finished = NO;
+    
+    [ds setFilterBlock:^BOOL(NSNumber *number) {
+        return [number integerValue] == 4;
+    } refining:YES completion:^(BOOL done) {
+        finished = done;
+    }];
+    
+    expect(finished).will.beTruthy();
+    expect([self filteredItems]).to.equal(@[ @4 ]);
+}
+
+- (void)testBackgroundFilterFallsBackWhenSourceChanges
+{
+    __block BOOL finished = NO;
+    
+    [ds setFilterBlock:^BOOL(NSNumber *number) {
+        return [number integerValue] > 4;
+    } refining:NO completion:^(BOOL done) {
+        finished = done;
+    }];
+    
+    [source appendItem:@7];
+    
+    expect(finished).will.beTruthy();
+    expect([self filteredItems]).to.equal(@[ @5, @6, @7 ]);
+}
+
+@end
@@ -0,0 +1,172 @@
+#import "SSTestHelper.h"
+#import <SSDataSources.h>
+
+@interface SSGroupedDataSourceTests : XCTestCase
+@end
+
+@implementation SSGroupedDataSourceTests
+{
+    SSGroupedDataSource *ds;
+    OCMockObject *mockTable;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    
+    mockTable = [OCMockObject niceMockForClass:[UITableView class]];
+    ds = [[SSGroupedDataSource alloc] initWithItems:@[ @"bat", @"ant", @"bee", @"cat" ]
+                                         groupBlock:^id(NSString *word) {
+                                             return [word substringToIndex:1];
+                                         }];
+    ds.tableView = (UITableView *)mockTable;
+}
+
+- (void)tearDown
+{
+    [super tearDown];
+    ds = nil;
+}
+
+- (NSArray *)groupedItems
+{
+    return [[[ds snapshot] allItems] copy];
+}
+
+- (void)testGroupsItemsInOrderOfAppearance
+{
+    expect([ds numberOfSections]).to.equal(3);
+    expect([ds sectionAtIndex:0].sectionIdentifier).to.equal(@"b");
+    expect([ds sectionAtIndex:0].items).to.equal(@[ @"bat", @"bee" ]);
+    expect([ds titleForHeaderInSection:1]).to.equal(@"a");
+}
+
+- (void)testGroupsByKeyPath
+{
+    SSGroupedDataSource *grouped = [[SSGroupedDataSource alloc] initWithItems:@[ @"one", @"three", @"two" ]
+                                                                 groupKeyPath:@"length"];
+    
+    expect([grouped numberOfSections]).to.equal(2);
+    expect([grouped sectionWithIdentifier:@3].items).to.equal(@[ @"one", @"two" ]);
+}
+
+- (void)testGroupsLargeArraysInParallel
+{
+    NSMutableArray *numbers = [NSMutableArray array];
+    
+    for (NSUInteger i = 0; i < 5000; i++) {
+        [numbers addObject:@(i)];
+    }
+    
+    SSGroupedDataSource *grouped = [[SSGroupedDataSource alloc] initWithItems:numbers groupBlock:^id(NSNumber *number) {
+        return @([number unsignedIntegerValue] % 3);
+    }];
+    
+    expect([grouped numberOfSections]).to.equal(3);
+    expect([grouped numberOfItemsInSection:0]).to.equal(1667);
+    expect([grouped itemAtIndexPath:[NSIndexPath indexPathForRow:2 inSection:1]]).to.equal(@7);
+}
+
+- (void)testSortsSectionsWithComparator
+{
+    [[mockTable reject] reloadData];
+    
+    ds.groupComparator = ^NSComparisonResult(NSString *group1, NSString *group2) {
+        return [group1 compare:group2];
+    };
+    
+    [mockTable verify];
+    expect([ds sectionAtIndex:0].sectionIdentifier).to.equal(@"a");
+    expect([ds sectionAtIndex:2].sectionIdentifier).to.equal(@"c");
+    expect([ds insertItem:@"bug"]).to.equal([NSIndexPath indexPathForRow:2 inSection:1]);
+    expect([ds insertItem:@"ape"]).to.equal([NSIndexPath indexPathForRow:1 inSection:0]);
+}
+
+- (void)testInsertsItemsIntoGroups
+{
+    [[mockTable expect] insertRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:1 inSection:1] ]
+                              withRowAnimation:ds.rowAnimation];
+    
+    expect([ds insertItem:@"ape"]).to.equal([NSIndexPath indexPathForRow:1 inSection:1]);
+    
+    [mockTable verify];
+    
+    [[mockTable expect] insertSections:[NSIndexSet indexSetWithIndex:3]
+                      withRowAnimation:ds.rowAnimation];
+    
+    expect([ds insertItem:@"dog"]).to.equal([NSIndexPath indexPathForRow:0 inSection:3]);
+    
+    [mockTable verify];
+}
+
+- (void)testRegroupMovesItemBetweenSections
+{
+    NSMutableString *word = [NSMutableString stringWithString:@"bug"];
+    [ds insertItem:word];
+    
+    [[mockTable expect] moveRowAtIndexPath:[NSIndexPath indexPathForRow:2 inSection:0]
+                               toIndexPath:[NSIndexPath indexPathForRow:1 inSection:2]];
+    [[mockTable reject] reloadData];
+    
+    [word setString:@"cub"];
+    
+    expect([ds regroupItemAtIndexPath:[NSIndexPath indexPathForRow:2 inSection:0]])
+        .to.equal([NSIndexPath indexPathForRow:1 inSection:2]);
+    
+    [mockTable verify];
+    expect([ds sectionAtIndex:2].items).to.equal(@[ @"cat", @"cub" ]);
+}
+
+- (void)testRegroupRemovesEmptySections
+{
+    NSMutableString *word = [NSMutableString stringWithString:@"cat"];
+    SSGroupedDataSource *grouped = [[SSGroupedDataSource alloc] initWithItems:@[ @"ant", word ]
+                                                                   groupBlock:^id(NSString *string) {
+                                                                       return [string substringToIndex:1];
+                                                                   }];
+    
+    grouped.tableView = (UITableView *)mockTable;
+    
+    [[mockTable expect] insertSections:[NSIndexSet indexSetWithIndex:2]
+                      withRowAnimation:grouped.rowAnimation];
+    [[mockTable expect] moveRowAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:1]
+                               toIndexPath:[NSIndexPath indexPathForRow:0 inSection:2]];
+    [[mockTable expect] deleteSections:[NSIndexSet indexSetWithIndex:1]
+                      withRowAnimation:grouped.rowAnimation];
+    [[mockTable reject] reloadData];
+    
+    [word setString:@"dog"];
+    
+    expect([grouped regroupItemAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:1]])
+        .to.equal([NSIndexPath indexPathForRow:0 inSection:1]);
+    
+    [mockTable verify];
+    expect([grouped numberOfSections]).to.equal(2);
+    expect([grouped sectionAtIndex:1].sectionIdentifier).to.equal(@"d");
+}
+
+- (void)testUpdatesItemsWithMinimalChanges
+{
+    [[mockTable expect] deleteSections:[NSIndexSet indexSetWithIndex:2]
+                      withRowAnimation:ds.rowAnimation];
+    [[mockTable reject] reloadData];
+    
+    [ds updateItems:@[ @"bat", @"ant", @"bee", @"bug" ]];
+    
+    [mockTable verify];
+    expect([self groupedItems]).to.equal(@[ @"bat", @"bee", @"bug", @"ant" ]);
+}
+
+- (void)testUpdatesItemsInBackground
+{
+    __block BOOL finished = NO;
+    
+    [ds updateItems:@[ @"cow", @"ant" ] completion:^(BOOL didFinish) {
+        finished = didFinish;
+    }];
+    
+    expect(finished).will.beTruthy();
+    expect([self groupedItems]).to.equal(@[ @"cow", @"ant" ]);
+}
+
+@end
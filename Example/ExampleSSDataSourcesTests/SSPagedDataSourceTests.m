@@ -0,0 +1,181 @@
+#import "SSTestHelper.h"
+#import <SSDataSources.h>
+
+@interface SSPagedDataSourceTests : XCTestCase
+@end
+
+@implementation SSPagedDataSourceTests
+{
+    SSPagedDataSource *ds; // system-under-test
+    NSMutableArray *requestedRanges;
+    NSMutableArray *completions;
+    UITableView *tableView;
+}
+
+- (void)setUp
+{
+    [super setUp];
+
+    requestedRanges = [NSMutableArray array];
+    completions = [NSMutableArray array];
+    tableView = [OCMockObject niceMockForClass:UITableView.class];
+
+    NSMutableArray *ranges = requestedRanges;
+    NSMutableArray *pendingCompletions = completions;
+
+    ds = [[SSPagedDataSource alloc] initWithNumberOfItems:1000
+                                                 pageSize:10
+                                            pageLoadBlock:^(NSRange range, void (^completion)(NSArray *items)) {
+                                                [ranges addObject:[NSValue valueWithRange:range]];
+                                                [pendingCompletions addObject:[completion copy]];
+                                            }];
+    ds.cellCreationBlock = ^id(id object, id parentView, NSIndexPath *indexPath) {
+        return [UITableViewCell new];
+    };
+}
+
+- (void)tearDown
+{
+    [super tearDown];
+    ds = nil;
+}
+
+- (NSArray *)itemsInRange:(NSRange)range
+{
+    NSMutableArray *items = [NSMutableArray array];
+
+    for (NSUInteger i = range.location; i < NSMaxRange(range); i++) {
+        [items addObject:@(i)];
+    }
+
+    return items;
+}
+
+- (void)completeRequestAtIndex:(NSUInteger)index
+{
+    void (^completion)(NSArray *) = completions[index];
+    completion([self itemsInRange:[requestedRanges[index] rangeValue]]);
+}
+
+- (void)testShowsPlaceholdersUntilLoaded
+{
+    NSIndexPath *indexPath = [NSIndexPath indexPathForRow:5 inSection:0];
+
+    expect(ds.numberOfItems).to.equal(1000);
+    expect([ds itemAtIndexPath:indexPath]).to.equal([NSNull null]);
+    expect([ds isItemLoadedAtIndex:5]).to.beFalsy();
+
+    [ds loadPagesNearIndex:5];
+    [self completeRequestAtIndex:0];
+
+    expect([ds itemAtIndexPath:indexPath]).to.equal(@5);
+    expect([ds isItemLoadedAtIndex:5]).to.beTruthy();
+    expect(ds.numberOfItems).to.equal(1000);
+}
+
+- (void)testLoadsNeighboringPagesOnce
+{
+    [ds loadPagesNearIndex:55];
+    [ds loadPagesNearIndex:56];
+
+    expect(requestedRanges).to.equal((@[ [NSValue valueWithRange:NSMakeRange(50, 10)],
+                                         [NSValue valueWithRange:NSMakeRange(60, 10)],
+                                         [NSValue valueWithRange:NSMakeRange(40, 10)] ]));
+}
+
+- (void)testDisplayingCellsLoadsPages
+{
+    [ds tableView:tableView cellForRowAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]];
+
+    expect(requestedRanges).to.equal((@[ [NSValue valueWithRange:NSMakeRange(0, 10)],
+                                         [NSValue valueWithRange:NSMakeRange(10, 10)] ]));
+}
+
+- (void)testLoadedPagesReloadRows
+{
+    id mockTable = tableView;
+    ds.tableView = mockTable;
+
+    [[mockTable expect] reloadRowsAtIndexPaths:[SSPagedDataSource indexPathArrayWithRange:NSMakeRange(0, 10)
+                                                                                inSection:0]
+                              withRowAnimation:ds.rowAnimation];
+    [[mockTable reject] insertRowsAtIndexPaths:OCMOCK_ANY withRowAnimation:ds.rowAnimation];
+
+    [ds loadPagesNearIndex:0];
+    [self completeRequestAtIndex:0];
+
+    [mockTable verify];
+}
+
+- (void)testEvictsFarawayPages
+{
+    ds.preloadPageCount = 0;
+    ds.maximumNumberOfResidentPages = 2;
+
+    for (NSUInteger i = 0; i < 3; i++) {
+        [ds loadPagesNearIndex:i * 100];
+        [self completeRequestAtIndex:i];
+    }
+
+    NSMutableIndexSet *residentPages = [NSMutableIndexSet indexSetWithIndex:10];
+    [residentPages addIndex:20];
+
+    expect(ds.residentPageIndexes).to.equal(residentPages);
+    expect([ds itemAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]]).to.equal([NSNull null]);
+}
+
+- (void)testKeepsVisiblePages
+{
+    id mockTable = tableView;
+    ds.tableView = mockTable;
+    ds.preloadPageCount = 0;
+    ds.maximumNumberOfResidentPages = 2;
+
+    [[[mockTable stub] andReturn:@[ [NSIndexPath indexPathForRow:5 inSection:0] ]] indexPathsForVisibleRows];
+
+    for (NSUInteger i = 0; i < 3; i++) {
+        [ds loadPagesNearIndex:i * 100];
+        [self completeRequestAtIndex:i];
+    }
+
+    NSMutableIndexSet *residentPages = [NSMutableIndexSet indexSetWithIndex:0];
+    [residentPages addIndex:20];
+
+    expect(ds.residentPageIndexes).to.equal(residentPages);
+    expect([ds itemAtIndexPath:[NSIndexPath indexPathForRow:5 inSection:0]]).to.equal(@5);
+}
+
+- (void)testRequestsShortPagesAgain
+{
+    ds.preloadPageCount = 0;
+
+    [ds loadPagesNearIndex:0];
+
+    void (^completion)(NSArray *) = completions[0];
+    completion([self itemsInRange:NSMakeRange(0, 4)]);
+
+    expect([ds isItemLoadedAtIndex:3]).to.beTruthy();
+    expect([ds isItemLoadedAtIndex:4]).to.beFalsy();
+
+    [ds loadPagesNearIndex:0];
+
+    expect(requestedRanges).to.haveCountOf(2);
+
+    [self completeRequestAtIndex:1];
+    [ds loadPagesNearIndex:0];
+
+    expect([ds isItemLoadedAtIndex:9]).to.beTruthy();
+    expect(requestedRanges).to.haveCountOf(2);
+}
+
+- (void)testResettingDropsPages
+{
+    [ds loadPagesNearIndex:0];
+    [ds resetWithNumberOfItems:5];
+    [self completeRequestAtIndex:0];
+
+    expect(ds.numberOfItems).to.equal(5);
+    expect([ds isItemLoadedAtIndex:0]).to.beFalsy();
+}
+
+@end
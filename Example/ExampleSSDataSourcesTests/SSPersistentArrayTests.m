@@ -0,0 +1,106 @@
+#import "SSTestHelper.h"
+#import <SSDataSources.h>
+
+@interface SSPersistentArrayTests : XCTestCase
+@end
+
+@implementation SSPersistentArrayTests
+
+- (NSArray *)numbersUpTo:(NSUInteger)count
+{
+    NSMutableArray *numbers = [NSMutableArray arrayWithCapacity:count];
+
+    for (NSUInteger i = 0; i < count; i++) {
+        [numbers addObject:@(i)];
+    }
+
+    return numbers;
+}
+
+- (void)testEmptyArray
+{
+    SSPersistentArray *array = [SSPersistentArray new];
+    expect(array.count).to.equal(0);
+    expect([array firstObject]).to.beNil();
+
+    SSPersistentArray *inserted = [array arrayByInsertingObject:@1 atIndex:0];
+    expect(inserted).to.equal(@[ @1 ]);
+    expect(array.count).to.equal(0);
+}
+
+- (void)testBuildsFromLargeArrays
+{
+    NSArray *numbers = [self numbersUpTo:5000];
+    SSPersistentArray *array = [[SSPersistentArray alloc] initWithArray:numbers];
+
+    expect(array.count).to.equal(5000);
+    expect(array[0]).to.equal(@0);
+    expect(array[4999]).to.equal(@4999);
+    expect(array).to.equal(numbers);
+    expect([array subarrayWithRange:NSMakeRange(1000, 100)]).to.equal([numbers subarrayWithRange:NSMakeRange(1000, 100)]);
+}
+
+- (void)testPersistentOperationsLeaveReceiverUnchanged
+{
+    NSArray *numbers = [self numbersUpTo:1000];
+    SSPersistentArray *array = [[SSPersistentArray alloc] initWithArray:numbers];
+
+    SSPersistentArray *inserted = [array arrayByInsertingObject:@"new" atIndex:500];
+    SSPersistentArray *removed = [array arrayByRemovingObjectAtIndex:0];
+    SSPersistentArray *replaced = [array arrayByReplacingObjectAtIndex:999 withObject:@"last"];
+
+    expect(array).to.equal(numbers);
+    expect(inserted.count).to.equal(1001);
+    expect(inserted[500]).to.equal(@"new");
+    expect(inserted[501]).to.equal(@500);
+    expect(removed.count).to.equal(999);
+    expect(removed[0]).to.equal(@1);
+    expect(replaced[999]).to.equal(@"last");
+    expect(replaced[998]).to.equal(@998);
+}
+
+- (void)testMatchesMutableArray
+{
+    NSMutableArray *expected = [NSMutableArray array];
+    SSPersistentArray *array = [SSPersistentArray new];
+
+    for (NSUInteger i = 0; i < 2000; i++) {
+        NSUInteger index = (i * 7919) % ([expected count] + 1);
+        [expected insertObject:@(i) atIndex:index];
+        array = [array arrayByInsertingObject:@(i) atIndex:index];
+    }
+
+    expect(array).to.equal(expected);
+
+    for (NSUInteger i = 0; i < 1500; i++) {
+        NSUInteger index = (i * 104729) % [expected count];
+
+        if (i % 3 == 0) {
+            expected[index] = @(-i);
+            array = [array arrayByReplacingObjectAtIndex:index withObject:@(-i)];
+        } else {
+            [expected removeObjectAtIndex:index];
+            array = [array arrayByRemovingObjectAtIndex:index];
+        }
+    }
+
+    expect(array).to.equal(expected);
+}
+
+- (void)testCopyReturnsSelf
+{
+    SSPersistentArray *array = [[SSPersistentArray alloc] initWithArray:@[ @1, @2 ]];
+    expect([array copy]).to.beIdenticalTo(array);
+}
+
+- (void)testRaisesForIndexesOutOfBounds
+{
+    SSPersistentArray *array = [[SSPersistentArray alloc] initWithArray:@[ @1, @2 ]];
+
+    expect(^{ [array objectAtIndex:2]; }).to.raise(NSRangeException);
+    expect(^{ [array arrayByRemovingObjectAtIndex:2]; }).to.raise(NSRangeException);
+    expect(^{ [array arrayByInsertingObject:@3 atIndex:3]; }).to.raise(NSRangeException);
+    expect([array arrayByInsertingObject:@3 atIndex:2]).to.equal(@[ @1, @2, @3 ]);
+}
+
+@end
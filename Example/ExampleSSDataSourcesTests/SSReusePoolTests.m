@@ -0,0 +1,69 @@
+#import "SSTestHelper.h"
+#import <SSDataSources.h>
+
+@interface SSReusePoolTests : XCTestCase
+@end
+
+@implementation SSReusePoolTests
+{
+    UITableView *tableView;
+}
+
+- (void)setUp
+{
+    [super setUp];
+
+    tableView = [OCMockObject niceMockForClass:UITableView.class];
+}
+
+- (void)tearDown
+{
+    [super tearDown];
+    tableView = nil;
+}
+
+- (void)testWarmedUpCellsAreUsedOnDequeueMiss
+{
+    [SSBaseTableCell warmUpCells:2 forTableView:tableView whenIdle:NO];
+
+    SSReusePool *pool = [SSReusePool poolForView:tableView];
+    expect([pool numberOfViewsWithIdentifier:[SSBaseTableCell identifier]]).to.equal(2);
+
+    SSBaseTableCell *cell = [SSBaseTableCell cellForTableView:tableView];
+
+    expect(cell).toNot.beNil();
+    expect(cell.reuseIdentifier).to.equal([SSBaseTableCell identifier]);
+    expect([pool numberOfViewsWithIdentifier:[SSBaseTableCell identifier]]).to.equal(1);
+}
+
+- (void)testWarmingUpTopsUpThePool
+{
+    [SSBaseTableCell warmUpCells:2 forTableView:tableView whenIdle:NO];
+    [SSBaseTableCell cellForTableView:tableView];
+    [SSBaseTableCell warmUpCells:2 forTableView:tableView whenIdle:NO];
+
+    expect([[SSReusePool poolForView:tableView] numberOfViewsWithIdentifier:[SSBaseTableCell identifier]]).to.equal(2);
+}
+
+- (void)testWarmsUpWhenIdle
+{
+    [SSBaseTableCell warmUpCells:3 forTableView:tableView whenIdle:YES];
+
+    SSReusePool *pool = [SSReusePool poolForView:tableView];
+
+    expect([pool numberOfViewsWithIdentifier:[SSBaseTableCell identifier]]).to.equal(0);
+    expect([pool numberOfViewsWithIdentifier:[SSBaseTableCell identifier]]).will.equal(3);
+}
+
+- (void)testSectionedDataSourceUsesWarmedUpHeaders
+{
+    SSSectionedDataSource *ds = [[SSSectionedDataSource alloc] initWithItems:@[ @1 ]];
+    ds.tableView = tableView;
+
+    [SSBaseHeaderFooterView warmUpViews:1 forTableView:tableView whenIdle:NO];
+
+    expect([ds viewForHeaderInSection:0]).toNot.beNil();
+    expect([[SSReusePool poolForView:tableView] numberOfViewsWithIdentifier:[SSBaseHeaderFooterView identifier]]).to.equal(0);
+}
+
+@end
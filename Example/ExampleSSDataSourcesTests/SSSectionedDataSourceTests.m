@@ -162,6 +162,44 @@
     expect([ds sectionAtIndex:0].items).to.equal(@[ @1, @2, @3 ]);
 }
 
+- (void) test_virtual_sections_compute_items
+{
+    SSSection *section = [SSSection sectionWithNumberOfItems:100000 itemProvider:^id(NSUInteger index) {
+        return [NSString stringWithFormat:@"Day %lu", (unsigned long)index];
+    }];
+    
+    expect([section isVirtual]).to.beTruthy();
+    expect([section numberOfItems]).to.equal(100000);
+    expect([section itemAtIndex:41]).to.equal(@"Day 41");
+    expect([[SSSection sectionWithNumberOfItems:3].items copy]).to.equal((@[ @0, @1, @2 ]));
+    
+    SSSection *copy = [section copy];
+    expect([copy isVirtual]).to.beTruthy();
+    expect([copy itemAtIndex:7]).to.equal(@"Day 7");
+}
+
+- (void) test_adjusting_virtual_section_stays_virtual
+{
+    ds = [[SSSectionedDataSource alloc] initWithSection:[SSSection sectionWithNumberOfItems:100000]];
+    
+    [ds adjustSectionAtIndex:0 toNumberOfItems:500000];
+    [ds adjustSectionAtIndex:0 toNumberOfItems:10];
+    
+    expect([[ds sectionAtIndex:0] isVirtual]).to.beTruthy();
+    expect([ds numberOfItemsInSection:0]).to.equal(10);
+    expect([ds itemAtIndexPath:[NSIndexPath indexPathForRow:9 inSection:0]]).to.equal(@9);
+}
+
+- (void) test_changing_virtual_section_items_stores_them
+{
+    ds = [[SSSectionedDataSource alloc] initWithSection:[SSSection sectionWithNumberOfItems:3]];
+    
+    [ds insertItem:@"foo" atIndexPath:[NSIndexPath indexPathForRow:1 inSection:0]];
+    
+    expect([[ds sectionAtIndex:0] isVirtual]).to.beFalsy();
+    expect([ds sectionAtIndex:0].items).to.equal((@[ @0, @"foo", @1, @2 ]));
+}
+
 - (void) test_adjusting_section_reloads_section
 {
     ds = [[SSSectionedDataSource alloc] initWithSection:[SSSection sectionWithNumberOfItems:6]];
@@ -230,6 +268,64 @@
     expect([ds tableView:ds.tableView titleForFooterInSection:0]).to.equal(@"F");
 }
 
+- (void)testSectionIdentifiersFollowSectionChanges
+{
+    for (NSUInteger i = 0; i < 4; i++) {
+        [ds appendSection:[SSSection sectionWithNumberOfItems:1 header:nil footer:nil identifier:@(i)]];
+    }
+    
+    expect([ds indexOfSectionWithIdentifier:@3]).to.equal(3);
+    
+    [ds insertSection:[SSSection sectionWithNumberOfItems:1 header:nil footer:nil identifier:@"new"] atIndex:0];
+    expect([ds indexOfSectionWithIdentifier:@"new"]).to.equal(0);
+    expect([ds indexOfSectionWithIdentifier:@0]).to.equal(1);
+    expect([ds indexOfSectionWithIdentifier:@3]).to.equal(4);
+    
+    [ds moveSectionAtIndex:4 toIndex:1];
+    expect([ds indexOfSectionWithIdentifier:@3]).to.equal(1);
+    expect([ds indexOfSectionWithIdentifier:@0]).to.equal(2);
+    
+    [ds removeSectionAtIndex:0];
+    expect([ds indexOfSectionWithIdentifier:@"new"]).to.equal(NSNotFound);
+    expect([ds indexOfSectionWithIdentifier:@3]).to.equal(0);
+    expect([ds indexOfSectionWithIdentifier:@2]).to.equal(3);
+    
+    [ds applySections:@[ [SSSection sectionWithNumberOfItems:1 header:nil footer:nil identifier:@2] ]];
+    expect([ds indexOfSectionWithIdentifier:@2]).to.equal(0);
+    expect([ds indexOfSectionWithIdentifier:@3]).to.equal(NSNotFound);
+}
+
+- (void)testSectionIdentifierLookupReturnsFirstMatch
+{
+    [ds appendSection:[SSSection sectionWithNumberOfItems:1 header:nil footer:nil identifier:@"a"]];
+    [ds appendSection:[SSSection sectionWithNumberOfItems:1 header:nil footer:nil identifier:@"b"]];
+    [ds appendSection:[SSSection sectionWithNumberOfItems:1 header:nil footer:nil identifier:@"a"]];
+    
+    expect([ds indexOfSectionWithIdentifier:@"a"]).to.equal(0);
+    
+    [ds removeSectionAtIndex:0];
+    expect([ds indexOfSectionWithIdentifier:@"a"]).to.equal(1);
+}
+
+- (void)testBatchSectionIdentifierLookupAndRemoval
+{
+    for (NSUInteger i = 0; i < 5; i++) {
+        [ds appendSection:[SSSection sectionWithNumberOfItems:1 header:nil footer:nil identifier:@(i)]];
+    }
+    
+    NSMutableIndexSet *expected = [NSMutableIndexSet indexSetWithIndex:1];
+    [expected addIndex:3];
+    expect([ds indexesOfSectionsWithIdentifiers:@[ @3, @1, @"missing" ]]).to.equal(expected);
+    
+    [[mockTable expect] deleteSections:expected withRowAnimation:ds.rowAnimation];
+    [ds removeSectionsWithIdentifiers:@[ @3, @1, @"missing" ]];
+    [mockTable verify];
+    
+    expect([ds numberOfSections]).to.equal(3);
+    expect([ds indexOfSectionWithIdentifier:@4]).to.equal(2);
+    expect([ds indexOfSectionWithIdentifier:@1]).to.equal(NSNotFound);
+}
+
 - (void)testMovingItems
 {
     [ds appendSection:[SSSection sectionWithNumberOfItems:1]];
@@ -241,6 +337,41 @@ moveRowAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]
     expect([ds itemAtIndexPath:[NSIndexPath indexPathForRow:1 inSection:0]]).to.equal(@0);
 }
 
+- (void)testItemIndexTracksSectionChanges
+{
+    ds.maintainsItemIndex = YES;
+    [ds appendSection:[SSSection sectionWithItems:@[ @"a", @"b" ]]];
+    [ds appendSection:[SSSection sectionWithItems:@[ @"c" ]]];
+    
+    expect([ds indexPathForItem:@"c"]).to.equal([NSIndexPath indexPathForRow:0 inSection:1]);
+    
+    [ds insertSection:[SSSection sectionWithItems:@[ @"d" ]] atIndex:0];
+    expect([ds indexPathForItem:@"a"]).to.equal([NSIndexPath indexPathForRow:0 inSection:1]);
+    expect([ds indexPathForItem:@"c"]).to.equal([NSIndexPath indexPathForRow:0 inSection:2]);
+    
+    [ds tableView:ds.tableView
+moveRowAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:1]
+      toIndexPath:[NSIndexPath indexPathForRow:1 inSection:2]];
+    expect([ds indexPathForItem:@"b"]).to.equal([NSIndexPath indexPathForRow:0 inSection:1]);
+    expect([ds indexPathForItem:@"a"]).to.equal([NSIndexPath indexPathForRow:1 inSection:2]);
+    
+    [ds removeSectionAtIndex:0];
+    expect([ds indexPathForItem:@"d"]).to.beNil();
+    expect([ds indexPathForItem:@"a"]).to.equal([NSIndexPath indexPathForRow:1 inSection:1]);
+}
+
+- (void)testItemIndexRecoversFromDirectMutation
+{
+    ds.maintainsItemIndex = YES;
+    [ds appendSection:[SSSection sectionWithItems:@[ @"a", @"b" ]]];
+    
+    expect([ds indexPathForItem:@"b"]).to.equal([NSIndexPath indexPathForRow:1 inSection:0]);
+    
+    [[ds sectionAtIndex:0].items exchangeObjectAtIndex:0 withObjectAtIndex:1];
+    expect([ds indexPathForItem:@"b"]).to.equal([NSIndexPath indexPathForRow:0 inSection:0]);
+    expect([ds indexPathForItem:@"a"]).to.equal([NSIndexPath indexPathForRow:1 inSection:0]);
+}
+
 - (void)testInsertingSections
 {
     [ds insertSections:@[
@@ -294,6 +425,232 @@ moveRowAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]
     expect(copySection.sectionIdentifier).to.equal(section.sectionIdentifier);
 }
 
+#pragma mark - Global item indexes
+
+- (void)testGlobalIndexes
+{
+    [ds appendSection:[SSSection sectionWithItems:@[ @"a", @"b" ]]];
+    [ds appendSection:[SSSection sectionWithItems:@[]]];
+    [ds appendSection:[SSSection sectionWithItems:@[ @"c" ]]];
+    
+    expect([ds numberOfItems]).to.equal(3);
+    expect([ds indexPathForGlobalIndex:1]).to.equal([NSIndexPath indexPathForRow:1 inSection:0]);
+    expect([ds indexPathForGlobalIndex:2]).to.equal([NSIndexPath indexPathForRow:0 inSection:2]);
+    expect([ds indexPathForGlobalIndex:3]).to.beNil();
+    expect([ds globalIndexForIndexPath:[NSIndexPath indexPathForRow:0 inSection:2]]).to.equal(2);
+    expect([ds globalIndexForIndexPath:[NSIndexPath indexPathForRow:0 inSection:1]]).to.equal(NSNotFound);
+}
+
+- (void)testGlobalIndexesTrackChanges
+{
+    [ds appendSection:[SSSection sectionWithItems:@[ @"a", @"b" ]]];
+    [ds appendSection:[SSSection sectionWithItems:@[ @"c" ]]];
+    expect([ds numberOfItems]).to.equal(3);
+    
+    [ds insertItem:@"d" atIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]];
+    expect([ds numberOfItems]).to.equal(4);
+    expect([ds indexPathForGlobalIndex:3]).to.equal([NSIndexPath indexPathForRow:0 inSection:1]);
+    
+    [ds insertSection:[SSSection sectionWithItems:@[ @"e" ]] atIndex:0];
+    expect([ds numberOfItems]).to.equal(5);
+    expect([ds globalIndexForIndexPath:[NSIndexPath indexPathForRow:0 inSection:2]]).to.equal(4);
+    
+    [ds moveSectionAtIndex:2 toIndex:0];
+    expect([ds indexPathForGlobalIndex:1]).to.equal([NSIndexPath indexPathForRow:0 inSection:1]);
+    
+    [ds removeItemAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:2]];
+    expect([ds numberOfItems]).to.equal(4);
+    expect([ds indexPathForGlobalIndex:3]).to.equal([NSIndexPath indexPathForRow:1 inSection:2]);
+    
+    [ds applySections:@[ [SSSection sectionWithItems:@[ @"a" ]] ]];
+    expect([ds numberOfItems]).to.equal(1);
+}
+
+- (void)testGlobalIndexesTrackSectionChangesInBatchUpdates
+{
+    [ds appendSection:[SSSection sectionWithItems:@[ @"a", @"b" ] header:nil footer:nil identifier:@"A"]];
+    [ds appendSection:[SSSection sectionWithItems:@[ @"c" ] header:nil footer:nil identifier:@"B"]];
+    [ds appendSection:[SSSection sectionWithItems:@[ @"d", @"e", @"f" ] header:nil footer:nil identifier:@"C"]];
+    expect([ds numberOfItems]).to.equal(6);
+    
+    [ds performBatchUpdates:^{
+        [ds removeSectionAtIndex:0];
+        [ds insertSection:[SSSection sectionWithItems:@[ @"g" ]] atIndex:2];
+        [ds insertItem:@"h" atIndexPath:[NSIndexPath indexPathForRow:1 inSection:0]];
+    }];
+    
+    expect([ds numberOfItems]).to.equal(6);
+    expect([ds indexPathForGlobalIndex:2]).to.equal([NSIndexPath indexPathForRow:0 inSection:1]);
+    expect([ds globalIndexForIndexPath:[NSIndexPath indexPathForRow:0 inSection:2]]).to.equal(5);
+    
+    [ds applySections:@[
+        [SSSection sectionWithItems:@[ @"d", @"e" ] header:nil footer:nil identifier:@"C"],
+        [SSSection sectionWithItems:@[ @"x", @"y" ] header:nil footer:nil identifier:@"D"],
+        [SSSection sectionWithItems:@[ @"c", @"h", @"z" ] header:nil footer:nil identifier:@"B"]
+    ]];
+    
+    expect([ds numberOfItems]).to.equal(7);
+    expect([ds indexPathForGlobalIndex:3]).to.equal([NSIndexPath indexPathForRow:1 inSection:1]);
+    expect([ds globalIndexForIndexPath:[NSIndexPath indexPathForRow:2 inSection:2]]).to.equal(6);
+    
+    [ds moveSectionAtIndex:2 toIndex:0];
+    [ds removeSectionAtIndex:1];
+    expect([ds numberOfItems]).to.equal(5);
+    expect([ds indexPathForGlobalIndex:4]).to.equal([NSIndexPath indexPathForRow:1 inSection:1]);
+}
+
+- (void)testGlobalIndexesWithinBatchUpdates
+{
+    [ds appendSection:[SSSection sectionWithItems:@[ @"a", @"b" ]]];
+    [ds appendSection:[SSSection sectionWithItems:@[ @"c" ]]];
+    
+    [ds performBatchUpdates:^{
+        [ds insertItem:@"d" atIndexPath:[NSIndexPath indexPathForRow:0 inSection:1]];
+        
+        expect([ds numberOfItems]).to.equal(4);
+        expect([ds indexPathForGlobalIndex:2]).to.equal([NSIndexPath indexPathForRow:0 inSection:1]);
+        
+        [ds removeSectionAtIndex:0];
+        [ds appendSection:[SSSection sectionWithItems:@[ @"e", @"f" ]]];
+        
+        expect([ds numberOfItems]).to.equal(4);
+        expect([ds globalIndexForIndexPath:[NSIndexPath indexPathForRow:1 inSection:1]]).to.equal(3);
+    }];
+    
+    expect([ds numberOfItems]).to.equal(4);
+    expect([ds indexPathForGlobalIndex:1]).to.equal([NSIndexPath indexPathForRow:1 inSection:0]);
+}
+
+#pragma mark - Applying sections
+
+- (void)testApplyingSectionsReplacesSections
+{
+    ds = [[SSSectionedDataSource alloc] initWithSections:@[
+        [SSSection sectionWithItems:@[ @"a", @"b" ] header:nil footer:nil identifier:@"A"],
+        [SSSection sectionWithItems:@[ @"c" ] header:nil footer:nil identifier:@"B"]
+    ]];
+    
+    [ds applySections:@[
+        [SSSection sectionWithItems:@[ @"c", @"b" ] header:nil footer:nil identifier:@"B"],
+        [SSSection sectionWithItems:@[ @"x" ] header:nil footer:nil identifier:@"C"]
+    ]];
+    
+    expect(ds.numberOfSections).to.equal(2);
+    expect([ds sectionAtIndex:0].sectionIdentifier).to.equal(@"B");
+    expect([ds sectionAtIndex:0].items).to.equal((@[ @"c", @"b" ]));
+    expect([ds sectionAtIndex:1].items).to.equal((@[ @"x" ]));
+}
+
+- (void)testApplyingSectionsAnimatesSectionAndItemChanges
+{
+    ds = [[SSSectionedDataSource alloc] initWithSections:@[
+        [SSSection sectionWithItems:@[ @"a", @"b" ] header:nil footer:nil identifier:@"A"],
+        [SSSection sectionWithItems:@[ @"c" ] header:nil footer:nil identifier:@"B"]
+    ]];
+    ds.tableView = (UITableView *)mockTable;
+    
+    [[mockTable expect] deleteSections:[NSIndexSet indexSetWithIndex:0]
+                      withRowAnimation:ds.rowAnimation];
+    [[mockTable expect] insertSections:[NSIndexSet indexSetWithIndex:1]
+                      withRowAnimation:ds.rowAnimation];
+    [[mockTable expect] insertRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:1 inSection:0] ]
+                              withRowAnimation:ds.rowAnimation];
+    [[mockTable reject] reloadData];
+    
+    [ds applySections:@[
+        [SSSection sectionWithItems:@[ @"c", @"b" ] header:nil footer:nil identifier:@"B"],
+        [SSSection sectionWithItems:@[ @"x" ] header:nil footer:nil identifier:@"C"]
+    ]];
+    
+    [mockTable verify];
+}
+
+- (void)testApplyingSectionsInBackground
+{
+    ds = [[SSSectionedDataSource alloc] initWithSections:@[
+        [SSSection sectionWithItems:@[ @"a", @"b" ] header:nil footer:nil identifier:@"A"]
+    ]];
+    ds.tableView = (UITableView *)mockTable;
+    __block BOOL finished = NO;
+
+    [[mockTable expect] insertSections:[NSIndexSet indexSetWithIndex:1]
+                      withRowAnimation:ds.rowAnimation];
+
+    [ds applySections:@[
+        [SSSection sectionWithItems:@[ @"a", @"b" ] header:nil footer:nil identifier:@"A"],
+        [SSSection sectionWithItems:@[ @"c" ] header:nil footer:nil identifier:@"B"]
+    ] completion:^(BOOL didFinish) {
+        finished = didFinish;
+    }];
+
+    expect(ds.numberOfSections).to.equal(1);
+    expect(finished).will.beTruthy();
+    expect(ds.numberOfSections).to.equal(2);
+    expect(ds.numberOfItems).to.equal(3);
+    [mockTable verify];
+}
+
+- (void)testApplyingSectionsMovesItemsBetweenSections
+{
+    ds = [[SSSectionedDataSource alloc] initWithSections:@[
+        [SSSection sectionWithItems:@[ @"a", @"b" ] header:nil footer:nil identifier:@"A"],
+        [SSSection sectionWithItems:@[ @"c" ] header:nil footer:nil identifier:@"B"]
+    ]];
+    ds.tableView = (UITableView *)mockTable;
+    
+    [[mockTable expect] moveRowAtIndexPath:[NSIndexPath indexPathForRow:1 inSection:0]
+                               toIndexPath:[NSIndexPath indexPathForRow:1 inSection:1]];
+    
+    [ds applySections:@[
+        [SSSection sectionWithItems:@[ @"a" ] header:nil footer:nil identifier:@"A"],
+        [SSSection sectionWithItems:@[ @"c", @"b" ] header:nil footer:nil identifier:@"B"]
+    ]];
+    
+    [mockTable verify];
+}
+
+- (void)testSectionedDiff
+{
+    NSArray *oldSections = @[
+        [SSSection sectionWithItems:@[ @1, @2, @3 ] header:@"One" footer:nil identifier:@1],
+        [SSSection sectionWithItems:@[ @4 ] header:@"Two" footer:nil identifier:@2]
+    ];
+    NSArray *newSections = @[
+        [SSSection sectionWithItems:@[ @4, @5 ] header:@"Two" footer:nil identifier:@2],
+        [SSSection sectionWithItems:@[ @3, @1 ] header:@"One" footer:nil identifier:@1]
+    ];
+    
+    SSSectionedDiff *diff = [SSSectionedDiff diffFromSections:oldSections
+                                                   toSections:newSections
+                                              identifierBlock:nil
+                                                equalityBlock:nil];
+    
+    expect(diff.sectionMoves).to.haveCountOf(1);
+    expect(diff.deletedIndexPaths).to.equal(@[ [NSIndexPath indexPathForRow:1 inSection:0] ]);
+    expect(diff.insertedIndexPaths).to.equal(@[ [NSIndexPath indexPathForRow:1 inSection:0] ]);
+    expect(diff.moves).to.haveCountOf(1);
+    expect([diff.moves[0] fromIndexPath]).to.equal([NSIndexPath indexPathForRow:2 inSection:0]);
+    expect([diff.moves[0] toIndexPath]).to.equal([NSIndexPath indexPathForRow:0 inSection:1]);
+    
+    expect([diff indexPathAfterChangesForIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]])
+        .to.equal([NSIndexPath indexPathForRow:1 inSection:1]);
+    expect([diff indexPathAfterChangesForIndexPath:[NSIndexPath indexPathForRow:0 inSection:1]])
+        .to.equal([NSIndexPath indexPathForRow:0 inSection:0]);
+    expect([diff indexPathAfterChangesForIndexPath:[NSIndexPath indexPathForRow:1 inSection:0]]).to.beNil();
+    
+    expect([diff isValidFromSectionCount:2 toSectionCount:2]).to.beTruthy();
+    expect([diff isValidFromSectionCount:2 toSectionCount:3]).to.beFalsy();
+    expect([diff.removedSections count]).to.equal(1);
+    expect([diff.addedSections count]).to.equal(1);
+    expect([diff sectionAfterChangesForSection:0]).to.equal(1);
+    expect([diff sectionAfterChangesForSection:1]).to.equal(0);
+    expect([diff sectionBeforeChangesForSection:0]).to.equal(1);
+    expect([diff sectionBeforeChangesForSection:1]).to.equal(0);
+    expect([diff removedRowsInSection:0]).to.equal([NSIndexSet indexSetWithIndexesInRange:NSMakeRange(1, 2)]);
+    expect([diff addedRowsInSection:0]).to.equal([NSIndexSet indexSetWithIndex:1]);
+    expect([diff addedRowsInSection:1]).to.equal([NSIndexSet indexSetWithIndex:0]);
+}
+
 #pragma mark - Header/Footer
 
 - (void)testHeaderFooterView
@@ -307,6 +664,68 @@ moveRowAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]
     expect(headerFooter.reuseIdentifier).to.equal([SSBaseHeaderFooterView identifier]);
 }
 
+#pragma mark - Section index
+
+- (SSSection *)sectionWithIndexTitle:(NSString *)indexTitle
+{
+    SSSection *section = [SSSection sectionWithNumberOfItems:1];
+    section.indexTitle = indexTitle;
+    return section;
+}
+
+- (void)testSectionIndexTitles
+{
+    expect([ds sectionIndexTitles]).to.beNil();
+    
+    [ds appendSection:[self sectionWithIndexTitle:@"A"]];
+    [ds appendSection:[self sectionWithIndexTitle:@"A"]];
+    [ds appendSection:[SSSection sectionWithNumberOfItems:1]];
+    [ds appendSection:[self sectionWithIndexTitle:@"C"]];
+    
+    expect([ds sectionIndexTitlesForTableView:(UITableView *)mockTable]).to.equal(@[ @"A", @"C" ]);
+    expect([ds tableView:(UITableView *)mockTable sectionForSectionIndexTitle:@"A" atIndex:0]).to.equal(0);
+    expect([ds tableView:(UITableView *)mockTable sectionForSectionIndexTitle:@"C" atIndex:1]).to.equal(3);
+}
+
+- (void)testSectionIndexFollowsSectionChanges
+{
+    [ds appendSection:[self sectionWithIndexTitle:@"A"]];
+    [ds appendSection:[self sectionWithIndexTitle:@"B"]];
+    [ds appendSection:[self sectionWithIndexTitle:@"C"]];
+    expect([ds sectionIndexTitles]).to.equal(@[ @"A", @"B", @"C" ]);
+    
+    [ds insertSection:[self sectionWithIndexTitle:@"Z"] atIndex:1];
+    expect([ds sectionIndexTitles]).to.equal(@[ @"A", @"Z", @"B", @"C" ]);
+    expect([ds sectionForSectionIndexTitleAtIndex:3]).to.equal(3);
+    
+    [ds removeSectionAtIndex:3];
+    expect([ds sectionIndexTitles]).to.equal(@[ @"A", @"Z", @"B" ]);
+    
+    [ds moveSectionAtIndex:0 toIndex:2];
+    expect([ds sectionIndexTitles]).to.equal(@[ @"Z", @"B", @"A" ]);
+    expect([ds sectionForSectionIndexTitleAtIndex:2]).to.equal(2);
+    
+    [ds sectionAtIndex:1].indexTitle = @"Y";
+    [ds reloadSectionsAtIndexes:[NSIndexSet indexSetWithIndex:1]];
+    expect([ds sectionIndexTitles]).to.equal(@[ @"Z", @"Y", @"A" ]);
+}
+
+- (void)testSectionIndexWithCollation
+{
+    UILocalizedIndexedCollation *collation = [UILocalizedIndexedCollation currentCollation];
+    NSArray *titles = collation.sectionTitles;
+    ds.collation = collation;
+    
+    [ds appendSection:[self sectionWithIndexTitle:titles[0]]];
+    [ds appendSection:[self sectionWithIndexTitle:titles[2]]];
+    
+    expect([ds sectionIndexTitles]).to.equal(collation.sectionIndexTitles);
+    
+    // A title without a section scrolls to the next title that has one.
+    NSInteger secondIndexTitle = (NSInteger)[collation.sectionIndexTitles indexOfObject:titles[1]];
+    expect([ds sectionForSectionIndexTitleAtIndex:secondIndexTitle]).to.equal(1);
+}
+
 #pragma mark - UITableViewDelegate helpers
 
 - (void)testHeaderFooterViewDelegate
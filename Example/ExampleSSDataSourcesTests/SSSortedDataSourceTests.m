@@ -0,0 +1,135 @@
+#import "SSTestHelper.h"
+#import <SSDataSources.h>
+
+@interface SSSortedDataSourceTests : XCTestCase
+@end
+
+@implementation SSSortedDataSourceTests
+{
+    SSSortedDataSource *ds;
+    OCMockObject *mockTable;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    
+    mockTable = [OCMockObject niceMockForClass:[UITableView class]];
+    ds = [[SSSortedDataSource alloc] initWithItems:@[ @30, @10, @20 ]
+                                        comparator:^NSComparisonResult(NSNumber *number1, NSNumber *number2) {
+                                            return [number1 compare:number2];
+                                        }];
+    ds.tableView = (UITableView *)mockTable;
+}
+
+- (void)tearDown
+{
+    [super tearDown];
+    ds = nil;
+}
+
+- (void)testSortsInitialItems
+{
+    expect([ds allItems]).to.equal(@[ @10, @20, @30 ]);
+    expect([ds numberOfItems]).to.equal(3);
+}
+
+- (void)testSortsWithSortDescriptors
+{
+    SSSortedDataSource *sorted = [[SSSortedDataSource alloc] initWithItems:@[ @"b", @"c", @"a" ]
+                                                           sortDescriptors:@[ [NSSortDescriptor sortDescriptorWithKey:@"self"
+                                                                                                            ascending:NO] ]];
+    expect([sorted allItems]).to.equal(@[ @"c", @"b", @"a" ]);
+    expect([sorted insertItem:@"bb"]).to.equal(1);
+}
+
+- (void)testInsertsItemInOrder
+{
+    [[mockTable expect] insertRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:2 inSection:0] ]
+                              withRowAnimation:ds.rowAnimation];
+    
+    expect([ds insertItem:@25]).to.equal(2);
+    
+    [mockTable verify];
+    expect([ds allItems]).to.equal(@[ @10, @20, @25, @30 ]);
+}
+
+- (void)testInsertsEqualItemsAfterExistingItems
+{
+    NSNumber *twenty = [NSNumber numberWithDouble:20.0];
+    
+    expect([ds insertItem:twenty]).to.equal(2);
+    expect([ds allItems][1]).to.beIdenticalTo(@20);
+}
+
+- (void)testMergesInsertedItems
+{
+    NSMutableIndexSet *insertedIndexes = [NSMutableIndexSet indexSetWithIndex:0];
+    [insertedIndexes addIndex:3];
+    [insertedIndexes addIndexesInRange:NSMakeRange(5, 2)];
+    
+    [[mockTable expect] insertRowsAtIndexPaths:[SSBaseDataSource indexPathArrayWithIndexSet:insertedIndexes
+                                                                                  inSection:0]
+                              withRowAnimation:ds.rowAnimation];
+    
+    [ds insertItems:@[ @40, @5, @25, @35 ]];
+    
+    [mockTable verify];
+    expect([ds allItems]).to.equal(@[ @5, @10, @20, @25, @30, @35, @40 ]);
+}
+
+- (void)testFindsAndRemovesItems
+{
+    expect([ds indexOfItem:@20]).to.equal(1);
+    expect([ds indexOfItem:@15]).to.equal(NSNotFound);
+    
+    [[mockTable expect] deleteRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:1 inSection:0] ]
+                              withRowAnimation:ds.rowAnimation];
+    
+    [ds removeItem:@20];
+    
+    [mockTable verify];
+    expect([ds allItems]).to.equal(@[ @10, @30 ]);
+}
+
+- (void)testRepositionsItem
+{
+    NSMutableArray *scores = [NSMutableArray arrayWithObjects:@10, @20, @30, nil];
+    SSSortedDataSource *sorted = [[SSSortedDataSource alloc] initWithItems:@[ @0, @1, @2 ]
+                                                                comparator:^NSComparisonResult(NSNumber *index1, NSNumber *index2) {
+                                                                    return [scores[[index1 unsignedIntegerValue]]
+                                                                            compare:scores[[index2 unsignedIntegerValue]]];
+                                                                }];
+    sorted.tableView = (UITableView *)mockTable;
+    
+    [[mockTable expect] moveRowAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]
+                               toIndexPath:[NSIndexPath indexPathForRow:2 inSection:0]];
+    
+    scores[0] = @40;
+    expect([sorted repositionItemAtIndex:0]).to.equal(2);
+    
+    [mockTable verify];
+    expect([sorted allItems]).to.equal(@[ @1, @2, @0 ]);
+    
+    [[mockTable expect] reloadRowsAtIndexPaths:@[ [NSIndexPath indexPathForRow:1 inSection:0] ]
+                              withRowAnimation:sorted.rowAnimation];
+    
+    scores[2] = @25;
+    expect([sorted repositionItemAtIndex:1]).to.equal(1);
+    
+    [mockTable verify];
+    expect([sorted allItems]).to.equal(@[ @1, @2, @0 ]);
+}
+
+- (void)testUpdatesItemsInOrder
+{
+    ds.itemIdentifierBlock = ^id(NSNumber *number) {
+        return number;
+    };
+    
+    [ds updateItems:@[ @50, @10, @40 ]];
+    
+    expect([ds allItems]).to.equal(@[ @10, @40, @50 ]);
+}
+
+@end
@@ -60,10 +60,33 @@
 
 /**
  * Replace all items in the data source.
- * This will reload the table or collection view.
+ *
+ * If you have specified an `itemIdentifierBlock`, the old and new items are diffed
+ * and the table or collection view receives only the required inserts, deletes,
+ * moves and reloads in a single batch update. Otherwise, this will reload
+ * the table or collection view.
  */
 - (void) updateItems:(NSArray *)newItems;
 
+/**
+ *  As above, but the old and new items are diffed on a background queue,
+ *  keeping the main thread responsive for very large arrays.
+ *  The changes are then animated on the main thread.
+ *
+ *  If this method is called again before the diff completes, the earlier update
+ *  is dropped in favor of the newer one and its completion block receives NO.
+ *  If the items are changed in any other way while the diff is being computed,
+ *  the update is applied as with `updateItems:` instead.
+ *
+ *  `itemIdentifierBlock` and `itemEqualityBlock` are called on the background queue,
+ *  so they must be safe to call from any thread. Don't mutate `newItems` afterwards.
+ *
+ *  @param newItems   the new items
+ *  @param completion optional block called on the main thread once the update
+ *                    has been applied (YES) or superseded by a newer update (NO)
+ */
+- (void) updateItems:(NSArray *)newItems completion:(void (^)(BOOL finished))completion;
+
 #pragma mark - Adding Items
 
 /**
@@ -58,6 +58,25 @@ static void *SSArrayKeyPathDataSourceContext = &SSArrayKeyPathDataSourceContext;
  */
 @property (nonatomic, strong) NSMutableArray *items;
 
+/**
+ * Replace the receiver's items with `newItems`, animating the changes described by `diff`
+ * as a single batch update.
+ */
+- (void) applyDiff:(SSArrayDiff *)diff withItems:(NSArray *)newItems;
+
+// Background diffing, implemented by SSBaseDataSource
+- (void) _performBackgroundDiff:(id (^)(void))diffBlock
+                          apply:(BOOL (^)(id diff))applyBlock
+                          retry:(void (^)(void))retryBlock
+                     completion:(void (^)(BOOL finished))completion;
+- (void) _cancelBackgroundDiffs;
+
+// Implemented by SSBaseDataSource
+- (BOOL) _hasCachedData;
+- (NSArray *) _itemsInSection:(NSUInteger)section;
+- (void) _removeCachedDataForItems:(NSArray *)items;
+- (void) _invalidateSnapshot;
+
 @end
 
 @implementation SSArrayDataSource
@@ -116,6 +135,10 @@ static void *SSArrayKeyPathDataSourceContext = &SSArrayKeyPathDataSourceContext;
     return nil;
 }
 
+- (NSArray *)_itemsInSection:(NSUInteger)section {
+    return self.items;
+}
+
 #pragma mark - Updating items
 
 - (void)clearItems {
@@ -130,12 +153,101 @@ static void *SSArrayKeyPathDataSourceContext = &SSArrayKeyPathDataSourceContext;
 }
 
 - (void)updateItems:(NSArray *)newItems {
+    [self _cancelBackgroundDiffs];
+    
+    if (self.itemIdentifierBlock) {
+        SSArrayDiff *diff = [SSArrayDiff diffFromArray:[self.items copy]
+                                               toArray:(newItems ?: @[])
+                                       identifierBlock:self.itemIdentifierBlock
+                                         equalityBlock:self.itemEqualityBlock];
+        
+        [self applyDiff:diff withItems:newItems];
+        return;
+    }
+    
     [self unregisterKVO];
     [self.items setArray:newItems];
     [self reloadData];
     [self registerKVO];
 }
 
+- (void)updateItems:(NSArray *)newItems completion:(void (^)(BOOL))completion {
+    NSArray *items = ([newItems copy] ?: @[]);
+    
+    if (!self.itemIdentifierBlock) {
+        [self updateItems:items];
+        
+        if (completion) {
+            completion(YES);
+        }
+        
+        return;
+    }
+    
+    NSArray *oldItems = [self.items copy];
+    SSItemIdentifierBlock identifierBlock = self.itemIdentifierBlock;
+    SSItemEqualityBlock equalityBlock = self.itemEqualityBlock;
+    __weak SSArrayDataSource *weakSelf = self;
+    
+    [self _performBackgroundDiff:^id{
+        return [SSArrayDiff diffFromArray:oldItems
+                                  toArray:items
+                          identifierBlock:identifierBlock
+                            equalityBlock:equalityBlock];
+    } apply:^BOOL(SSArrayDiff *diff) {
+        [weakSelf applyDiff:diff withItems:items];
+        return YES;
+    } retry:^{
+        [weakSelf updateItems:items completion:completion];
+    } completion:completion];
+}
+
+- (void)applyDiff:(SSArrayDiff *)diff withItems:(NSArray *)newItems {
+    [self unregisterKVO];
+    
+    if (![diff hasChanges]) {
+        // Same items in the same order; just swap in the new instances.
+        // Index paths are unchanged, but the snapshot holds the old instances.
+        [self.items setArray:newItems];
+        [self _invalidateSnapshot];
+        [self registerKVO];
+        return;
+    }
+    
+    if ([self exceedsMaximumAnimatedChangeCount:diff.changeCount]) {
+        [self.items setArray:newItems];
+        [self reloadData];
+        [self registerKVO];
+        return;
+    }
+    
+    // Reloaded items keep their identifiers, but their contents changed.
+    if ([self _hasCachedData]) {
+        [self invalidateSizesForItemsAtIndexPaths:[self.class indexPathArrayWithIndexSet:diff.reloadedIndexes
+                                                                               inSection:0]];
+    }
+    
+    // Deleted items won't be found at their index paths once the new items are in place.
+    if ([self _hasCachedData]) {
+        [self _removeCachedDataForItems:[self.items objectsAtIndexes:diff.deletedIndexes]];
+    }
+    
+    [self performBatchUpdates:^{
+        [self.items setArray:newItems];
+        
+        [self deleteCellsAtIndexes:diff.deletedIndexes inSection:0];
+        [self insertCellsAtIndexes:diff.insertedIndexes inSection:0];
+        [self reloadCellsAtIndexes:diff.reloadedIndexes inSection:0];
+        
+        for (SSArrayDiffMove *move in diff.moves) {
+            [self moveCellAtIndexPath:[NSIndexPath indexPathForRow:(NSInteger)move.fromIndex inSection:0]
+                          toIndexPath:[NSIndexPath indexPathForRow:(NSInteger)move.toIndex inSection:0]];
+        }
+    }];
+    
+    [self registerKVO];
+}
+
 - (NSArray *)allItems {
     return self.items;
 }
@@ -218,6 +330,10 @@ static void *SSArrayKeyPathDataSourceContext = &SSArrayKeyPathDataSourceContext;
 #pragma mark - Item Searching
 
 - (NSIndexPath *)indexPathForItemWithId:(NSManagedObjectID *)itemId {
+    if (self.maintainsItemIndex && !self.itemIdentifierBlock) {
+        return [self indexPathForItemWithIdentifier:itemId];
+    }
+    
     NSUInteger row = [self.items indexOfObjectPassingTest:^BOOL(NSManagedObject *object,
                                                                 NSUInteger index,
                                                                 BOOL *stop) {
@@ -242,15 +358,19 @@ moveRowAtIndexPath:(NSIndexPath *)sourceIndexPath
     [self.items removeObject:item];
     [self.items insertObject:item
                      atIndex:(NSUInteger)destinationIndexPath.row];
+    [self invalidateItemIndexFromIndexPath:([sourceIndexPath compare:destinationIndexPath] == NSOrderedAscending
+                                            ? sourceIndexPath
+                                            : destinationIndexPath)];
     [self registerKVO];
 }
 
 #pragma mark Key-value observing
 
 - (void)registerKVO {
+    // The old values identify items that are removed or replaced, which are gone by the time we hear of it.
     [self.target addObserver:self
                   forKeyPath:self.keyPath
-                     options:NSKeyValueObservingOptionInitial
+                     options:NSKeyValueObservingOptionOld
                      context:&SSArrayKeyPathDataSourceContext];
 }
 
@@ -263,19 +383,22 @@ moveRowAtIndexPath:(NSIndexPath *)sourceIndexPath
 - (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary *)change context:(void *)context {
     if (context == SSArrayKeyPathDataSourceContext && [keyPath isEqualToString:self.keyPath]) {
         NSKeyValueChange changeKind = [change[NSKeyValueChangeKindKey] unsignedIntegerValue];
-        NSArray *indexPaths = [self.class indexPathArrayWithIndexSet:change[NSKeyValueChangeIndexesKey]
-                                                           inSection:0];
+        NSIndexSet *indexes = change[NSKeyValueChangeIndexesKey];
+        
         switch (changeKind) {
             case NSKeyValueChangeInsertion:
-                [self insertCellsAtIndexPaths:indexPaths];
+                [self insertCellsAtIndexes:indexes inSection:0];
                 break;
             case NSKeyValueChangeRemoval:
-                [self deleteCellsAtIndexPaths:indexPaths];
+                [self _removeCachedDataForItems:change[NSKeyValueChangeOldKey]];
+                [self deleteCellsAtIndexes:indexes inSection:0];
                 break;
             case NSKeyValueChangeReplacement:
-                [self reloadCellsAtIndexPaths:indexPaths];
+                [self _removeCachedDataForItems:change[NSKeyValueChangeOldKey]];
+                [self reloadCellsAtIndexes:indexes inSection:0];
                 break;
             case NSKeyValueChangeSetting:
+                [self invalidateItemIndexFromIndexPath:nil];
                 break;
             default:
                 break;
@@ -0,0 +1,133 @@
+//
+//  SSArrayDiff.h
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * SSArrayDiff computes the inserts, deletes, moves, and reloads required to
+ * transform one array into another in O(n + m) time using Heckel's algorithm.
+ *
+ * Items are matched across the two arrays by an identifier that you provide.
+ * Matched items whose contents differ are reported as reloads.
+ * The result uses the same conventions as a UITableView or UICollectionView batch update:
+ * deleted and reloaded indexes refer to the old array, inserted indexes refer to the new array.
+ */
+
+#pragma mark - SSArrayDiff block signatures
+
+// Block used to derive a stable identifier for an item.
+// Two items with equal identifiers (via -hash and -isEqual:) represent the same entity.
+typedef id   (^SSItemIdentifierBlock) (id item);     // The item to identify
+
+// Block used to determine whether two items with the same identifier have the same contents.
+typedef BOOL (^SSItemEqualityBlock)   (id oldItem,   // The item in the old array
+                                       id newItem);  // The item in the new array
+
+#pragma mark - SSArrayDiffMove
+
+@interface SSArrayDiffMove : NSObject
+
+/**
+ * Index of the moved item in the old array.
+ */
+@property (nonatomic, assign, readonly) NSUInteger fromIndex;
+
+/**
+ * Index of the moved item in the new array.
+ */
+@property (nonatomic, assign, readonly) NSUInteger toIndex;
+
+@end
+
+#pragma mark - SSArrayDiff
+
+@interface SSArrayDiff : NSObject
+
+/**
+ *  Compute the difference between two arrays.
+ *
+ *  @param oldArray        the original array
+ *  @param newArray        the updated array
+ *  @param identifierBlock nil, or a block returning an identifier for each item.
+ *                         If nil, items are their own identifiers.
+ *  @param equalityBlock   nil, or a block comparing the contents of two matched items.
+ *                         If nil, matched items are compared with -isEqual:.
+ *
+ *  @return a diff between the two arrays
+ */
++ (instancetype) diffFromArray:(NSArray *)oldArray
+                       toArray:(NSArray *)newArray
+               identifierBlock:(SSItemIdentifierBlock)identifierBlock
+                 equalityBlock:(SSItemEqualityBlock)equalityBlock;
+
+/**
+ * Indexes in the old array of items that were removed.
+ */
+@property (nonatomic, strong, readonly) NSIndexSet *deletedIndexes;
+
+/**
+ * Indexes in the new array of items that were added.
+ */
+@property (nonatomic, strong, readonly) NSIndexSet *insertedIndexes;
+
+/**
+ * Indexes in the old array of items that did not move but whose contents changed.
+ * Items that both moved and changed are reported as a delete plus an insert,
+ * since table and collection views cannot move and reload the same item in one batch.
+ */
+@property (nonatomic, strong, readonly) NSIndexSet *reloadedIndexes;
+
+/**
+ * An array of `SSArrayDiffMove` objects. Only the minimal set of moves is reported;
+ * items that merely shift due to inserts and deletes around them are not included.
+ */
+@property (nonatomic, strong, readonly) NSArray *moves;
+
+/**
+ * Total number of inserts, deletes, moves, and reloads in this diff.
+ */
+@property (nonatomic, assign, readonly) NSUInteger changeCount;
+
+/**
+ *  YES if applying this diff would change the table or collection view.
+ */
+- (BOOL) hasChanges;
+
+#pragma mark - Helpers
+
+/**
+ *  Pair items in two arrays by identifier. Duplicate identifiers are paired in order of appearance.
+ *
+ *  @param oldArray        the original array
+ *  @param newArray        the updated array
+ *  @param identifierBlock nil, or a block returning an identifier for each item
+ *  @param oldToNew        buffer with room for `oldArray.count` elements. On return, contains
+ *                         the index in `newArray` of each old item, or NSNotFound
+ *  @param newToOld        buffer with room for `newArray.count` elements. On return, contains
+ *                         the index in `oldArray` of each new item, or NSNotFound
+ */
++ (void) matchItemsInArray:(NSArray *)oldArray
+                   toArray:(NSArray *)newArray
+           identifierBlock:(SSItemIdentifierBlock)identifierBlock
+                  oldToNew:(NSUInteger *)oldToNew
+                  newToOld:(NSUInteger *)newToOld;
+
+/**
+ *  Find the positions of the longest increasing subsequence in a sequence of indexes.
+ *  Elements at these positions keep their relative order and need not be moved;
+ *  every other element must be moved explicitly.
+ *
+ *  @param sequence an array of indexes
+ *  @param count    number of elements in the sequence
+ *
+ *  @return positions within `sequence` of elements that can remain in place
+ */
++ (NSIndexSet *) indexesOfStableElementsInSequence:(const NSUInteger *)sequence
+                                             count:(NSUInteger)count;
+
+@end
@@ -0,0 +1,273 @@
+//
+//  SSArrayDiff.m
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSDataSources.h"
+
+static inline id SSDiffIdentifierForItem(id item, SSItemIdentifierBlock identifierBlock) {
+    id identifier = (identifierBlock ? identifierBlock(item) : item);
+
+    return (identifier ?: item);
+}
+
+static inline BOOL SSDiffItemsAreEqual(id oldItem, id newItem, SSItemEqualityBlock equalityBlock) {
+    if (oldItem == newItem) {
+        return YES;
+    }
+
+    return (equalityBlock ? equalityBlock(oldItem, newItem) : [oldItem isEqual:newItem]);
+}
+
+#pragma mark - SSArrayDiffMove
+
+@interface SSArrayDiffMove ()
+
+@property (nonatomic, assign, readwrite) NSUInteger fromIndex;
+@property (nonatomic, assign, readwrite) NSUInteger toIndex;
+
++ (instancetype) moveFromIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex;
+
+@end
+
+@implementation SSArrayDiffMove
+
++ (instancetype)moveFromIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex {
+    SSArrayDiffMove *move = [self new];
+    move.fromIndex = fromIndex;
+    move.toIndex = toIndex;
+
+    return move;
+}
+
+- (BOOL)isEqual:(id)object {
+    if (![object isKindOfClass:[SSArrayDiffMove class]]) {
+        return NO;
+    }
+
+    return (self.fromIndex == [object fromIndex] && self.toIndex == [object toIndex]);
+}
+
+- (NSUInteger)hash {
+    return (self.fromIndex * 31) ^ self.toIndex;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %lu -> %lu>",
+            NSStringFromClass([self class]),
+            (unsigned long)self.fromIndex,
+            (unsigned long)self.toIndex];
+}
+
+@end
+
+#pragma mark - SSArrayDiff
+
+@interface SSArrayDiff ()
+
+@property (nonatomic, strong, readwrite) NSIndexSet *deletedIndexes;
+@property (nonatomic, strong, readwrite) NSIndexSet *insertedIndexes;
+@property (nonatomic, strong, readwrite) NSIndexSet *reloadedIndexes;
+@property (nonatomic, strong, readwrite) NSArray *moves;
+
+@end
+
+@implementation SSArrayDiff
+
++ (instancetype)diffFromArray:(NSArray *)oldArray
+                      toArray:(NSArray *)newArray
+              identifierBlock:(SSItemIdentifierBlock)identifierBlock
+                equalityBlock:(SSItemEqualityBlock)equalityBlock {
+
+    NSUInteger oldCount = [oldArray count];
+    NSUInteger newCount = [newArray count];
+
+    NSUInteger *oldToNew = malloc(sizeof(NSUInteger) * MAX(oldCount, 1u));
+    NSUInteger *newToOld = malloc(sizeof(NSUInteger) * MAX(newCount, 1u));
+
+    [self matchItemsInArray:oldArray
+                    toArray:newArray
+            identifierBlock:identifierBlock
+                   oldToNew:oldToNew
+                   newToOld:newToOld];
+
+    NSMutableIndexSet *deleted = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *inserted = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *reloaded = [NSMutableIndexSet indexSet];
+    NSMutableArray *moves = [NSMutableArray array];
+
+    for (NSUInteger index = 0; index < oldCount; index++) {
+        if (oldToNew[index] == NSNotFound) {
+            [deleted addIndex:index];
+        }
+    }
+
+    // Matched items outside the longest increasing run of old indexes must move.
+    NSUInteger *survivors = malloc(sizeof(NSUInteger) * MAX(newCount, 1u));
+    NSUInteger *survivorNewIndexes = malloc(sizeof(NSUInteger) * MAX(newCount, 1u));
+    NSUInteger survivorCount = 0;
+
+    for (NSUInteger index = 0; index < newCount; index++) {
+        if (newToOld[index] == NSNotFound) {
+            [inserted addIndex:index];
+        } else {
+            survivors[survivorCount] = newToOld[index];
+            survivorNewIndexes[survivorCount] = index;
+            survivorCount++;
+        }
+    }
+
+    NSIndexSet *stablePositions = [self indexesOfStableElementsInSequence:survivors
+                                                                    count:survivorCount];
+
+    for (NSUInteger position = 0; position < survivorCount; position++) {
+        NSUInteger oldIndex = survivors[position];
+        NSUInteger newIndex = survivorNewIndexes[position];
+        BOOL changed = !SSDiffItemsAreEqual(oldArray[oldIndex], newArray[newIndex], equalityBlock);
+
+        if ([stablePositions containsIndex:position]) {
+            if (changed) {
+                [reloaded addIndex:oldIndex];
+            }
+        } else if (changed) {
+            [deleted addIndex:oldIndex];
+            [inserted addIndex:newIndex];
+        } else {
+            [moves addObject:[SSArrayDiffMove moveFromIndex:oldIndex toIndex:newIndex]];
+        }
+    }
+
+    free(oldToNew);
+    free(newToOld);
+    free(survivors);
+    free(survivorNewIndexes);
+
+    SSArrayDiff *diff = [self new];
+    diff.deletedIndexes = deleted;
+    diff.insertedIndexes = inserted;
+    diff.reloadedIndexes = reloaded;
+    diff.moves = moves;
+
+    return diff;
+}
+
+- (NSUInteger)changeCount {
+    return [self.deletedIndexes count]
+         + [self.insertedIndexes count]
+         + [self.reloadedIndexes count]
+         + [self.moves count];
+}
+
+- (BOOL)hasChanges {
+    return [self changeCount] > 0;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: deleted %@, inserted %@, reloaded %@, moves %@>",
+            NSStringFromClass([self class]),
+            self.deletedIndexes,
+            self.insertedIndexes,
+            self.reloadedIndexes,
+            self.moves];
+}
+
+#pragma mark - Helpers
+
++ (void)matchItemsInArray:(NSArray *)oldArray
+                  toArray:(NSArray *)newArray
+          identifierBlock:(SSItemIdentifierBlock)identifierBlock
+                 oldToNew:(NSUInteger *)oldToNew
+                 newToOld:(NSUInteger *)newToOld {
+
+    NSUInteger oldCount = [oldArray count];
+    NSUInteger newCount = [newArray count];
+
+    NSMapTable *firstOldIndexes = [NSMapTable strongToStrongObjectsMapTable];
+    NSUInteger *nextOldIndexes = malloc(sizeof(NSUInteger) * MAX(oldCount, 1u));
+
+    // Chain together the old indexes that share an identifier, lowest index first.
+    for (NSUInteger i = oldCount; i > 0; i--) {
+        NSUInteger index = i - 1;
+        id identifier = SSDiffIdentifierForItem(oldArray[index], identifierBlock);
+        NSNumber *head = [firstOldIndexes objectForKey:identifier];
+
+        nextOldIndexes[index] = (head ? [head unsignedIntegerValue] : NSNotFound);
+        oldToNew[index] = NSNotFound;
+        [firstOldIndexes setObject:@(index) forKey:identifier];
+    }
+
+    // Pair each new item with the earliest unmatched old item sharing its identifier.
+    for (NSUInteger index = 0; index < newCount; index++) {
+        id identifier = SSDiffIdentifierForItem(newArray[index], identifierBlock);
+        NSNumber *head = [firstOldIndexes objectForKey:identifier];
+
+        if (!head) {
+            newToOld[index] = NSNotFound;
+            continue;
+        }
+
+        NSUInteger oldIndex = [head unsignedIntegerValue];
+        newToOld[index] = oldIndex;
+        oldToNew[oldIndex] = index;
+
+        if (nextOldIndexes[oldIndex] == NSNotFound) {
+            [firstOldIndexes removeObjectForKey:identifier];
+        } else {
+            [firstOldIndexes setObject:@(nextOldIndexes[oldIndex]) forKey:identifier];
+        }
+    }
+
+    free(nextOldIndexes);
+}
+
++ (NSIndexSet *)indexesOfStableElementsInSequence:(const NSUInteger *)sequence
+                                            count:(NSUInteger)count {
+    if (count == 0) {
+        return [NSIndexSet indexSet];
+    }
+
+    // Patience sorting: tails[n] is the position of the smallest element
+    // ending an increasing run of length n + 1.
+    NSUInteger *tails = malloc(sizeof(NSUInteger) * count);
+    NSUInteger *predecessors = malloc(sizeof(NSUInteger) * count);
+    NSUInteger length = 0;
+
+    for (NSUInteger position = 0; position < count; position++) {
+        NSUInteger low = 0, high = length;
+
+        while (low < high) {
+            NSUInteger mid = low + (high - low) / 2;
+
+            if (sequence[tails[mid]] < sequence[position]) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+
+        predecessors[position] = (low > 0 ? tails[low - 1] : NSNotFound);
+        tails[low] = position;
+
+        if (low == length) {
+            length++;
+        }
+    }
+
+    NSMutableIndexSet *stable = [NSMutableIndexSet indexSet];
+    NSUInteger position = tails[length - 1];
+
+    while (position != NSNotFound) {
+        [stable addIndex:position];
+        position = predecessors[position];
+    }
+
+    free(tails);
+    free(predecessors);
+
+    return stable;
+}
+
+@end
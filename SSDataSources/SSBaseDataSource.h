@@ -14,6 +14,13 @@
  */
 
 #import <UIKit/UIKit.h>
+#import "SSArrayDiff.h"
+
+@class SSItemSizeCache;
+@class SSDataSourceMetrics;
+@class SSDataSourceSnapshot;
+@class SSSectionedDiff;
+@protocol SSDataSourceObserver;
 
 @interface SSBaseDataSource : NSObject <UITableViewDataSource, UICollectionViewDataSource>
 
@@ -61,6 +68,30 @@ typedef void (^SSTableCellDeletionBlock)
                                       UITableView *parentView, // the parent table view
                                       NSIndexPath *indexPath); // the indexPath being deleted
 
+// Optional block used to compute the size of a cell for an item.
+// May be called on a background queue, so it should depend only on its arguments.
+typedef CGSize (^SSItemSizeBlock)    (id item,                 // The item to measure
+                                      CGFloat width);          // The width available to its cell
+
+// Optional block used to start loading data for an item before its cell is displayed.
+// Return an object that identifies the work, e.g. an NSOperation, to receive it again on cancellation.
+typedef id   (^SSItemPrefetchBlock)  (id item);                // The item that will soon be displayed
+
+// Optional block used to cancel work started by an SSItemPrefetchBlock.
+typedef void (^SSItemCancelPrefetchBlock)
+                                     (id item,                 // The item no longer expected to be displayed
+                                      id prefetchToken);       // The object returned by the prefetch block, or nil
+
+// Optional block used to prepare everything a cell needs to display an item, e.g. formatted
+// strings and text layout. May be called on a background queue, so it should depend only on the item.
+typedef id   (^SSItemPrepareBlock)   (id item);                // The item to prepare
+
+// Optional block called to configure a cell with a view model returned by an SSItemPrepareBlock.
+typedef void (^SSCellApplyBlock)     (id cell,                 // The cell to configure
+                                      id viewModel,            // The view model prepared for this cell's item
+                                      id parentView,           // The parent table or collection view
+                                      NSIndexPath *indexPath); // Index path for this cell
+
 #pragma mark - NSIndexPath helpers
 
 /**
@@ -109,6 +140,8 @@ typedef void (^SSTableCellDeletionBlock)
 
 /**
  * Search all sections for the specified item. Sends -isEqual: to every object in the data source.
+ * If `maintainsItemIndex` is YES, the item is instead located by its identifier
+ * (see -identifierForItem:) without a search.
  *
  * @param item item for which to search
  *
@@ -149,6 +182,285 @@ typedef void (^SSTableCellDeletionBlock)
  */
 @property (nonatomic, strong) UIView *emptyView;
 
+#pragma mark - Snapshots
+
+/**
+ *  Return an immutable copy of the data source's items, which may be read on any thread.
+ *
+ *  The data source keeps its latest snapshot up to date as items and sections are inserted,
+ *  removed, reloaded and moved, sharing all unchanged storage with earlier snapshots,
+ *  so taking a snapshot is normally O(1). Batch updates and transactions are applied
+ *  to it once they end. The first snapshot, and the first after -reloadData, is built from scratch.
+ *
+ *  @return a snapshot of the current items
+ */
+- (SSDataSourceSnapshot *) snapshot;
+
+#pragma mark - Item identity
+
+/**
+ * Optional block returning a stable identifier for an item, such as a server ID.
+ * Items with equal identifiers are treated as the same entity across updates.
+ *
+ * When specified, updating the entire contents of a data source
+ * (e.g. -[SSArrayDataSource updateItems:]) computes the minimal set of
+ * inserts, deletes, moves and reloads and applies them in a single batch update,
+ * rather than reloading the table or collection view.
+ */
+@property (nonatomic, copy) SSItemIdentifierBlock itemIdentifierBlock;
+
+/**
+ * Optional block used to decide whether two items sharing an identifier
+ * have the same contents. Matched items with different contents are reloaded.
+ * If not specified, items are compared with -isEqual:.
+ */
+@property (nonatomic, copy) SSItemEqualityBlock itemEqualityBlock;
+
+/**
+ * If YES, the data source keeps an index from item identifiers to index paths,
+ * so that -indexPathForItem: and -indexPathForItemWithIdentifier: need not
+ * search every item. Defaults to NO.
+ *
+ * The index is updated by the insert, delete, reload and move operations below.
+ * Positions after a change are re-indexed lazily on the next lookup,
+ * so lookups between changes are constant time.
+ * If you modify items without going through the data source, call -invalidateItemIndexFromIndexPath:.
+ */
+@property (nonatomic, assign) BOOL maintainsItemIndex;
+
+/**
+ *  Return the identifier for an item: the result of `itemIdentifierBlock` if specified,
+ *  otherwise the `objectID` of managed objects, otherwise the item itself.
+ *
+ *  @param item an item in the data source
+ *
+ *  @return an identifier for the item
+ */
+- (id) identifierForItem:(id)item;
+
+/**
+ *  Find the first item with the specified identifier.
+ *
+ *  @param identifier an identifier, as returned by -identifierForItem:
+ *
+ *  @return an indexpath, or nil if not found
+ */
+- (NSIndexPath *) indexPathForItemWithIdentifier:(id)identifier;
+
+/**
+ *  Mark the item index as stale from the specified index path onwards.
+ *  Pass nil to discard the entire index. You probably don't need to call this directly.
+ *
+ *  @param indexPath the first index path whose item may have changed, or nil
+ */
+- (void) invalidateItemIndexFromIndexPath:(NSIndexPath *)indexPath;
+
+#pragma mark - Item sizes
+
+/**
+ * Optional block used to compute the size of each item's cell at a given width,
+ * e.g. from the item's text and font metrics. See `sizeForItemAtIndexPath:width:`.
+ * It may be called on a background queue; see `precomputeSizesForItemsAtIndexPaths:width:completion:`.
+ * SSCoreDataSource always calls it on the main thread, as managed objects
+ * may only be used on their context's queue.
+ */
+@property (nonatomic, copy) SSItemSizeBlock itemSizeBlock;
+
+/**
+ * Sizes computed by `itemSizeBlock` or recorded with `setSize:forItemAtIndexPath:width:`,
+ * keyed by item identifier (see -identifierForItem:) and width.
+ *
+ * Sizes are removed for items that are inserted, reloaded, replaced or removed through the data source,
+ * or updated or removed by `updateItems:` and `applySections:`, and the cache is emptied by -reloadData.
+ * If you change an item without going through the data source, call
+ * `invalidateSizesForItemsAtIndexPaths:`.
+ */
+@property (nonatomic, strong, readonly) SSItemSizeCache *sizeCache;
+
+/**
+ *  Return the size of the cell for an item, e.g. from tableView:heightForRowAtIndexPath:
+ *  or collectionView:layout:sizeForItemAtIndexPath:. If the size isn't cached,
+ *  it is computed with `itemSizeBlock` and cached.
+ *
+ *  @param indexPath index path of the item
+ *  @param width     width available to the cell
+ *
+ *  @return the size of the cell, or CGSizeZero if not cached and there is no `itemSizeBlock`
+ */
+- (CGSize) sizeForItemAtIndexPath:(NSIndexPath *)indexPath width:(CGFloat)width;
+
+/**
+ *  Cache a size measured elsewhere, e.g. by Auto Layout when a self-sizing cell is displayed.
+ *
+ *  @param size      the size of the cell
+ *  @param indexPath index path of the item
+ *  @param width     width available to the cell
+ */
+- (void) setSize:(CGSize)size forItemAtIndexPath:(NSIndexPath *)indexPath width:(CGFloat)width;
+
+/**
+ *  Remove cached sizes and prepared view models (see `itemPrepareBlock`)
+ *  for the items at the specified index paths.
+ *
+ *  @param indexPaths index paths of items whose sizes may have changed
+ */
+- (void) invalidateSizesForItemsAtIndexPaths:(NSArray *)indexPaths;
+
+/**
+ *  Compute sizes with `itemSizeBlock` on a background queue, so that they are
+ *  cached before the cells are displayed, e.g. for a newly loaded page of items.
+ *  Items that already have a size at this width are skipped.
+ *
+ *  If an item's sizes are invalidated before its size is computed,
+ *  its computed size is discarded, as it may describe old contents.
+ *
+ *  SSCoreDataSource computes the sizes later on the main thread instead,
+ *  as its managed objects may not be used on a background queue.
+ *
+ *  @param indexPaths index paths of items to measure
+ *  @param width      width available to the cells
+ *  @param completion optional block called on the main thread once the sizes are cached
+ */
+- (void) precomputeSizesForItemsAtIndexPaths:(NSArray *)indexPaths
+                                       width:(CGFloat)width
+                                  completion:(void (^)(void))completion;
+
+/**
+ *  Like `precomputeSizesForItemsAtIndexPaths:width:completion:`, for items you already have,
+ *  e.g. a page of items just appended, without looking up their index paths.
+ *
+ *  Call it after the items are added: inserting an item invalidates its sizes,
+ *  so sizes computed before insertion are discarded.
+ *
+ *  @param items      items to measure
+ *  @param width      width available to the cells
+ *  @param completion optional block called on the main thread once the sizes are cached
+ */
+- (void) precomputeSizesForItems:(NSArray *)items
+                           width:(CGFloat)width
+                      completion:(void (^)(void))completion;
+
+#pragma mark - Cell preparation
+
+/**
+ * Optional block that turns an item into a view model for its cell, doing the expensive work --
+ * formatting, building attributed strings, measuring text -- away from cell configuration.
+ * Use with `cellApplyBlock`. See block signature above.
+ *
+ * View models are cached by item identifier (see -identifierForItem:) and discarded
+ * along with cached sizes when items are inserted, reloaded or replaced; see `sizeCache`.
+ * Items about to be displayed are prepared on a background queue: on iOS 10 and later,
+ * the data source becomes its view's `prefetchDataSource` while this block is set.
+ * Any item displayed before its view model is ready is prepared on the main thread.
+ * SSCoreDataSource always prepares items on the main thread, as managed objects
+ * may only be used on their context's queue.
+ */
+@property (nonatomic, copy) SSItemPrepareBlock itemPrepareBlock;
+
+/**
+ * Optional block called to configure each cell with its item's view model, before `cellConfigureBlock`.
+ * It runs on the main thread as cells are displayed, so keep it to assigning properties.
+ */
+@property (nonatomic, copy) SSCellApplyBlock cellApplyBlock;
+
+/**
+ * Maximum number of prepared view models to keep. Defaults to 0, meaning no limit,
+ * though view models may still be discarded when memory is low.
+ */
+@property (nonatomic, assign) NSUInteger maximumNumberOfPreparedViewModels;
+
+/**
+ *  Return the view model for an item, prepared with `itemPrepareBlock` now if it isn't cached.
+ *
+ *  @param indexPath index path of the item
+ *
+ *  @return the view model, or nil if there is no item or `itemPrepareBlock`
+ */
+- (id) preparedViewModelForItemAtIndexPath:(NSIndexPath *)indexPath;
+
+/**
+ *  Prepare view models with `itemPrepareBlock` on a background queue, so they are cached
+ *  before the cells are displayed. Items that already have a view model are skipped.
+ *  Called for you with items the table or collection view is about to display.
+ *
+ *  If any view models are discarded before these are ready, these are discarded too,
+ *  as they may describe old contents.
+ *
+ *  SSCoreDataSource prepares the view models later on the main thread instead,
+ *  as its managed objects may not be used on a background queue.
+ *
+ *  @param indexPaths index paths of items to prepare
+ *  @param completion optional block called on the main thread once the view models are cached
+ */
+- (void) prepareViewModelsForItemsAtIndexPaths:(NSArray *)indexPaths
+                                    completion:(void (^)(void))completion;
+
+#pragma mark - Prefetching
+
+/**
+ * Optional block called with items whose cells are likely to be displayed soon,
+ * so that their images or other data can be loaded ahead of time. See block signature above.
+ *
+ * On iOS 10 and later, the data source becomes the `prefetchDataSource` of its
+ * table or collection view while this block is set. Items are matched by identifier
+ * (see -identifierForItem:), so an item already being prefetched is not prefetched again
+ * until its cell is displayed or its prefetch is cancelled.
+ */
+@property (nonatomic, copy) SSItemPrefetchBlock itemPrefetchBlock;
+
+/**
+ * Optional block called when an item being prefetched is no longer expected to be displayed,
+ * e.g. because the user scrolled back the other way, or because it was removed or reloaded.
+ * See block signature above. Not called for items whose cells have been displayed.
+ */
+@property (nonatomic, copy) SSItemCancelPrefetchBlock itemCancelPrefetchBlock;
+
+/**
+ *  Prefetch the items at the specified index paths. Called for you by
+ *  the table or collection view on iOS 10 and later.
+ *
+ *  @param indexPaths index paths of items to prefetch
+ */
+- (void) prefetchItemsAtIndexPaths:(NSArray *)indexPaths;
+
+/**
+ *  Cancel prefetching the items at the specified index paths. Called for you by
+ *  the table or collection view on iOS 10 and later.
+ *
+ *  @param indexPaths index paths of items no longer expected to be displayed
+ */
+- (void) cancelPrefetchingItemsAtIndexPaths:(NSArray *)indexPaths;
+
+#pragma mark - Metrics
+
+/**
+ * Optional: assign a metrics object to record how long this data source spends
+ * creating and configuring cells, showing its empty view and updating its table or collection view,
+ * along with cell dequeue misses and the size of each batch update.
+ * Several data sources may share one metrics object.
+ *
+ * Defaults to nil, in which case nothing is recorded.
+ */
+@property (nonatomic, strong) SSDataSourceMetrics *metrics;
+
+#pragma mark - Observers
+
+/**
+ *  Add an object to be told about changes to the data source's items.
+ *  Used by data sources that present another data source's items, such as SSFilteredDataSource.
+ *  Observers are not retained.
+ *
+ *  @param observer the observer to add
+ */
+- (void) addObserver:(id <SSDataSourceObserver>)observer;
+
+/**
+ *  Stop telling an object about changes to the data source's items.
+ *
+ *  @param observer the observer to remove
+ */
+- (void) removeObserver:(id <SSDataSourceObserver>)observer;
+
 #pragma mark - UITableView
 
 /**
@@ -213,6 +525,26 @@ typedef void (^SSTableCellDeletionBlock)
 
 #pragma mark - Base tableView/collectionView operations
 
+/**
+ * Animating a very large number of changes is much slower than reloading.
+ * If a single operation, diff or transaction changes more than this many rows and sections,
+ * the affected sections (or the entire table or collection view) are reloaded instead.
+ *
+ * Defaults to 0, which means changes are always animated.
+ */
+@property (nonatomic, assign) NSUInteger maximumAnimatedChangeCount;
+
+/**
+ *  Whether the specified number of changes should be applied by reloading
+ *  rather than animating. See `maximumAnimatedChangeCount`.
+ *  You probably don't need to call this directly.
+ *
+ *  @param changeCount number of rows and sections to change
+ *
+ *  @return YES if the changes should be reloaded
+ */
+- (BOOL) exceedsMaximumAnimatedChangeCount:(NSUInteger)changeCount;
+
 /**
  *  Insert the specified cells. You probably don't need to call this directly.
  *
@@ -234,6 +566,34 @@ typedef void (^SSTableCellDeletionBlock)
  */
 - (void) reloadCellsAtIndexPaths:(NSArray *)indexPaths;
 
+/**
+ *  Insert cells at the specified rows in a single section.
+ *  Index paths are only created if the cells are animated individually.
+ *  You probably don't need to call this directly.
+ *
+ *  @param indexes rows to insert
+ *  @param section section containing the rows
+ */
+- (void) insertCellsAtIndexes:(NSIndexSet *)indexes inSection:(NSInteger)section;
+
+/**
+ *  Delete cells at the specified rows in a single section.
+ *  You probably don't need to call this directly.
+ *
+ *  @param indexes rows to delete
+ *  @param section section containing the rows
+ */
+- (void) deleteCellsAtIndexes:(NSIndexSet *)indexes inSection:(NSInteger)section;
+
+/**
+ *  Reload cells at the specified rows in a single section.
+ *  You probably don't need to call this directly.
+ *
+ *  @param indexes rows to reload
+ *  @param section section containing the rows
+ */
+- (void) reloadCellsAtIndexes:(NSIndexSet *)indexes inSection:(NSInteger)section;
+
 /**
  *  Move a cell to another index path. You probably don't need to call this directly.
  *
@@ -276,4 +636,74 @@ typedef void (^SSTableCellDeletionBlock)
  */
 - (void) reloadData;
 
+/**
+ *  Perform a group of the above operations as a single animated batch update
+ *  on the table or collection view. The block is always called exactly once,
+ *  even if no table or collection view is assigned.
+ *  You probably don't need to call this directly.
+ *
+ *  @param updates block in which to insert, delete, reload and move cells and sections
+ */
+- (void) performBatchUpdates:(void (^)(void))updates;
+
+#pragma mark - Transactions
+
+/**
+ *  Group any number of changes to the data source into a single animated update.
+ *  Within the `updates` block, insert, remove, replace and move items and sections as usual.
+ *  Rather than updating the table or collection view as each change is made,
+ *  the changes are merged and applied in one batch update when the block returns,
+ *  and the empty view is updated once at the end.
+ *
+ *  Transactions may be nested; changes are applied when the outermost block returns.
+ *
+ *  @param updates    block in which to modify the data source
+ *  @param completion optional block called once the changes have been applied.
+ *                    For collection views, it is called when the batch animation completes.
+ */
+- (void) performUpdates:(void (^)(void))updates
+             completion:(void (^)(BOOL finished))completion;
+
+@end
+
+#pragma mark - SSDataSourceObserver
+
+/**
+ * Observers are told about each change to a data source's items after it has been made,
+ * with the same index paths and indexes sent to its table or collection view.
+ *
+ * Changes made in a batch update or transaction are reported together as a single
+ * -dataSource:didApplyChanges: once the update has been applied. Calls to -reloadData,
+ * including any made within a batch update, are reported as -dataSourceDidReloadData:.
+ */
+
+@protocol SSDataSourceObserver <NSObject>
+
+- (void) dataSource:(SSBaseDataSource *)dataSource didInsertItemsAtIndexPaths:(NSArray *)indexPaths;
+- (void) dataSource:(SSBaseDataSource *)dataSource didDeleteItemsAtIndexPaths:(NSArray *)indexPaths;
+- (void) dataSource:(SSBaseDataSource *)dataSource didReloadItemsAtIndexPaths:(NSArray *)indexPaths;
+- (void) dataSource:(SSBaseDataSource *)dataSource
+ didMoveItemAtIndexPath:(NSIndexPath *)fromIndexPath
+            toIndexPath:(NSIndexPath *)toIndexPath;
+
+- (void) dataSource:(SSBaseDataSource *)dataSource didInsertSections:(NSIndexSet *)sections;
+- (void) dataSource:(SSBaseDataSource *)dataSource didDeleteSections:(NSIndexSet *)sections;
+- (void) dataSource:(SSBaseDataSource *)dataSource didReloadSections:(NSIndexSet *)sections;
+- (void) dataSource:(SSBaseDataSource *)dataSource
+     didMoveSection:(NSUInteger)fromSection
+          toSection:(NSUInteger)toSection;
+
+/**
+ *  Called once a batch update or transaction has been applied.
+ *
+ *  @param dataSource the data source that changed
+ *  @param changes    every change in the update. As in a UITableView batch update,
+ *                    deleted, reloaded and moved-from sections and index paths refer to
+ *                    the contents before the update; inserted and moved-to ones refer to
+ *                    the contents after it.
+ */
+- (void) dataSource:(SSBaseDataSource *)dataSource didApplyChanges:(SSSectionedDiff *)changes;
+
+- (void) dataSourceDidReloadData:(SSBaseDataSource *)dataSource;
+
 @end
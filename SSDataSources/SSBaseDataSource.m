@@ -12,9 +12,144 @@
 
 @property (nonatomic, assign) UITableViewCellSeparatorStyle cachedSeparatorStyle;
 
+// Item identifier -> first NSIndexPath holding an item with that identifier.
+// nil until first needed. Entries before `itemIndexWatermark` are known to be current;
+// entries at or after it are re-indexed on the next lookup.
+@property (nonatomic, strong) NSMapTable *itemIndex;
+@property (nonatomic, strong) NSIndexPath *itemIndexWatermark;
+
+// Records changes made within -performUpdates:completion:.
+@property (nonatomic, strong) SSDataSourceChangeset *changeset;
+@property (nonatomic, strong) NSMutableArray *changesetCompletionBlocks;
+
+// Depth of nested -performBatchUpdates: calls in progress.
+@property (nonatomic, assign) NSUInteger batchUpdateDepth;
+
+// Serial queue on which diffs are computed in the background; created when first needed.
+@property (nonatomic, strong) dispatch_queue_t diffQueue;
+
+// Incremented for each background diff request, superseding any still in flight.
+// Only read and written on the main queue.
+@property (nonatomic, assign) NSUInteger updateGeneration;
+
+// Incremented whenever the contents change, so a background diff can tell whether
+// its starting snapshot is still current.
+@property (nonatomic, assign) NSUInteger mutationCount;
+
+// Weak references to SSDataSourceObservers. nil until an observer is added.
+@property (nonatomic, strong) NSHashTable *observers;
+
+// Set when changes are made in a batch update or transaction, which observers
+// hear about together once it has been applied, or as a reload if it reloaded.
+@property (nonatomic, assign) BOOL observersNeedReload;
+
+// Each section's items as of `snapshotMutationCount`, shared with the snapshots handed out.
+// nil until the first snapshot is taken.
+@property (nonatomic, copy) NSArray *snapshotSections;
+@property (nonatomic, assign) NSUInteger snapshotMutationCount;
+
+// Set while a transaction is applied if the snapshot was current when it began,
+// so the snapshot can be brought up to date from the changes it recorded.
+@property (nonatomic, assign) BOOL transactionStartedFromSnapshot;
+
+@property (nonatomic, strong, readwrite) SSItemSizeCache *sizeCache;
+
+// Serial queue on which sizes are precomputed; created when first needed.
+@property (nonatomic, strong) dispatch_queue_t sizingQueue;
+
+// Item identifier -> @[ item, object returned by `itemPrefetchBlock` (or NSNull) ] for items being prefetched.
+@property (nonatomic, strong) NSMapTable *prefetchingItems;
+
+// Item identifier -> view model returned by `itemPrepareBlock`. nil until first needed.
+@property (nonatomic, strong) NSCache *preparedViewModels;
+
+// Incremented whenever view models are discarded, so that view models prepared
+// in the background can tell whether the items they describe are still current.
+@property (nonatomic, assign) NSUInteger preparedViewModelInvalidationCount;
+
+// Identifiers of the items whose view models are being prepared in the background.
+@property (nonatomic, strong) NSCountedSet *preparingIdentifiers;
+
+// Serial queue on which view models are prepared; created when first needed.
+@property (nonatomic, strong) dispatch_queue_t preparationQueue;
+
+// Cells returned while `metrics` is set, to tell newly created cells from dequeued ones.
+@property (nonatomic, strong) NSHashTable *metricsKnownCells;
+
+// Rows and sections changed so far by the outermost batch update in progress.
+@property (nonatomic, assign) NSUInteger batchUpdateChangeCount;
+
+// Changes sent to the views so far by the outermost batch update in progress,
+// or nil if none is in progress or it reloaded the views outright.
+@property (nonatomic, strong) SSSectionedDiff *batchChanges;
+
 - (void) _updateEmptyView;
+- (void) _updateEmptyViewVisibility;
+- (void) _performBatchUpdates:(void (^)(void))updates completion:(void (^)(BOOL finished))completion;
+- (void) _applyChangeset:(SSDataSourceChangeset *)changeset completion:(void (^)(BOOL finished))completion;
+- (void) _applyDiffToViews:(SSSectionedDiff *)diff;
+- (BOOL) _isPerformingUpdates;
+- (SSDataSourceMetrics *) _beginViewUpdateWithChangeCount:(NSUInteger)changeCount;
+- (void) _didApplyChanges:(SSSectionedDiff *)changes;
+- (BOOL) _shouldReloadSectionInsteadOfAnimatingIndexes:(NSIndexSet *)indexes;
+- (void) _performBackgroundDiff:(id (^)(void))diffBlock
+                          apply:(BOOL (^)(id diff))applyBlock
+                          retry:(void (^)(void))retryBlock
+                     completion:(void (^)(BOOL finished))completion;
+- (void) _cancelBackgroundDiffs;
+- (void) _updateItemIndex;
+- (BOOL) _itemAtIndexPath:(NSIndexPath *)indexPath hasIdentifier:(id)identifier;
+- (void) _invalidateItemIndexFromIndexPaths:(NSArray *)indexPaths;
+- (SSPersistentArray *) _snapshotItemsInSection:(NSUInteger)section;
+- (NSArray *) _itemsInSection:(NSUInteger)section;
+- (void) _updateSnapshotWithBlock:(BOOL (^)(NSMutableArray *sections))block;
+- (void) _updateSnapshotWithChanges:(SSSectionedDiff *)changes;
+- (BOOL) _isSnapshotCurrent;
+- (void) _invalidateSnapshot;
+- (void) _invalidateSizesForItemsInSections:(NSIndexSet *)sections;
+- (BOOL) _hasCachedData;
+- (void) _removeCachedDataForIdentifier:(id)identifier;
+- (void) _removeCachedDataForItems:(NSArray *)items;
+- (void) _removeAllCachedData;
+- (BOOL) _canAccessItemsInBackground;
+- (id) _preparedViewModelForItem:(id)item;
+- (void) _updatePrefetchDataSources;
+- (BOOL) _wantsPrefetching;
+- (void) _finishPrefetchingItem:(id)item;
+- (void) _cancelPrefetchingItemWithIdentifier:(id)identifier;
+- (void) _cancelAllPrefetching;
+- (BOOL) _isValidIndexPath:(NSIndexPath *)indexPath;
+- (void) _reconfigureCellAtIndexPath:(NSIndexPath *)indexPath;
+- (void) _recordCell:(id)cell createdSince:(CFTimeInterval)startTime;
+- (void) _notifyObservers:(void (^)(id <SSDataSourceObserver> observer))block;
+- (void) _notifyObserversOfPendingReload;
+- (void) _notifyObserversOfChanges:(SSSectionedDiff *)changes;
+
+@end
+
+// Recording batch updates, implemented by SSSectionedDiff
+@interface SSSectionedDiff ()
+
++ (instancetype) batchUpdateDiff;
 
+- (void) insertRowsAtIndexPaths:(NSArray *)indexPaths;
+- (void) deleteRowsAtIndexPaths:(NSArray *)indexPaths;
+- (void) reloadRowsAtIndexPaths:(NSArray *)indexPaths;
+- (void) moveRowAtIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath;
+
+- (void) insertSections:(NSIndexSet *)sections;
+- (void) deleteSections:(NSIndexSet *)sections;
+- (void) reloadSections:(NSIndexSet *)sections;
+- (void) moveSection:(NSUInteger)fromSection toSection:(NSUInteger)toSection;
+
+- (void) addChangesFromDiff:(SSSectionedDiff *)diff;
+
+@end
+
+#if __IPHONE_OS_VERSION_MAX_ALLOWED >= 100000
+@interface SSBaseDataSource () <UITableViewDataSourcePrefetching, UICollectionViewDataSourcePrefetching>
 @end
+#endif
 
 @implementation SSBaseDataSource
 
@@ -26,6 +161,7 @@
         self.collectionViewSupplementaryElementClass = [SSBaseCollectionReusableView class];
         self.rowAnimation = UITableViewRowAnimationAutomatic;
         self.cachedSeparatorStyle = UITableViewCellSeparatorStyleNone;
+        _sizeCache = [SSItemSizeCache new];
     }
     
     return self;
@@ -43,6 +179,18 @@
     self.collectionSupplementaryCreationBlock = nil;
     self.tableActionBlock = nil;
     self.tableDeletionBlock = nil;
+    self.itemIdentifierBlock = nil;
+    self.itemEqualityBlock = nil;
+    self.itemSizeBlock = nil;
+    self.itemPrefetchBlock = nil;
+    self.itemCancelPrefetchBlock = nil;
+    self.itemPrepareBlock = nil;
+    self.cellApplyBlock = nil;
+    self.metrics = nil;
+    self.itemIndex = nil;
+    self.changeset = nil;
+    self.changesetCompletionBlocks = nil;
+    self.batchChanges = nil;
     self.tableView.dataSource = nil;
     self.collectionView.dataSource = nil;
 }
@@ -75,6 +223,10 @@
 }
 
 - (NSIndexPath *)indexPathForItem:(id)item {
+    if (self.maintainsItemIndex) {
+        return (item ? [self indexPathForItemWithIdentifier:[self identifierForItem:item]] : nil);
+    }
+    
     for (NSUInteger section = 0; section < [self numberOfSections]; section++) {
         for (NSUInteger row = 0; row < [self numberOfItemsInSection:section]; row++) {
             NSIndexPath *indexPath = [NSIndexPath indexPathForRow:row inSection:section];
@@ -88,308 +240,1904 @@
     return nil;
 }
 
-#pragma mark - Common
+#pragma mark - Item identity
 
-- (void)configureCell:(id)cell
-              forItem:(id)item
-           parentView:(id)parentView
-            indexPath:(NSIndexPath *)indexPath {
+- (void)setItemIdentifierBlock:(SSItemIdentifierBlock)itemIdentifierBlock {
+    _itemIdentifierBlock = [itemIdentifierBlock copy];
     
-    if (self.cellConfigureBlock) {
-        self.cellConfigureBlock(cell, item, parentView, indexPath);
-    }
+    [self invalidateItemIndexFromIndexPath:nil];
+    [self _removeAllCachedData];
 }
 
-- (void)setTableView:(UITableView *)tableView {
-    _tableView = tableView;
+- (void)setMaintainsItemIndex:(BOOL)maintainsItemIndex {
+    _maintainsItemIndex = maintainsItemIndex;
     
-    if (tableView) {
-        tableView.dataSource = self;
-    }
-
-    [self _updateEmptyView];
+    [self invalidateItemIndexFromIndexPath:nil];
 }
 
-- (void)setCollectionView:(UICollectionView *)collectionView {
-    _collectionView = collectionView;
+- (id)identifierForItem:(id)item {
+    if (!item) {
+        return nil;
+    }
     
-    if (collectionView) {
-        collectionView.dataSource = self;
+    id identifier = (self.itemIdentifierBlock ? self.itemIdentifierBlock(item) : nil);
+    
+    if (!identifier && [item isKindOfClass:[NSManagedObject class]]) {
+        identifier = [(NSManagedObject *)item objectID];
     }
-
-    [self _updateEmptyView];
-}
-
-#pragma mark - UITableViewDataSource
-
-- (UITableViewCell *)tableView:(UITableView *)tv
-         cellForRowAtIndexPath:(NSIndexPath *)indexPath {
-        
-    id item = [self itemAtIndexPath:indexPath];
     
-    id cell = (self.cellCreationBlock
-               ? self.cellCreationBlock(item, tv, indexPath)
-               : [self.cellClass cellForTableView:tv]);
-
-    [self configureCell:cell
-                forItem:item
-             parentView:tv
-              indexPath:indexPath];
-
-    return cell;
-}
-
-- (NSInteger)numberOfSectionsInTableView:(UITableView *)tableView {
-    return (NSInteger)[self numberOfSections];
-}
-
-- (NSInteger)tableView:(UITableView *)tableView numberOfRowsInSection:(NSInteger)section {
-    return (NSInteger)[self numberOfItemsInSection:section];
+    return (identifier ?: item);
 }
 
-- (BOOL)tableView:(UITableView *)tv canMoveRowAtIndexPath:(NSIndexPath *)indexPath {
+- (NSIndexPath *)indexPathForItemWithIdentifier:(id)identifier {
+    if (!identifier) {
+        return nil;
+    }
     
-    if (self.tableActionBlock) {
-        return self.tableActionBlock(SSCellActionTypeMove,
-                                     tv,
-                                     indexPath);
+    if (!self.maintainsItemIndex) {
+        for (NSUInteger section = 0; section < [self numberOfSections]; section++) {
+            for (NSUInteger row = 0; row < [self numberOfItemsInSection:section]; row++) {
+                NSIndexPath *indexPath = [NSIndexPath indexPathForRow:row inSection:section];
+                
+                if ([self _itemAtIndexPath:indexPath hasIdentifier:identifier]) {
+                    return indexPath;
+                }
+            }
+        }
+        
+        return nil;
     }
     
-    return NO;
-}
-
-- (BOOL)tableView:(UITableView *)tv canEditRowAtIndexPath:(NSIndexPath *)indexPath {
+    NSIndexPath *indexPath = [self.itemIndex objectForKey:identifier];
+    NSIndexPath *watermark = self.itemIndexWatermark;
     
-    if (self.tableActionBlock) {
-        return self.tableActionBlock(SSCellActionTypeEdit,
-                                     tv,
-                                     indexPath);
+    // Entries before the watermark are unaffected by any change since they were indexed.
+    if (!self.itemIndex
+        || (watermark && (!indexPath || [indexPath compare:watermark] != NSOrderedAscending))) {
+        [self _updateItemIndex];
+        
+        indexPath = [self.itemIndex objectForKey:identifier];
     }
     
-    return YES;
-}
-
-- (void)tableView:(UITableView *)tv
-commitEditingStyle:(UITableViewCellEditingStyle)editingStyle
-forRowAtIndexPath:(NSIndexPath *)indexPath {
+    if (!indexPath || [self _itemAtIndexPath:indexPath hasIdentifier:identifier]) {
+        return indexPath;
+    }
     
-    if (self.tableDeletionBlock) {
-        self.tableDeletionBlock(self,
-                                tv,
-                                indexPath);
+    if (watermark && [indexPath compare:watermark] != NSOrderedAscending) {
+        // A leftover entry for an item removed since it was indexed.
+        [self.itemIndex removeObjectForKey:identifier];
+        return nil;
     }
-}
-
-#pragma mark - UICollectionViewDataSource
-
-- (UICollectionViewCell *)collectionView:(UICollectionView *)cv
-                  cellForItemAtIndexPath:(NSIndexPath *)indexPath {
     
-    id item = [self itemAtIndexPath:indexPath];
+    // The index no longer matches the items, which were probably modified directly.
+    [self invalidateItemIndexFromIndexPath:nil];
+    [self _updateItemIndex];
     
-    id cell = (self.cellCreationBlock
-               ? self.cellCreationBlock(item, cv, indexPath)
-               : [self.cellClass cellForCollectionView:cv
-                                             indexPath:indexPath]);
-
-    [self configureCell:cell
-                forItem:item
-             parentView:cv
-              indexPath:indexPath];
-
-    return cell;
-}
-
-- (NSInteger)numberOfSectionsInCollectionView:(UICollectionView *)collectionView {
-    return (NSInteger)[self numberOfSections];
-}
-
-- (NSInteger)collectionView:(UICollectionView *)collectionView
-     numberOfItemsInSection:(NSInteger)section {
-  
-    return (NSInteger)[self numberOfItemsInSection:section];
+    return [self.itemIndex objectForKey:identifier];
 }
 
-- (UICollectionReusableView *)collectionView:(UICollectionView *)cv
-           viewForSupplementaryElementOfKind:(NSString *)kind
-                                 atIndexPath:(NSIndexPath *)indexPath {
-    
-    UICollectionReusableView *supplementaryView =
-        (self.collectionSupplementaryCreationBlock
-         ? self.collectionSupplementaryCreationBlock(kind, cv, indexPath)
-         : [self.collectionViewSupplementaryElementClass
-            supplementaryViewForCollectionView:cv
-            kind:kind
-            indexPath:indexPath]);
+- (void)invalidateItemIndexFromIndexPath:(NSIndexPath *)indexPath {
+    // Every change to the contents passes through here.
+    self.mutationCount++;
     
-    if (self.collectionSupplementaryConfigureBlock) {
-        self.collectionSupplementaryConfigureBlock(supplementaryView, kind, cv, indexPath);
+    if (!indexPath) {
+        self.itemIndex = nil;
+        self.itemIndexWatermark = nil;
+        return;
     }
     
-    return supplementaryView;
-}
-
-#pragma mark - Empty Views
-
-- (void)setEmptyView:(UIView *)emptyView {
-    if (self.emptyView) {
-        [self.emptyView removeFromSuperview];
+    if (!self.itemIndex) {
+        return;
     }
     
-    _emptyView = emptyView;
-    self.emptyView.hidden = YES;
+    NSIndexPath *watermark = self.itemIndexWatermark;
     
-    [self _updateEmptyView];
+    if (!watermark || [indexPath compare:watermark] == NSOrderedAscending) {
+        self.itemIndexWatermark = indexPath;
+    }
 }
 
-- (void)_updateEmptyView {
-    if (!self.emptyView) {
+- (void)_invalidateItemIndexFromIndexPaths:(NSArray *)indexPaths {
+    if (!self.itemIndex) {
+        self.mutationCount++;
         return;
     }
     
-    UITableView *tableView = self.tableView;
-    UICollectionView *collectionView = self.collectionView;
-    UIScrollView *targetView = (tableView ?: collectionView);
+    NSIndexPath *first = nil;
     
-    if (!targetView) {
-        return;
+    for (NSIndexPath *indexPath in indexPaths) {
+        if (!first || [indexPath compare:first] == NSOrderedAscending) {
+            first = indexPath;
+        }
     }
     
-    if (self.emptyView.superview != targetView) {
-        [targetView addSubview:self.emptyView];
+    if (first) {
+        [self invalidateItemIndexFromIndexPath:first];
+    }
+}
+
+- (BOOL)_itemAtIndexPath:(NSIndexPath *)indexPath hasIdentifier:(id)identifier {
+    if ((NSUInteger)indexPath.section >= [self numberOfSections]
+        || (NSUInteger)indexPath.row >= [self numberOfItemsInSection:indexPath.section]) {
+        return NO;
     }
     
-    BOOL shouldShowEmptyView = ([self numberOfItems] == 0);
-    BOOL isShowingEmptyView = !self.emptyView.hidden;
+    id itemIdentifier = [self identifierForItem:[self itemAtIndexPath:indexPath]];
     
-    if (shouldShowEmptyView) {
-        if (tableView.separatorStyle != UITableViewCellSeparatorStyleNone) {
-            self.cachedSeparatorStyle = tableView.separatorStyle;
-            tableView.separatorStyle = UITableViewCellSeparatorStyleNone;
-        }
-    } else if (self.cachedSeparatorStyle != UITableViewCellSeparatorStyleNone) {
-        tableView.separatorStyle = self.cachedSeparatorStyle;
-    }
+    return (itemIdentifier == identifier || [itemIdentifier isEqual:identifier]);
+}
+
+- (void)_updateItemIndex {
+    NSIndexPath *watermark = self.itemIndexWatermark;
     
-    if (shouldShowEmptyView == isShowingEmptyView) {
+    if (self.itemIndex && !watermark) {
         return;
     }
     
-    if (CGRectEqualToRect(self.emptyView.frame, CGRectZero)) {
-        CGRect frame = UIEdgeInsetsInsetRect(targetView.bounds, targetView.contentInset);
-        
-        if (tableView.tableHeaderView) {
-            frame.size.height -= CGRectGetHeight(tableView.tableHeaderView.frame);
-        }
-        
-        [self.emptyView setFrame:frame];
-        self.emptyView.autoresizingMask = targetView.autoresizingMask;
+    // Start over if stale entries for removed items have piled up.
+    if (!self.itemIndex || [self.itemIndex count] > 2 * [self numberOfItems]) {
+        self.itemIndex = [NSMapTable strongToStrongObjectsMapTable];
+        watermark = [NSIndexPath indexPathForRow:0 inSection:0];
     }
     
-    self.emptyView.hidden = !shouldShowEmptyView;
+    NSMapTable *itemIndex = self.itemIndex;
+    NSMutableSet *indexedIdentifiers = [NSMutableSet set];
     
-    // Reloading seems to work around an awkward delay where the empty view
-    // is not immediately visible but the separator lines still are
-    if (shouldShowEmptyView) {
-        [tableView reloadData];
-        [collectionView reloadData];
+    for (NSUInteger section = (NSUInteger)watermark.section; section < [self numberOfSections]; section++) {
+        NSUInteger firstRow = (section == (NSUInteger)watermark.section ? (NSUInteger)watermark.row : 0);
+        
+        for (NSUInteger row = firstRow; row < [self numberOfItemsInSection:section]; row++) {
+            NSIndexPath *indexPath = [NSIndexPath indexPathForRow:row inSection:section];
+            id identifier = [self identifierForItem:[self itemAtIndexPath:indexPath]];
+            
+            if (!identifier || [indexedIdentifiers containsObject:identifier]) {
+                continue;
+            }
+            
+            // Keep an earlier, still-current position for a duplicate identifier.
+            NSIndexPath *existing = [itemIndex objectForKey:identifier];
+            
+            if (existing && [existing compare:watermark] == NSOrderedAscending) {
+                continue;
+            }
+            
+            [indexedIdentifiers addObject:identifier];
+            [itemIndex setObject:indexPath forKey:identifier];
+        }
     }
+    
+    self.itemIndexWatermark = nil;
 }
 
-#pragma mark - NSIndexPath helpers
+#pragma mark - Snapshots
 
-+ (NSArray *)indexPathArrayWithIndexSet:(NSIndexSet *)indexes
-                              inSection:(NSInteger)section {
+- (SSDataSourceSnapshot *)snapshot {
+    NSArray *sections = self.snapshotSections;
     
-    NSMutableArray *ret = [NSMutableArray array];
+    // Sections changed without telling us won't bump the mutation count; catch what we cheaply can.
+    if (![self _isSnapshotCurrent] || [sections count] != [self numberOfSections]) {
+        NSMutableArray *newSections = [NSMutableArray arrayWithCapacity:[self numberOfSections]];
     
-    [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
-        [ret addObject:[NSIndexPath indexPathForRow:(NSInteger)index inSection:section]];
-    }];
+        for (NSUInteger section = 0; section < [self numberOfSections]; section++) {
+            [newSections addObject:[self _snapshotItemsInSection:section]];
+        }
     
-    return ret;
+        sections = newSections;
+        self.snapshotSections = sections;
+        self.snapshotMutationCount = self.mutationCount;
+    }
+    
+    return [[SSDataSourceSnapshot alloc] initWithSections:sections];
 }
 
-+ (NSArray *)indexPathArrayWithRange:(NSRange)range
-                           inSection:(NSInteger)section {
+- (SSPersistentArray *)_snapshotItemsInSection:(NSUInteger)section {
+    NSArray *sectionItems = [self _itemsInSection:section];
     
-    return [self indexPathArrayWithIndexSet:[NSIndexSet indexSetWithIndexesInRange:range]
-                                  inSection:section];
+    if (sectionItems) {
+        return [[SSPersistentArray alloc] initWithArray:sectionItems];
+    }
+    
+    NSUInteger count = [self numberOfItemsInSection:(NSInteger)section];
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:count];
+    
+    for (NSUInteger row = 0; row < count; row++) {
+        id item = [self itemAtIndexPath:[NSIndexPath indexPathForRow:(NSInteger)row
+                                                            inSection:(NSInteger)section]];
+    
+        if (item) {
+            [items addObject:item];
+        }
+    }
+    
+    return [[SSPersistentArray alloc] initWithArray:items];
 }
 
-#pragma mark - UITableView/UICollectionView Operations
+- (NSArray *)_itemsInSection:(NSUInteger)section {
+    // Subclasses that keep a section's items in an array return it here,
+    // so snapshots needn't be built one row at a time.
+    return nil;
+}
 
-- (void)insertCellsAtIndexPaths:(NSArray *)indexPaths {
-    [self.tableView insertRowsAtIndexPaths:indexPaths
-                          withRowAnimation:self.rowAnimation];
+- (void)_updateSnapshotWithBlock:(BOOL (^)(NSMutableArray *))block {
+    // A snapshot can only be patched if this one change is all it's missing.
+    // Within a batch update, index paths don't describe the current items,
+    // so the snapshot is patched from all of the batch's changes once it ends.
+    if (!self.snapshotSections
+        || self.snapshotMutationCount + 1 != self.mutationCount
+        || self.batchUpdateDepth > 0) {
+        return;
+    }
     
-    [self.collectionView insertItemsAtIndexPaths:indexPaths];
+    NSMutableArray *sections = [self.snapshotSections mutableCopy];
     
-    [self _updateEmptyView];
+    if (block(sections)) {
+        self.snapshotSections = sections;
+        self.snapshotMutationCount = self.mutationCount;
+    } else {
+        self.snapshotSections = nil;
+    }
 }
 
-- (void)deleteCellsAtIndexPaths:(NSArray *)indexPaths {
-    [self.tableView deleteRowsAtIndexPaths:indexPaths
-                          withRowAnimation:self.rowAnimation];
-    
-    [self.collectionView deleteItemsAtIndexPaths:indexPaths];
-    
-    [self _updateEmptyView];
+- (BOOL)_isSnapshotCurrent {
+    return (self.snapshotSections && self.snapshotMutationCount == self.mutationCount);
 }
 
-- (void)reloadCellsAtIndexPaths:(NSArray *)indexPaths {
-    [self.tableView reloadRowsAtIndexPaths:indexPaths
+- (void)_invalidateSnapshot {
+    self.snapshotSections = nil;
+}
+
+- (void)_updateSnapshotWithChanges:(SSSectionedDiff *)changes {
+    NSArray *sections = self.snapshotSections;
+    NSUInteger sectionCount = [self numberOfSections];
+    
+    // Whatever happens below, the old sections no longer describe the contents.
+    self.snapshotSections = nil;
+    
+    if (![changes isValidFromSectionCount:[sections count] toSectionCount:sectionCount]) {
+        return;
+    }
+    
+    NSMutableArray *newSections = [NSMutableArray arrayWithCapacity:sectionCount];
+    
+    for (NSUInteger section = 0; section < sectionCount; section++) {
+        NSUInteger oldSection = [changes sectionBeforeChangesForSection:section];
+    
+        // Inserted and reloaded sections are copied from the contents.
+        if (oldSection == NSNotFound || [changes.reloadedSections containsIndex:oldSection]) {
+            [newSections addObject:[self _snapshotItemsInSection:section]];
+            continue;
+        }
+    
+        __block SSPersistentArray *items = sections[oldSection];
+        NSIndexSet *removed = [changes removedRowsInSection:oldSection];
+        NSIndexSet *added = [changes addedRowsInSection:section];
+        NSIndexSet *reloaded = [changes reloadedRowsInSection:oldSection];
+    
+        if (!removed && !added && !reloaded) {
+            [newSections addObject:items];
+            continue;
+        }
+    
+        if ([removed count] > 0 && [removed lastIndex] >= [items count]) {
+            return;
+        }
+    
+        [removed enumerateIndexesWithOptions:NSEnumerationReverse
+                                  usingBlock:^(NSUInteger row, BOOL *stop) {
+            items = [items arrayByRemovingObjectAtIndex:row];
+        }];
+    
+        NSMutableIndexSet *reloadedIndexes = [NSMutableIndexSet indexSet];
+    
+        [reloaded enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+            NSIndexPath *indexPath = [changes indexPathAfterChangesForIndexPath:
+                                      [NSIndexPath indexPathForRow:(NSInteger)row inSection:(NSInteger)oldSection]];
+    
+            if (indexPath) {
+                [reloadedIndexes addIndex:(NSUInteger)indexPath.row];
+            }
+        }];
+    
+        NSMutableIndexSet *changedRows = [reloadedIndexes mutableCopy];
+        __block BOOL updated = YES;
+    
+        [changedRows addIndexes:added];
+    
+        // In ascending order, every row before the one at hand is already in place.
+        [changedRows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+            BOOL isReload = [reloadedIndexes containsIndex:row];
+            id item = [self itemAtIndexPath:[NSIndexPath indexPathForRow:(NSInteger)row
+                                                               inSection:(NSInteger)section]];
+    
+            if (!item || row > [items count] || (isReload && row == [items count])) {
+                updated = NO;
+                *stop = YES;
+            } else if (isReload) {
+                items = [items arrayByReplacingObjectAtIndex:row withObject:item];
+            } else {
+                items = [items arrayByInsertingObject:item atIndex:row];
+            }
+        }];
+    
+        if (!updated || [items count] != [self numberOfItemsInSection:(NSInteger)section]) {
+            return;
+        }
+    
+        [newSections addObject:items];
+    }
+    
+    self.snapshotSections = newSections;
+    self.snapshotMutationCount = self.mutationCount;
+}
+
+#pragma mark - Item sizes
+
+- (CGSize)sizeForItemAtIndexPath:(NSIndexPath *)indexPath width:(CGFloat)width {
+    id item = [self itemAtIndexPath:indexPath];
+    id identifier = [self identifierForItem:item];
+    CGSize size = CGSizeZero;
+    
+    if ([self.sizeCache getSize:&size forIdentifier:identifier width:width]) {
+        return size;
+    }
+    
+    if (!item || !self.itemSizeBlock) {
+        return CGSizeZero;
+    }
+    
+    size = self.itemSizeBlock(item, width);
+    [self.sizeCache setSize:size forIdentifier:identifier width:width];
+    
+    return size;
+}
+
+- (void)setSize:(CGSize)size forItemAtIndexPath:(NSIndexPath *)indexPath width:(CGFloat)width {
+    [self.sizeCache setSize:size
+              forIdentifier:[self identifierForItem:[self itemAtIndexPath:indexPath]]
+                      width:width];
+}
+
+- (void)invalidateSizesForItemsAtIndexPaths:(NSArray *)indexPaths {
+    if (![self _hasCachedData]) {
+        return;
+    }
+    
+    for (NSIndexPath *indexPath in indexPaths) {
+        [self _removeCachedDataForIdentifier:[self identifierForItem:[self itemAtIndexPath:indexPath]]];
+    }
+}
+
+- (void)_invalidateSizesForItemsInSections:(NSIndexSet *)sections {
+    if (![self _hasCachedData]) {
+        return;
+    }
+    
+    [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop) {
+        if (section >= [self numberOfSections]) {
+            return;
+        }
+        
+        for (NSUInteger row = 0; row < [self numberOfItemsInSection:(NSInteger)section]; row++) {
+            NSIndexPath *indexPath = [NSIndexPath indexPathForRow:(NSInteger)row inSection:(NSInteger)section];
+            [self _removeCachedDataForIdentifier:[self identifierForItem:[self itemAtIndexPath:indexPath]]];
+        }
+    }];
+}
+
+- (BOOL)_hasCachedData {
+    return ([self.sizeCache count] > 0
+            || self.sizeCache.isMeasuring
+            || self.preparedViewModels != nil
+            || [self.prefetchingItems count] > 0);
+}
+
+- (void)_removeCachedDataForIdentifier:(id)identifier {
+    if (!identifier) {
+        return;
+    }
+    
+    [self.sizeCache removeSizesForIdentifier:identifier];
+    
+    // Only discarding a view model that exists, or is on its way, can make one stale.
+    if ([self.preparedViewModels objectForKey:identifier]) {
+        [self.preparedViewModels removeObjectForKey:identifier];
+        self.preparedViewModelInvalidationCount++;
+    } else if ([self.preparingIdentifiers containsObject:identifier]) {
+        self.preparedViewModelInvalidationCount++;
+    }
+    
+    // A prefetch started for a removed or changed item is of no further use.
+    [self _cancelPrefetchingItemWithIdentifier:identifier];
+}
+
+- (void)_removeCachedDataForItems:(NSArray *)items {
+    if (![self _hasCachedData]) {
+        return;
+    }
+    
+    for (id item in items) {
+        [self _removeCachedDataForIdentifier:[self identifierForItem:item]];
+    }
+}
+
+- (void)_removeAllCachedData {
+    [self.sizeCache removeAllSizes];
+    
+    if (self.preparedViewModels) {
+        [self.preparedViewModels removeAllObjects];
+        self.preparedViewModelInvalidationCount++;
+    }
+    
+    [self _cancelAllPrefetching];
+}
+
+- (BOOL)_canAccessItemsInBackground {
+    return YES;
+}
+
+- (void)precomputeSizesForItemsAtIndexPaths:(NSArray *)indexPaths
+                                      width:(CGFloat)width
+                                 completion:(void (^)(void))completion {
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:[indexPaths count]];
+    
+    for (NSIndexPath *indexPath in indexPaths) {
+        id item = [self itemAtIndexPath:indexPath];
+        
+        if (item) {
+            [items addObject:item];
+        }
+    }
+    
+    [self precomputeSizesForItems:items width:width completion:completion];
+}
+
+- (void)precomputeSizesForItems:(NSArray *)items
+                          width:(CGFloat)width
+                     completion:(void (^)(void))completion {
+    SSItemSizeBlock sizeBlock = self.itemSizeBlock;
+    NSMutableArray *itemsToMeasure = [NSMutableArray array];
+    NSMutableArray *identifiers = [NSMutableArray array];
+    
+    for (id item in items) {
+        id identifier = [self identifierForItem:item];
+        
+        if (!identifier || [self.sizeCache getSize:NULL forIdentifier:identifier width:width]) {
+            continue;
+        }
+        
+        [itemsToMeasure addObject:item];
+        [identifiers addObject:identifier];
+    }
+    
+    if (!sizeBlock || [itemsToMeasure count] == 0) {
+        if (completion) {
+            completion();
+        }
+        
+        return;
+    }
+    
+    if (!self.sizingQueue && [self _canAccessItemsInBackground]) {
+        self.sizingQueue = dispatch_queue_create("com.splinesoft.SSDataSources.sizing", DISPATCH_QUEUE_SERIAL);
+    }
+    
+    NSUInteger token = [self.sizeCache beginMeasuringIdentifiers:identifiers];
+    __weak SSBaseDataSource *weakSelf = self;
+    
+    dispatch_async(self.sizingQueue ?: dispatch_get_main_queue(), ^{
+        NSMutableArray *sizes = [NSMutableArray arrayWithCapacity:[itemsToMeasure count]];
+        
+        for (id item in itemsToMeasure) {
+            [sizes addObject:[NSValue valueWithCGSize:sizeBlock(item, width)]];
+        }
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            SSItemSizeCache *sizeCache = weakSelf.sizeCache;
+            
+            // Only items invalidated in the meantime may have changed since we measured them.
+            [identifiers enumerateObjectsUsingBlock:^(id identifier, NSUInteger idx, BOOL *stop) {
+                if ([sizeCache endMeasuringIdentifier:identifier token:token]) {
+                    [sizeCache setSize:[sizes[idx] CGSizeValue] forIdentifier:identifier width:width];
+                }
+            }];
+            
+            if (completion) {
+                completion();
+            }
+        });
+    });
+}
+
+#pragma mark - Cell preparation
+
+- (void)setItemPrepareBlock:(SSItemPrepareBlock)itemPrepareBlock {
+    _itemPrepareBlock = [itemPrepareBlock copy];
+    
+    if (itemPrepareBlock && !self.preparedViewModels) {
+        self.preparedViewModels = [NSCache new];
+        self.preparedViewModels.countLimit = self.maximumNumberOfPreparedViewModels;
+    } else if (!itemPrepareBlock) {
+        self.preparedViewModels = nil;
+    }
+    
+    [self.preparedViewModels removeAllObjects];
+    self.preparedViewModelInvalidationCount++;
+    
+    [self _updatePrefetchDataSources];
+}
+
+- (void)setMaximumNumberOfPreparedViewModels:(NSUInteger)maximumNumberOfPreparedViewModels {
+    _maximumNumberOfPreparedViewModels = maximumNumberOfPreparedViewModels;
+    
+    self.preparedViewModels.countLimit = maximumNumberOfPreparedViewModels;
+}
+
+- (id)preparedViewModelForItemAtIndexPath:(NSIndexPath *)indexPath {
+    return [self _preparedViewModelForItem:[self itemAtIndexPath:indexPath]];
+}
+
+- (id)_preparedViewModelForItem:(id)item {
+    id identifier = [self identifierForItem:item];
+    
+    if (!identifier || !self.itemPrepareBlock) {
+        return nil;
+    }
+    
+    id viewModel = [self.preparedViewModels objectForKey:identifier];
+    
+    if (!viewModel) {
+        viewModel = self.itemPrepareBlock(item);
+        
+        if (viewModel) {
+            [self.preparedViewModels setObject:viewModel forKey:identifier];
+        }
+    }
+    
+    return viewModel;
+}
+
+- (void)prepareViewModelsForItemsAtIndexPaths:(NSArray *)indexPaths
+                                   completion:(void (^)(void))completion {
+    SSItemPrepareBlock prepareBlock = self.itemPrepareBlock;
+    NSMutableArray *items = [NSMutableArray array];
+    NSMutableArray *identifiers = [NSMutableArray array];
+    
+    for (NSIndexPath *indexPath in indexPaths) {
+        if (!prepareBlock || ![self _isValidIndexPath:indexPath]) {
+            continue;
+        }
+        
+        id item = [self itemAtIndexPath:indexPath];
+        id identifier = [self identifierForItem:item];
+        
+        if (!identifier || [self.preparedViewModels objectForKey:identifier]) {
+            continue;
+        }
+        
+        [items addObject:item];
+        [identifiers addObject:identifier];
+    }
+    
+    if ([items count] == 0) {
+        if (completion) {
+            completion();
+        }
+        
+        return;
+    }
+    
+    if (!self.preparationQueue && [self _canAccessItemsInBackground]) {
+        self.preparationQueue = dispatch_queue_create("com.splinesoft.SSDataSources.preparation", DISPATCH_QUEUE_SERIAL);
+    }
+    
+    if (!self.preparingIdentifiers) {
+        self.preparingIdentifiers = [NSCountedSet set];
+    }
+    
+    for (id identifier in identifiers) {
+        [self.preparingIdentifiers addObject:identifier];
+    }
+    
+    NSUInteger invalidationCount = self.preparedViewModelInvalidationCount;
+    __weak SSBaseDataSource *weakSelf = self;
+    
+    dispatch_async(self.preparationQueue ?: dispatch_get_main_queue(), ^{
+        NSMutableArray *viewModels = [NSMutableArray arrayWithCapacity:[items count]];
+        
+        for (id item in items) {
+            [viewModels addObject:(prepareBlock(item) ?: [NSNull null])];
+        }
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            SSBaseDataSource *strongSelf = weakSelf;
+            
+            for (id identifier in identifiers) {
+                [strongSelf.preparingIdentifiers removeObject:identifier];
+            }
+            
+            // View models discarded in the meantime may belong to the items we prepared.
+            if (strongSelf && strongSelf.preparedViewModelInvalidationCount == invalidationCount) {
+                [identifiers enumerateObjectsUsingBlock:^(id identifier, NSUInteger idx, BOOL *stop) {
+                    if (viewModels[idx] != [NSNull null]) {
+                        [strongSelf.preparedViewModels setObject:viewModels[idx] forKey:identifier];
+                    }
+                }];
+            }
+            
+            if (completion) {
+                completion();
+            }
+        });
+    });
+}
+
+#pragma mark - Common
+
+- (void)configureCell:(id)cell
+              forItem:(id)item
+           parentView:(id)parentView
+            indexPath:(NSIndexPath *)indexPath {
+    
+    if (!self.cellConfigureBlock && !self.cellApplyBlock) {
+        return;
+    }
+    
+    SSDataSourceMetrics *metrics = self.metrics;
+    CFTimeInterval startTime = (metrics ? CACurrentMediaTime() : 0);
+    
+    if (self.cellApplyBlock) {
+        self.cellApplyBlock(cell, [self _preparedViewModelForItem:item], parentView, indexPath);
+    }
+    
+    if (self.cellConfigureBlock) {
+        self.cellConfigureBlock(cell, item, parentView, indexPath);
+    }
+    
+    if (!metrics) {
+        return;
+    }
+    
+    [metrics recordDuration:CACurrentMediaTime() - startTime
+                  forMetric:SSDataSourceMetricCellConfiguration
+                  cellClass:[cell class]];
+}
+
+- (void)_reconfigureCellAtIndexPath:(NSIndexPath *)indexPath {
+    id item = [self itemAtIndexPath:indexPath];
+    
+    // Moved cells aren't reloaded, so bring them up to date in place.
+    [self invalidateSizesForItemsAtIndexPaths:@[ indexPath ]];
+    
+    UITableViewCell *tableCell = [self.tableView cellForRowAtIndexPath:indexPath];
+    
+    if (tableCell) {
+        [self configureCell:tableCell forItem:item parentView:self.tableView indexPath:indexPath];
+    }
+    
+    UICollectionViewCell *collectionCell = [self.collectionView cellForItemAtIndexPath:indexPath];
+    
+    if (collectionCell) {
+        [self configureCell:collectionCell forItem:item parentView:self.collectionView indexPath:indexPath];
+    }
+}
+
+- (void)setTableView:(UITableView *)tableView {
+    _tableView = tableView;
+    
+    if (tableView) {
+        tableView.dataSource = self;
+    }
+
+    [self _updatePrefetchDataSources];
+    [self _updateEmptyView];
+}
+
+- (void)setCollectionView:(UICollectionView *)collectionView {
+    _collectionView = collectionView;
+    
+    if (collectionView) {
+        collectionView.dataSource = self;
+    }
+
+    [self _updatePrefetchDataSources];
+    [self _updateEmptyView];
+}
+
+#pragma mark - Prefetching
+
+- (void)setItemPrefetchBlock:(SSItemPrefetchBlock)itemPrefetchBlock {
+    _itemPrefetchBlock = [itemPrefetchBlock copy];
+    
+    [self _updatePrefetchDataSources];
+}
+
+- (void)_updatePrefetchDataSources {
+#if __IPHONE_OS_VERSION_MAX_ALLOWED >= 100000
+    id prefetchDataSource = ([self _wantsPrefetching] ? self : nil);
+    
+    if ([self.tableView respondsToSelector:@selector(setPrefetchDataSource:)]
+        && (prefetchDataSource || self.tableView.prefetchDataSource == self)) {
+        self.tableView.prefetchDataSource = prefetchDataSource;
+    }
+    
+    if ([self.collectionView respondsToSelector:@selector(setPrefetchDataSource:)]
+        && (prefetchDataSource || self.collectionView.prefetchDataSource == self)) {
+        self.collectionView.prefetchDataSource = prefetchDataSource;
+    }
+#endif
+}
+
+- (BOOL)_wantsPrefetching {
+    return (self.itemPrefetchBlock != nil || self.itemPrepareBlock != nil);
+}
+
+- (BOOL)_isValidIndexPath:(NSIndexPath *)indexPath {
+    return ((NSUInteger)indexPath.section < [self numberOfSections]
+            && (NSUInteger)indexPath.row < [self numberOfItemsInSection:indexPath.section]);
+}
+
+- (void)prefetchItemsAtIndexPaths:(NSArray *)indexPaths {
+    if (self.itemPrepareBlock) {
+        [self prepareViewModelsForItemsAtIndexPaths:indexPaths completion:nil];
+    }
+    
+    if (!self.itemPrefetchBlock) {
+        return;
+    }
+    
+    if (!self.prefetchingItems) {
+        self.prefetchingItems = [NSMapTable strongToStrongObjectsMapTable];
+    }
+    
+    for (NSIndexPath *indexPath in indexPaths) {
+        if (![self _isValidIndexPath:indexPath]) {
+            continue;
+        }
+        
+        id item = [self itemAtIndexPath:indexPath];
+        id identifier = [self identifierForItem:item];
+        
+        if (!identifier || [self.prefetchingItems objectForKey:identifier]) {
+            continue;
+        }
+        
+        id token = self.itemPrefetchBlock(item);
+        
+        [self.prefetchingItems setObject:@[ item, (token ?: [NSNull null]) ] forKey:identifier];
+    }
+}
+
+- (void)cancelPrefetchingItemsAtIndexPaths:(NSArray *)indexPaths {
+    if ([self.prefetchingItems count] == 0) {
+        return;
+    }
+    
+    for (NSIndexPath *indexPath in indexPaths) {
+        if (![self _isValidIndexPath:indexPath]) {
+            continue;
+        }
+        
+        [self _cancelPrefetchingItemWithIdentifier:[self identifierForItem:[self itemAtIndexPath:indexPath]]];
+    }
+}
+
+- (void)_cancelPrefetchingItemWithIdentifier:(id)identifier {
+    NSArray *prefetch = (identifier ? [self.prefetchingItems objectForKey:identifier] : nil);
+    
+    if (!prefetch) {
+        return;
+    }
+    
+    [self.prefetchingItems removeObjectForKey:identifier];
+    
+    if (self.itemCancelPrefetchBlock) {
+        id token = prefetch[1];
+        self.itemCancelPrefetchBlock(prefetch[0], (token == [NSNull null] ? nil : token));
+    }
+}
+
+- (void)_cancelAllPrefetching {
+    if ([self.prefetchingItems count] == 0) {
+        return;
+    }
+    
+    NSArray *identifiers = [[self.prefetchingItems keyEnumerator] allObjects];
+    
+    for (id identifier in identifiers) {
+        [self _cancelPrefetchingItemWithIdentifier:identifier];
+    }
+}
+
+- (void)_finishPrefetchingItem:(id)item {
+    // The cell is on screen, so its prefetch should no longer be cancelled.
+    id identifier = ([self.prefetchingItems count] > 0 ? [self identifierForItem:item] : nil);
+    
+    if (identifier) {
+        [self.prefetchingItems removeObjectForKey:identifier];
+    }
+}
+
+#pragma mark - Metrics
+
+- (void)setMetrics:(SSDataSourceMetrics *)metrics {
+    _metrics = metrics;
+    
+    self.metricsKnownCells = (metrics ? [NSHashTable weakObjectsHashTable] : nil);
+}
+
+- (void)_recordCell:(id)cell createdSince:(CFTimeInterval)startTime {
+    SSDataSourceMetrics *metrics = self.metrics;
+    
+    [metrics recordDuration:CACurrentMediaTime() - startTime
+                  forMetric:SSDataSourceMetricCellCreation
+                  cellClass:[cell class]];
+    [metrics incrementCounter:SSDataSourceMetricCellRequests by:1];
+    
+    // A cell we haven't returned before was just created rather than dequeued.
+    if (cell && ![self.metricsKnownCells containsObject:cell]) {
+        [self.metricsKnownCells addObject:cell];
+        [metrics incrementCounter:SSDataSourceMetricCellDequeueMisses by:1];
+    }
+}
+
+#pragma mark - Observers
+
+- (void)addObserver:(id<SSDataSourceObserver>)observer {
+    if (!self.observers) {
+        self.observers = [NSHashTable weakObjectsHashTable];
+    }
+    
+    [self.observers addObject:observer];
+}
+
+- (void)removeObserver:(id<SSDataSourceObserver>)observer {
+    [self.observers removeObject:observer];
+}
+
+- (void)_notifyObservers:(void (^)(id<SSDataSourceObserver>))block {
+    if ([self.observers count] == 0) {
+        return;
+    }
+    
+    if (self.batchUpdateDepth > 0) {
+        self.observersNeedReload = YES;
+        return;
+    }
+    
+    for (id <SSDataSourceObserver> observer in [self.observers allObjects]) {
+        block(observer);
+    }
+}
+
+- (void)_notifyObserversOfChanges:(SSSectionedDiff *)changes {
+    if (!self.observersNeedReload) {
+        return;
+    }
+    
+    self.observersNeedReload = NO;
+    
+    if (![changes hasChanges]) {
+        return;
+    }
+    
+    [self _notifyObservers:^(id<SSDataSourceObserver> observer) {
+        [observer dataSource:self didApplyChanges:changes];
+    }];
+}
+
+- (void)_notifyObserversOfPendingReload {
+    if (!self.observersNeedReload || self.batchUpdateDepth > 0 || self.changeset) {
+        return;
+    }
+    
+    self.observersNeedReload = NO;
+    
+    [self _notifyObservers:^(id<SSDataSourceObserver> observer) {
+        [observer dataSourceDidReloadData:self];
+    }];
+}
+
+#pragma mark - UITableViewDataSource
+
+- (UITableViewCell *)tableView:(UITableView *)tv
+         cellForRowAtIndexPath:(NSIndexPath *)indexPath {
+        
+    id item = [self itemAtIndexPath:indexPath];
+    
+    [self _finishPrefetchingItem:item];
+    
+    CFTimeInterval startTime = (self.metrics ? CACurrentMediaTime() : 0);
+    
+    id cell = (self.cellCreationBlock
+               ? self.cellCreationBlock(item, tv, indexPath)
+               : [self.cellClass cellForTableView:tv]);
+    
+    if (self.metrics) {
+        [self _recordCell:cell createdSince:startTime];
+    }
+
+    [self configureCell:cell
+                forItem:item
+             parentView:tv
+              indexPath:indexPath];
+
+    return cell;
+}
+
+- (NSInteger)numberOfSectionsInTableView:(UITableView *)tableView {
+    return (NSInteger)[self numberOfSections];
+}
+
+- (NSInteger)tableView:(UITableView *)tableView numberOfRowsInSection:(NSInteger)section {
+    return (NSInteger)[self numberOfItemsInSection:section];
+}
+
+- (BOOL)tableView:(UITableView *)tv canMoveRowAtIndexPath:(NSIndexPath *)indexPath {
+    
+    if (self.tableActionBlock) {
+        return self.tableActionBlock(SSCellActionTypeMove,
+                                     tv,
+                                     indexPath);
+    }
+    
+    return NO;
+}
+
+- (BOOL)tableView:(UITableView *)tv canEditRowAtIndexPath:(NSIndexPath *)indexPath {
+    
+    if (self.tableActionBlock) {
+        return self.tableActionBlock(SSCellActionTypeEdit,
+                                     tv,
+                                     indexPath);
+    }
+    
+    return YES;
+}
+
+- (void)tableView:(UITableView *)tv
+commitEditingStyle:(UITableViewCellEditingStyle)editingStyle
+forRowAtIndexPath:(NSIndexPath *)indexPath {
+    
+    if (self.tableDeletionBlock) {
+        self.tableDeletionBlock(self,
+                                tv,
+                                indexPath);
+    }
+}
+
+#pragma mark - UICollectionViewDataSource
+
+- (UICollectionViewCell *)collectionView:(UICollectionView *)cv
+                  cellForItemAtIndexPath:(NSIndexPath *)indexPath {
+    
+    id item = [self itemAtIndexPath:indexPath];
+    
+    [self _finishPrefetchingItem:item];
+    
+    CFTimeInterval startTime = (self.metrics ? CACurrentMediaTime() : 0);
+    
+    id cell = (self.cellCreationBlock
+               ? self.cellCreationBlock(item, cv, indexPath)
+               : [self.cellClass cellForCollectionView:cv
+                                             indexPath:indexPath]);
+    
+    if (self.metrics) {
+        [self _recordCell:cell createdSince:startTime];
+    }
+
+    [self configureCell:cell
+                forItem:item
+             parentView:cv
+              indexPath:indexPath];
+
+    return cell;
+}
+
+- (NSInteger)numberOfSectionsInCollectionView:(UICollectionView *)collectionView {
+    return (NSInteger)[self numberOfSections];
+}
+
+- (NSInteger)collectionView:(UICollectionView *)collectionView
+     numberOfItemsInSection:(NSInteger)section {
+  
+    return (NSInteger)[self numberOfItemsInSection:section];
+}
+
+- (UICollectionReusableView *)collectionView:(UICollectionView *)cv
+           viewForSupplementaryElementOfKind:(NSString *)kind
+                                 atIndexPath:(NSIndexPath *)indexPath {
+    
+    UICollectionReusableView *supplementaryView =
+        (self.collectionSupplementaryCreationBlock
+         ? self.collectionSupplementaryCreationBlock(kind, cv, indexPath)
+         : [self.collectionViewSupplementaryElementClass
+            supplementaryViewForCollectionView:cv
+            kind:kind
+            indexPath:indexPath]);
+    
+    if (self.collectionSupplementaryConfigureBlock) {
+        SSDataSourceMetrics *metrics = self.metrics;
+        CFTimeInterval startTime = (metrics ? CACurrentMediaTime() : 0);
+        
+        self.collectionSupplementaryConfigureBlock(supplementaryView, kind, cv, indexPath);
+        
+        if (metrics) {
+            [metrics recordDuration:CACurrentMediaTime() - startTime
+                          forMetric:SSDataSourceMetricSupplementaryConfiguration
+                          cellClass:[supplementaryView class]];
+        }
+    }
+    
+    return supplementaryView;
+}
+
+#pragma mark - UITableViewDataSourcePrefetching
+
+- (void)tableView:(UITableView *)tableView prefetchRowsAtIndexPaths:(NSArray *)indexPaths {
+    [self prefetchItemsAtIndexPaths:indexPaths];
+}
+
+- (void)tableView:(UITableView *)tableView cancelPrefetchingForRowsAtIndexPaths:(NSArray *)indexPaths {
+    [self cancelPrefetchingItemsAtIndexPaths:indexPaths];
+}
+
+#pragma mark - UICollectionViewDataSourcePrefetching
+
+- (void)collectionView:(UICollectionView *)collectionView prefetchItemsAtIndexPaths:(NSArray *)indexPaths {
+    [self prefetchItemsAtIndexPaths:indexPaths];
+}
+
+- (void)collectionView:(UICollectionView *)collectionView cancelPrefetchingForItemsAtIndexPaths:(NSArray *)indexPaths {
+    [self cancelPrefetchingItemsAtIndexPaths:indexPaths];
+}
+
+#pragma mark - Empty Views
+
+- (void)setEmptyView:(UIView *)emptyView {
+    if (self.emptyView) {
+        [self.emptyView removeFromSuperview];
+    }
+    
+    _emptyView = emptyView;
+    self.emptyView.hidden = YES;
+    
+    [self _updateEmptyView];
+}
+
+- (void)_updateEmptyView {
+    // Batch updates update the empty view once they are done.
+    if (!self.emptyView || [self _isPerformingUpdates]) {
+        return;
+    }
+    
+    SSDataSourceMetrics *metrics = self.metrics;
+    
+    if (!metrics) {
+        [self _updateEmptyViewVisibility];
+        return;
+    }
+    
+    CFTimeInterval startTime = CACurrentMediaTime();
+    
+    [self _updateEmptyViewVisibility];
+    
+    [metrics recordDuration:CACurrentMediaTime() - startTime
+                  forMetric:SSDataSourceMetricEmptyViewUpdate
+                  cellClass:nil];
+}
+
+- (void)_updateEmptyViewVisibility {
+    UITableView *tableView = self.tableView;
+    UICollectionView *collectionView = self.collectionView;
+    UIScrollView *targetView = (tableView ?: collectionView);
+    
+    if (!targetView) {
+        return;
+    }
+    
+    if (self.emptyView.superview != targetView) {
+        [targetView addSubview:self.emptyView];
+    }
+    
+    BOOL shouldShowEmptyView = ([self numberOfItems] == 0);
+    BOOL isShowingEmptyView = !self.emptyView.hidden;
+    
+    if (shouldShowEmptyView) {
+        if (tableView.separatorStyle != UITableViewCellSeparatorStyleNone) {
+            self.cachedSeparatorStyle = tableView.separatorStyle;
+            tableView.separatorStyle = UITableViewCellSeparatorStyleNone;
+        }
+    } else if (self.cachedSeparatorStyle != UITableViewCellSeparatorStyleNone) {
+        tableView.separatorStyle = self.cachedSeparatorStyle;
+    }
+    
+    if (shouldShowEmptyView == isShowingEmptyView) {
+        return;
+    }
+    
+    if (CGRectEqualToRect(self.emptyView.frame, CGRectZero)) {
+        CGRect frame = UIEdgeInsetsInsetRect(targetView.bounds, targetView.contentInset);
+        
+        if (tableView.tableHeaderView) {
+            frame.size.height -= CGRectGetHeight(tableView.tableHeaderView.frame);
+        }
+        
+        [self.emptyView setFrame:frame];
+        self.emptyView.autoresizingMask = targetView.autoresizingMask;
+    }
+    
+    self.emptyView.hidden = !shouldShowEmptyView;
+    
+    // Reloading seems to work around an awkward delay where the empty view
+    // is not immediately visible but the separator lines still are
+    if (shouldShowEmptyView) {
+        [tableView reloadData];
+        [collectionView reloadData];
+    }
+}
+
+#pragma mark - NSIndexPath helpers
+
++ (NSArray *)indexPathArrayWithIndexSet:(NSIndexSet *)indexes
+                              inSection:(NSInteger)section {
+    
+    NSMutableArray *ret = [NSMutableArray array];
+    
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        [ret addObject:[NSIndexPath indexPathForRow:(NSInteger)index inSection:section]];
+    }];
+    
+    return ret;
+}
+
++ (NSArray *)indexPathArrayWithRange:(NSRange)range
+                           inSection:(NSInteger)section {
+    
+    return [self indexPathArrayWithIndexSet:[NSIndexSet indexSetWithIndexesInRange:range]
+                                  inSection:section];
+}
+
+#pragma mark - UITableView/UICollectionView Operations
+
+- (void)insertCellsAtIndexPaths:(NSArray *)indexPaths {
+    [self _invalidateItemIndexFromIndexPaths:indexPaths];
+    [self invalidateSizesForItemsAtIndexPaths:indexPaths];
+    
+    if (self.changeset) {
+        [self.changeset insertRowsAtIndexPaths:indexPaths];
+        return;
+    }
+    
+    [self.batchChanges insertRowsAtIndexPaths:indexPaths];
+    
+    [self _updateSnapshotWithBlock:^BOOL(NSMutableArray *sections) {
+        for (NSIndexPath *indexPath in [indexPaths sortedArrayUsingSelector:@selector(compare:)]) {
+            SSPersistentArray *items = ((NSUInteger)indexPath.section < [sections count]
+                                        ? sections[(NSUInteger)indexPath.section]
+                                        : nil);
+            id item = [self itemAtIndexPath:indexPath];
+    
+            if (!item || (NSUInteger)indexPath.row > [items count]) {
+                return NO;
+            }
+    
+            sections[(NSUInteger)indexPath.section] = [items arrayByInsertingObject:item
+                                                                            atIndex:(NSUInteger)indexPath.row];
+        }
+    
+        return YES;
+    }];
+    
+    SSDataSourceMetrics *metrics = [self _beginViewUpdateWithChangeCount:[indexPaths count]];
+    
+    [self.tableView insertRowsAtIndexPaths:indexPaths
+                          withRowAnimation:self.rowAnimation];
+    
+    [self.collectionView insertItemsAtIndexPaths:indexPaths];
+    
+    [metrics endUpdateWithChangeCount:[indexPaths count]];
+    
+    [self _notifyObservers:^(id<SSDataSourceObserver> observer) {
+        [observer dataSource:self didInsertItemsAtIndexPaths:indexPaths];
+    }];
+    
+    [self _updateEmptyView];
+}
+
+- (void)deleteCellsAtIndexPaths:(NSArray *)indexPaths {
+    [self _invalidateItemIndexFromIndexPaths:indexPaths];
+    
+    if (self.changeset) {
+        [self.changeset deleteRowsAtIndexPaths:indexPaths];
+        return;
+    }
+    
+    [self.batchChanges deleteRowsAtIndexPaths:indexPaths];
+    
+    [self _updateSnapshotWithBlock:^BOOL(NSMutableArray *sections) {
+        for (NSIndexPath *indexPath in [[indexPaths sortedArrayUsingSelector:@selector(compare:)] reverseObjectEnumerator]) {
+            SSPersistentArray *items = ((NSUInteger)indexPath.section < [sections count]
+                                        ? sections[(NSUInteger)indexPath.section]
+                                        : nil);
+    
+            if ((NSUInteger)indexPath.row >= [items count]) {
+                return NO;
+            }
+    
+            sections[(NSUInteger)indexPath.section] = [items arrayByRemovingObjectAtIndex:(NSUInteger)indexPath.row];
+        }
+    
+        return YES;
+    }];
+    
+    SSDataSourceMetrics *metrics = [self _beginViewUpdateWithChangeCount:[indexPaths count]];
+    
+    [self.tableView deleteRowsAtIndexPaths:indexPaths
+                          withRowAnimation:self.rowAnimation];
+    
+    [self.collectionView deleteItemsAtIndexPaths:indexPaths];
+    
+    [metrics endUpdateWithChangeCount:[indexPaths count]];
+    
+    [self _notifyObservers:^(id<SSDataSourceObserver> observer) {
+        [observer dataSource:self didDeleteItemsAtIndexPaths:indexPaths];
+    }];
+    
+    [self _updateEmptyView];
+}
+
+- (void)reloadCellsAtIndexPaths:(NSArray *)indexPaths {
+    [self _invalidateItemIndexFromIndexPaths:indexPaths];
+    
+    // Within a batch update these are the rows' old index paths,
+    // so whoever changed the items is responsible for their sizes.
+    if (self.batchUpdateDepth == 0) {
+        [self invalidateSizesForItemsAtIndexPaths:indexPaths];
+    }
+    
+    if (self.changeset) {
+        [self.changeset reloadRowsAtIndexPaths:indexPaths];
+        return;
+    }
+    
+    [self.batchChanges reloadRowsAtIndexPaths:indexPaths];
+    
+    [self _updateSnapshotWithBlock:^BOOL(NSMutableArray *sections) {
+        for (NSIndexPath *indexPath in indexPaths) {
+            SSPersistentArray *items = ((NSUInteger)indexPath.section < [sections count]
+                                        ? sections[(NSUInteger)indexPath.section]
+                                        : nil);
+            id item = [self itemAtIndexPath:indexPath];
+    
+            if (!item || (NSUInteger)indexPath.row >= [items count]) {
+                return NO;
+            }
+    
+            sections[(NSUInteger)indexPath.section] = [items arrayByReplacingObjectAtIndex:(NSUInteger)indexPath.row
+                                                                                withObject:item];
+        }
+    
+        return YES;
+    }];
+    
+    SSDataSourceMetrics *metrics = [self _beginViewUpdateWithChangeCount:[indexPaths count]];
+    
+    [self.tableView reloadRowsAtIndexPaths:indexPaths
                           withRowAnimation:self.rowAnimation];
     
     [self.collectionView reloadItemsAtIndexPaths:indexPaths];
+    
+    [metrics endUpdateWithChangeCount:[indexPaths count]];
+    
+    [self _notifyObservers:^(id<SSDataSourceObserver> observer) {
+        [observer dataSource:self didReloadItemsAtIndexPaths:indexPaths];
+    }];
+}
+
+- (BOOL)exceedsMaximumAnimatedChangeCount:(NSUInteger)changeCount {
+    return (self.maximumAnimatedChangeCount > 0 && changeCount > self.maximumAnimatedChangeCount);
+}
+
+- (BOOL)_shouldReloadSectionInsteadOfAnimatingIndexes:(NSIndexSet *)indexes {
+    // Mixing section reloads with row changes in the same batch is an error,
+    // so within a batch update the rows are always animated.
+    return (self.batchUpdateDepth == 0
+            && [self exceedsMaximumAnimatedChangeCount:[indexes count]]);
+}
+
+- (void)insertCellsAtIndexes:(NSIndexSet *)indexes inSection:(NSInteger)section {
+    if ([indexes count] == 0) {
+        return;
+    }
+    
+    if (self.changeset) {
+        [self invalidateItemIndexFromIndexPath:[NSIndexPath indexPathForRow:(NSInteger)[indexes firstIndex]
+                                                                  inSection:section]];
+        if ([self _hasCachedData]) {
+            [self invalidateSizesForItemsAtIndexPaths:[self.class indexPathArrayWithIndexSet:indexes
+                                                                                   inSection:section]];
+        }
+        
+        [self.changeset insertRows:indexes inSection:(NSUInteger)section];
+        return;
+    }
+    
+    if ([self _shouldReloadSectionInsteadOfAnimatingIndexes:indexes]) {
+        [self reloadSectionsAtIndexes:[NSIndexSet indexSetWithIndex:(NSUInteger)section]];
+        [self _updateEmptyView];
+        return;
+    }
+    
+    [self insertCellsAtIndexPaths:[self.class indexPathArrayWithIndexSet:indexes
+                                                               inSection:section]];
+}
+
+- (void)deleteCellsAtIndexes:(NSIndexSet *)indexes inSection:(NSInteger)section {
+    if ([indexes count] == 0) {
+        return;
+    }
+    
+    if (self.changeset) {
+        [self invalidateItemIndexFromIndexPath:[NSIndexPath indexPathForRow:(NSInteger)[indexes firstIndex]
+                                                                  inSection:section]];
+        [self.changeset deleteRows:indexes inSection:(NSUInteger)section];
+        return;
+    }
+    
+    if ([self _shouldReloadSectionInsteadOfAnimatingIndexes:indexes]) {
+        [self reloadSectionsAtIndexes:[NSIndexSet indexSetWithIndex:(NSUInteger)section]];
+        [self _updateEmptyView];
+        return;
+    }
+    
+    [self deleteCellsAtIndexPaths:[self.class indexPathArrayWithIndexSet:indexes
+                                                               inSection:section]];
+}
+
+- (void)reloadCellsAtIndexes:(NSIndexSet *)indexes inSection:(NSInteger)section {
+    if ([indexes count] == 0) {
+        return;
+    }
+    
+    if (self.changeset) {
+        [self invalidateItemIndexFromIndexPath:[NSIndexPath indexPathForRow:(NSInteger)[indexes firstIndex]
+                                                                  inSection:section]];
+        if (self.batchUpdateDepth == 0 && [self _hasCachedData]) {
+            [self invalidateSizesForItemsAtIndexPaths:[self.class indexPathArrayWithIndexSet:indexes
+                                                                                   inSection:section]];
+        }
+        
+        [self.changeset reloadRows:indexes inSection:(NSUInteger)section];
+        return;
+    }
+    
+    if ([self _shouldReloadSectionInsteadOfAnimatingIndexes:indexes]) {
+        [self reloadSectionsAtIndexes:[NSIndexSet indexSetWithIndex:(NSUInteger)section]];
+        return;
+    }
+    
+    [self reloadCellsAtIndexPaths:[self.class indexPathArrayWithIndexSet:indexes
+                                                               inSection:section]];
 }
 
 - (void)moveCellAtIndexPath:(NSIndexPath *)index1 toIndexPath:(NSIndexPath *)index2 {
+    [self _invalidateItemIndexFromIndexPaths:@[ index1, index2 ]];
+    
+    if (self.changeset) {
+        [self.changeset moveRowAtIndexPath:index1 toIndexPath:index2];
+        return;
+    }
+    
+    [self.batchChanges moveRowAtIndexPath:index1 toIndexPath:index2];
+    
+    [self _updateSnapshotWithBlock:^BOOL(NSMutableArray *sections) {
+        NSUInteger fromSection = (NSUInteger)index1.section, toSection = (NSUInteger)index2.section;
+        id item = [self itemAtIndexPath:index2];
+    
+        if (!item
+            || fromSection >= [sections count] || toSection >= [sections count]
+            || (NSUInteger)index1.row >= [sections[fromSection] count]) {
+            return NO;
+        }
+    
+        sections[fromSection] = [sections[fromSection] arrayByRemovingObjectAtIndex:(NSUInteger)index1.row];
+    
+        if ((NSUInteger)index2.row > [sections[toSection] count]) {
+            return NO;
+        }
+    
+        sections[toSection] = [sections[toSection] arrayByInsertingObject:item
+                                                                  atIndex:(NSUInteger)index2.row];
+    
+        return YES;
+    }];
+    
+    SSDataSourceMetrics *metrics = [self _beginViewUpdateWithChangeCount:1];
+    
     [self.tableView moveRowAtIndexPath:index1
                            toIndexPath:index2];
     
     [self.collectionView moveItemAtIndexPath:index1
                                  toIndexPath:index2];
+    
+    [metrics endUpdateWithChangeCount:1];
+    
+    [self _notifyObservers:^(id<SSDataSourceObserver> observer) {
+        [observer dataSource:self didMoveItemAtIndexPath:index1 toIndexPath:index2];
+    }];
 }
 
 - (void)moveSectionAtIndex:(NSInteger)index1 toIndex:(NSInteger)index2 {
+    [self invalidateItemIndexFromIndexPath:[NSIndexPath indexPathForRow:0
+                                                              inSection:MIN(index1, index2)]];
+    
+    if (self.changeset) {
+        [self.changeset moveSection:(NSUInteger)index1 toSection:(NSUInteger)index2];
+        return;
+    }
+    
+    [self.batchChanges moveSection:(NSUInteger)index1 toSection:(NSUInteger)index2];
+    
+    [self _updateSnapshotWithBlock:^BOOL(NSMutableArray *sections) {
+        if ((NSUInteger)index1 >= [sections count] || (NSUInteger)index2 >= [sections count]) {
+            return NO;
+        }
+    
+        id items = sections[(NSUInteger)index1];
+    
+        [sections removeObjectAtIndex:(NSUInteger)index1];
+        [sections insertObject:items atIndex:(NSUInteger)index2];
+    
+        return YES;
+    }];
+    
+    SSDataSourceMetrics *metrics = [self _beginViewUpdateWithChangeCount:1];
+    
     [self.tableView moveSection:index1
                       toSection:index2];
     
     [self.collectionView moveSection:index1
                            toSection:index2];
+    
+    [metrics endUpdateWithChangeCount:1];
+    
+    [self _notifyObservers:^(id<SSDataSourceObserver> observer) {
+        [observer dataSource:self didMoveSection:(NSUInteger)index1 toSection:(NSUInteger)index2];
+    }];
 }
 
 - (void)insertSectionsAtIndexes:(NSIndexSet *)indexes {
+    if ([indexes count] > 0) {
+        [self invalidateItemIndexFromIndexPath:[NSIndexPath indexPathForRow:0
+                                                                  inSection:(NSInteger)[indexes firstIndex]]];
+    }
+    
+    if (self.changeset) {
+        [self.changeset insertSections:indexes];
+        return;
+    }
+    
+    [self.batchChanges insertSections:indexes];
+    
+    [self _updateSnapshotWithBlock:^BOOL(NSMutableArray *sections) {
+        __block BOOL updated = YES;
+    
+        [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+            if (index > [sections count]) {
+                updated = NO;
+                *stop = YES;
+                return;
+            }
+    
+            [sections insertObject:[self _snapshotItemsInSection:index] atIndex:index];
+        }];
+    
+        return updated;
+    }];
+    
+    SSDataSourceMetrics *metrics = [self _beginViewUpdateWithChangeCount:[indexes count]];
+    
     [self.tableView insertSections:indexes
                   withRowAnimation:self.rowAnimation];
     
     [self.collectionView insertSections:indexes];
     
+    [metrics endUpdateWithChangeCount:[indexes count]];
+    
+    [self _notifyObservers:^(id<SSDataSourceObserver> observer) {
+        [observer dataSource:self didInsertSections:indexes];
+    }];
+    
     [self _updateEmptyView];
 }
 
 - (void)deleteSectionsAtIndexes:(NSIndexSet *)indexes {
+    if ([indexes count] > 0) {
+        [self invalidateItemIndexFromIndexPath:[NSIndexPath indexPathForRow:0
+                                                                  inSection:(NSInteger)[indexes firstIndex]]];
+    }
+    
+    if (self.changeset) {
+        [self.changeset deleteSections:indexes];
+        return;
+    }
+    
+    [self.batchChanges deleteSections:indexes];
+    
+    [self _updateSnapshotWithBlock:^BOOL(NSMutableArray *sections) {
+        if ([indexes lastIndex] >= [sections count]) {
+            return NO;
+        }
+    
+        [sections removeObjectsAtIndexes:indexes];
+    
+        return YES;
+    }];
+    
+    SSDataSourceMetrics *metrics = [self _beginViewUpdateWithChangeCount:[indexes count]];
+    
     [self.tableView deleteSections:indexes
                   withRowAnimation:self.rowAnimation];
     
     [self.collectionView deleteSections:indexes];
     
+    [metrics endUpdateWithChangeCount:[indexes count]];
+    
+    [self _notifyObservers:^(id<SSDataSourceObserver> observer) {
+        [observer dataSource:self didDeleteSections:indexes];
+    }];
+    
     [self _updateEmptyView];
 }
 
 - (void)reloadSectionsAtIndexes:(NSIndexSet *)indexes {
+    if ([indexes count] > 0) {
+        [self invalidateItemIndexFromIndexPath:[NSIndexPath indexPathForRow:0
+                                                                  inSection:(NSInteger)[indexes firstIndex]]];
+    }
+    
+    if (self.batchUpdateDepth == 0) {
+        [self _invalidateSizesForItemsInSections:indexes];
+    } else {
+        [self _removeAllCachedData];
+    }
+    
+    if (self.changeset) {
+        [self.changeset reloadSections:indexes];
+        return;
+    }
+    
+    [self.batchChanges reloadSections:indexes];
+    
+    [self _updateSnapshotWithBlock:^BOOL(NSMutableArray *sections) {
+        if ([indexes lastIndex] >= [sections count]) {
+            return NO;
+        }
+    
+        [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+            sections[index] = [self _snapshotItemsInSection:index];
+        }];
+    
+        return YES;
+    }];
+    
+    SSDataSourceMetrics *metrics = [self _beginViewUpdateWithChangeCount:[indexes count]];
+    
     [self.tableView reloadSections:indexes
                   withRowAnimation:self.rowAnimation];
 
     [self.collectionView reloadSections:indexes];
+    
+    [metrics endUpdateWithChangeCount:[indexes count]];
+    
+    [self _notifyObservers:^(id<SSDataSourceObserver> observer) {
+        [observer dataSource:self didReloadSections:indexes];
+    }];
 }
 
 - (void)reloadData {
+    [self invalidateItemIndexFromIndexPath:nil];
+    [self _removeAllCachedData];
+    
+    if (self.changeset) {
+        [self.changeset reloadData];
+        return;
+    }
+    
+    // The batch in progress, if any, can no longer be described as a set of changes.
+    self.batchChanges = nil;
+    
+    SSDataSourceMetrics *metrics = self.metrics;
+    
+    [metrics beginUpdate];
     [self.tableView reloadData];
     [self.collectionView reloadData];
+    [metrics endUpdateWithChangeCount:NSNotFound];
+    
+    [self _notifyObservers:^(id<SSDataSourceObserver> observer) {
+        [observer dataSourceDidReloadData:self];
+    }];
+    
+    [self _updateEmptyView];
+}
+
+- (void)performBatchUpdates:(void (^)(void))updates {
+    SSDataSourceChangeset *changeset = self.changeset;
+    
+    if (changeset) {
+        self.batchUpdateDepth++;
+        [changeset beginBatchUpdates];
+        updates();
+        [changeset endBatchUpdates];
+        self.batchUpdateDepth--;
+        return;
+    }
+    
+    [self _performBatchUpdates:updates completion:nil];
+}
+
+- (void)_performBatchUpdates:(void (^)(void))updates completion:(void (^)(BOOL finished))completion {
+    UITableView *tableView = self.tableView;
+    UICollectionView *collectionView = self.collectionView;
+    BOOL isOutermost = (self.batchUpdateDepth == 0);
+    BOOL startedFromSnapshot = (self.transactionStartedFromSnapshot || [self _isSnapshotCurrent]);
+    
+    if (isOutermost) {
+        self.batchChanges = [SSSectionedDiff batchUpdateDiff];
+    }
+    
+    void (^tableUpdates)(void) = ^{
+        SSDataSourceMetrics *metrics = (self.batchUpdateDepth == 0 ? self.metrics : nil);
+        
+        if (metrics) {
+            self.batchUpdateChangeCount = 0;
+            [metrics beginUpdate];
+        }
+        
+        self.batchUpdateDepth++;
+        [tableView beginUpdates];
+        updates();
+        [tableView endUpdates];
+        self.batchUpdateDepth--;
+        
+        [metrics endUpdateWithChangeCount:self.batchUpdateChangeCount];
+    };
+    
+    if (collectionView) {
+        [collectionView performBatchUpdates:tableUpdates completion:completion];
+    } else {
+        tableUpdates();
+    }
+    
+    if (isOutermost) {
+        SSSectionedDiff *changes = self.batchChanges;
+        self.batchChanges = nil;
+        
+        if (changes) {
+            if (startedFromSnapshot) {
+                [self _updateSnapshotWithChanges:changes];
+            }
+            
+            [self _didApplyChanges:changes];
+            [self _notifyObserversOfChanges:changes];
+        }
+        
+        [self _notifyObserversOfPendingReload];
+        [self _updateEmptyView];
+    }
+    
+    if (!collectionView && completion) {
+        completion(YES);
+    }
+}
+
+- (BOOL)_isPerformingUpdates {
+    return (self.batchUpdateDepth > 0 || self.changeset != nil);
+}
+
+- (SSDataSourceMetrics *)_beginViewUpdateWithChangeCount:(NSUInteger)changeCount {
+    // Within a batch update, the change is measured as part of the batch.
+    if (self.batchUpdateDepth > 0) {
+        self.batchUpdateChangeCount += changeCount;
+        return nil;
+    }
+    
+    SSDataSourceMetrics *metrics = self.metrics;
+    
+    [metrics beginUpdate];
+    
+    return metrics;
+}
+
+- (void)_didApplyChanges:(SSSectionedDiff *)changes {
+    // Subclasses that keep their own bookkeeping in step with their contents
+    // bring it up to date here, rather than after each change within the batch.
+}
+
+#pragma mark - Transactions
+
+- (void)performUpdates:(void (^)(void))updates completion:(void (^)(BOOL finished))completion {
+    if (self.changeset) {
+        // Nested transactions are applied along with the outermost one.
+        if (updates) {
+            updates();
+        }
+        
+        if (completion) {
+            [self.changesetCompletionBlocks addObject:[completion copy]];
+        }
+        
+        return;
+    }
+    
+    SSDataSourceChangeset *changeset = [[SSDataSourceChangeset alloc] initWithDataSource:self];
+    NSMutableArray *completionBlocks = [NSMutableArray array];
+    
+    if (completion) {
+        [completionBlocks addObject:[completion copy]];
+    }
+    
+    BOOL startedFromSnapshot = [self _isSnapshotCurrent];
+    
+    self.changeset = changeset;
+    self.changesetCompletionBlocks = completionBlocks;
+    
+    if (updates) {
+        updates();
+    }
+    
+    self.changeset = nil;
+    self.changesetCompletionBlocks = nil;
+    self.transactionStartedFromSnapshot = startedFromSnapshot;
+    
+    [self _applyChangeset:changeset completion:^(BOOL finished) {
+        for (void (^block)(BOOL) in completionBlocks) {
+            block(finished);
+        }
+    }];
+    
+    self.transactionStartedFromSnapshot = NO;
+}
+
+- (void)_applyChangeset:(SSDataSourceChangeset *)changeset completion:(void (^)(BOOL finished))completionBlock {
+    if ([changeset requiresReloadData]) {
+        [self reloadData];
+        completionBlock(YES);
+        return;
+    }
+    
+    if ([self exceedsMaximumAnimatedChangeCount:changeset.recordedChangeCount]) {
+        NSIndexSet *changedSections = changeset.changedSections;
+        
+        if (!changedSections) {
+            [self reloadData];
+            completionBlock(YES);
+            return;
+        }
+        
+        [self reloadSectionsAtIndexes:changedSections];
+        completionBlock(YES);
+        [self _updateEmptyView];
+        return;
+    }
+    
+    SSSectionedDiff *diff = [changeset diff];
+    
+    if ([diff hasChanges]) {
+        // The diff goes straight to the views, so observers hear about it once it's applied.
+        self.observersNeedReload = YES;
+    
+        [self _performBatchUpdates:^{
+            [self _applyDiffToViews:diff];
+        } completion:completionBlock];
+    } else {
+        // Whatever was changed was changed back.
+        if (self.transactionStartedFromSnapshot) {
+            self.snapshotMutationCount = self.mutationCount;
+        }
+    
+        completionBlock(YES);
+    }
     
     [self _updateEmptyView];
 }
 
+#pragma mark - Background diffing
+
+- (void)_performBackgroundDiff:(id (^)(void))diffBlock
+                         apply:(BOOL (^)(id diff))applyBlock
+                         retry:(void (^)(void))retryBlock
+                    completion:(void (^)(BOOL finished))completion {
+    
+    if (!self.diffQueue) {
+        self.diffQueue = dispatch_queue_create("com.splinesoft.SSDataSources.diff", DISPATCH_QUEUE_SERIAL);
+    }
+    
+    NSUInteger generation = ++self.updateGeneration;
+    NSUInteger mutationCount = self.mutationCount;
+    __weak SSBaseDataSource *weakSelf = self;
+    
+    // The diff queue never touches the data source, so the last reference to it
+    // is always released on the main queue.
+    dispatch_async(self.diffQueue, ^{
+        id diff = diffBlock();
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            SSBaseDataSource *strongSelf = weakSelf;
+            
+            if (!strongSelf || strongSelf.updateGeneration != generation) {
+                if (completion) {
+                    completion(NO);
+                }
+                
+                return;
+            }
+            
+            if (strongSelf.mutationCount != mutationCount || !applyBlock(diff)) {
+                // The contents changed while we were diffing, so the diff no longer applies.
+                // Diff again against the current contents; the retry reports completion.
+                retryBlock();
+                return;
+            }
+            
+            if (completion) {
+                completion(YES);
+            }
+        });
+    });
+}
+
+- (void)_cancelBackgroundDiffs {
+    self.updateGeneration++;
+}
+
+- (void)_applyDiffToViews:(SSSectionedDiff *)diff {
+    UITableView *tableView = self.tableView;
+    UICollectionView *collectionView = self.collectionView;
+    UITableViewRowAnimation rowAnimation = self.rowAnimation;
+    
+    self.batchUpdateChangeCount += diff.changeCount;
+    [self.batchChanges addChangesFromDiff:diff];
+    
+    if ([diff.deletedSections count] > 0) {
+        [tableView deleteSections:diff.deletedSections withRowAnimation:rowAnimation];
+        [collectionView deleteSections:diff.deletedSections];
+    }
+    
+    if ([diff.insertedSections count] > 0) {
+        [tableView insertSections:diff.insertedSections withRowAnimation:rowAnimation];
+        [collectionView insertSections:diff.insertedSections];
+    }
+    
+    if ([diff.reloadedSections count] > 0) {
+        [tableView reloadSections:diff.reloadedSections withRowAnimation:rowAnimation];
+        [collectionView reloadSections:diff.reloadedSections];
+    }
+    
+    for (SSArrayDiffMove *move in diff.sectionMoves) {
+        [tableView moveSection:(NSInteger)move.fromIndex toSection:(NSInteger)move.toIndex];
+        [collectionView moveSection:(NSInteger)move.fromIndex toSection:(NSInteger)move.toIndex];
+    }
+    
+    if ([diff.deletedIndexPaths count] > 0) {
+        [tableView deleteRowsAtIndexPaths:diff.deletedIndexPaths withRowAnimation:rowAnimation];
+        [collectionView deleteItemsAtIndexPaths:diff.deletedIndexPaths];
+    }
+    
+    if ([diff.insertedIndexPaths count] > 0) {
+        [tableView insertRowsAtIndexPaths:diff.insertedIndexPaths withRowAnimation:rowAnimation];
+        [collectionView insertItemsAtIndexPaths:diff.insertedIndexPaths];
+    }
+    
+    if ([diff.reloadedIndexPaths count] > 0) {
+        [tableView reloadRowsAtIndexPaths:diff.reloadedIndexPaths withRowAnimation:rowAnimation];
+        [collectionView reloadItemsAtIndexPaths:diff.reloadedIndexPaths];
+    }
+    
+    for (SSSectionedDiffMove *move in diff.moves) {
+        [tableView moveRowAtIndexPath:move.fromIndexPath toIndexPath:move.toIndexPath];
+        [collectionView moveItemAtIndexPath:move.fromIndexPath toIndexPath:move.toIndexPath];
+    }
+}
+
 @end
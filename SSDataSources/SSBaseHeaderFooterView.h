@@ -26,4 +26,20 @@
  */
 - (instancetype) init;
 
+/**
+ * Dequeues a header/footer view from tableView, or if there are none of the receiver's type
+ * in the queue, takes one created by +warmUpViews:forTableView:whenIdle: or creates a new one.
+ */
++ (instancetype) viewForTableView:(UITableView *)tableView;
+
+/**
+ *  Create header/footer views ahead of time for +viewForTableView:.
+ *  See +[SSBaseTableCell warmUpCells:forTableView:whenIdle:].
+ *
+ *  @param count     number of views to keep ready
+ *  @param tableView the table view that will display the views
+ *  @param whenIdle  whether to create the views gradually while the main thread is idle
+ */
++ (void) warmUpViews:(NSUInteger)count forTableView:(UITableView *)tableView whenIdle:(BOOL)whenIdle;
+
 @end
@@ -7,6 +7,7 @@
 //
 
 #import "SSBaseHeaderFooterView.h"
+#import "SSReusePool.h"
 
 @implementation SSBaseHeaderFooterView
 
@@ -22,4 +23,29 @@
     return self;
 }
 
++ (instancetype)viewForTableView:(UITableView *)tableView {
+    SSBaseHeaderFooterView *view = [tableView dequeueReusableHeaderFooterViewWithIdentifier:[self identifier]];
+    
+    if (!view && tableView) {
+        view = [[SSReusePool poolForView:tableView] dequeueViewWithIdentifier:[self identifier]];
+    }
+    
+    return (view ?: [self new]);
+}
+
++ (void)warmUpViews:(NSUInteger)count forTableView:(UITableView *)tableView whenIdle:(BOOL)whenIdle {
+    if (!tableView) {
+        return;
+    }
+    
+    Class viewClass = self;
+    
+    [[SSReusePool poolForView:tableView] fillWithCount:count
+                                            identifier:[self identifier]
+                                              whenIdle:whenIdle
+                                         creationBlock:^id{
+                                             return [viewClass new];
+                                         }];
+}
+
 @end
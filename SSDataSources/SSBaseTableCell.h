@@ -23,6 +23,18 @@
  */
 + (instancetype) cellForTableView:(UITableView *)tableView;
 
+/**
+ *  Create and configure cells ahead of time, so that the first cells displayed
+ *  by tableView don't have to be. +cellForTableView: uses these cells when
+ *  tableView has none of its own to reuse. Call before the table appears, or
+ *  pass `whenIdle` to create one cell at a time whenever the main thread is idle.
+ *
+ *  @param count     number of cells to keep ready
+ *  @param tableView the table view that will display the cells
+ *  @param whenIdle  whether to create the cells gradually while the main thread is idle
+ */
++ (void) warmUpCells:(NSUInteger)count forTableView:(UITableView *)tableView whenIdle:(BOOL)whenIdle;
+
 /**
  *  Cell's identifier. You probably don't need to override me.
  *
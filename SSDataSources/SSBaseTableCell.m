@@ -7,6 +7,7 @@
 //
 
 #import "SSBaseTableCell.h"
+#import "SSReusePool.h"
 
 @implementation SSBaseTableCell
 
@@ -21,6 +22,10 @@
 + (instancetype)cellForTableView:(UITableView *)tableView {
     SSBaseTableCell *cell = (SSBaseTableCell *)[tableView dequeueReusableCellWithIdentifier:[self identifier]];
     
+    if (!cell && tableView) {
+        cell = [[SSReusePool poolForView:tableView] dequeueViewWithIdentifier:[self identifier]];
+    }
+    
     if (!cell) {
         cell = [[self alloc] initWithStyle:[self cellStyle]
                            reuseIdentifier:[self identifier]];
@@ -31,6 +36,26 @@
     return cell;
 }
 
++ (void)warmUpCells:(NSUInteger)count forTableView:(UITableView *)tableView whenIdle:(BOOL)whenIdle {
+    if (!tableView) {
+        return;
+    }
+    
+    Class cellClass = self;
+    
+    [[SSReusePool poolForView:tableView] fillWithCount:count
+                                            identifier:[self identifier]
+                                              whenIdle:whenIdle
+                                         creationBlock:^id{
+                                             SSBaseTableCell *cell = [[cellClass alloc] initWithStyle:[cellClass cellStyle]
+                                                                                      reuseIdentifier:[cellClass identifier]];
+                                             
+                                             [cell configureCell];
+                                             
+                                             return cell;
+                                         }];
+}
+
 - (void) configureCell {
     // override me!
 }
@@ -0,0 +1,89 @@
+//
+//  SSCompositeDataSource.h
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSBaseDataSource.h"
+
+/**
+ * A data source presenting the sections of several other data sources, one after another,
+ * e.g. a home screen made of an SSCoreDataSource followed by an SSArrayDataSource.
+ * Assign the composite data source, rather than its children, to your table or collection view,
+ * and configure its cells as usual. Table section header and footer titles are taken from
+ * the children.
+ *
+ * Sections are mapped to children by binary search over their section counts.
+ * As items and sections change in a child, the composite data source
+ * makes the same changes to that child's sections. Batch updates and transactions
+ * in a child reload only that child's sections.
+ */
+
+@interface SSCompositeDataSource : SSBaseDataSource
+
+/**
+ *  Create a composite data source.
+ *
+ *  @param dataSources the data sources whose sections to present, in order.
+ *                     Don't assign them a table or collection view.
+ *
+ *  @return an initialized data source
+ */
+- (instancetype) initWithDataSources:(NSArray *)dataSources;
+
+/**
+ * The data sources whose sections are presented.
+ */
+@property (nonatomic, copy, readonly) NSArray *dataSources;
+
+#pragma mark - Sections
+
+/**
+ *  Return the child data source presenting a section.
+ *
+ *  @param section      a section in the composite data source
+ *  @param localSection optional; on return, the corresponding section in the child
+ *
+ *  @return the child data source, or nil if there is no such section
+ */
+- (SSBaseDataSource *) dataSourceForSection:(NSInteger)section
+                               localSection:(NSInteger *)localSection;
+
+/**
+ *  Return the section in the composite data source of a child's section.
+ *
+ *  @param localSection a section in the child data source
+ *  @param dataSource   one of `dataSources`
+ *
+ *  @return a section in the composite data source, or NSNotFound
+ */
+- (NSInteger) sectionForLocalSection:(NSInteger)localSection
+                        inDataSource:(SSBaseDataSource *)dataSource;
+
+#pragma mark - Index paths
+
+/**
+ *  Return the index path in its child data source of an item in the composite data source.
+ *
+ *  @param indexPath  an index path in the composite data source
+ *  @param dataSource optional; on return, the child data source
+ *
+ *  @return an index path in the child data source, or nil if there is no such section
+ */
+- (NSIndexPath *) localIndexPathForIndexPath:(NSIndexPath *)indexPath
+                                  dataSource:(SSBaseDataSource **)dataSource;
+
+/**
+ *  Return the index path in the composite data source of an item in a child data source.
+ *
+ *  @param localIndexPath an index path in the child data source
+ *  @param dataSource     one of `dataSources`
+ *
+ *  @return an index path in the composite data source, or nil
+ */
+- (NSIndexPath *) indexPathForLocalIndexPath:(NSIndexPath *)localIndexPath
+                                inDataSource:(SSBaseDataSource *)dataSource;
+
+@end
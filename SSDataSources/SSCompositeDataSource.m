@@ -0,0 +1,506 @@
+//
+//  SSCompositeDataSource.m
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSDataSources.h"
+
+@interface SSCompositeDataSource () <SSDataSourceObserver>
+
+// Number of sections in each child.
+@property (nonatomic, strong) SSCountTree *sectionCounts;
+
+// Index of each child in `dataSources`.
+@property (nonatomic, strong) NSMapTable *dataSourceIndexes;
+
+- (NSUInteger)indexOfDataSource:(SSBaseDataSource *)dataSource;
+- (NSUInteger)sectionOffsetOfDataSourceAtIndex:(NSUInteger)index;
+
+// Offset a child's index paths, or return nil if any of their sections is unknown.
+- (NSArray *)indexPathsForLocalIndexPaths:(NSArray *)localIndexPaths
+                      inDataSourceAtIndex:(NSUInteger)index;
+- (NSIndexSet *)sectionsForLocalSections:(NSIndexSet *)localSections
+                     inDataSourceAtIndex:(NSUInteger)index;
+
+- (void)reloadSectionCounts;
+
+@end
+
+@implementation SSCompositeDataSource
+
+- (instancetype)initWithDataSources:(NSArray *)dataSources {
+    if ((self = [self init])) {
+        _dataSources = [(dataSources ?: @[]) copy];
+        _dataSourceIndexes = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsStrongMemory
+                                                                 | NSPointerFunctionsObjectPointerPersonality)
+                                                   valueOptions:NSPointerFunctionsStrongMemory];
+    
+        for (NSUInteger i = 0; i < [_dataSources count]; i++) {
+            SSBaseDataSource *dataSource = _dataSources[i];
+    
+            NSAssert(![_dataSourceIndexes objectForKey:dataSource],
+                     @"%@ appears more than once in a composite data source", dataSource);
+    
+            [_dataSourceIndexes setObject:@(i) forKey:dataSource];
+            [dataSource addObserver:self];
+        }
+    
+        [self reloadSectionCounts];
+    }
+    
+    return self;
+}
+
+- (void)dealloc {
+    for (SSBaseDataSource *dataSource in _dataSources) {
+        [dataSource removeObserver:self];
+    }
+}
+
+#pragma mark - SSBaseDataSource
+
+- (NSUInteger)numberOfSections {
+    return self.sectionCounts.total;
+}
+
+- (NSUInteger)numberOfItemsInSection:(NSInteger)section {
+    NSInteger localSection = 0;
+    SSBaseDataSource *dataSource = [self dataSourceForSection:section localSection:&localSection];
+    
+    return [dataSource numberOfItemsInSection:localSection];
+}
+
+- (id)itemAtIndexPath:(NSIndexPath *)indexPath {
+    SSBaseDataSource *dataSource = nil;
+    NSIndexPath *localIndexPath = [self localIndexPathForIndexPath:indexPath dataSource:&dataSource];
+    
+    return [dataSource itemAtIndexPath:localIndexPath];
+}
+
+#pragma mark - Sections
+
+- (SSBaseDataSource *)dataSourceForSection:(NSInteger)section localSection:(NSInteger *)localSection {
+    if (section < 0) {
+        return nil;
+    }
+    
+    NSUInteger remainder = 0;
+    NSUInteger index = [self.sectionCounts indexForPrefixSum:(NSUInteger)section remainder:&remainder];
+    
+    if (index == NSNotFound) {
+        return nil;
+    }
+    
+    if (localSection) {
+        *localSection = (NSInteger)remainder;
+    }
+    
+    return self.dataSources[index];
+}
+
+- (NSInteger)sectionForLocalSection:(NSInteger)localSection inDataSource:(SSBaseDataSource *)dataSource {
+    NSUInteger index = [self indexOfDataSource:dataSource];
+    
+    if (index == NSNotFound
+        || localSection < 0
+        || (NSUInteger)localSection >= [self.sectionCounts valueAtIndex:index]) {
+        return NSNotFound;
+    }
+    
+    return (NSInteger)[self sectionOffsetOfDataSourceAtIndex:index] + localSection;
+}
+
+- (NSUInteger)indexOfDataSource:(SSBaseDataSource *)dataSource {
+    NSNumber *index = (dataSource ? [self.dataSourceIndexes objectForKey:dataSource] : nil);
+    
+    return (index ? [index unsignedIntegerValue] : NSNotFound);
+}
+
+- (NSUInteger)sectionOffsetOfDataSourceAtIndex:(NSUInteger)index {
+    return [self.sectionCounts prefixSumBeforeIndex:index];
+}
+
+- (void)reloadSectionCounts {
+    NSUInteger count = [self.dataSources count];
+    NSUInteger *counts = calloc(MAX(count, 1u), sizeof(NSUInteger));
+    
+    for (NSUInteger i = 0; i < count; i++) {
+        counts[i] = [(SSBaseDataSource *)self.dataSources[i] numberOfSections];
+    }
+    
+    self.sectionCounts = [[SSCountTree alloc] initWithValues:counts count:count];
+    free(counts);
+}
+
+#pragma mark - Index paths
+
+- (NSIndexPath *)localIndexPathForIndexPath:(NSIndexPath *)indexPath dataSource:(SSBaseDataSource **)dataSource {
+    NSInteger localSection = 0;
+    SSBaseDataSource *child = (indexPath
+                               ? [self dataSourceForSection:indexPath.section localSection:&localSection]
+                               : nil);
+    
+    if (dataSource) {
+        *dataSource = child;
+    }
+    
+    return (child ? [NSIndexPath indexPathForRow:indexPath.row inSection:localSection] : nil);
+}
+
+- (NSIndexPath *)indexPathForLocalIndexPath:(NSIndexPath *)localIndexPath inDataSource:(SSBaseDataSource *)dataSource {
+    NSInteger section = (localIndexPath
+                         ? [self sectionForLocalSection:localIndexPath.section inDataSource:dataSource]
+                         : NSNotFound);
+    
+    return (section != NSNotFound ? [NSIndexPath indexPathForRow:localIndexPath.row inSection:section] : nil);
+}
+
+- (NSArray *)indexPathsForLocalIndexPaths:(NSArray *)localIndexPaths inDataSourceAtIndex:(NSUInteger)index {
+    NSUInteger sectionCount = [self.sectionCounts valueAtIndex:index];
+    NSInteger offset = (NSInteger)[self sectionOffsetOfDataSourceAtIndex:index];
+    NSMutableArray *indexPaths = [NSMutableArray arrayWithCapacity:[localIndexPaths count]];
+    
+    for (NSIndexPath *localIndexPath in localIndexPaths) {
+        if (localIndexPath.section < 0 || (NSUInteger)localIndexPath.section >= sectionCount) {
+            return nil;
+        }
+    
+        [indexPaths addObject:[NSIndexPath indexPathForRow:localIndexPath.row
+                                                 inSection:offset + localIndexPath.section]];
+    }
+    
+    return indexPaths;
+}
+
+- (NSIndexSet *)sectionsForLocalSections:(NSIndexSet *)localSections inDataSourceAtIndex:(NSUInteger)index {
+    NSMutableIndexSet *sections = [localSections mutableCopy];
+    
+    [sections shiftIndexesStartingAtIndex:0 by:(NSInteger)[self sectionOffsetOfDataSourceAtIndex:index]];
+    
+    return sections;
+}
+
+#pragma mark - UITableViewDataSource
+
+- (NSString *)tableView:(UITableView *)tableView titleForHeaderInSection:(NSInteger)section {
+    NSInteger localSection = 0;
+    id dataSource = [self dataSourceForSection:section localSection:&localSection];
+    
+    return ([dataSource respondsToSelector:@selector(tableView:titleForHeaderInSection:)]
+            ? [dataSource tableView:tableView titleForHeaderInSection:localSection]
+            : nil);
+}
+
+- (NSString *)tableView:(UITableView *)tableView titleForFooterInSection:(NSInteger)section {
+    NSInteger localSection = 0;
+    id dataSource = [self dataSourceForSection:section localSection:&localSection];
+    
+    return ([dataSource respondsToSelector:@selector(tableView:titleForFooterInSection:)]
+            ? [dataSource tableView:tableView titleForFooterInSection:localSection]
+            : nil);
+}
+
+#pragma mark - SSDataSourceObserver
+
+- (void)dataSource:(SSBaseDataSource *)dataSource didInsertItemsAtIndexPaths:(NSArray *)indexPaths {
+    NSUInteger index = [self indexOfDataSource:dataSource];
+    
+    // Changes to data sources that aren't children don't affect the composite.
+    if (index == NSNotFound) {
+        return;
+    }
+    
+    NSArray *insertedIndexPaths = [self indexPathsForLocalIndexPaths:indexPaths
+                                                 inDataSourceAtIndex:index];
+    
+    if (!insertedIndexPaths) {
+        [self reloadSectionCounts];
+        [self reloadData];
+        return;
+    }
+    
+    [self insertCellsAtIndexPaths:insertedIndexPaths];
+}
+
+- (void)dataSource:(SSBaseDataSource *)dataSource didDeleteItemsAtIndexPaths:(NSArray *)indexPaths {
+    NSUInteger index = [self indexOfDataSource:dataSource];
+    
+    if (index == NSNotFound) {
+        return;
+    }
+    
+    NSArray *deletedIndexPaths = [self indexPathsForLocalIndexPaths:indexPaths
+                                                inDataSourceAtIndex:index];
+    
+    if (!deletedIndexPaths) {
+        [self reloadSectionCounts];
+        [self reloadData];
+        return;
+    }
+    
+    [self deleteCellsAtIndexPaths:deletedIndexPaths];
+}
+
+- (void)dataSource:(SSBaseDataSource *)dataSource didReloadItemsAtIndexPaths:(NSArray *)indexPaths {
+    NSUInteger index = [self indexOfDataSource:dataSource];
+    
+    if (index == NSNotFound) {
+        return;
+    }
+    
+    NSArray *reloadedIndexPaths = [self indexPathsForLocalIndexPaths:indexPaths
+                                                 inDataSourceAtIndex:index];
+    
+    if (!reloadedIndexPaths) {
+        [self reloadSectionCounts];
+        [self reloadData];
+        return;
+    }
+    
+    [self reloadCellsAtIndexPaths:reloadedIndexPaths];
+}
+
+- (void)dataSource:(SSBaseDataSource *)dataSource
+didMoveItemAtIndexPath:(NSIndexPath *)fromIndexPath
+       toIndexPath:(NSIndexPath *)toIndexPath {
+    
+    NSUInteger index = [self indexOfDataSource:dataSource];
+    
+    if (index == NSNotFound) {
+        return;
+    }
+    
+    NSArray *indexPaths = [self indexPathsForLocalIndexPaths:@[ fromIndexPath, toIndexPath ]
+                                         inDataSourceAtIndex:index];
+    
+    if (!indexPaths) {
+        [self reloadSectionCounts];
+        [self reloadData];
+        return;
+    }
+    
+    [self moveCellAtIndexPath:indexPaths[0] toIndexPath:indexPaths[1]];
+}
+
+- (void)dataSource:(SSBaseDataSource *)dataSource didInsertSections:(NSIndexSet *)sections {
+    NSUInteger index = [self indexOfDataSource:dataSource];
+    
+    if (index == NSNotFound) {
+        return;
+    }
+    
+    NSUInteger oldCount = [self.sectionCounts valueAtIndex:index];
+    NSUInteger newCount = [dataSource numberOfSections];
+    
+    if (newCount != oldCount + [sections count] || [sections lastIndex] >= newCount) {
+        [self reloadSectionCounts];
+        [self reloadData];
+        return;
+    }
+    
+    [self.sectionCounts setValue:newCount atIndex:index];
+    [self insertSectionsAtIndexes:[self sectionsForLocalSections:sections inDataSourceAtIndex:index]];
+}
+
+- (void)dataSource:(SSBaseDataSource *)dataSource didDeleteSections:(NSIndexSet *)sections {
+    NSUInteger index = [self indexOfDataSource:dataSource];
+    
+    if (index == NSNotFound) {
+        return;
+    }
+    
+    NSUInteger oldCount = [self.sectionCounts valueAtIndex:index];
+    NSUInteger newCount = [dataSource numberOfSections];
+    
+    if (newCount + [sections count] != oldCount || [sections lastIndex] >= oldCount) {
+        [self reloadSectionCounts];
+        [self reloadData];
+        return;
+    }
+    
+    // Deleted sections are offset by the sections before this child, which don't change.
+    NSIndexSet *deletedSections = [self sectionsForLocalSections:sections inDataSourceAtIndex:index];
+    
+    [self.sectionCounts setValue:newCount atIndex:index];
+    [self deleteSectionsAtIndexes:deletedSections];
+}
+
+- (void)dataSource:(SSBaseDataSource *)dataSource didReloadSections:(NSIndexSet *)sections {
+    NSUInteger index = [self indexOfDataSource:dataSource];
+    
+    if (index == NSNotFound) {
+        return;
+    }
+    
+    if ([sections lastIndex] >= [self.sectionCounts valueAtIndex:index]) {
+        [self reloadSectionCounts];
+        [self reloadData];
+        return;
+    }
+    
+    [self reloadSectionsAtIndexes:[self sectionsForLocalSections:sections inDataSourceAtIndex:index]];
+}
+
+- (void)dataSource:(SSBaseDataSource *)dataSource
+    didMoveSection:(NSUInteger)fromSection
+         toSection:(NSUInteger)toSection {
+    
+    NSUInteger index = [self indexOfDataSource:dataSource];
+    
+    if (index == NSNotFound) {
+        return;
+    }
+    
+    NSUInteger sectionCount = [self.sectionCounts valueAtIndex:index];
+    
+    if (fromSection >= sectionCount || toSection >= sectionCount) {
+        [self reloadSectionCounts];
+        [self reloadData];
+        return;
+    }
+    
+    NSUInteger offset = [self sectionOffsetOfDataSourceAtIndex:index];
+    
+    [self moveSectionAtIndex:(NSInteger)(offset + fromSection) toIndex:(NSInteger)(offset + toSection)];
+}
+
+- (void)dataSource:(SSBaseDataSource *)dataSource didApplyChanges:(SSSectionedDiff *)changes {
+    NSUInteger index = [self indexOfDataSource:dataSource];
+    
+    if (index == NSNotFound) {
+        return;
+    }
+    
+    NSUInteger oldCount = [self.sectionCounts valueAtIndex:index];
+    NSUInteger newCount = [dataSource numberOfSections];
+    NSMutableIndexSet *oldSections = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *newSections = [NSMutableIndexSet indexSet];
+    
+    // Row deletes, reloads and moves' origins refer to the child's old sections,
+    // inserts and moves' destinations to its new ones.
+    for (NSIndexPath *indexPath in [changes.deletedIndexPaths arrayByAddingObjectsFromArray:changes.reloadedIndexPaths]) {
+        [oldSections addIndex:(NSUInteger)indexPath.section];
+    }
+    
+    for (NSIndexPath *indexPath in changes.insertedIndexPaths) {
+        [newSections addIndex:(NSUInteger)indexPath.section];
+    }
+    
+    for (SSSectionedDiffMove *move in changes.moves) {
+        [oldSections addIndex:(NSUInteger)move.fromIndexPath.section];
+        [newSections addIndex:(NSUInteger)move.toIndexPath.section];
+    }
+    
+    if (![changes isValidFromSectionCount:oldCount toSectionCount:newCount]
+        || ([oldSections count] > 0 && [oldSections lastIndex] >= oldCount)
+        || ([newSections count] > 0 && [newSections lastIndex] >= newCount)) {
+        [self reloadSectionCounts];
+        [self reloadData];
+        return;
+    }
+    
+    // The sections before this child don't change, so old and new sections share its offset.
+    NSUInteger offset = [self sectionOffsetOfDataSourceAtIndex:index];
+    NSArray *(^offsetIndexPaths)(NSArray *) = ^NSArray *(NSArray *localIndexPaths) {
+        NSMutableArray *indexPaths = [NSMutableArray arrayWithCapacity:[localIndexPaths count]];
+    
+        for (NSIndexPath *localIndexPath in localIndexPaths) {
+            [indexPaths addObject:[NSIndexPath indexPathForRow:localIndexPath.row
+                                                     inSection:(NSInteger)offset + localIndexPath.section]];
+        }
+    
+        return indexPaths;
+    };
+    
+    [self performBatchUpdates:^{
+        [self.sectionCounts setValue:newCount atIndex:index];
+    
+        if ([changes.deletedSections count] > 0) {
+            [self deleteSectionsAtIndexes:[self sectionsForLocalSections:changes.deletedSections
+                                                     inDataSourceAtIndex:index]];
+        }
+    
+        if ([changes.insertedSections count] > 0) {
+            [self insertSectionsAtIndexes:[self sectionsForLocalSections:changes.insertedSections
+                                                     inDataSourceAtIndex:index]];
+        }
+    
+        if ([changes.reloadedSections count] > 0) {
+            [self reloadSectionsAtIndexes:[self sectionsForLocalSections:changes.reloadedSections
+                                                     inDataSourceAtIndex:index]];
+        }
+    
+        for (SSArrayDiffMove *move in changes.sectionMoves) {
+            [self moveSectionAtIndex:(NSInteger)(offset + move.fromIndex) toIndex:(NSInteger)(offset + move.toIndex)];
+        }
+    
+        if ([changes.deletedIndexPaths count] > 0) {
+            [self deleteCellsAtIndexPaths:offsetIndexPaths(changes.deletedIndexPaths)];
+        }
+    
+        if ([changes.insertedIndexPaths count] > 0) {
+            [self insertCellsAtIndexPaths:offsetIndexPaths(changes.insertedIndexPaths)];
+        }
+    
+        if ([changes.reloadedIndexPaths count] > 0) {
+            [self reloadCellsAtIndexPaths:offsetIndexPaths(changes.reloadedIndexPaths)];
+        }
+    
+        for (SSSectionedDiffMove *move in changes.moves) {
+            NSArray *indexPaths = offsetIndexPaths(@[ move.fromIndexPath, move.toIndexPath ]);
+    
+            [self moveCellAtIndexPath:indexPaths[0] toIndexPath:indexPaths[1]];
+        }
+    }];
+    
+    // Within the batch, reloaded rows were only known by their old index paths.
+    NSMutableArray *reloadedIndexPaths = [NSMutableArray arrayWithCapacity:[changes.reloadedIndexPaths count]];
+    
+    for (NSIndexPath *localIndexPath in changes.reloadedIndexPaths) {
+        NSIndexPath *newLocalIndexPath = [changes indexPathAfterChangesForIndexPath:localIndexPath];
+    
+        if (newLocalIndexPath) {
+            [reloadedIndexPaths addObject:offsetIndexPaths(@[ newLocalIndexPath ])[0]];
+        }
+    }
+    
+    [self invalidateSizesForItemsAtIndexPaths:reloadedIndexPaths];
+}
+
+- (void)dataSourceDidReloadData:(SSBaseDataSource *)dataSource {
+    NSUInteger index = [self indexOfDataSource:dataSource];
+    
+    if (index == NSNotFound) {
+        return;
+    }
+    
+    NSUInteger offset = [self sectionOffsetOfDataSourceAtIndex:index];
+    NSUInteger oldCount = [self.sectionCounts valueAtIndex:index];
+    NSUInteger newCount = [dataSource numberOfSections];
+    
+    // Only this child's sections need reloading.
+    if (newCount == oldCount) {
+        if (newCount > 0) {
+            [self reloadSectionsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(offset, newCount)]];
+        }
+    
+        return;
+    }
+    
+    [self performBatchUpdates:^{
+        [self.sectionCounts setValue:newCount atIndex:index];
+    
+        if (oldCount > 0) {
+            [self deleteSectionsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(offset, oldCount)]];
+        }
+    
+        if (newCount > 0) {
+            [self insertSectionsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(offset, newCount)]];
+        }
+    }];
+}
+
+@end
@@ -40,6 +40,8 @@
 
 /**
  *  Find a managed object by its ID and return its index path.
+ *  Asks the fetched results controller for the object directly rather than
+ *  searching every fetched object.
  *
  *  @param objectId managed object ID
  *
@@ -47,6 +49,18 @@
  */
 - (NSIndexPath *) indexPathForItemWithId:(NSManagedObjectID *)objectId;
 
+/**
+ *  Find many managed objects by their IDs at once, e.g. to scroll to the first unread item.
+ *  Each ID is resolved through the context, so the other fetched objects
+ *  are not touched, and deleted objects are simply not found.
+ *
+ *  @param objectIds an array of managed object IDs
+ *
+ *  @return a dictionary of index paths keyed by managed object ID.
+ *  IDs of objects that are not found are omitted.
+ */
+- (NSDictionary *) indexPathsForItemsWithIds:(NSArray *)objectIds;
+
 /**
  * The data source's fetched results controller. You probably don't need to set this directly
  * as both initializers will do this for you.
@@ -59,6 +73,61 @@
  */
 @property (nonatomic, strong, readonly) NSError *fetchError;
 
+/**
+ * Changes reported by the fetched results controller are merged into a single
+ * batch update before they reach the table or collection view: an object inserted
+ * and then deleted produces no change, and an object updated several times is reloaded once.
+ *
+ * If greater than 0, changes reported within this many seconds of the first unapplied change
+ * are merged into the same update, which avoids a stream of small animations while
+ * many saves arrive in quick succession, e.g. during a background import.
+ * Until then, the table or collection view shows the previous contents, and the data source
+ * answers in terms of them: `itemAtIndexPath:` returns the object shown at that index path,
+ * even one that has since been deleted.
+ *
+ * Defaults to 0, which applies each set of changes as soon as the controller finishes reporting it.
+ */
+@property (nonatomic, assign) NSTimeInterval changeCoalescingInterval;
+
+/**
+ * Immediately apply any changes waiting for `changeCoalescingInterval` to elapse.
+ */
+- (void) applyPendingChanges;
+
+#pragma mark - Working set
+
+/**
+ * Objects shown in cells stay realized in their context after they scroll away,
+ * so memory grows as the user scrolls through a large store. If greater than 0,
+ * the data source keeps at most this many displayed objects realized, turning
+ * the least recently displayed ones back into faults. Visible objects and objects
+ * with unsaved changes are never turned into faults.
+ *
+ * Setting this also sets the fetch request's `fetchBatchSize`, if it hasn't been set,
+ * and fetches again. On a memory warning, all objects not currently visible are turned into faults.
+ *
+ * Defaults to 0, which leaves objects realized.
+ */
+@property (nonatomic, assign) NSUInteger maximumNumberOfRealizedObjects;
+
+/**
+ * Number of displayed objects that are currently realized.
+ */
+@property (nonatomic, assign, readonly) NSUInteger numberOfRealizedObjects;
+
+/**
+ * Total number of objects the data source has turned back into faults.
+ */
+@property (nonatomic, assign, readonly) NSUInteger numberOfFaultedObjects;
+
+/**
+ *  Turn displayed objects back into faults until at most the specified number remain realized.
+ *  Called for you as cells are displayed and on memory warnings when `maximumNumberOfRealizedObjects` is set.
+ *
+ *  @param numberOfObjects the number of most recently displayed objects to leave realized
+ */
+- (void) faultObjectsKeepingMostRecent:(NSUInteger)numberOfObjects;
+
 // Block called when move is needed on a CoreData object.
 typedef void (^SSCoreDataMoveRowBlock) (id object,                          // The object being moved
                                         NSIndexPath *sourceIndexPath,       // The source index path
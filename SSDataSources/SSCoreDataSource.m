@@ -10,25 +10,51 @@
 
 @interface SSCoreDataSource ()
 
-// For UICollectionView
-@property (nonatomic, strong) NSMutableArray *sectionUpdates;
-@property (nonatomic, strong) NSMutableArray *objectUpdates;
+// Changes reported by the controller that haven't been applied to the views yet.
+@property (nonatomic, strong) SSDataSourceChangeset *pendingChanges;
+
+// The number of items in each section as last shown by the views, as NSNumbers.
+@property (nonatomic, copy) NSArray *displayedItemCounts;
+
+// While changes are being coalesced, the views are answered in terms of what they display:
+// the section names they show, objects removed from the controller since, keyed by
+// the index path the views show them at, and the pending changes, which map other
+// displayed index paths to the controller's. nil once the changes are applied.
+@property (nonatomic, copy) NSArray *displayedSectionNames;
+@property (nonatomic, strong) NSMutableDictionary *displayedRemovedObjects;
+@property (nonatomic, strong) SSSectionedDiff *displayedChanges;
+
+// The earliest index path changed while changes were being coalesced.
+@property (nonatomic, strong) NSIndexPath *firstPendingIndexPath;
+
+@property (nonatomic, assign, getter=isWaitingToApplyChanges) BOOL waitingToApplyChanges;
+
+// Displayed objects that may be realized, least recently displayed first.
+@property (nonatomic, strong) NSMutableOrderedSet *displayedObjects;
+
+@property (nonatomic, assign, readwrite) NSUInteger numberOfFaultedObjects;
+@property (nonatomic, assign, getter=isFaultingScheduled) BOOL faultingScheduled;
 
 - (void) _performFetch;
+- (NSArray *) _currentItemCounts;
+- (void) _captureDisplayedSections;
+- (void) _captureDisplayedObject:(id)object atIndexPath:(NSIndexPath *)indexPath;
+- (void) _noteChangeAtIndexPath:(NSIndexPath *)indexPath;
+- (void) _didDisplayItem:(id)item;
+- (NSSet *) _visibleItems;
+- (NSIndexPath *) _indexPathForObjectWithId:(NSManagedObjectID *)objectId;
+- (void) _didReceiveMemoryWarning:(NSNotification *)notification;
+
+// Implemented by SSBaseDataSource
+- (void) _applyChangeset:(SSDataSourceChangeset *)changeset completion:(void (^)(BOOL finished))completion;
+- (void) _removeCachedDataForIdentifier:(id)identifier;
+- (BOOL) _canAccessItemsInBackground;
+- (NSArray *) _itemsInSection:(NSUInteger)section;
 
 @end
 
 @implementation SSCoreDataSource
 
-- (instancetype)init {
-    if ((self = [super init])) {
-        _sectionUpdates = [NSMutableArray new];
-        _objectUpdates = [NSMutableArray new];
-    }
-    
-    return self;
-}
-
 - (instancetype) initWithFetchedResultsController:(NSFetchedResultsController *)aController {
     if ((self = [self init])) {
         _controller = aController;
@@ -36,6 +62,8 @@
         
         if (!self.controller.fetchedObjects) {
             [self _performFetch];
+        } else {
+            self.displayedItemCounts = [self _currentItemCounts];
         }
     }
     
@@ -54,11 +82,17 @@
 }
 
 - (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    [NSObject cancelPreviousPerformRequestsWithTarget:self
+                                             selector:@selector(applyPendingChanges)
+                                               object:nil];
     self.controller.delegate = nil;
     self.controller = nil;
     self.coreDataMoveRowBlock = nil;
-    [self.sectionUpdates removeAllObjects];
-    [self.objectUpdates removeAllObjects];
+    self.pendingChanges = nil;
+    self.displayedSectionNames = nil;
+    self.displayedRemovedObjects = nil;
+    self.displayedChanges = nil;
 }
 
 #pragma mark - Fetching
@@ -67,45 +101,357 @@
     NSError *fetchErr;
     [self.controller performFetch:&fetchErr];
     _fetchError = fetchErr;
+    
+    [self invalidateItemIndexFromIndexPath:nil];
+    self.displayedItemCounts = [self _currentItemCounts];
+}
+
+- (NSArray *)_currentItemCounts {
+    NSArray *sections = [self.controller sections];
+    NSMutableArray *itemCounts = [NSMutableArray arrayWithCapacity:[sections count]];
+    
+    for (id <NSFetchedResultsSectionInfo> sectionInfo in sections) {
+        [itemCounts addObject:@([sectionInfo numberOfObjects])];
+    }
+    
+    return itemCounts;
+}
+
+- (void)_captureDisplayedSections {
+    // Called before the controller's first unapplied change, so its sections
+    // are still the ones the views are showing. Their objects are found later
+    // through the pending changes, so only the names are kept.
+    NSArray *sections = [self.controller sections];
+    NSArray *itemCounts = self.displayedItemCounts;
+    NSMutableArray *names = [NSMutableArray arrayWithCapacity:[sections count]];
+    
+    if ([sections count] != [itemCounts count]) {
+        return;
+    }
+    
+    for (NSUInteger section = 0; section < [sections count]; section++) {
+        id <NSFetchedResultsSectionInfo> sectionInfo = sections[section];
+        
+        if ([sectionInfo numberOfObjects] != [itemCounts[section] unsignedIntegerValue]) {
+            // Not what the views were last shown after all.
+            return;
+        }
+        
+        [names addObject:([sectionInfo name] ?: [NSNull null])];
+    }
+    
+    self.displayedSectionNames = names;
+    self.displayedRemovedObjects = [NSMutableDictionary dictionary];
+}
+
+- (void)_captureDisplayedObject:(id)object atIndexPath:(NSIndexPath *)indexPath {
+    // The index path is the controller's before this change, which the pending
+    // changes trace back to where the views show the object, if they do.
+    NSIndexPath *displayedIndexPath = [self.pendingChanges originalIndexPathForIndexPath:indexPath];
+    
+    if (object && displayedIndexPath) {
+        self.displayedRemovedObjects[displayedIndexPath] = object;
+    }
+}
+
+- (void)_noteChangeAtIndexPath:(NSIndexPath *)indexPath {
+    [self invalidateItemIndexFromIndexPath:indexPath];
+    
+    if (self.displayedSectionNames
+        && (!self.firstPendingIndexPath || [indexPath compare:self.firstPendingIndexPath] == NSOrderedAscending)) {
+        self.firstPendingIndexPath = indexPath;
+    }
 }
 
 #pragma mark - SSBaseDataSource
 
 - (NSUInteger)numberOfSections {
+    if (self.displayedSectionNames) {
+        return [self.displayedItemCounts count];
+    }
+    
     return (NSUInteger)[[self.controller sections] count];
 }
 
 - (NSUInteger)numberOfItemsInSection:(NSInteger)section {
-    id <NSFetchedResultsSectionInfo> sectionInfo = [self.controller sections][(NSUInteger)section];
-    return (NSUInteger)[sectionInfo numberOfObjects];
+    if (self.displayedSectionNames) {
+        NSArray *itemCounts = self.displayedItemCounts;
+        
+        return ((NSUInteger)section < [itemCounts count]
+                ? [itemCounts[(NSUInteger)section] unsignedIntegerValue]
+                : 0);
+    }
+    
+    NSArray *sections = [self.controller sections];
+    
+    if ((NSUInteger)section >= [sections count]) {
+        return 0;
+    }
+    
+    return (NSUInteger)[sections[(NSUInteger)section] numberOfObjects];
 }
 
 - (id)itemAtIndexPath:(NSIndexPath *)indexPath {
+    NSArray *sections;
+    
+    if (self.displayedSectionNames) {
+        if ((NSUInteger)indexPath.row >= [self numberOfItemsInSection:indexPath.section]) {
+            return nil;
+        }
+        
+        id object = self.displayedRemovedObjects[indexPath];
+        
+        if (object || self.pendingChanges.requiresReloadData) {
+            return object;
+        }
+        
+        if (!self.displayedChanges) {
+            self.displayedChanges = [self.pendingChanges diff];
+        }
+        
+        NSIndexPath *currentIndexPath = [self.displayedChanges indexPathAfterChangesForIndexPath:indexPath];
+        
+        return (currentIndexPath ? [self.controller objectAtIndexPath:currentIndexPath] : nil);
+    }
+    
+    if (self.pendingChanges) {
+        // The views may still be showing more rows than the controller now has.
+        sections = [self.controller sections];
+        
+        if ((NSUInteger)indexPath.section >= [sections count]
+            || (NSUInteger)indexPath.row >= [sections[(NSUInteger)indexPath.section] numberOfObjects]) {
+            return nil;
+        }
+    }
+    
     return [self.controller objectAtIndexPath:indexPath];
 }
 
+- (NSArray *)_itemsInSection:(NSUInteger)section {
+    // While coalescing, the displayed items are pieced together from the controller and the changes.
+    if (self.displayedSectionNames) {
+        return nil;
+    }
+    
+    NSArray *sections = [self.controller sections];
+    
+    return (section < [sections count] ? [sections[section] objects] : nil);
+}
+
+- (void)reloadData {
+    // The views are about to show the controller's current contents.
+    [NSObject cancelPreviousPerformRequestsWithTarget:self
+                                             selector:@selector(applyPendingChanges)
+                                               object:nil];
+    self.waitingToApplyChanges = NO;
+    self.pendingChanges = nil;
+    self.displayedSectionNames = nil;
+    self.displayedRemovedObjects = nil;
+    self.displayedChanges = nil;
+    self.firstPendingIndexPath = nil;
+    self.displayedItemCounts = [self _currentItemCounts];
+    
+    [super reloadData];
+}
+
+- (BOOL)_canAccessItemsInBackground {
+    // Managed objects may only be used on their context's queue.
+    return NO;
+}
+
 #pragma mark - Core Data access
 
 - (NSIndexPath *)indexPathForItemWithId:(NSManagedObjectID *)objectId {
-    for (NSUInteger section = 0; section < [self numberOfSections]; section++) {
-        id <NSFetchedResultsSectionInfo> sec = [self.controller sections][section];
+    if (!objectId) {
+        return nil;
+    }
+    
+    if (self.maintainsItemIndex && !self.itemIdentifierBlock) {
+        return [self indexPathForItemWithIdentifier:objectId];
+    }
+    
+    return [self _indexPathForObjectWithId:objectId];
+}
+
+- (NSDictionary *)indexPathsForItemsWithIds:(NSArray *)objectIds {
+    NSMutableDictionary *indexPaths = [NSMutableDictionary dictionaryWithCapacity:[objectIds count]];
+    BOOL useItemIndex = (self.maintainsItemIndex && !self.itemIdentifierBlock);
+    
+    for (NSManagedObjectID *objectId in objectIds) {
+        NSIndexPath *indexPath = (useItemIndex
+                                  ? [self indexPathForItemWithIdentifier:objectId]
+                                  : [self _indexPathForObjectWithId:objectId]);
         
-        NSUInteger index = [[sec objects] indexOfObjectPassingTest:^BOOL(NSManagedObject *object,
-                                                                         NSUInteger idx,
-                                                                         BOOL *stop) {
-            return [[object objectID] isEqual:objectId];
-        }];
-    
-        if (index != NSNotFound) {
-            return [NSIndexPath indexPathForRow:(NSInteger)index inSection:(NSInteger)section];
+        if (indexPath) {
+            indexPaths[objectId] = indexPath;
         }
     }
-  
-    return nil;
+    
+    return indexPaths;
+}
+
+- (NSIndexPath *)_indexPathForObjectWithId:(NSManagedObjectID *)objectId {
+    // The controller can locate a registered object, or an unfired fault,
+    // without touching any of its other objects.
+    NSManagedObjectContext *context = self.controller.managedObjectContext;
+    NSManagedObject *object = [context objectRegisteredForID:objectId];
+    
+    if (!object) {
+        if ([objectId isTemporaryID] || ![objectId persistentStore]) {
+            return nil;
+        }
+        
+        // Unlike objectWithID:, returns nil rather than a fault
+        // that raises when fired if the object has been deleted.
+        object = [context existingObjectWithID:objectId error:NULL];
+    }
+    
+    return (object ? [self.controller indexPathForObject:object] : nil);
+}
+
+#pragma mark - Working set
+
+- (void)setMaximumNumberOfRealizedObjects:(NSUInteger)maximumNumberOfRealizedObjects {
+    BOOL wasBounded = (_maximumNumberOfRealizedObjects > 0);
+    
+    _maximumNumberOfRealizedObjects = maximumNumberOfRealizedObjects;
+    
+    if (maximumNumberOfRealizedObjects == 0) {
+        if (wasBounded) {
+            [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                            name:UIApplicationDidReceiveMemoryWarningNotification
+                                                          object:nil];
+        }
+        
+        self.displayedObjects = nil;
+        return;
+    }
+    
+    if (!wasBounded) {
+        self.displayedObjects = [NSMutableOrderedSet orderedSet];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(_didReceiveMemoryWarning:)
+                                                     name:UIApplicationDidReceiveMemoryWarningNotification
+                                                   object:nil];
+    }
+    
+    // Without a batch size, every fetched object is realized up front.
+    NSFetchRequest *fetchRequest = self.controller.fetchRequest;
+    
+    if (fetchRequest && fetchRequest.fetchBatchSize == 0) {
+        fetchRequest.fetchBatchSize = MIN(maximumNumberOfRealizedObjects, (NSUInteger)50);
+        
+        if (self.controller.fetchedObjects) {
+            [self _performFetch];
+            [self reloadData];
+        }
+    }
+    
+    [self faultObjectsKeepingMostRecent:maximumNumberOfRealizedObjects];
+}
+
+- (NSUInteger)numberOfRealizedObjects {
+    NSUInteger count = 0;
+    
+    for (NSManagedObject *object in self.displayedObjects) {
+        if (![object isFault]) {
+            count++;
+        }
+    }
+    
+    return count;
+}
+
+- (void)_didDisplayItem:(id)item {
+    if (self.maximumNumberOfRealizedObjects == 0 || ![item isKindOfClass:[NSManagedObject class]]) {
+        return;
+    }
+    
+    // Most recently displayed last.
+    [self.displayedObjects removeObject:item];
+    [self.displayedObjects addObject:item];
+    
+    if ([self.displayedObjects count] <= self.maximumNumberOfRealizedObjects || self.isFaultingScheduled) {
+        return;
+    }
+    
+    // Wait until the table or collection view has finished laying out cells,
+    // so we know which objects are visible.
+    self.faultingScheduled = YES;
+    __weak SSCoreDataSource *weakSelf = self;
+    
+    dispatch_async(dispatch_get_main_queue(), ^{
+        weakSelf.faultingScheduled = NO;
+        [weakSelf faultObjectsKeepingMostRecent:weakSelf.maximumNumberOfRealizedObjects];
+    });
+}
+
+- (NSSet *)_visibleItems {
+    NSMutableArray *indexPaths = [NSMutableArray array];
+    
+    if (self.tableView) {
+        [indexPaths addObjectsFromArray:[self.tableView indexPathsForVisibleRows]];
+    }
+    
+    if (self.collectionView) {
+        [indexPaths addObjectsFromArray:[self.collectionView indexPathsForVisibleItems]];
+    }
+    
+    NSMutableSet *items = [NSMutableSet setWithCapacity:[indexPaths count]];
+    
+    for (NSIndexPath *indexPath in indexPaths) {
+        id item = [self itemAtIndexPath:indexPath];
+        
+        if (item) {
+            [items addObject:item];
+        }
+    }
+    
+    return items;
+}
+
+- (void)faultObjectsKeepingMostRecent:(NSUInteger)numberOfObjects {
+    if ([self.displayedObjects count] <= numberOfObjects) {
+        return;
+    }
+    
+    NSSet *visibleItems = [self _visibleItems];
+    NSUInteger index = 0;
+    
+    while ([self.displayedObjects count] > numberOfObjects
+           && index < [self.displayedObjects count]) {
+        
+        NSManagedObject *object = self.displayedObjects[index];
+        NSManagedObjectContext *context = [object managedObjectContext];
+        
+        if ([visibleItems containsObject:object] || [object hasChanges]) {
+            index++;
+            continue;
+        }
+        
+        if (context && ![object isFault]) {
+            [context refreshObject:object mergeChanges:NO];
+            self.numberOfFaultedObjects++;
+        }
+        
+        [self.displayedObjects removeObjectAtIndex:index];
+    }
+}
+
+- (void)_didReceiveMemoryWarning:(NSNotification *)notification {
+    [self faultObjectsKeepingMostRecent:0];
 }
 
 #pragma mark - UITableViewDataSource
 
+- (UITableViewCell *)tableView:(UITableView *)tv cellForRowAtIndexPath:(NSIndexPath *)indexPath {
+    UITableViewCell *cell = [super tableView:tv cellForRowAtIndexPath:indexPath];
+    
+    [self _didDisplayItem:[self itemAtIndexPath:indexPath]];
+    
+    return cell;
+}
+
 - (NSInteger)tableView:(UITableView *)tableView sectionForSectionIndexTitle:(NSString *)title
                atIndex:(NSInteger)index {
     return [self.controller sectionForSectionIndexTitle:title atIndex:index];
@@ -116,8 +462,20 @@
 }
 
 - (NSString *)tableView:(UITableView *)tableView titleForHeaderInSection:(NSInteger)section {
-    id <NSFetchedResultsSectionInfo> sectionInfo = [self.controller sections][(NSUInteger)section];
-    return [sectionInfo name];
+    NSArray *names = self.displayedSectionNames;
+    
+    if (names) {
+        id name = ((NSUInteger)section < [names count] ? names[(NSUInteger)section] : nil);
+        return (name == [NSNull null] ? nil : name);
+    }
+    
+    NSArray *sections = [self.controller sections];
+    
+    if ((NSUInteger)section >= [sections count]) {
+        return nil;
+    }
+    
+    return [sections[(NSUInteger)section] name];
 }
 
 - (void)tableView:(UITableView *)tableView
@@ -131,6 +489,16 @@ moveRowAtIndexPath:(NSIndexPath *)sourceIndexPath
     }
 }
 
+#pragma mark - UICollectionViewDataSource
+
+- (UICollectionViewCell *)collectionView:(UICollectionView *)cv cellForItemAtIndexPath:(NSIndexPath *)indexPath {
+    UICollectionViewCell *cell = [super collectionView:cv cellForItemAtIndexPath:indexPath];
+    
+    [self _didDisplayItem:[self itemAtIndexPath:indexPath]];
+    
+    return cell;
+}
+
 #pragma mark - NSFetchedResultsControllerDelegate
 
 - (NSString *)controller:(NSFetchedResultsController *)controller sectionIndexTitleForSectionName:(NSString *)sectionName {
@@ -138,7 +506,23 @@ moveRowAtIndexPath:(NSIndexPath *)sourceIndexPath
 }
 
 - (void)controllerWillChangeContent:(NSFetchedResultsController *)controller {
-    [self.tableView beginUpdates];
+    if (!self.pendingChanges) {
+        if (self.displayedItemCounts) {
+            self.pendingChanges = [[SSDataSourceChangeset alloc] initWithItemCounts:self.displayedItemCounts];
+            
+            // Until the changes are applied, the views keep showing these contents.
+            if (self.changeCoalescingInterval > 0) {
+                [self _captureDisplayedSections];
+            }
+        } else {
+            // We don't know what the views are showing, so reload them.
+            self.pendingChanges = [[SSDataSourceChangeset alloc] initWithItemCounts:@[]];
+            [self.pendingChanges reloadData];
+        }
+    }
+    
+    // Each set of changes from the controller follows batch update rules.
+    [self.pendingChanges beginBatchUpdates];
 }
 
 - (void)controller:(NSFetchedResultsController *)controller
@@ -147,38 +531,46 @@ moveRowAtIndexPath:(NSIndexPath *)sourceIndexPath
      forChangeType:(NSFetchedResultsChangeType)type
       newIndexPath:(NSIndexPath *)newIndexPath {
     
-    NSMutableDictionary *change = [NSMutableDictionary new];
-    UITableView *tableView = self.tableView;
+    SSDataSourceChangeset *changes = self.pendingChanges;
+    NSIndexPath *firstChangedIndexPath = (indexPath ?: newIndexPath);
+    
+    if (newIndexPath && [newIndexPath compare:firstChangedIndexPath] == NSOrderedAscending) {
+        firstChangedIndexPath = newIndexPath;
+    }
+    
+    [self _noteChangeAtIndexPath:firstChangedIndexPath];
+    
+    [self _removeCachedDataForIdentifier:[self identifierForItem:anObject]];
     
     switch (type) {
         case NSFetchedResultsChangeInsert:
-            change[@(type)] = newIndexPath;
-            [tableView insertRowsAtIndexPaths:@[ newIndexPath ]
-                             withRowAnimation:self.rowAnimation];
+            [changes insertRowsAtIndexPaths:@[ newIndexPath ]];
             break;
             
         case NSFetchedResultsChangeDelete:
-            change[@(type)] = indexPath;
-            [tableView deleteRowsAtIndexPaths:@[ indexPath ]
-                             withRowAnimation:self.rowAnimation];
+            if (self.displayedSectionNames) {
+                [self _captureDisplayedObject:anObject atIndexPath:indexPath];
+            }
+            
+            [changes deleteRowsAtIndexPaths:@[ indexPath ]];
+            [self.displayedObjects removeObject:anObject];
             break;
             
         case NSFetchedResultsChangeUpdate:
-            change[@(type)] = indexPath;
-            [tableView reloadRowsAtIndexPaths:@[ indexPath ]
-                             withRowAnimation:self.rowAnimation];
+            [changes reloadRowsAtIndexPaths:@[ indexPath ]];
             break;
             
         case NSFetchedResultsChangeMove:
-            change[@(type)] = @[ indexPath, newIndexPath ];
-            [tableView deleteRowsAtIndexPaths:@[ indexPath ]
-                             withRowAnimation:self.rowAnimation];
-            [tableView insertRowsAtIndexPaths:@[ newIndexPath ]
-                             withRowAnimation:self.rowAnimation];
+            // The object moved because its sort key changed, so its cell needs
+            // to be recreated rather than moved.
+            if (self.displayedSectionNames) {
+                [self _captureDisplayedObject:anObject atIndexPath:indexPath];
+            }
+            
+            [changes deleteRowsAtIndexPaths:@[ indexPath ]];
+            [changes insertRowsAtIndexPaths:@[ newIndexPath ]];
             break;
     }
-    
-    [self.objectUpdates addObject:change];
 }
 
 - (void)controller:(NSFetchedResultsController *)controller
@@ -186,95 +578,76 @@ moveRowAtIndexPath:(NSIndexPath *)sourceIndexPath
            atIndex:(NSUInteger)sectionIndex
      forChangeType:(NSFetchedResultsChangeType)type {
     
-    NSMutableDictionary *change = [NSMutableDictionary new];
-    UITableView *tableView = self.tableView;
+    [self _noteChangeAtIndexPath:[NSIndexPath indexPathForRow:0
+                                                    inSection:(NSInteger)sectionIndex]];
     
     switch (type) {
         case NSFetchedResultsChangeInsert:
-            [tableView insertSections:[NSIndexSet indexSetWithIndex:sectionIndex]
-                     withRowAnimation:self.rowAnimation];
-            change[@(type)] = @[@(sectionIndex)];
+            [self.pendingChanges insertSections:[NSIndexSet indexSetWithIndex:sectionIndex]];
             break;
             
         case NSFetchedResultsChangeDelete:
-            [tableView deleteSections:[NSIndexSet indexSetWithIndex:sectionIndex]
-                     withRowAnimation:self.rowAnimation];
-            change[@(type)] = @[@(sectionIndex)];
+            [self.pendingChanges deleteSections:[NSIndexSet indexSetWithIndex:sectionIndex]];
             break;
+            
         default:
-            return;
+            break;
     }
-    
-    [self.sectionUpdates addObject:change];
 }
 
 - (void)controllerDidChangeContent:(NSFetchedResultsController *)controller {
-    [self.tableView endUpdates];
+    [self.pendingChanges endBatchUpdates];
+    self.displayedChanges = nil;
     
-    UICollectionView *collectionView = self.collectionView;
+    if (self.changeCoalescingInterval <= 0) {
+        [self applyPendingChanges];
+        return;
+    }
     
-    if (collectionView) {
-        
-        if ([self.sectionUpdates count] > 0) {
-            [collectionView performBatchUpdates:^{
-                for (NSDictionary *change in self.sectionUpdates) {
-                    [change enumerateKeysAndObjectsUsingBlock:^(NSNumber *key, id secnum, BOOL *stop) {
-                        NSFetchedResultsChangeType type = (NSFetchedResultsChangeType)[key unsignedIntegerValue];
-                        NSIndexSet *section = [NSIndexSet indexSetWithIndex:[secnum unsignedIntegerValue]];
-                        
-                        switch( type ) {
-                            case NSFetchedResultsChangeInsert:
-                                [collectionView insertSections:section];
-                                break;
-                            case NSFetchedResultsChangeDelete:
-                                [collectionView deleteSections:section];
-                                break;
-                            case NSFetchedResultsChangeUpdate:
-                                [collectionView reloadSections:section];
-                                break;
-                            default:
-                                break;
-                        }
-                    }];
-                }
-            } completion:^(BOOL finished) {
-                [self.sectionUpdates removeAllObjects];
-                [self.objectUpdates removeAllObjects];
-                
-                // Hackish; force recalculation of empty view state
-                self.emptyView = self.emptyView;
-            }];
-        } else if ([self.objectUpdates count] > 0) {
-            [collectionView performBatchUpdates:^{
-                for (NSDictionary *change in self.objectUpdates) {
-                    [change enumerateKeysAndObjectsUsingBlock:^(NSNumber *key, id indexPath, BOOL *stop) {
-                        NSFetchedResultsChangeType type = [key unsignedIntegerValue];
-                        
-                        switch( type ) {
-                            case NSFetchedResultsChangeInsert:
-                                [collectionView insertItemsAtIndexPaths:@[ indexPath ]];
-                                break;
-                            case NSFetchedResultsChangeDelete:
-                                [collectionView deleteItemsAtIndexPaths:@[ indexPath ]];
-                                break;
-                            case NSFetchedResultsChangeUpdate:
-                                [collectionView reloadItemsAtIndexPaths:@[ indexPath ]];
-                                break;
-                            case NSFetchedResultsChangeMove:
-                                [collectionView moveItemAtIndexPath:indexPath[0]
-                                                        toIndexPath:indexPath[1]];
-                                break;
-                        }
-                    }];
-                }
-            } completion:^(BOOL finished) {
-                [self.objectUpdates removeAllObjects];
-                
-                // Hackish; force recalculation of empty view state
-                self.emptyView = self.emptyView;
-            }];
+    // The window starts with the first unapplied change, so a steady stream
+    // of saves can't postpone the update indefinitely.
+    if (!self.isWaitingToApplyChanges) {
+        self.waitingToApplyChanges = YES;
+        [self performSelector:@selector(applyPendingChanges)
+                   withObject:nil
+                   afterDelay:self.changeCoalescingInterval];
+    }
+}
+
+#pragma mark - Applying changes
+
+- (void)applyPendingChanges {
+    if (self.isWaitingToApplyChanges) {
+        [NSObject cancelPreviousPerformRequestsWithTarget:self
+                                                 selector:@selector(applyPendingChanges)
+                                                   object:nil];
+        self.waitingToApplyChanges = NO;
+    }
+    
+    SSDataSourceChangeset *changes = self.pendingChanges;
+    
+    if (!changes) {
+        return;
+    }
+    
+    self.pendingChanges = nil;
+    
+    // From here on the views show the controller's contents.
+    if (self.displayedSectionNames) {
+        self.displayedSectionNames = nil;
+        self.displayedRemovedObjects = nil;
+        self.displayedChanges = nil;
+    
+        // Items looked up in the meantime were indexed where the views showed them.
+        if (self.firstPendingIndexPath) {
+            [self invalidateItemIndexFromIndexPath:self.firstPendingIndexPath];
+            self.firstPendingIndexPath = nil;
         }
     }
+    
+    [self _applyChangeset:changes completion:^(BOOL finished) {}];
+    
+    self.displayedItemCounts = [self _currentItemCounts];
 }
 
 @end
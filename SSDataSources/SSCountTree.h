@@ -0,0 +1,107 @@
+//
+//  SSCountTree.h
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * An ordered list of non-negative counts, stored in a balanced tree
+ * that keeps the size and total of each subtree.
+ *
+ * Supports O(log n) updates, prefix sums, and the reverse lookup
+ * from a running total to the element containing it.
+ * Values may also be inserted, removed and moved in O(log n).
+ *
+ * Used by SSSectionedDataSource to map between index paths and
+ * flat item indexes as sections come and go, and by SSCompositeDataSource
+ * to map between its sections and those of its children.
+ */
+
+@interface SSCountTree : NSObject
+
+/**
+ *  Create a tree containing the specified values in O(n) time.
+ *
+ *  @param values an array of `count` values, or NULL for all zeroes
+ *  @param count  number of values
+ *
+ *  @return an initialized tree
+ */
+- (instancetype) initWithValues:(const NSUInteger *)values
+                          count:(NSUInteger)count;
+
+/**
+ * Number of values in the tree.
+ */
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/**
+ * Sum of all values in the tree.
+ */
+@property (nonatomic, assign, readonly) NSUInteger total;
+
+/**
+ *  Return the value at the specified index.
+ *
+ *  @param index an index less than `count`
+ */
+- (NSUInteger) valueAtIndex:(NSUInteger)index;
+
+/**
+ *  Replace the value at the specified index.
+ *
+ *  @param value the new value
+ *  @param index an index less than `count`
+ */
+- (void) setValue:(NSUInteger)value atIndex:(NSUInteger)index;
+
+/**
+ *  Insert a value, shifting later values up by one.
+ *
+ *  @param value the value to insert
+ *  @param index an index no greater than `count`
+ */
+- (void) insertValue:(NSUInteger)value atIndex:(NSUInteger)index;
+
+/**
+ *  Remove a value, shifting later values down by one.
+ *
+ *  @param index an index less than `count`
+ */
+- (void) removeValueAtIndex:(NSUInteger)index;
+
+/**
+ *  Move a value, as if it were removed and then inserted at `toIndex`.
+ *
+ *  @param fromIndex an index less than `count`
+ *  @param toIndex   an index less than `count`
+ */
+- (void) moveValueAtIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex;
+
+/**
+ *  Return the sum of the values before the specified index.
+ *
+ *  @param index an index no greater than `count`
+ *
+ *  @return the sum of values in [0, index)
+ */
+- (NSUInteger) prefixSumBeforeIndex:(NSUInteger)index;
+
+/**
+ *  Find the element containing the specified position in the running total,
+ *  i.e. the index `i` such that prefixSumBeforeIndex(i) <= sum < prefixSumBeforeIndex(i + 1).
+ *  Elements with a value of zero are never returned.
+ *
+ *  @param sum       a position less than `total`
+ *  @param remainder optional; on return, `sum - prefixSumBeforeIndex(i)`
+ *
+ *  @return the index of the element, or NSNotFound if `sum` is not less than `total`
+ */
+- (NSUInteger) indexForPrefixSum:(NSUInteger)sum
+                       remainder:(NSUInteger *)remainder;
+
+@end
@@ -0,0 +1,351 @@
+//
+//  SSCountTree.m
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSDataSources.h"
+
+// A node of a treap ordered by position: a binary tree whose in-order traversal gives the values,
+// kept balanced by random priorities, each no greater than its parent's.
+// Nodes refer to each other by index; node 0 is the empty tree.
+typedef struct {
+    NSUInteger left;
+    NSUInteger right;
+    NSUInteger size;  // number of values in this subtree
+    NSUInteger sum;   // total of the values in this subtree
+    NSUInteger value;
+    uint32_t priority;
+} SSCountTreeNode;
+
+static inline void SSCountTreeUpdateNode(SSCountTreeNode *nodes, NSUInteger node) {
+    SSCountTreeNode *n = &nodes[node];
+
+    n->size = 1 + nodes[n->left].size + nodes[n->right].size;
+    n->sum = n->value + nodes[n->left].sum + nodes[n->right].sum;
+}
+
+// Split a subtree into its first `count` values and the rest.
+static void SSCountTreeSplit(SSCountTreeNode *nodes,
+                             NSUInteger node,
+                             NSUInteger count,
+                             NSUInteger *first,
+                             NSUInteger *rest) {
+    if (node == 0) {
+        *first = 0;
+        *rest = 0;
+        return;
+    }
+
+    NSUInteger leftSize = nodes[nodes[node].left].size;
+
+    if (count <= leftSize) {
+        SSCountTreeSplit(nodes, nodes[node].left, count, first, &nodes[node].left);
+        *rest = node;
+    } else {
+        SSCountTreeSplit(nodes, nodes[node].right, count - leftSize - 1, &nodes[node].right, rest);
+        *first = node;
+    }
+
+    SSCountTreeUpdateNode(nodes, node);
+}
+
+// Join two subtrees, all of whose values in `first` come before those in `rest`.
+static NSUInteger SSCountTreeMerge(SSCountTreeNode *nodes, NSUInteger first, NSUInteger rest) {
+    if (first == 0 || rest == 0) {
+        return (first == 0 ? rest : first);
+    }
+
+    if (nodes[first].priority > nodes[rest].priority) {
+        nodes[first].right = SSCountTreeMerge(nodes, nodes[first].right, rest);
+        SSCountTreeUpdateNode(nodes, first);
+        return first;
+    }
+
+    nodes[rest].left = SSCountTreeMerge(nodes, first, nodes[rest].left);
+    SSCountTreeUpdateNode(nodes, rest);
+    return rest;
+}
+
+// Restore the heap order of priorities below a node whose children are already in order.
+// Only priorities are exchanged, so the shape of the tree is unchanged.
+static void SSCountTreeSiftDown(SSCountTreeNode *nodes, NSUInteger node) {
+    while (YES) {
+        NSUInteger child = nodes[node].left;
+        NSUInteger right = nodes[node].right;
+
+        if (right != 0 && (child == 0 || nodes[right].priority > nodes[child].priority)) {
+            child = right;
+        }
+
+        if (child == 0 || nodes[child].priority <= nodes[node].priority) {
+            return;
+        }
+
+        uint32_t priority = nodes[node].priority;
+        nodes[node].priority = nodes[child].priority;
+        nodes[child].priority = priority;
+        node = child;
+    }
+}
+
+// Build a perfectly balanced subtree of the values in [start, end), held by nodes start + 1 through end.
+static NSUInteger SSCountTreeBuild(SSCountTreeNode *nodes,
+                                   const NSUInteger *values,
+                                   NSUInteger start,
+                                   NSUInteger end) {
+    if (start == end) {
+        return 0;
+    }
+
+    NSUInteger middle = start + (end - start) / 2;
+    NSUInteger node = middle + 1;
+
+    nodes[node].value = (values ? values[middle] : 0);
+    nodes[node].left = SSCountTreeBuild(nodes, values, start, middle);
+    nodes[node].right = SSCountTreeBuild(nodes, values, middle + 1, end);
+    SSCountTreeUpdateNode(nodes, node);
+    SSCountTreeSiftDown(nodes, node);
+
+    return node;
+}
+
+@interface SSCountTree ()
+
+- (NSUInteger)nodeAtIndex:(NSUInteger)index;
+- (NSUInteger)newNodeWithValue:(NSUInteger)value;
+
+@end
+
+@implementation SSCountTree
+{
+    SSCountTreeNode *_nodes;
+    NSUInteger _capacity;   // number of nodes allocated, including the empty node 0
+    NSUInteger _nodeCount;  // highest node index handed out
+    NSUInteger _freeNode;   // first node of the free list, linked by `left`
+    NSUInteger _root;
+}
+
+- (instancetype)init {
+    return [self initWithValues:NULL count:0];
+}
+
+- (instancetype)initWithValues:(const NSUInteger *)values count:(NSUInteger)count {
+    if ((self = [super init])) {
+        _capacity = MAX(count + 1, 16u);
+        _nodes = calloc(_capacity, sizeof(SSCountTreeNode));
+        _nodeCount = count;
+
+        for (NSUInteger node = 1; node <= count; node++) {
+            _nodes[node].priority = arc4random();
+        }
+
+        _root = SSCountTreeBuild(_nodes, values, 0, count);
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    free(_nodes);
+}
+
+- (NSUInteger)count {
+    return _nodes[_root].size;
+}
+
+- (NSUInteger)total {
+    return _nodes[_root].sum;
+}
+
+- (NSUInteger)nodeAtIndex:(NSUInteger)index {
+    NSUInteger node = _root;
+
+    while (node != 0) {
+        NSUInteger leftSize = _nodes[_nodes[node].left].size;
+
+        if (index < leftSize) {
+            node = _nodes[node].left;
+        } else if (index == leftSize) {
+            break;
+        } else {
+            index -= leftSize + 1;
+            node = _nodes[node].right;
+        }
+    }
+
+    return node;
+}
+
+- (NSUInteger)newNodeWithValue:(NSUInteger)value {
+    NSUInteger node = _freeNode;
+
+    if (node != 0) {
+        _freeNode = _nodes[node].left;
+    } else {
+        if (_nodeCount + 1 == _capacity) {
+            _capacity *= 2;
+            _nodes = realloc(_nodes, sizeof(SSCountTreeNode) * _capacity);
+        }
+
+        node = ++_nodeCount;
+    }
+
+    _nodes[node] = (SSCountTreeNode){ 0, 0, 1, value, value, arc4random() };
+
+    return node;
+}
+
+- (NSUInteger)valueAtIndex:(NSUInteger)index {
+    NSParameterAssert(index < self.count);
+
+    return _nodes[[self nodeAtIndex:index]].value;
+}
+
+- (void)setValue:(NSUInteger)value atIndex:(NSUInteger)index {
+    NSParameterAssert(index < self.count);
+
+    NSUInteger target = [self nodeAtIndex:index];
+
+    // Unsigned arithmetic wraps, so adding the difference also works when the value shrinks.
+    NSUInteger delta = value - _nodes[target].value;
+
+    if (delta == 0) {
+        return;
+    }
+
+    _nodes[target].value = value;
+
+    // Every subtree on the way down to the node contains it.
+    for (NSUInteger node = _root; node != 0;) {
+        NSUInteger leftSize = _nodes[_nodes[node].left].size;
+
+        _nodes[node].sum += delta;
+
+        if (index < leftSize) {
+            node = _nodes[node].left;
+        } else if (index == leftSize) {
+            break;
+        } else {
+            index -= leftSize + 1;
+            node = _nodes[node].right;
+        }
+    }
+}
+
+- (void)insertValue:(NSUInteger)value atIndex:(NSUInteger)index {
+    NSParameterAssert(index <= self.count);
+
+    NSUInteger node = [self newNodeWithValue:value];
+    NSUInteger first = 0, rest = 0;
+
+    SSCountTreeSplit(_nodes, _root, index, &first, &rest);
+    _root = SSCountTreeMerge(_nodes, SSCountTreeMerge(_nodes, first, node), rest);
+}
+
+- (void)removeValueAtIndex:(NSUInteger)index {
+    NSParameterAssert(index < self.count);
+
+    NSUInteger first = 0, rest = 0, removed = 0;
+
+    SSCountTreeSplit(_nodes, _root, index, &first, &rest);
+    SSCountTreeSplit(_nodes, rest, 1, &removed, &rest);
+    _root = SSCountTreeMerge(_nodes, first, rest);
+
+    _nodes[removed] = (SSCountTreeNode){ _freeNode, 0, 0, 0, 0, 0 };
+    _freeNode = removed;
+}
+
+- (void)moveValueAtIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex {
+    NSParameterAssert(fromIndex < self.count && toIndex < self.count);
+
+    if (fromIndex == toIndex) {
+        return;
+    }
+
+    NSUInteger value = [self valueAtIndex:fromIndex];
+
+    [self removeValueAtIndex:fromIndex];
+    [self insertValue:value atIndex:toIndex];
+}
+
+- (NSUInteger)prefixSumBeforeIndex:(NSUInteger)index {
+    NSParameterAssert(index <= self.count);
+
+    NSUInteger sum = 0;
+    NSUInteger node = _root;
+
+    while (node != 0 && index > 0) {
+        NSUInteger left = _nodes[node].left;
+        NSUInteger leftSize = _nodes[left].size;
+
+        if (index == leftSize) {
+            sum += _nodes[left].sum;
+            break;
+        }
+
+        if (index < leftSize) {
+            node = left;
+        } else {
+            sum += _nodes[left].sum + _nodes[node].value;
+            index -= leftSize + 1;
+            node = _nodes[node].right;
+        }
+    }
+
+    return sum;
+}
+
+- (NSUInteger)indexForPrefixSum:(NSUInteger)sum remainder:(NSUInteger *)remainder {
+    if (sum >= self.total) {
+        return NSNotFound;
+    }
+
+    NSUInteger index = 0;
+    NSUInteger node = _root;
+
+    // The running total passes `sum` within this subtree; find the element where it does.
+    while (node != 0) {
+        NSUInteger left = _nodes[node].left;
+
+        if (sum < _nodes[left].sum) {
+            node = left;
+            continue;
+        }
+
+        sum -= _nodes[left].sum;
+        index += _nodes[left].size;
+
+        if (sum < _nodes[node].value) {
+            break;
+        }
+
+        sum -= _nodes[node].value;
+        index++;
+        node = _nodes[node].right;
+    }
+
+    if (remainder) {
+        *remainder = sum;
+    }
+
+    return index;
+}
+
+- (NSString *)description {
+    NSUInteger count = self.count;
+    NSMutableArray *values = [NSMutableArray arrayWithCapacity:count];
+
+    for (NSUInteger i = 0; i < count; i++) {
+        [values addObject:@([self valueAtIndex:i])];
+    }
+
+    return [NSString stringWithFormat:@"<%@: total %lu, values %@>",
+            NSStringFromClass([self class]),
+            (unsigned long)self.total,
+            [values componentsJoinedByString:@", "]];
+}
+
+@end
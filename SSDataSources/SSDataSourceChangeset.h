@@ -0,0 +1,121 @@
+//
+//  SSDataSourceChangeset.h
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class SSBaseDataSource;
+@class SSSectionedDiff;
+
+/**
+ * SSDataSourceChangeset records a sequence of row and section operations
+ * made against a data source and merges them into a single set of changes
+ * that can be applied to a table or collection view in one batch update.
+ *
+ * Each row remembers the index path it occupied when the changeset was created,
+ * so an item inserted and then removed produces no change at all,
+ * and an item moved several times produces at most one move.
+ *
+ * Operations are interpreted in order, each relative to the result of the last,
+ * except between -beginBatchUpdates and -endBatchUpdates, where they follow
+ * UITableView batch update rules: deletes and reloads refer to index paths before the batch,
+ * inserts refer to index paths after the batch.
+ *
+ * Used by -[SSBaseDataSource performUpdates:completion:]; you probably don't need this directly.
+ */
+
+@interface SSDataSourceChangeset : NSObject
+
+/**
+ *  Create a changeset for the current contents of a data source.
+ *
+ *  @param dataSource the data source whose changes will be recorded
+ *
+ *  @return an initialized changeset
+ */
+- (instancetype) initWithDataSource:(SSBaseDataSource *)dataSource;
+
+/**
+ *  Create a changeset for contents with the specified number of items in each section,
+ *  e.g. the contents a table or collection view is currently displaying.
+ *
+ *  @param itemCounts an NSNumber per section
+ *
+ *  @return an initialized changeset
+ */
+- (instancetype) initWithItemCounts:(NSArray *)itemCounts;
+
+/**
+ * YES if the recorded operations cannot be expressed as a batch update,
+ * for example after -reloadData. Apply the changeset by reloading instead.
+ */
+@property (nonatomic, assign, readonly) BOOL requiresReloadData;
+
+/**
+ * The number of rows and sections affected by the recorded operations.
+ * An inexpensive estimate of the cost of applying them, available without computing the diff.
+ */
+@property (nonatomic, assign, readonly) NSUInteger recordedChangeCount;
+
+/**
+ * The sections in which rows were inserted, deleted, reloaded or moved, plus any reloaded sections.
+ * nil if sections were inserted, deleted or moved, in which case section indexes are not stable.
+ */
+@property (nonatomic, strong, readonly) NSIndexSet *changedSections;
+
+#pragma mark - Recording operations
+
+- (void) insertRowsAtIndexPaths:(NSArray *)indexPaths;
+- (void) deleteRowsAtIndexPaths:(NSArray *)indexPaths;
+- (void) reloadRowsAtIndexPaths:(NSArray *)indexPaths;
+- (void) moveRowAtIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath;
+
+/**
+ *  As above, for rows within a single section.
+ *  Rows are stored as ranges; no index paths are created.
+ */
+- (void) insertRows:(NSIndexSet *)rows inSection:(NSUInteger)section;
+- (void) deleteRows:(NSIndexSet *)rows inSection:(NSUInteger)section;
+- (void) reloadRows:(NSIndexSet *)rows inSection:(NSUInteger)section;
+
+- (void) insertSections:(NSIndexSet *)sections;
+- (void) deleteSections:(NSIndexSet *)sections;
+- (void) reloadSections:(NSIndexSet *)sections;
+- (void) moveSection:(NSUInteger)fromSection toSection:(NSUInteger)toSection;
+
+- (void) reloadData;
+
+/**
+ *  Group the following operations as a single batch update.
+ *  Batches may be nested; operations are merged when the outermost batch ends.
+ */
+- (void) beginBatchUpdates;
+- (void) endBatchUpdates;
+
+/**
+ *  Find where a row was when the changeset was created, e.g. to tell which row
+ *  a view still showing the original contents displays for an item being removed.
+ *  Within a batch update, index paths refer to the contents before the batch.
+ *
+ *  @param indexPath an index path in the current contents
+ *
+ *  @return the row's original index path, or nil if it was inserted since
+ *  or the changeset requires a reload
+ */
+- (NSIndexPath *) originalIndexPathForIndexPath:(NSIndexPath *)indexPath;
+
+#pragma mark - Merged changes
+
+/**
+ *  Compute the net changes between the data source's contents when
+ *  the changeset was created and its contents now.
+ *
+ *  @return a diff expressed in batch update index paths
+ */
+- (SSSectionedDiff *) diff;
+
+@end
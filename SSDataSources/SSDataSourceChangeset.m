@@ -0,0 +1,817 @@
+//
+//  SSDataSourceChangeset.m
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSDataSources.h"
+
+// Where a row was when the changeset was created.
+// Rows inserted since then have a section and row of NSNotFound.
+typedef struct {
+    NSUInteger section;
+    NSUInteger row;
+} SSChangesetRow;
+
+static const SSChangesetRow SSChangesetInsertedRow = { NSNotFound, NSNotFound };
+
+// Add rows to a dictionary of NSMutableIndexSets keyed by section.
+static void SSChangesetAddRows(NSMutableDictionary *rowsBySection, NSIndexSet *rows, NSUInteger section) {
+    NSMutableIndexSet *sectionRows = rowsBySection[@(section)];
+
+    if (!sectionRows) {
+        sectionRows = [NSMutableIndexSet indexSet];
+        rowsBySection[@(section)] = sectionRows;
+    }
+
+    [sectionRows addIndexes:rows];
+}
+
+@interface SSArrayDiffMove ()
+
++ (instancetype) moveFromIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex;
+
+@end
+
+@interface SSSectionedDiffMove ()
+
++ (instancetype) moveFromIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath;
+
+@end
+
+@interface SSSectionedDiff ()
+
+@property (nonatomic, strong, readwrite) NSIndexSet *deletedSections;
+@property (nonatomic, strong, readwrite) NSIndexSet *insertedSections;
+@property (nonatomic, strong, readwrite) NSIndexSet *reloadedSections;
+@property (nonatomic, strong, readwrite) NSArray *sectionMoves;
+@property (nonatomic, strong, readwrite) NSArray *deletedIndexPaths;
+@property (nonatomic, strong, readwrite) NSArray *insertedIndexPaths;
+@property (nonatomic, strong, readwrite) NSArray *reloadedIndexPaths;
+@property (nonatomic, strong, readwrite) NSArray *moves;
+
+@end
+
+#pragma mark - SSChangesetSection
+
+@interface SSChangesetSection : NSObject
+
+// Index of this section when the changeset was created, or NSNotFound if it was inserted since.
+@property (nonatomic, assign) NSUInteger origin;
+
+// A reloaded section is replaced in its entirety, so its rows are no longer tracked.
+@property (nonatomic, assign) BOOL reloaded;
+
+// An SSChangesetRow per row, or nil if the section still has its original rows.
+@property (nonatomic, strong) NSMutableData *rows;
+
++ (instancetype) sectionWithOrigin:(NSUInteger)origin;
+
+- (BOOL) isTracked;
+
+@end
+
+@implementation SSChangesetSection
+
++ (instancetype)sectionWithOrigin:(NSUInteger)origin {
+    SSChangesetSection *section = [self new];
+    section.origin = origin;
+
+    return section;
+}
+
+- (BOOL)isTracked {
+    return (self.origin != NSNotFound && !self.reloaded);
+}
+
+@end
+
+#pragma mark - SSDataSourceChangeset
+
+@interface SSDataSourceChangeset ()
+
+@property (nonatomic, assign, readwrite) BOOL requiresReloadData;
+@property (nonatomic, assign, readwrite) NSUInteger recordedChangeCount;
+
+// SSChangesetSection for each current section.
+@property (nonatomic, strong) NSMutableArray *sections;
+
+// Original row indexes of rows that were reloaded, keyed by original section.
+@property (nonatomic, strong) NSMutableDictionary *reloadedItems;
+
+// Current indexes of sections with changes, or nil once sections have been inserted, deleted or moved.
+@property (nonatomic, strong) NSMutableIndexSet *touchedSections;
+
+// Pending rows are NSMutableIndexSets keyed by section.
+@property (nonatomic, assign) NSUInteger batchDepth;
+@property (nonatomic, strong) NSMutableIndexSet *pendingReloadedSections;
+@property (nonatomic, strong) NSMutableIndexSet *pendingDeletedSections;
+@property (nonatomic, strong) NSMutableIndexSet *pendingInsertedSections;
+@property (nonatomic, strong) NSMutableArray *pendingSectionMoves;
+@property (nonatomic, strong) NSMutableDictionary *pendingReloadedRows;
+@property (nonatomic, strong) NSMutableDictionary *pendingDeletedRows;
+@property (nonatomic, strong) NSMutableDictionary *pendingInsertedRows;
+@property (nonatomic, strong) NSMutableArray *pendingRowMoves;
+
+- (void) addRows:(NSIndexSet *)rows inSection:(NSUInteger)section toPendingRows:(NSMutableDictionary *)pendingRows;
+- (void) addIndexPaths:(NSArray *)indexPaths toPendingRows:(NSMutableDictionary *)pendingRows;
+- (void) touchSections:(NSIndexSet *)sections;
+- (void) touchSection:(NSUInteger)section;
+
+- (void) flushPendingUpdatesIfNeeded;
+- (void) flushPendingUpdates;
+- (void) clearPendingUpdates;
+- (void) failWithInconsistentUpdate;
+
+- (NSMutableData *) rowsForSection:(SSChangesetSection *)section;
+- (NSUInteger) rowCountForSection:(SSChangesetSection *)section;
+- (BOOL) getRow:(SSChangesetRow *)row atIndexPath:(NSIndexPath *)indexPath;
+- (BOOL) isRowReloaded:(NSUInteger)row inSection:(NSUInteger)section;
+
+@end
+
+@implementation SSDataSourceChangeset
+{
+    NSUInteger _originalSectionCount;
+    NSUInteger *_originalItemCounts;
+}
+
+- (instancetype)initWithDataSource:(SSBaseDataSource *)dataSource {
+    NSUInteger sectionCount = [dataSource numberOfSections];
+    NSMutableArray *itemCounts = [NSMutableArray arrayWithCapacity:sectionCount];
+
+    for (NSUInteger section = 0; section < sectionCount; section++) {
+        [itemCounts addObject:@([dataSource numberOfItemsInSection:(NSInteger)section])];
+    }
+
+    return [self initWithItemCounts:itemCounts];
+}
+
+- (instancetype)initWithItemCounts:(NSArray *)itemCounts {
+    if ((self = [super init])) {
+        _originalSectionCount = [itemCounts count];
+        _originalItemCounts = malloc(sizeof(NSUInteger) * MAX(_originalSectionCount, 1u));
+        _sections = [NSMutableArray arrayWithCapacity:_originalSectionCount];
+        _reloadedItems = [NSMutableDictionary dictionary];
+        _touchedSections = [NSMutableIndexSet indexSet];
+
+        for (NSUInteger section = 0; section < _originalSectionCount; section++) {
+            _originalItemCounts[section] = [itemCounts[section] unsignedIntegerValue];
+            [_sections addObject:[SSChangesetSection sectionWithOrigin:section]];
+        }
+
+        _pendingReloadedSections = [NSMutableIndexSet indexSet];
+        _pendingDeletedSections = [NSMutableIndexSet indexSet];
+        _pendingInsertedSections = [NSMutableIndexSet indexSet];
+        _pendingSectionMoves = [NSMutableArray array];
+        _pendingReloadedRows = [NSMutableDictionary dictionary];
+        _pendingDeletedRows = [NSMutableDictionary dictionary];
+        _pendingInsertedRows = [NSMutableDictionary dictionary];
+        _pendingRowMoves = [NSMutableArray array];
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    free(_originalItemCounts);
+}
+
+- (NSIndexSet *)changedSections {
+    return [self.touchedSections copy];
+}
+
+#pragma mark - Recording operations
+
+- (void)insertRowsAtIndexPaths:(NSArray *)indexPaths {
+    [self addIndexPaths:indexPaths toPendingRows:self.pendingInsertedRows];
+    [self flushPendingUpdatesIfNeeded];
+}
+
+- (void)deleteRowsAtIndexPaths:(NSArray *)indexPaths {
+    [self addIndexPaths:indexPaths toPendingRows:self.pendingDeletedRows];
+    [self flushPendingUpdatesIfNeeded];
+}
+
+- (void)reloadRowsAtIndexPaths:(NSArray *)indexPaths {
+    [self addIndexPaths:indexPaths toPendingRows:self.pendingReloadedRows];
+    [self flushPendingUpdatesIfNeeded];
+}
+
+- (void)moveRowAtIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath {
+    [self.pendingRowMoves addObject:[SSSectionedDiffMove moveFromIndexPath:fromIndexPath
+                                                               toIndexPath:toIndexPath]];
+    self.recordedChangeCount++;
+    [self touchSection:(NSUInteger)fromIndexPath.section];
+    [self touchSection:(NSUInteger)toIndexPath.section];
+    [self flushPendingUpdatesIfNeeded];
+}
+
+- (void)insertRows:(NSIndexSet *)rows inSection:(NSUInteger)section {
+    [self addRows:rows inSection:section toPendingRows:self.pendingInsertedRows];
+    [self flushPendingUpdatesIfNeeded];
+}
+
+- (void)deleteRows:(NSIndexSet *)rows inSection:(NSUInteger)section {
+    [self addRows:rows inSection:section toPendingRows:self.pendingDeletedRows];
+    [self flushPendingUpdatesIfNeeded];
+}
+
+- (void)reloadRows:(NSIndexSet *)rows inSection:(NSUInteger)section {
+    [self addRows:rows inSection:section toPendingRows:self.pendingReloadedRows];
+    [self flushPendingUpdatesIfNeeded];
+}
+
+- (void)insertSections:(NSIndexSet *)sections {
+    [self.pendingInsertedSections addIndexes:sections];
+    self.recordedChangeCount += [sections count];
+    self.touchedSections = nil;
+    [self flushPendingUpdatesIfNeeded];
+}
+
+- (void)deleteSections:(NSIndexSet *)sections {
+    [self.pendingDeletedSections addIndexes:sections];
+    self.recordedChangeCount += [sections count];
+    self.touchedSections = nil;
+    [self flushPendingUpdatesIfNeeded];
+}
+
+- (void)reloadSections:(NSIndexSet *)sections {
+    [self.pendingReloadedSections addIndexes:sections];
+    self.recordedChangeCount += [sections count];
+    [self touchSections:sections];
+    [self flushPendingUpdatesIfNeeded];
+}
+
+- (void)moveSection:(NSUInteger)fromSection toSection:(NSUInteger)toSection {
+    [self.pendingSectionMoves addObject:[SSArrayDiffMove moveFromIndex:fromSection
+                                                               toIndex:toSection]];
+    self.recordedChangeCount++;
+    self.touchedSections = nil;
+    [self flushPendingUpdatesIfNeeded];
+}
+
+- (void)reloadData {
+    self.requiresReloadData = YES;
+    self.touchedSections = nil;
+    [self clearPendingUpdates];
+}
+
+- (void)beginBatchUpdates {
+    self.batchDepth++;
+}
+
+- (void)endBatchUpdates {
+    if (self.batchDepth > 0) {
+        self.batchDepth--;
+    }
+
+    [self flushPendingUpdatesIfNeeded];
+}
+
+- (void)addRows:(NSIndexSet *)rows inSection:(NSUInteger)section toPendingRows:(NSMutableDictionary *)pendingRows {
+    if ([rows count] == 0) {
+        return;
+    }
+
+    SSChangesetAddRows(pendingRows, rows, section);
+    self.recordedChangeCount += [rows count];
+    [self touchSection:section];
+}
+
+- (void)addIndexPaths:(NSArray *)indexPaths toPendingRows:(NSMutableDictionary *)pendingRows {
+    for (NSIndexPath *indexPath in indexPaths) {
+        [self addRows:[NSIndexSet indexSetWithIndex:(NSUInteger)indexPath.row]
+            inSection:(NSUInteger)indexPath.section
+        toPendingRows:pendingRows];
+    }
+}
+
+- (void)touchSections:(NSIndexSet *)sections {
+    [self.touchedSections addIndexes:sections];
+}
+
+- (void)touchSection:(NSUInteger)section {
+    [self.touchedSections addIndex:section];
+}
+
+#pragma mark - Merging operations
+
+- (void)flushPendingUpdatesIfNeeded {
+    if (self.batchDepth == 0) {
+        [self flushPendingUpdates];
+    }
+}
+
+- (void)flushPendingUpdates {
+    if (self.requiresReloadData) {
+        [self clearPendingUpdates];
+        return;
+    }
+
+    NSMutableArray *sections = self.sections;
+    NSUInteger sectionCount = [sections count];
+
+    if (([self.pendingReloadedSections count] > 0 && [self.pendingReloadedSections lastIndex] >= sectionCount)
+        || ([self.pendingDeletedSections count] > 0 && [self.pendingDeletedSections lastIndex] >= sectionCount)) {
+        [self failWithInconsistentUpdate];
+        return;
+    }
+
+    // Reloads refer to index paths before the batch.
+    [self.pendingReloadedSections enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        SSChangesetSection *section = sections[index];
+
+        if (section.origin != NSNotFound) {
+            section.reloaded = YES;
+            section.rows = nil;
+        }
+    }];
+
+    __block BOOL isConsistent = YES;
+
+    [self.pendingReloadedRows enumerateKeysAndObjectsUsingBlock:^(NSNumber *sectionIndex, NSIndexSet *rows, BOOL *stop) {
+        NSUInteger index = [sectionIndex unsignedIntegerValue];
+
+        if (index >= sectionCount || [rows lastIndex] >= [self rowCountForSection:sections[index]]) {
+            isConsistent = NO;
+            *stop = YES;
+            return;
+        }
+
+        SSChangesetSection *section = sections[index];
+
+        if (![section isTracked]) {
+            return;
+        }
+
+        if (!section.rows) {
+            SSChangesetAddRows(self.reloadedItems, rows, section.origin);
+            return;
+        }
+
+        const SSChangesetRow *bytes = [section.rows bytes];
+
+        [rows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stopRows) {
+            if (bytes[row].section != NSNotFound) {
+                SSChangesetAddRows(self.reloadedItems,
+                                   [NSIndexSet indexSetWithIndex:bytes[row].row],
+                                   bytes[row].section);
+            }
+        }];
+    }];
+
+    if (!isConsistent) {
+        [self failWithInconsistentUpdate];
+        return;
+    }
+
+    // Moves are a delete before the batch paired with an insert after it.
+    NSMutableDictionary *removedRows = [NSMutableDictionary dictionaryWithCapacity:[self.pendingDeletedRows count]];
+    NSMutableDictionary *addedRows = [NSMutableDictionary dictionaryWithCapacity:[self.pendingInsertedRows count]];
+    NSMutableDictionary *movedRows = [NSMutableDictionary dictionaryWithCapacity:[self.pendingRowMoves count]];
+    NSMutableIndexSet *removedSections = [self.pendingDeletedSections mutableCopy];
+    NSMutableDictionary *movedSections = [NSMutableDictionary dictionaryWithCapacity:[self.pendingSectionMoves count]];
+
+    [self.pendingDeletedRows enumerateKeysAndObjectsUsingBlock:^(NSNumber *section, NSIndexSet *rows, BOOL *stop) {
+        removedRows[section] = [rows mutableCopy];
+    }];
+
+    [self.pendingInsertedRows enumerateKeysAndObjectsUsingBlock:^(NSNumber *section, NSIndexSet *rows, BOOL *stop) {
+        addedRows[section] = [rows mutableCopy];
+    }];
+
+    for (SSSectionedDiffMove *move in self.pendingRowMoves) {
+        SSChangesetRow row;
+
+        if (![self getRow:&row atIndexPath:move.fromIndexPath]) {
+            [self failWithInconsistentUpdate];
+            return;
+        }
+
+        movedRows[move.toIndexPath] = [NSValue valueWithBytes:&row objCType:@encode(SSChangesetRow)];
+
+        SSChangesetAddRows(removedRows,
+                           [NSIndexSet indexSetWithIndex:(NSUInteger)move.fromIndexPath.row],
+                           (NSUInteger)move.fromIndexPath.section);
+        SSChangesetAddRows(addedRows,
+                           [NSIndexSet indexSetWithIndex:(NSUInteger)move.toIndexPath.row],
+                           (NSUInteger)move.toIndexPath.section);
+    }
+
+    for (SSArrayDiffMove *move in self.pendingSectionMoves) {
+        if (move.fromIndex >= sectionCount) {
+            [self failWithInconsistentUpdate];
+            return;
+        }
+
+        movedSections[@(move.toIndex)] = sections[move.fromIndex];
+        [removedSections addIndex:move.fromIndex];
+    }
+
+    // Deletes go from last to first so that earlier rows stay in place.
+    [removedRows enumerateKeysAndObjectsUsingBlock:^(NSNumber *sectionIndex, NSIndexSet *rows, BOOL *stop) {
+        NSUInteger index = [sectionIndex unsignedIntegerValue];
+
+        if (index >= sectionCount || [rows lastIndex] >= [self rowCountForSection:sections[index]]) {
+            isConsistent = NO;
+            *stop = YES;
+            return;
+        }
+
+        SSChangesetSection *section = sections[index];
+
+        if (![section isTracked]) {
+            return;
+        }
+
+        NSMutableData *sectionRows = [self rowsForSection:section];
+
+        [rows enumerateRangesWithOptions:NSEnumerationReverse
+                              usingBlock:^(NSRange range, BOOL *stopRanges) {
+            [sectionRows replaceBytesInRange:NSMakeRange(range.location * sizeof(SSChangesetRow),
+                                                         range.length * sizeof(SSChangesetRow))
+                                   withBytes:NULL
+                                      length:0];
+        }];
+    }];
+
+    if (!isConsistent) {
+        [self failWithInconsistentUpdate];
+        return;
+    }
+
+    [sections removeObjectsAtIndexes:removedSections];
+
+    // Inserts refer to index paths after the batch and go from first to last.
+    NSMutableIndexSet *addedSections = [self.pendingInsertedSections mutableCopy];
+
+    for (NSNumber *index in movedSections) {
+        [addedSections addIndex:[index unsignedIntegerValue]];
+    }
+
+    [addedSections enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        if (index > [sections count]) {
+            isConsistent = NO;
+            *stop = YES;
+            return;
+        }
+
+        [sections insertObject:(movedSections[@(index)] ?: [SSChangesetSection sectionWithOrigin:NSNotFound])
+                       atIndex:index];
+    }];
+
+    if (!isConsistent) {
+        [self failWithInconsistentUpdate];
+        return;
+    }
+
+    [addedRows enumerateKeysAndObjectsUsingBlock:^(NSNumber *sectionIndex, NSIndexSet *rows, BOOL *stop) {
+        NSUInteger index = [sectionIndex unsignedIntegerValue];
+
+        if (index >= [sections count]) {
+            isConsistent = NO;
+            *stop = YES;
+            return;
+        }
+
+        SSChangesetSection *section = sections[index];
+
+        if (![section isTracked]) {
+            return;
+        }
+
+        NSMutableData *sectionRows = [self rowsForSection:section];
+
+        [rows enumerateRangesUsingBlock:^(NSRange range, BOOL *stopRanges) {
+            if (range.location > [sectionRows length] / sizeof(SSChangesetRow)) {
+                isConsistent = NO;
+                *stopRanges = YES;
+                return;
+            }
+
+            NSMutableData *insertedRows = [NSMutableData dataWithLength:range.length * sizeof(SSChangesetRow)];
+            SSChangesetRow *bytes = [insertedRows mutableBytes];
+
+            for (NSUInteger row = 0; row < range.length; row++) {
+                bytes[row] = SSChangesetInsertedRow;
+            }
+
+            [sectionRows replaceBytesInRange:NSMakeRange(range.location * sizeof(SSChangesetRow), 0)
+                                   withBytes:bytes
+                                      length:[insertedRows length]];
+        }];
+
+        if (!isConsistent) {
+            *stop = YES;
+        }
+    }];
+
+    if (!isConsistent) {
+        [self failWithInconsistentUpdate];
+        return;
+    }
+
+    // Moved rows carry their original position to their destination.
+    [movedRows enumerateKeysAndObjectsUsingBlock:^(NSIndexPath *indexPath, NSValue *value, BOOL *stop) {
+        SSChangesetSection *section = sections[(NSUInteger)indexPath.section];
+
+        if ([section isTracked]) {
+            SSChangesetRow *bytes = [[self rowsForSection:section] mutableBytes];
+            [value getValue:&bytes[indexPath.row]];
+        }
+    }];
+
+    [self clearPendingUpdates];
+}
+
+- (void)clearPendingUpdates {
+    [self.pendingReloadedSections removeAllIndexes];
+    [self.pendingDeletedSections removeAllIndexes];
+    [self.pendingInsertedSections removeAllIndexes];
+    [self.pendingSectionMoves removeAllObjects];
+    [self.pendingReloadedRows removeAllObjects];
+    [self.pendingDeletedRows removeAllObjects];
+    [self.pendingInsertedRows removeAllObjects];
+    [self.pendingRowMoves removeAllObjects];
+}
+
+- (void)failWithInconsistentUpdate {
+    // Out-of-range index paths can't be merged; fall back to reloading everything.
+    [self reloadData];
+}
+
+#pragma mark - Rows
+
+- (NSMutableData *)rowsForSection:(SSChangesetSection *)section {
+    if (!section.rows) {
+        NSUInteger rowCount = _originalItemCounts[section.origin];
+        NSMutableData *rows = [NSMutableData dataWithLength:sizeof(SSChangesetRow) * rowCount];
+        SSChangesetRow *bytes = [rows mutableBytes];
+
+        for (NSUInteger row = 0; row < rowCount; row++) {
+            bytes[row] = (SSChangesetRow){ section.origin, row };
+        }
+
+        section.rows = rows;
+    }
+
+    return section.rows;
+}
+
+- (NSUInteger)rowCountForSection:(SSChangesetSection *)section {
+    if (![section isTracked]) {
+        // Rows aren't tracked individually, so any row is acceptable.
+        return NSUIntegerMax;
+    }
+
+    if (!section.rows) {
+        return _originalItemCounts[section.origin];
+    }
+
+    return [section.rows length] / sizeof(SSChangesetRow);
+}
+
+- (BOOL)getRow:(SSChangesetRow *)row atIndexPath:(NSIndexPath *)indexPath {
+    if ((NSUInteger)indexPath.section >= [self.sections count]) {
+        return NO;
+    }
+
+    SSChangesetSection *section = self.sections[(NSUInteger)indexPath.section];
+    NSUInteger index = (NSUInteger)indexPath.row;
+
+    if (index >= [self rowCountForSection:section]) {
+        return NO;
+    }
+
+    if (![section isTracked]) {
+        *row = SSChangesetInsertedRow;
+    } else if (!section.rows) {
+        *row = (SSChangesetRow){ section.origin, index };
+    } else {
+        *row = ((const SSChangesetRow *)[section.rows bytes])[index];
+    }
+
+    return YES;
+}
+
+- (BOOL)isRowReloaded:(NSUInteger)row inSection:(NSUInteger)section {
+    return [(NSIndexSet *)self.reloadedItems[@(section)] containsIndex:row];
+}
+
+- (NSIndexPath *)originalIndexPathForIndexPath:(NSIndexPath *)indexPath {
+    SSChangesetRow row;
+
+    // Operations still pending in a batch haven't moved any rows yet.
+    if (self.requiresReloadData || ![self getRow:&row atIndexPath:indexPath] || row.section == NSNotFound) {
+        return nil;
+    }
+
+    return [NSIndexPath indexPathForRow:(NSInteger)row.row inSection:(NSInteger)row.section];
+}
+
+#pragma mark - Merged changes
+
+- (SSSectionedDiff *)diff {
+    NSArray *sections = self.sections;
+    NSUInteger sectionCount = [sections count];
+    NSUInteger oldSectionCount = _originalSectionCount;
+
+    NSMutableIndexSet *deletedSections = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *insertedSections = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *reloadedSections = [NSMutableIndexSet indexSet];
+    NSMutableArray *sectionMoves = [NSMutableArray array];
+    NSMutableArray *deletedIndexPaths = [NSMutableArray array];
+    NSMutableArray *insertedIndexPaths = [NSMutableArray array];
+    NSMutableArray *reloadedIndexPaths = [NSMutableArray array];
+    NSMutableArray *moves = [NSMutableArray array];
+
+    // Current index of each original section whose rows are still tracked individually.
+    NSUInteger *trackedSections = malloc(sizeof(NSUInteger) * MAX(oldSectionCount, 1u));
+    BOOL *survivingSections = calloc(MAX(oldSectionCount, 1u), sizeof(BOOL));
+    NSUInteger *origins = malloc(sizeof(NSUInteger) * MAX(sectionCount, 1u));
+    NSUInteger *originSections = malloc(sizeof(NSUInteger) * MAX(sectionCount, 1u));
+    NSUInteger originCount = 0;
+
+    for (NSUInteger oldSection = 0; oldSection < oldSectionCount; oldSection++) {
+        trackedSections[oldSection] = NSNotFound;
+    }
+
+    for (NSUInteger newSection = 0; newSection < sectionCount; newSection++) {
+        SSChangesetSection *section = sections[newSection];
+
+        if (section.origin == NSNotFound) {
+            [insertedSections addIndex:newSection];
+            continue;
+        }
+
+        survivingSections[section.origin] = YES;
+        origins[originCount] = section.origin;
+        originSections[originCount] = newSection;
+        originCount++;
+    }
+
+    for (NSUInteger oldSection = 0; oldSection < oldSectionCount; oldSection++) {
+        if (!survivingSections[oldSection]) {
+            [deletedSections addIndex:oldSection];
+        }
+    }
+
+    NSIndexSet *stableSections = [SSArrayDiff indexesOfStableElementsInSequence:origins
+                                                                          count:originCount];
+
+    for (NSUInteger position = 0; position < originCount; position++) {
+        NSUInteger oldSection = origins[position];
+        NSUInteger newSection = originSections[position];
+        BOOL reloaded = [(SSChangesetSection *)sections[newSection] reloaded];
+
+        if ([stableSections containsIndex:position]) {
+            if (reloaded) {
+                [reloadedSections addIndex:oldSection];
+            } else {
+                trackedSections[oldSection] = newSection;
+            }
+        } else if (reloaded) {
+            [deletedSections addIndex:oldSection];
+            [insertedSections addIndex:newSection];
+        } else {
+            [sectionMoves addObject:[SSArrayDiffMove moveFromIndex:oldSection toIndex:newSection]];
+            trackedSections[oldSection] = newSection;
+        }
+    }
+
+    // Only sections whose rows changed need to be examined row by row.
+    BOOL **survivingRows = calloc(MAX(oldSectionCount, 1u), sizeof(BOOL *));
+
+    for (NSUInteger oldSection = 0; oldSection < oldSectionCount; oldSection++) {
+        NSUInteger newSection = trackedSections[oldSection];
+
+        if (newSection != NSNotFound && [(SSChangesetSection *)sections[newSection] rows]) {
+            survivingRows[oldSection] = calloc(MAX(_originalItemCounts[oldSection], 1u), sizeof(BOOL));
+        }
+    }
+
+    for (NSUInteger oldSection = 0; oldSection < oldSectionCount; oldSection++) {
+        if (!survivingRows[oldSection]) {
+            continue;
+        }
+
+        NSData *rows = [(SSChangesetSection *)sections[trackedSections[oldSection]] rows];
+        const SSChangesetRow *bytes = [rows bytes];
+        NSUInteger rowCount = [rows length] / sizeof(SSChangesetRow);
+
+        for (NSUInteger row = 0; row < rowCount; row++) {
+            if (bytes[row].section != NSNotFound && survivingRows[bytes[row].section]) {
+                survivingRows[bytes[row].section][bytes[row].row] = YES;
+            }
+        }
+    }
+
+    for (NSUInteger oldSection = 0; oldSection < oldSectionCount; oldSection++) {
+        if (!survivingRows[oldSection]) {
+            continue;
+        }
+
+        NSUInteger newSection = trackedSections[oldSection];
+        NSData *rows = [(SSChangesetSection *)sections[newSection] rows];
+        const SSChangesetRow *bytes = [rows bytes];
+        NSUInteger rowCount = [rows length] / sizeof(SSChangesetRow);
+        NSUInteger *sequence = malloc(sizeof(NSUInteger) * MAX(rowCount, 1u));
+        NSUInteger *sequenceRows = malloc(sizeof(NSUInteger) * MAX(rowCount, 1u));
+        NSUInteger sequenceCount = 0;
+
+        for (NSUInteger row = 0; row < rowCount; row++) {
+            SSChangesetRow origin = bytes[row];
+            NSIndexPath *newIndexPath = [NSIndexPath indexPathForRow:(NSInteger)row
+                                                           inSection:(NSInteger)newSection];
+
+            if (origin.section == NSNotFound || !survivingRows[origin.section]) {
+                [insertedIndexPaths addObject:newIndexPath];
+            } else if (origin.section != oldSection) {
+                NSIndexPath *oldIndexPath = [NSIndexPath indexPathForRow:(NSInteger)origin.row
+                                                               inSection:(NSInteger)origin.section];
+
+                if ([self isRowReloaded:origin.row inSection:origin.section]) {
+                    [deletedIndexPaths addObject:oldIndexPath];
+                    [insertedIndexPaths addObject:newIndexPath];
+                } else {
+                    [moves addObject:[SSSectionedDiffMove moveFromIndexPath:oldIndexPath
+                                                                toIndexPath:newIndexPath]];
+                }
+            } else {
+                sequence[sequenceCount] = origin.row;
+                sequenceRows[sequenceCount] = row;
+                sequenceCount++;
+            }
+        }
+
+        NSIndexSet *stableRows = [SSArrayDiff indexesOfStableElementsInSequence:sequence
+                                                                          count:sequenceCount];
+
+        for (NSUInteger position = 0; position < sequenceCount; position++) {
+            NSIndexPath *oldIndexPath = [NSIndexPath indexPathForRow:(NSInteger)sequence[position]
+                                                           inSection:(NSInteger)oldSection];
+            NSIndexPath *newIndexPath = [NSIndexPath indexPathForRow:(NSInteger)sequenceRows[position]
+                                                           inSection:(NSInteger)newSection];
+            BOOL reloaded = [self isRowReloaded:sequence[position] inSection:oldSection];
+
+            if ([stableRows containsIndex:position]) {
+                if (reloaded) {
+                    [reloadedIndexPaths addObject:oldIndexPath];
+                }
+            } else if (reloaded) {
+                [deletedIndexPaths addObject:oldIndexPath];
+                [insertedIndexPaths addObject:newIndexPath];
+            } else {
+                [moves addObject:[SSSectionedDiffMove moveFromIndexPath:oldIndexPath
+                                                            toIndexPath:newIndexPath]];
+            }
+        }
+
+        for (NSUInteger row = 0; row < _originalItemCounts[oldSection]; row++) {
+            if (!survivingRows[oldSection][row]) {
+                [deletedIndexPaths addObject:[NSIndexPath indexPathForRow:(NSInteger)row
+                                                                inSection:(NSInteger)oldSection]];
+            }
+        }
+
+        free(sequence);
+        free(sequenceRows);
+    }
+
+    // Reloaded rows in sections whose rows were otherwise untouched.
+    [self.reloadedItems enumerateKeysAndObjectsUsingBlock:^(NSNumber *section, NSIndexSet *rows, BOOL *stop) {
+        NSUInteger oldSection = [section unsignedIntegerValue];
+
+        if (trackedSections[oldSection] != NSNotFound && !survivingRows[oldSection]) {
+            [reloadedIndexPaths addObjectsFromArray:[SSBaseDataSource indexPathArrayWithIndexSet:rows
+                                                                                        inSection:(NSInteger)oldSection]];
+        }
+    }];
+
+    for (NSUInteger oldSection = 0; oldSection < oldSectionCount; oldSection++) {
+        free(survivingRows[oldSection]);
+    }
+
+    free(survivingRows);
+    free(trackedSections);
+    free(survivingSections);
+    free(origins);
+    free(originSections);
+
+    SSSectionedDiff *diff = [SSSectionedDiff new];
+    diff.deletedSections = deletedSections;
+    diff.insertedSections = insertedSections;
+    diff.reloadedSections = reloadedSections;
+    diff.sectionMoves = sectionMoves;
+    diff.deletedIndexPaths = deletedIndexPaths;
+    diff.insertedIndexPaths = insertedIndexPaths;
+    diff.reloadedIndexPaths = reloadedIndexPaths;
+    diff.moves = moves;
+
+    return diff;
+}
+
+@end
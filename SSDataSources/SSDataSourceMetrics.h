@@ -0,0 +1,97 @@
+//
+//  SSDataSourceMetrics.h
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+// Timings, recorded in microseconds, overall and per cell class.
+extern NSString * const SSDataSourceMetricCellCreation;             // cellCreationBlock, or creating/dequeuing a `cellClass` cell
+extern NSString * const SSDataSourceMetricCellConfiguration;        // cellConfigureBlock
+extern NSString * const SSDataSourceMetricSupplementaryConfiguration; // collectionSupplementaryConfigureBlock
+extern NSString * const SSDataSourceMetricEmptyViewUpdate;          // showing or hiding the empty view
+extern NSString * const SSDataSourceMetricBatchUpdate;              // a batch update or reload of the table or collection view
+
+// Values recorded per update.
+extern NSString * const SSDataSourceMetricBatchUpdateSize;          // number of rows and sections changed by a batch update
+
+// Counters.
+extern NSString * const SSDataSourceMetricCellRequests;             // cells requested by a table or collection view
+extern NSString * const SSDataSourceMetricCellDequeueMisses;        // requested cells that had to be allocated
+extern NSString * const SSDataSourceMetricReloads;                  // full reloads of the table or collection view
+
+/**
+ * SSDataSourceMetrics records how long a data source spends creating and configuring cells
+ * and updating its table or collection view. Assign an instance to
+ * `-[SSBaseDataSource metrics]` to start recording; data sources without metrics record nothing.
+ *
+ * Values are kept in histograms with power-of-two buckets: bucket 0 counts zeroes,
+ * and bucket `i` counts values in [2^(i-1), 2^i).
+ *
+ * On iOS 12 and later, each batch update and reload is also marked with an os_signpost interval
+ * in the "com.splinesoft.SSDataSources" subsystem, for use with Instruments.
+ *
+ * Use from the main thread only.
+ */
+
+@interface SSDataSourceMetrics : NSObject
+
+/**
+ *  Add a value to a histogram.
+ *
+ *  @param value     the value, e.g. a duration in microseconds
+ *  @param metric    name of the histogram
+ *  @param cellClass optional; also add the value to this cell class's histogram
+ */
+- (void) recordValue:(NSUInteger)value forMetric:(NSString *)metric cellClass:(Class)cellClass;
+
+/**
+ *  As above, for a duration in seconds, which is recorded in microseconds.
+ */
+- (void) recordDuration:(NSTimeInterval)duration forMetric:(NSString *)metric cellClass:(Class)cellClass;
+
+/**
+ *  Add to a counter.
+ *
+ *  @param metric name of the counter
+ *  @param amount amount to add
+ */
+- (void) incrementCounter:(NSString *)metric by:(NSUInteger)amount;
+
+/**
+ *  Mark the start of an update to the table or collection view.
+ *  Updates may be nested. You probably don't need to call this directly.
+ */
+- (void) beginUpdate;
+
+/**
+ *  Mark the end of the most recent update begun with -beginUpdate.
+ *
+ *  @param changeCount number of rows and sections changed, or NSNotFound for a reload
+ */
+- (void) endUpdateWithChangeCount:(NSUInteger)changeCount;
+
+/**
+ *  Return everything recorded so far, suitable for serializing as JSON:
+ *
+ *  @{ @"histograms" : @{ metric : histogram },
+ *     @"cellClasses" : @{ class name : @{ metric : histogram } },
+ *     @"counters"   : @{ metric : count } }
+ *
+ *  where each histogram is
+ *
+ *  @{ @"count" : , @"sum" : , @"min" : , @"max" : , @"buckets" : @[ counts ] }
+ *
+ *  @return a snapshot of the metrics
+ */
+- (NSDictionary *) snapshot;
+
+/**
+ *  Discard everything recorded so far.
+ */
+- (void) reset;
+
+@end
@@ -0,0 +1,258 @@
+//
+//  SSDataSourceMetrics.m
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSDataSources.h"
+
+#if __IPHONE_OS_VERSION_MAX_ALLOWED >= 120000
+#import <os/signpost.h>
+#endif
+
+NSString * const SSDataSourceMetricCellCreation = @"cellCreation";
+NSString * const SSDataSourceMetricCellConfiguration = @"cellConfiguration";
+NSString * const SSDataSourceMetricSupplementaryConfiguration = @"supplementaryConfiguration";
+NSString * const SSDataSourceMetricEmptyViewUpdate = @"emptyViewUpdate";
+NSString * const SSDataSourceMetricBatchUpdate = @"batchUpdate";
+NSString * const SSDataSourceMetricBatchUpdateSize = @"batchUpdateSize";
+NSString * const SSDataSourceMetricCellRequests = @"cellRequests";
+NSString * const SSDataSourceMetricCellDequeueMisses = @"cellDequeueMisses";
+NSString * const SSDataSourceMetricReloads = @"reloads";
+
+static const NSUInteger SSHistogramBucketCount = 33;
+
+/**
+ * A histogram of unsigned values in power-of-two buckets.
+ */
+@interface SSMetricsHistogram : NSObject
+{
+    NSUInteger _count;
+    NSUInteger _sum;
+    NSUInteger _min;
+    NSUInteger _max;
+    NSUInteger _buckets[SSHistogramBucketCount];
+}
+
+- (void) addValue:(NSUInteger)value;
+- (NSDictionary *) dictionaryRepresentation;
+
+@end
+
+@implementation SSMetricsHistogram
+
+- (void)addValue:(NSUInteger)value {
+    NSUInteger bucket = 0;
+    
+    for (NSUInteger remaining = value; remaining > 0 && bucket < SSHistogramBucketCount - 1; remaining >>= 1) {
+        bucket++;
+    }
+    
+    _min = (_count == 0 ? value : MIN(_min, value));
+    _max = MAX(_max, value);
+    _count++;
+    _sum += value;
+    _buckets[bucket]++;
+}
+
+- (NSDictionary *)dictionaryRepresentation {
+    NSMutableArray *buckets = [NSMutableArray array];
+    NSUInteger lastBucket = 0;
+    
+    for (NSUInteger i = 0; i < SSHistogramBucketCount; i++) {
+        if (_buckets[i] > 0) {
+            lastBucket = i;
+        }
+    }
+    
+    for (NSUInteger i = 0; i <= lastBucket; i++) {
+        [buckets addObject:@(_buckets[i])];
+    }
+    
+    return @{ @"count"   : @(_count),
+              @"sum"     : @(_sum),
+              @"min"     : @(_min),
+              @"max"     : @(_max),
+              @"buckets" : buckets };
+}
+
+@end
+
+#pragma mark -
+
+@interface SSDataSourceMetrics ()
+
+// Metric name -> SSMetricsHistogram
+@property (nonatomic, strong) NSMutableDictionary *histograms;
+
+// Cell class name -> metric name -> SSMetricsHistogram
+@property (nonatomic, strong) NSMutableDictionary *cellClassHistograms;
+
+// Metric name -> NSNumber
+@property (nonatomic, strong) NSMutableDictionary *counters;
+
+// Start times (NSNumber) of updates in progress, innermost last.
+@property (nonatomic, strong) NSMutableArray *updateStartTimes;
+
+#if __IPHONE_OS_VERSION_MAX_ALLOWED >= 120000
+// Signpost IDs (NSNumber) of updates in progress, innermost last.
+@property (nonatomic, strong) NSMutableArray *updateSignpostIDs;
+#endif
+
+- (SSMetricsHistogram *) histogramNamed:(NSString *)metric inDictionary:(NSMutableDictionary *)dictionary;
+
+@end
+
+@implementation SSDataSourceMetrics
+
+- (instancetype)init {
+    if ((self = [super init])) {
+        _updateStartTimes = [NSMutableArray array];
+#if __IPHONE_OS_VERSION_MAX_ALLOWED >= 120000
+        _updateSignpostIDs = [NSMutableArray array];
+#endif
+        [self reset];
+    }
+    
+    return self;
+}
+
+- (SSMetricsHistogram *)histogramNamed:(NSString *)metric inDictionary:(NSMutableDictionary *)dictionary {
+    SSMetricsHistogram *histogram = dictionary[metric];
+    
+    if (!histogram) {
+        histogram = [SSMetricsHistogram new];
+        dictionary[metric] = histogram;
+    }
+    
+    return histogram;
+}
+
+#pragma mark - Recording
+
+- (void)recordValue:(NSUInteger)value forMetric:(NSString *)metric cellClass:(Class)cellClass {
+    [[self histogramNamed:metric inDictionary:self.histograms] addValue:value];
+    
+    if (!cellClass) {
+        return;
+    }
+    
+    NSString *className = NSStringFromClass(cellClass);
+    NSMutableDictionary *classHistograms = self.cellClassHistograms[className];
+    
+    if (!classHistograms) {
+        classHistograms = [NSMutableDictionary dictionary];
+        self.cellClassHistograms[className] = classHistograms;
+    }
+    
+    [[self histogramNamed:metric inDictionary:classHistograms] addValue:value];
+}
+
+- (void)recordDuration:(NSTimeInterval)duration forMetric:(NSString *)metric cellClass:(Class)cellClass {
+    [self recordValue:(NSUInteger)MAX(duration * 1e6, 0)
+            forMetric:metric
+            cellClass:cellClass];
+}
+
+- (void)incrementCounter:(NSString *)metric by:(NSUInteger)amount {
+    self.counters[metric] = @([self.counters[metric] unsignedIntegerValue] + amount);
+}
+
+#pragma mark - Updates
+
+#if __IPHONE_OS_VERSION_MAX_ALLOWED >= 120000
+static os_log_t SSDataSourceMetricsLog(void) API_AVAILABLE(ios(12.0)) {
+    static os_log_t log;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        log = os_log_create("com.splinesoft.SSDataSources", "Updates");
+    });
+    
+    return log;
+}
+#endif
+
+- (void)beginUpdate {
+    [self.updateStartTimes addObject:@(CACurrentMediaTime())];
+    
+#if __IPHONE_OS_VERSION_MAX_ALLOWED >= 120000
+    if (@available(iOS 12.0, *)) {
+        os_log_t log = SSDataSourceMetricsLog();
+        os_signpost_id_t signpostID = os_signpost_id_generate(log);
+    
+        [self.updateSignpostIDs addObject:@(signpostID)];
+        os_signpost_interval_begin(log, signpostID, "Update");
+    }
+#endif
+}
+
+- (void)endUpdateWithChangeCount:(NSUInteger)changeCount {
+    NSNumber *startTime = [self.updateStartTimes lastObject];
+    
+    if (!startTime) {
+        return;
+    }
+    
+    [self.updateStartTimes removeLastObject];
+    
+    [self recordDuration:CACurrentMediaTime() - [startTime doubleValue]
+               forMetric:SSDataSourceMetricBatchUpdate
+               cellClass:nil];
+    
+    if (changeCount == NSNotFound) {
+        [self incrementCounter:SSDataSourceMetricReloads by:1];
+    } else {
+        [self recordValue:changeCount forMetric:SSDataSourceMetricBatchUpdateSize cellClass:nil];
+    }
+    
+#if __IPHONE_OS_VERSION_MAX_ALLOWED >= 120000
+    if (@available(iOS 12.0, *)) {
+        NSNumber *signpostID = [self.updateSignpostIDs lastObject];
+    
+        if (signpostID) {
+            [self.updateSignpostIDs removeLastObject];
+            os_signpost_interval_end(SSDataSourceMetricsLog(),
+                                     (os_signpost_id_t)[signpostID unsignedLongLongValue],
+                                     "Update",
+                                     "%lu changes",
+                                     (unsigned long)(changeCount == NSNotFound ? 0 : changeCount));
+        }
+    }
+#endif
+}
+
+#pragma mark - Snapshots
+
+- (NSDictionary *)snapshot {
+    NSMutableDictionary *histograms = [NSMutableDictionary dictionary];
+    
+    [self.histograms enumerateKeysAndObjectsUsingBlock:^(NSString *metric, SSMetricsHistogram *histogram, BOOL *stop) {
+        histograms[metric] = [histogram dictionaryRepresentation];
+    }];
+    
+    NSMutableDictionary *cellClasses = [NSMutableDictionary dictionary];
+    
+    [self.cellClassHistograms enumerateKeysAndObjectsUsingBlock:^(NSString *className, NSDictionary *classHistograms, BOOL *stop) {
+        NSMutableDictionary *classSnapshot = [NSMutableDictionary dictionary];
+    
+        [classHistograms enumerateKeysAndObjectsUsingBlock:^(NSString *metric, SSMetricsHistogram *histogram, BOOL *innerStop) {
+            classSnapshot[metric] = [histogram dictionaryRepresentation];
+        }];
+    
+        cellClasses[className] = classSnapshot;
+    }];
+    
+    return @{ @"histograms"  : histograms,
+              @"cellClasses" : cellClasses,
+              @"counters"    : [self.counters copy] };
+}
+
+- (void)reset {
+    self.histograms = [NSMutableDictionary dictionary];
+    self.cellClassHistograms = [NSMutableDictionary dictionary];
+    self.counters = [NSMutableDictionary dictionary];
+}
+
+@end
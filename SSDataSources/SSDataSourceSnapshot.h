@@ -0,0 +1,75 @@
+//
+//  SSDataSourceSnapshot.h
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * An immutable copy of a data source's items at a point in time.
+ * See -[SSBaseDataSource snapshot].
+ *
+ * Snapshots share storage with each other and with the data source, so taking one is cheap,
+ * and unlike the data source they may be read from any thread -- e.g. to search,
+ * export or diff the items in the background.
+ */
+
+@interface SSDataSourceSnapshot : NSObject
+
+/**
+ *  Create a snapshot. You probably don't need to call this directly.
+ *
+ *  @param sections an array of SSPersistentArray objects, one for each section's items
+ *
+ *  @return an initialized snapshot
+ */
+- (instancetype) initWithSections:(NSArray *)sections;
+
+/**
+ * Number of sections.
+ */
+@property (nonatomic, assign, readonly) NSUInteger numberOfSections;
+
+/**
+ * Total number of items in all sections.
+ */
+@property (nonatomic, assign, readonly) NSUInteger numberOfItems;
+
+/**
+ *  Number of items in a section.
+ *
+ *  @param section a section index
+ *
+ *  @return number of items, or 0 if there is no such section
+ */
+- (NSUInteger) numberOfItemsInSection:(NSUInteger)section;
+
+/**
+ *  The items in a section, as an immutable SSPersistentArray.
+ *
+ *  @param section a section index
+ *
+ *  @return the section's items, or nil if there is no such section
+ */
+- (NSArray *) itemsInSection:(NSUInteger)section;
+
+/**
+ *  The item at an index path.
+ *
+ *  @param indexPath index path of the item
+ *
+ *  @return the item, or nil if there is no item at this index path
+ */
+- (id) itemAtIndexPath:(NSIndexPath *)indexPath;
+
+/**
+ *  All items in all sections, in order.
+ *
+ *  @return an array of items
+ */
+- (NSArray *) allItems;
+
+@end
@@ -0,0 +1,68 @@
+//
+//  SSDataSourceSnapshot.m
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSDataSources.h"
+
+@interface SSDataSourceSnapshot ()
+
+// SSPersistentArray of each section's items
+@property (nonatomic, copy) NSArray *sections;
+
+@end
+
+@implementation SSDataSourceSnapshot
+
+- (instancetype)init {
+    return [self initWithSections:nil];
+}
+
+- (instancetype)initWithSections:(NSArray *)sections {
+    if ((self = [super init])) {
+        _sections = [sections copy] ?: @[];
+        
+        for (NSArray *items in _sections) {
+            _numberOfItems += [items count];
+        }
+    }
+    
+    return self;
+}
+
+- (NSUInteger)numberOfSections {
+    return [self.sections count];
+}
+
+- (NSUInteger)numberOfItemsInSection:(NSUInteger)section {
+    return [[self itemsInSection:section] count];
+}
+
+- (NSArray *)itemsInSection:(NSUInteger)section {
+    return (section < [self.sections count] ? self.sections[section] : nil);
+}
+
+- (id)itemAtIndexPath:(NSIndexPath *)indexPath {
+    NSArray *items = (indexPath ? [self itemsInSection:(NSUInteger)indexPath.section] : nil);
+    
+    return ((NSUInteger)indexPath.row < [items count] ? items[(NSUInteger)indexPath.row] : nil);
+}
+
+- (NSArray *)allItems {
+    if ([self.sections count] == 1) {
+        return self.sections[0];
+    }
+    
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:self.numberOfItems];
+    
+    for (NSArray *sectionItems in self.sections) {
+        [items addObjectsFromArray:sectionItems];
+    }
+    
+    return items;
+}
+
+@end
@@ -13,9 +13,23 @@
 #import "SSBaseCollectionReusableView.h"
 #import "SSBaseHeaderFooterView.h"
 #import "SSSection.h"
+#import "SSArrayDiff.h"
+#import "SSSectionedDiff.h"
+#import "SSCountTree.h"
+#import "SSDataSourceChangeset.h"
+#import "SSItemSizeCache.h"
+#import "SSDataSourceMetrics.h"
+#import "SSReusePool.h"
+#import "SSPersistentArray.h"
+#import "SSDataSourceSnapshot.h"
 
 #import "SSBaseDataSource.h"
 #import "SSSectionedDataSource.h"
 #import "SSArrayDataSource.h"
 #import "SSCoreDataSource.h"
 #import "SSExpandingDataSource.h"
+#import "SSPagedDataSource.h"
+#import "SSFilteredDataSource.h"
+#import "SSSortedDataSource.h"
+#import "SSCompositeDataSource.h"
+#import "SSGroupedDataSource.h"
@@ -116,4 +116,16 @@ typedef NSInteger (^SSCollapsedSectionCountBlock) (SSSection *section,
  */
 - (void) setSection:(SSSection *)section expanded:(BOOL)expanded;
 
+#pragma mark - Replacing sections
+
+/**
+ *  As with SSSectionedDataSource, but new sections inherit the expanded/collapsed state
+ *  of the existing section with the same `sectionIdentifier`.
+ *  If any of those sections is collapsed, the table or collection view is reloaded
+ *  instead of animated. The same applies to `applySections:completion:`.
+ *
+ *  @param sections the new sections
+ */
+- (void) applySections:(NSArray *)sections;
+
 @end
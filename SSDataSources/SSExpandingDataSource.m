@@ -10,7 +10,16 @@
 
 @interface SSExpandingDataSource ()
 
-- (void) performBatchUpdates:(void (^)(void))updates;
+- (NSArray *)sectionsFromArray:(NSArray *)sectionObjects;
+- (void)updateItemCountsInSections:(NSIndexSet *)sections;
+- (NSIndexSet *)visibleIndexes:(NSIndexSet *)indexes inSection:(NSInteger)section;
+- (BOOL)inheritExpansionStateForSections:(NSArray *)sections;
+- (void)applyDiff:(SSSectionedDiff *)diff withSections:(NSArray *)newSections;
+
+// Implemented by SSBaseDataSource
+- (BOOL)_hasCachedData;
+- (void)_removeCachedDataForItems:(NSArray *)items;
+- (NSArray *)_itemsInSection:(NSUInteger)section;
 
 @end
 
@@ -22,6 +31,14 @@
 
 @implementation SSExpandingDataSource
 
+- (void)setCollapsedSectionCountBlock:(SSCollapsedSectionCountBlock)collapsedSectionCountBlock {
+    _collapsedSectionCountBlock = [collapsedSectionCountBlock copy];
+    
+    // Collapsed sections may now show a different number of rows.
+    [self updateItemCountsInSections:[NSIndexSet indexSetWithIndexesInRange:
+                                      NSMakeRange(0, [self numberOfSections])]];
+}
+
 #pragma mark - Section/Index helpers
 
 - (BOOL)isSectionExpandedAtIndex:(NSInteger)index {
@@ -32,6 +49,18 @@
     return (indexPath.row < [self numberOfItemsInSection:indexPath.section]);
 }
 
+- (NSIndexSet *)visibleIndexes:(NSIndexSet *)indexes inSection:(NSInteger)section {
+    // Equivalent to testing each index with -isItemVisibleAtIndexPath:, without creating index paths.
+    NSMutableIndexSet *visibleIndexes = [indexes mutableCopy];
+    NSUInteger visibleRowCount = [self numberOfItemsInSection:section];
+    
+    if (visibleRowCount < NSNotFound) {
+        [visibleIndexes removeIndexesInRange:NSMakeRange(visibleRowCount, NSNotFound - visibleRowCount)];
+    }
+    
+    return visibleIndexes;
+}
+
 - (NSIndexSet *) expandedSectionIndexes {
     NSMutableIndexSet *expandedIndexes = [NSMutableIndexSet indexSetWithIndexesInRange:
                                           NSMakeRange(0, [self numberOfSections])];
@@ -90,14 +119,64 @@
     section.expanded = expanded;
     
     if (expanded) {
-        [self insertCellsAtIndexPaths:
-         [self.class indexPathArrayWithRange:NSMakeRange(currentRowCount, targetRowCount - currentRowCount)
-                                   inSection:index]];
+        [self insertCellsAtIndexes:
+         [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(currentRowCount, targetRowCount - currentRowCount)]
+                         inSection:index];
     } else {
-        [self deleteCellsAtIndexPaths:
-         [self.class indexPathArrayWithRange:NSMakeRange(targetRowCount, currentRowCount - targetRowCount)
-                                   inSection:index]];
+        [self deleteCellsAtIndexes:
+         [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(targetRowCount, currentRowCount - targetRowCount)]
+                         inSection:index];
+    }
+}
+
+#pragma mark - Replacing sections
+
+- (BOOL)inheritExpansionStateForSections:(NSArray *)sections {
+    NSMapTable *existingSections = [NSMapTable strongToStrongObjectsMapTable];
+    BOOL hasCollapsedSections = NO;
+    
+    for (SSSection *section in self.sections) {
+        if (section.sectionIdentifier && ![existingSections objectForKey:section.sectionIdentifier]) {
+            [existingSections setObject:section forKey:section.sectionIdentifier];
+        }
+    }
+    
+    for (SSSection *section in sections) {
+        SSSection *existingSection = (section.sectionIdentifier
+                                      ? [existingSections objectForKey:section.sectionIdentifier]
+                                      : nil);
+        
+        if (existingSection && !existingSection.isExpanded) {
+            section.expanded = NO;
+            hasCollapsedSections = YES;
+        }
     }
+    
+    return hasCollapsedSections;
+}
+
+- (void)applySections:(NSArray *)newSections {
+    NSArray *sections = [self sectionsFromArray:newSections];
+    
+    if ([self inheritExpansionStateForSections:sections]) {
+        // Item diffs don't account for rows hidden by collapsed sections.
+        [self.sections setArray:sections];
+        [self reloadData];
+        return;
+    }
+    
+    [super applySections:sections];
+}
+
+- (void)applyDiff:(SSSectionedDiff *)diff withSections:(NSArray *)newSections {
+    // Sections diffed in the background only find out about collapsed sections now.
+    if ([self inheritExpansionStateForSections:newSections]) {
+        [self.sections setArray:newSections];
+        [self reloadData];
+        return;
+    }
+    
+    [super applyDiff:diff withSections:newSections];
 }
 
 #pragma mark - SSBaseDataSource
@@ -110,6 +189,15 @@
             : MIN(itemCount, [self numberOfCollapsedRowsInSection:section]));
 }
 
+- (NSArray *)_itemsInSection:(NSUInteger)section {
+    NSArray *items = [super _itemsInSection:section];
+    NSUInteger visibleCount = [self numberOfItemsInSection:(NSInteger)section];
+    
+    return ([items count] > visibleCount
+            ? [items subarrayWithRange:NSMakeRange(0, visibleCount)]
+            : items);
+}
+
 #pragma mark - Adding Items
 
 - (void)insertItem:(id)item atIndexPath:(NSIndexPath *)indexPath {
@@ -133,24 +221,18 @@
     [[self sectionAtIndex:section].items insertObjects:items
                                              atIndexes:indexes];
     
-    NSArray *potentialIndexes = [self.class indexPathArrayWithIndexSet:indexes
-                                                             inSection:section];
-    
-    [self performBatchUpdates:^{
-        [potentialIndexes enumerateObjectsUsingBlock:^(NSIndexPath *indexpath,
-                                                       NSUInteger index,
-                                                       BOOL *stop) {
-            if ([self isItemVisibleAtIndexPath:indexpath]) {
-                [self insertCellsAtIndexPaths:@[ indexpath ]];
-            }
-        }];
-    }];
+    [self insertCellsAtIndexes:[self visibleIndexes:indexes inSection:section]
+                     inSection:section];
 }
 
 #pragma mark - Replacing
 
 - (void)replaceItemAtIndexPath:(NSIndexPath *)indexPath withItem:(id)item {
     
+    if ([self _hasCachedData]) {
+        [self _removeCachedDataForItems:@[ [[self sectionAtIndex:indexPath.section] itemAtIndex:(NSUInteger)indexPath.row] ]];
+    }
+    
     [[self sectionAtIndex:indexPath.section].items removeObjectAtIndex:(NSUInteger)indexPath.row];
     [[self sectionAtIndex:indexPath.section].items insertObject:item
                                                         atIndex:(NSUInteger)indexPath.row];
@@ -173,37 +255,17 @@
 }
 
 - (void)removeItemsAtIndexes:(NSIndexSet *)indexes inSection:(NSInteger)section {
+    if ([self _hasCachedData]) {
+        [self _removeCachedDataForItems:[[self sectionAtIndex:section].items objectsAtIndexes:indexes]];
+    }
+    
     [[self sectionAtIndex:section].items removeObjectsAtIndexes:indexes];
     
     if (self.shouldRemoveEmptySections && [self sectionAtIndex:section].numberOfItems == 0) {
         [self removeSectionAtIndex:section];
     } else {
-        NSArray *potentialIndexes = [self.class indexPathArrayWithIndexSet:indexes
-                                                                 inSection:section];
-        
-        [self performBatchUpdates:^{
-            [potentialIndexes enumerateObjectsUsingBlock:^(NSIndexPath *indexpath,
-                                                           NSUInteger index,
-                                                           BOOL *stop) {
-                if ([self isItemVisibleAtIndexPath:indexpath]) {
-                    [self deleteCellsAtIndexPaths:@[ indexpath ]];
-                }
-            }];
-        }];
-    }
-}
-
-#pragma mark - Internal
-
-- (void)performBatchUpdates:(void (^)(void))updates {
-    if (self.collectionView) {
-        [self.collectionView performBatchUpdates:updates completion:nil];
-    }
-    
-    if (self.tableView) {
-        [self.tableView beginUpdates];
-        updates();
-        [self.tableView endUpdates];
+        [self deleteCellsAtIndexes:[self visibleIndexes:indexes inSection:section]
+                         inSection:section];
     }
 }
 
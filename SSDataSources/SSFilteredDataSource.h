@@ -0,0 +1,100 @@
+//
+//  SSFilteredDataSource.h
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSBaseDataSource.h"
+
+// Block called to decide whether an item is shown.
+typedef BOOL (^SSItemFilterBlock) (id item);       // The item to test
+
+/**
+ * A data source presenting the items of another data source that pass a filter,
+ * e.g. for type-ahead search. Assign the filtered data source, rather than the original,
+ * to your table or collection view, and configure its cells as usual.
+ *
+ * Each of the original data source's sections appears in the filtered data source,
+ * even if none of its items pass the filter. As items are inserted, removed,
+ * reloaded and moved in the original data source, only the items affected are tested,
+ * and the filtered data source inserts, removes, reloads and moves the matching cells.
+ * Batch updates and transactions in the original data source are translated the same way,
+ * as a single batch update; only a change the filtered data source can't account for,
+ * or one too large to animate, reloads it.
+ */
+
+@interface SSFilteredDataSource : SSBaseDataSource
+
+/**
+ *  Create a filtered data source. Initially, every item passes the filter.
+ *
+ *  @param dataSource the data source whose items to filter
+ *
+ *  @return an initialized data source
+ */
+- (instancetype) initWithDataSource:(SSBaseDataSource *)dataSource;
+
+/**
+ * The data source whose items are filtered.
+ */
+@property (nonatomic, strong, readonly) SSBaseDataSource *dataSource;
+
+/**
+ * Items for which this block returns YES are shown. nil shows every item.
+ *
+ * Setting a new filter tests every item of the original data source
+ * and animates the cells that appear and disappear.
+ */
+@property (nonatomic, copy) SSItemFilterBlock filterBlock;
+
+/**
+ *  As above, but only the items that pass the current filter are tested.
+ *  Use this when the new filter is stricter than the current one --
+ *  e.g. when the user types another letter of a search term.
+ *
+ *  @param filterBlock a filter that no item failing the current filter would pass
+ */
+- (void) refineFilterBlock:(SSItemFilterBlock)filterBlock;
+
+/**
+ *  As above, but items are tested on a background queue
+ *  and the changes are then animated on the main thread.
+ *
+ *  If this method is called again before the items have been tested, the earlier filter
+ *  is dropped in favor of the newer one and its completion block receives NO.
+ *  If the original data source changes while the items are being tested,
+ *  the filter is applied as with `filterBlock` instead.
+ *
+ *  `filterBlock` is called on the background queue, and later on the main thread
+ *  for items as they change, so it must be safe to call from any thread.
+ *
+ *  @param filterBlock the new filter
+ *  @param refining    YES to test only the items that pass the current filter; see above
+ *  @param completion  optional block called on the main thread once the filter
+ *                     has been applied (YES) or superseded by a newer filter (NO)
+ */
+- (void) setFilterBlock:(SSItemFilterBlock)filterBlock
+               refining:(BOOL)refining
+             completion:(void (^)(BOOL finished))completion;
+
+/**
+ *  Return the index path in the original data source of an item in the filtered data source.
+ *
+ *  @param indexPath an index path in the filtered data source
+ *
+ *  @return an index path in the original data source, or nil if there is no such item
+ */
+- (NSIndexPath *) sourceIndexPathForIndexPath:(NSIndexPath *)indexPath;
+
+/**
+ *  Return the index path in the filtered data source of an item in the original data source.
+ *
+ *  @param sourceIndexPath an index path in the original data source
+ *
+ *  @return an index path in the filtered data source, or nil if the item doesn't pass the filter
+ */
+- (NSIndexPath *) indexPathForSourceIndexPath:(NSIndexPath *)sourceIndexPath;
+
+@end
@@ -0,0 +1,798 @@
+//
+//  SSFilteredDataSource.m
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSDataSources.h"
+
+// The items of each section of a snapshot.
+static NSArray * SSFilteredDataSourceSectionsOfSnapshot(SSDataSourceSnapshot *snapshot) {
+    NSMutableArray *sections = [NSMutableArray arrayWithCapacity:snapshot.numberOfSections];
+    
+    for (NSUInteger section = 0; section < snapshot.numberOfSections; section++) {
+        [sections addObject:[snapshot itemsInSection:section]];
+    }
+    
+    return sections;
+}
+
+// An NSMutableIndexSet for each section of items, holding the rows that pass `filterBlock`.
+// With `candidateRows`, only those rows of each section are tested.
+static NSArray * SSFilteredDataSourceMatchingRows(NSArray *sections,
+                                                  NSArray *candidateRows,
+                                                  SSItemFilterBlock filterBlock) {
+    NSMutableArray *matchingRows = [NSMutableArray arrayWithCapacity:[sections count]];
+    
+    [sections enumerateObjectsUsingBlock:^(NSArray *items, NSUInteger section, BOOL *stop) {
+        NSIndexSet *rows = (section < [candidateRows count]
+                            ? candidateRows[section]
+                            : [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, [items count])]);
+    
+        if (!filterBlock) {
+            [matchingRows addObject:[rows mutableCopy]];
+            return;
+        }
+    
+        NSMutableIndexSet *matches = [NSMutableIndexSet indexSet];
+    
+        [rows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stopRows) {
+            if (row < [items count] && filterBlock(items[row])) {
+                [matches addIndex:row];
+            }
+        }];
+    
+        [matchingRows addObject:matches];
+    }];
+    
+    return matchingRows;
+}
+
+// Add an index path for each of `rows` missing from `otherRows`, counting only `rows`.
+static void SSFilteredDataSourceAddMissingRows(NSIndexSet *rows,
+                                               NSIndexSet *otherRows,
+                                               NSUInteger section,
+                                               NSMutableArray *indexPaths) {
+    __block NSInteger position = 0;
+    
+    [rows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+        if (![otherRows containsIndex:row]) {
+            [indexPaths addObject:[NSIndexPath indexPathForRow:position inSection:(NSInteger)section]];
+        }
+    
+        position++;
+    }];
+}
+
+// Implemented by SSBaseDataSource
+@interface SSBaseDataSource (SSFilteredDataSource)
+
+- (NSUInteger)mutationCount;
+
+@end
+
+@interface SSFilteredDataSource () <SSDataSourceObserver>
+
+// An NSMutableIndexSet for each section of `dataSource`, holding the rows that pass the filter.
+@property (nonatomic, strong) NSMutableArray *matchingRows;
+
+// For each section, an array of the source rows of the filtered rows,
+// or NSNull until it is needed. nil after sections change.
+@property (nonatomic, strong) NSMutableArray *sourceRows;
+
+- (NSArray *)sourceRowsInSection:(NSUInteger)section;
+- (void)invalidateSourceRowsInSection:(NSUInteger)section;
+- (NSIndexPath *)indexPathForSourceRow:(NSUInteger)row inSection:(NSUInteger)section;
+- (BOOL)itemMatchesAtSourceIndexPath:(NSIndexPath *)indexPath;
+- (NSMutableIndexSet *)matchingRowsInSourceSection:(NSUInteger)section;
+- (BOOL)isValidSourceSection:(NSInteger)section;
+
+- (void)updateFilterBlock:(SSItemFilterBlock)filterBlock refining:(BOOL)refining;
+- (void)applyMatchingRows:(NSArray *)matchingRows;
+- (void)reloadMatchingRows;
+
+// Background diffing, implemented by SSBaseDataSource
+- (void)_performBackgroundDiff:(id (^)(void))diffBlock
+                         apply:(BOOL (^)(id diff))applyBlock
+                         retry:(void (^)(void))retryBlock
+                    completion:(void (^)(BOOL finished))completion;
+- (void)_cancelBackgroundDiffs;
+
+@end
+
+@implementation SSFilteredDataSource
+
+- (instancetype)initWithDataSource:(SSBaseDataSource *)dataSource {
+    if ((self = [self init])) {
+        _dataSource = dataSource;
+        _matchingRows = [SSFilteredDataSourceMatchingRows(SSFilteredDataSourceSectionsOfSnapshot([dataSource snapshot]),
+                                                          nil,
+                                                          nil) mutableCopy];
+    
+        [dataSource addObserver:self];
+    }
+    
+    return self;
+}
+
+- (void)dealloc {
+    [_dataSource removeObserver:self];
+}
+
+#pragma mark - SSBaseDataSource
+
+- (NSUInteger)numberOfSections {
+    return [self.matchingRows count];
+}
+
+- (NSUInteger)numberOfItemsInSection:(NSInteger)section {
+    return ([self isValidSourceSection:section]
+            ? [(NSIndexSet *)self.matchingRows[(NSUInteger)section] count]
+            : 0);
+}
+
+- (id)itemAtIndexPath:(NSIndexPath *)indexPath {
+    NSIndexPath *sourceIndexPath = [self sourceIndexPathForIndexPath:indexPath];
+    
+    return (sourceIndexPath ? [self.dataSource itemAtIndexPath:sourceIndexPath] : nil);
+}
+
+#pragma mark - Index paths
+
+- (NSIndexPath *)sourceIndexPathForIndexPath:(NSIndexPath *)indexPath {
+    if (!indexPath || indexPath.row < 0 || ![self isValidSourceSection:indexPath.section]) {
+        return nil;
+    }
+    
+    NSArray *sourceRows = [self sourceRowsInSection:(NSUInteger)indexPath.section];
+    
+    if ((NSUInteger)indexPath.row >= [sourceRows count]) {
+        return nil;
+    }
+    
+    return [NSIndexPath indexPathForRow:[sourceRows[(NSUInteger)indexPath.row] integerValue]
+                              inSection:indexPath.section];
+}
+
+- (NSIndexPath *)indexPathForSourceIndexPath:(NSIndexPath *)sourceIndexPath {
+    if (!sourceIndexPath
+        || sourceIndexPath.row < 0
+        || ![self isValidSourceSection:sourceIndexPath.section]
+        || ![self.matchingRows[(NSUInteger)sourceIndexPath.section] containsIndex:(NSUInteger)sourceIndexPath.row]) {
+        return nil;
+    }
+    
+    return [self indexPathForSourceRow:(NSUInteger)sourceIndexPath.row
+                             inSection:(NSUInteger)sourceIndexPath.section];
+}
+
+- (NSIndexPath *)indexPathForSourceRow:(NSUInteger)row inSection:(NSUInteger)section {
+    NSUInteger filteredRow = [self.matchingRows[section] countOfIndexesInRange:NSMakeRange(0, row)];
+    
+    return [NSIndexPath indexPathForRow:(NSInteger)filteredRow inSection:(NSInteger)section];
+}
+
+- (NSArray *)sourceRowsInSection:(NSUInteger)section {
+    if (!self.sourceRows) {
+        self.sourceRows = [NSMutableArray arrayWithCapacity:[self.matchingRows count]];
+    
+        for (NSUInteger i = 0; i < [self.matchingRows count]; i++) {
+            [self.sourceRows addObject:[NSNull null]];
+        }
+    }
+    
+    NSArray *sourceRows = self.sourceRows[section];
+    
+    if ((id)sourceRows == [NSNull null]) {
+        NSIndexSet *matchingRows = self.matchingRows[section];
+        NSMutableArray *rows = [NSMutableArray arrayWithCapacity:[matchingRows count]];
+    
+        [matchingRows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+            [rows addObject:@(row)];
+        }];
+    
+        sourceRows = rows;
+        self.sourceRows[section] = rows;
+    }
+    
+    return sourceRows;
+}
+
+- (void)invalidateSourceRowsInSection:(NSUInteger)section {
+    if (section < [self.sourceRows count]) {
+        self.sourceRows[section] = [NSNull null];
+    }
+}
+
+- (BOOL)isValidSourceSection:(NSInteger)section {
+    return (section >= 0 && (NSUInteger)section < [self.matchingRows count]);
+}
+
+#pragma mark - Filtering
+
+- (void)setFilterBlock:(SSItemFilterBlock)filterBlock {
+    [self updateFilterBlock:filterBlock refining:NO];
+}
+
+- (void)refineFilterBlock:(SSItemFilterBlock)filterBlock {
+    [self updateFilterBlock:filterBlock refining:YES];
+}
+
+- (void)setFilterBlock:(SSItemFilterBlock)filterBlock
+              refining:(BOOL)refining
+            completion:(void (^)(BOOL))completion {
+    
+    SSBaseDataSource *dataSource = self.dataSource;
+    NSArray *sections = SSFilteredDataSourceSectionsOfSnapshot([dataSource snapshot]);
+    NSUInteger sourceMutationCount = [dataSource mutationCount];
+    NSMutableArray *candidateRows = nil;
+    
+    if (refining) {
+        // The matching rows change as the original items do, so test copies.
+        candidateRows = [NSMutableArray arrayWithCapacity:[self.matchingRows count]];
+    
+        for (NSIndexSet *rows in self.matchingRows) {
+            [candidateRows addObject:[rows copy]];
+        }
+    }
+    
+    SSItemFilterBlock newFilterBlock = [filterBlock copy];
+    __weak SSFilteredDataSource *weakSelf = self;
+    
+    [self _performBackgroundDiff:^id{
+        return SSFilteredDataSourceMatchingRows(sections, candidateRows, newFilterBlock);
+    } apply:^BOOL(NSArray *matchingRows) {
+        SSFilteredDataSource *strongSelf = weakSelf;
+    
+        if ([strongSelf.dataSource mutationCount] != sourceMutationCount) {
+            // The original items changed while we were testing them.
+            return NO;
+        }
+    
+        strongSelf->_filterBlock = newFilterBlock;
+        [strongSelf applyMatchingRows:matchingRows];
+        return YES;
+    } retry:^{
+        [weakSelf setFilterBlock:newFilterBlock refining:refining completion:completion];
+    } completion:completion];
+}
+
+- (void)updateFilterBlock:(SSItemFilterBlock)filterBlock refining:(BOOL)refining {
+    [self _cancelBackgroundDiffs];
+    
+    _filterBlock = [filterBlock copy];
+    
+    [self applyMatchingRows:SSFilteredDataSourceMatchingRows(SSFilteredDataSourceSectionsOfSnapshot([self.dataSource snapshot]),
+                                                             (refining ? self.matchingRows : nil),
+                                                             _filterBlock)];
+}
+
+- (void)applyMatchingRows:(NSArray *)newMatchingRows {
+    NSArray *oldMatchingRows = self.matchingRows;
+    
+    if ([newMatchingRows count] != [oldMatchingRows count]) {
+        self.matchingRows = [newMatchingRows mutableCopy];
+        self.sourceRows = nil;
+        [self reloadData];
+        return;
+    }
+    
+    NSMutableArray *deletedIndexPaths = [NSMutableArray array];
+    NSMutableArray *insertedIndexPaths = [NSMutableArray array];
+    
+    for (NSUInteger section = 0; section < [newMatchingRows count]; section++) {
+        SSFilteredDataSourceAddMissingRows(oldMatchingRows[section], newMatchingRows[section],
+                                           section, deletedIndexPaths);
+        SSFilteredDataSourceAddMissingRows(newMatchingRows[section], oldMatchingRows[section],
+                                           section, insertedIndexPaths);
+    }
+    
+    if ([deletedIndexPaths count] == 0 && [insertedIndexPaths count] == 0) {
+        self.matchingRows = [newMatchingRows mutableCopy];
+        self.sourceRows = nil;
+        return;
+    }
+    
+    if ([self exceedsMaximumAnimatedChangeCount:[deletedIndexPaths count] + [insertedIndexPaths count]]) {
+        self.matchingRows = [newMatchingRows mutableCopy];
+        self.sourceRows = nil;
+        [self reloadData];
+        return;
+    }
+    
+    [self performBatchUpdates:^{
+        self.matchingRows = [newMatchingRows mutableCopy];
+        self.sourceRows = nil;
+    
+        if ([deletedIndexPaths count] > 0) {
+            [self deleteCellsAtIndexPaths:deletedIndexPaths];
+        }
+    
+        if ([insertedIndexPaths count] > 0) {
+            [self insertCellsAtIndexPaths:insertedIndexPaths];
+        }
+    }];
+}
+
+- (void)reloadMatchingRows {
+    [self _cancelBackgroundDiffs];
+    
+    self.matchingRows = [SSFilteredDataSourceMatchingRows(SSFilteredDataSourceSectionsOfSnapshot([self.dataSource snapshot]),
+                                                          nil,
+                                                          self.filterBlock) mutableCopy];
+    self.sourceRows = nil;
+    
+    [self reloadData];
+}
+
+- (BOOL)itemMatchesAtSourceIndexPath:(NSIndexPath *)indexPath {
+    id item = [self.dataSource itemAtIndexPath:indexPath];
+    
+    return (item && (!self.filterBlock || self.filterBlock(item)));
+}
+
+- (NSMutableIndexSet *)matchingRowsInSourceSection:(NSUInteger)section {
+    NSMutableIndexSet *rows = [NSMutableIndexSet indexSet];
+    NSUInteger count = [self.dataSource numberOfItemsInSection:(NSInteger)section];
+    
+    for (NSUInteger row = 0; row < count; row++) {
+        if ([self itemMatchesAtSourceIndexPath:[NSIndexPath indexPathForRow:(NSInteger)row
+                                                                  inSection:(NSInteger)section]]) {
+            [rows addIndex:row];
+        }
+    }
+    
+    return rows;
+}
+
+#pragma mark - SSDataSourceObserver
+
+- (void)dataSource:(SSBaseDataSource *)dataSource didInsertItemsAtIndexPaths:(NSArray *)indexPaths {
+    NSMutableArray *insertedIndexPaths = [NSMutableArray array];
+    
+    // Ascending, so each insert only shifts the rows after it.
+    for (NSIndexPath *sourceIndexPath in [indexPaths sortedArrayUsingSelector:@selector(compare:)]) {
+        if (![self isValidSourceSection:sourceIndexPath.section]) {
+            [self reloadMatchingRows];
+            return;
+        }
+    
+        NSUInteger section = (NSUInteger)sourceIndexPath.section;
+        NSUInteger row = (NSUInteger)sourceIndexPath.row;
+        NSMutableIndexSet *rows = self.matchingRows[section];
+    
+        [rows shiftIndexesStartingAtIndex:row by:1];
+        [self invalidateSourceRowsInSection:section];
+    
+        if ([self itemMatchesAtSourceIndexPath:sourceIndexPath]) {
+            [rows addIndex:row];
+            [insertedIndexPaths addObject:[self indexPathForSourceRow:row inSection:section]];
+        }
+    }
+    
+    if ([insertedIndexPaths count] > 0) {
+        [self insertCellsAtIndexPaths:insertedIndexPaths];
+    }
+}
+
+- (void)dataSource:(SSBaseDataSource *)dataSource didDeleteItemsAtIndexPaths:(NSArray *)indexPaths {
+    NSMutableArray *deletedIndexPaths = [NSMutableArray array];
+    
+    // Descending, so each filtered index path is counted before any earlier rows are removed.
+    for (NSIndexPath *sourceIndexPath in [[indexPaths sortedArrayUsingSelector:@selector(compare:)] reverseObjectEnumerator]) {
+        if (![self isValidSourceSection:sourceIndexPath.section]) {
+            [self reloadMatchingRows];
+            return;
+        }
+    
+        NSUInteger section = (NSUInteger)sourceIndexPath.section;
+        NSUInteger row = (NSUInteger)sourceIndexPath.row;
+        NSMutableIndexSet *rows = self.matchingRows[section];
+    
+        if ([rows containsIndex:row]) {
+            [deletedIndexPaths addObject:[self indexPathForSourceRow:row inSection:section]];
+            [rows removeIndex:row];
+        }
+    
+        [rows shiftIndexesStartingAtIndex:row + 1 by:-1];
+        [self invalidateSourceRowsInSection:section];
+    }
+    
+    if ([deletedIndexPaths count] > 0) {
+        [self deleteCellsAtIndexPaths:deletedIndexPaths];
+    }
+}
+
+- (void)dataSource:(SSBaseDataSource *)dataSource didReloadItemsAtIndexPaths:(NSArray *)indexPaths {
+    NSMutableArray *deletedIndexPaths = [NSMutableArray array];
+    NSMutableArray *reloadedIndexPaths = [NSMutableArray array];
+    NSMutableArray *addedSourceIndexPaths = [NSMutableArray array];
+    NSMutableArray *removedSourceIndexPaths = [NSMutableArray array];
+    
+    // Reloaded items may now pass or fail the filter. Deletes and reloads
+    // are counted before any rows change, inserts after.
+    for (NSIndexPath *sourceIndexPath in indexPaths) {
+        if (![self isValidSourceSection:sourceIndexPath.section]) {
+            [self reloadMatchingRows];
+            return;
+        }
+    
+        NSUInteger section = (NSUInteger)sourceIndexPath.section;
+        NSUInteger row = (NSUInteger)sourceIndexPath.row;
+        BOOL wasMatching = [self.matchingRows[section] containsIndex:row];
+        BOOL isMatching = [self itemMatchesAtSourceIndexPath:sourceIndexPath];
+    
+        if (wasMatching && isMatching) {
+            [reloadedIndexPaths addObject:[self indexPathForSourceRow:row inSection:section]];
+        } else if (wasMatching) {
+            [deletedIndexPaths addObject:[self indexPathForSourceRow:row inSection:section]];
+            [removedSourceIndexPaths addObject:sourceIndexPath];
+        } else if (isMatching) {
+            [addedSourceIndexPaths addObject:sourceIndexPath];
+        }
+    }
+    
+    for (NSIndexPath *sourceIndexPath in removedSourceIndexPaths) {
+        [self.matchingRows[(NSUInteger)sourceIndexPath.section] removeIndex:(NSUInteger)sourceIndexPath.row];
+        [self invalidateSourceRowsInSection:(NSUInteger)sourceIndexPath.section];
+    }
+    
+    for (NSIndexPath *sourceIndexPath in addedSourceIndexPaths) {
+        [self.matchingRows[(NSUInteger)sourceIndexPath.section] addIndex:(NSUInteger)sourceIndexPath.row];
+        [self invalidateSourceRowsInSection:(NSUInteger)sourceIndexPath.section];
+    }
+    
+    NSMutableArray *insertedIndexPaths = [NSMutableArray arrayWithCapacity:[addedSourceIndexPaths count]];
+    
+    for (NSIndexPath *sourceIndexPath in addedSourceIndexPaths) {
+        [insertedIndexPaths addObject:[self indexPathForSourceRow:(NSUInteger)sourceIndexPath.row
+                                                        inSection:(NSUInteger)sourceIndexPath.section]];
+    }
+    
+    if ([deletedIndexPaths count] == 0 && [insertedIndexPaths count] == 0) {
+        if ([reloadedIndexPaths count] > 0) {
+            [self reloadCellsAtIndexPaths:reloadedIndexPaths];
+        }
+    
+        return;
+    }
+    
+    [self performBatchUpdates:^{
+        if ([deletedIndexPaths count] > 0) {
+            [self deleteCellsAtIndexPaths:deletedIndexPaths];
+        }
+    
+        if ([insertedIndexPaths count] > 0) {
+            [self insertCellsAtIndexPaths:insertedIndexPaths];
+        }
+    
+        if ([reloadedIndexPaths count] > 0) {
+            [self reloadCellsAtIndexPaths:reloadedIndexPaths];
+        }
+    }];
+}
+
+- (void)dataSource:(SSBaseDataSource *)dataSource
+didMoveItemAtIndexPath:(NSIndexPath *)fromIndexPath
+       toIndexPath:(NSIndexPath *)toIndexPath {
+    
+    if (![self isValidSourceSection:fromIndexPath.section]
+        || ![self isValidSourceSection:toIndexPath.section]) {
+        [self reloadMatchingRows];
+        return;
+    }
+    
+    NSUInteger fromSection = (NSUInteger)fromIndexPath.section, fromRow = (NSUInteger)fromIndexPath.row;
+    NSUInteger toSection = (NSUInteger)toIndexPath.section, toRow = (NSUInteger)toIndexPath.row;
+    NSMutableIndexSet *fromRows = self.matchingRows[fromSection];
+    NSMutableIndexSet *toRows = self.matchingRows[toSection];
+    BOOL isMatching = [fromRows containsIndex:fromRow];
+    NSIndexPath *filteredFromIndexPath = (isMatching
+                                          ? [self indexPathForSourceRow:fromRow inSection:fromSection]
+                                          : nil);
+    
+    [fromRows removeIndex:fromRow];
+    [fromRows shiftIndexesStartingAtIndex:fromRow + 1 by:-1];
+    [toRows shiftIndexesStartingAtIndex:toRow by:1];
+    
+    [self invalidateSourceRowsInSection:fromSection];
+    [self invalidateSourceRowsInSection:toSection];
+    
+    if (isMatching) {
+        [toRows addIndex:toRow];
+        [self moveCellAtIndexPath:filteredFromIndexPath
+                      toIndexPath:[self indexPathForSourceRow:toRow inSection:toSection]];
+    }
+}
+
+- (void)dataSource:(SSBaseDataSource *)dataSource didInsertSections:(NSIndexSet *)sections {
+    if ([sections lastIndex] >= [self.matchingRows count] + [sections count]) {
+        [self reloadMatchingRows];
+        return;
+    }
+    
+    [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop) {
+        [self.matchingRows insertObject:[self matchingRowsInSourceSection:section]
+                                atIndex:section];
+    }];
+    
+    self.sourceRows = nil;
+    [self insertSectionsAtIndexes:sections];
+}
+
+- (void)dataSource:(SSBaseDataSource *)dataSource didDeleteSections:(NSIndexSet *)sections {
+    if ([sections lastIndex] >= [self.matchingRows count]) {
+        [self reloadMatchingRows];
+        return;
+    }
+    
+    [self.matchingRows removeObjectsAtIndexes:sections];
+    
+    self.sourceRows = nil;
+    [self deleteSectionsAtIndexes:sections];
+}
+
+- (void)dataSource:(SSBaseDataSource *)dataSource didReloadSections:(NSIndexSet *)sections {
+    if ([sections lastIndex] >= [self.matchingRows count]) {
+        [self reloadMatchingRows];
+        return;
+    }
+    
+    [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop) {
+        self.matchingRows[section] = [self matchingRowsInSourceSection:section];
+    }];
+    
+    self.sourceRows = nil;
+    [self reloadSectionsAtIndexes:sections];
+}
+
+- (void)dataSource:(SSBaseDataSource *)dataSource
+    didMoveSection:(NSUInteger)fromSection
+         toSection:(NSUInteger)toSection {
+    
+    if (fromSection >= [self.matchingRows count] || toSection >= [self.matchingRows count]) {
+        [self reloadMatchingRows];
+        return;
+    }
+    
+    NSMutableIndexSet *rows = self.matchingRows[fromSection];
+    
+    [self.matchingRows removeObjectAtIndex:fromSection];
+    [self.matchingRows insertObject:rows atIndex:toSection];
+    
+    self.sourceRows = nil;
+    [self moveSectionAtIndex:(NSInteger)fromSection toIndex:(NSInteger)toSection];
+}
+
+- (void)dataSource:(SSBaseDataSource *)dataSource didApplyChanges:(SSSectionedDiff *)changes {
+    NSArray *oldMatchingRows = self.matchingRows;
+    NSUInteger sectionCount = [dataSource numberOfSections];
+    
+    // Filtered sections are the source's sections, so they change just as the source's did.
+    if (![changes isValidFromSectionCount:[oldMatchingRows count] toSectionCount:sectionCount]) {
+        [self reloadMatchingRows];
+        return;
+    }
+    
+    // Moved rows are handled below, once every section's matching rows are known.
+    NSMutableSet *movedFromIndexPaths = [NSMutableSet setWithCapacity:[changes.moves count]];
+    NSMutableSet *movedToIndexPaths = [NSMutableSet setWithCapacity:[changes.moves count]];
+    
+    for (SSSectionedDiffMove *move in changes.moves) {
+        [movedFromIndexPaths addObject:move.fromIndexPath];
+        [movedToIndexPaths addObject:move.toIndexPath];
+    }
+    
+    NSMutableArray *newMatchingRows = [NSMutableArray arrayWithCapacity:sectionCount];
+    NSMutableIndexSet *rebuiltSections = [NSMutableIndexSet indexSet];
+    NSMutableArray *deletedIndexPaths = [NSMutableArray array];
+    NSMutableArray *insertedIndexPaths = [NSMutableArray array];
+    NSMutableArray *reloadedIndexPaths = [NSMutableArray array];
+    NSMutableArray *resizedIndexPaths = [NSMutableArray array];
+    
+    for (NSUInteger section = 0; section < sectionCount; section++) {
+        NSUInteger fromSection = [changes sectionBeforeChangesForSection:section];
+    
+        // Inserted and reloaded sections are tested from scratch.
+        if (fromSection == NSNotFound || [changes.reloadedSections containsIndex:fromSection]) {
+            [newMatchingRows addObject:[self matchingRowsInSourceSection:section]];
+            [rebuiltSections addIndex:section];
+            continue;
+        }
+    
+        NSIndexSet *oldRows = oldMatchingRows[fromSection];
+        NSIndexSet *removed = [changes removedRowsInSection:fromSection];
+        NSIndexSet *added = [changes addedRowsInSection:section];
+        NSIndexSet *reloaded = [changes reloadedRowsInSection:fromSection];
+    
+        if ([removed count] == 0 && [added count] == 0 && [reloaded count] == 0) {
+            [newMatchingRows addObject:oldRows];
+            continue;
+        }
+    
+        NSMutableIndexSet *rows = [oldRows mutableCopy];
+    
+        [removed enumerateIndexesWithOptions:NSEnumerationReverse
+                                  usingBlock:^(NSUInteger row, BOOL *stop) {
+            [rows removeIndex:row];
+            [rows shiftIndexesStartingAtIndex:row + 1 by:-1];
+        }];
+    
+        [added enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+            [rows shiftIndexesStartingAtIndex:row by:1];
+    
+            if ([self itemMatchesAtSourceIndexPath:[NSIndexPath indexPathForRow:(NSInteger)row
+                                                                      inSection:(NSInteger)section]]) {
+                [rows addIndex:row];
+            }
+        }];
+    
+        // Reloaded rows are tested again where they end up. Rows keep their order,
+        // so the old and new rows of the reloads pair up in ascending order.
+        NSMutableIndexSet *reloadedOldRows = [NSMutableIndexSet indexSet];
+        NSMutableIndexSet *reloadedNewRows = [NSMutableIndexSet indexSet];
+        NSMutableIndexSet *wasMatching = [NSMutableIndexSet indexSet];
+    
+        [reloaded enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+            NSIndexPath *newIndexPath = [changes indexPathAfterChangesForIndexPath:
+                                         [NSIndexPath indexPathForRow:(NSInteger)row inSection:(NSInteger)fromSection]];
+    
+            if (!newIndexPath) {
+                return;
+            }
+    
+            NSUInteger newRow = (NSUInteger)newIndexPath.row;
+    
+            if ([oldRows containsIndex:row]) {
+                [wasMatching addIndex:newRow];
+            }
+    
+            [reloadedOldRows addIndex:row];
+            [reloadedNewRows addIndex:newRow];
+    
+            if ([self itemMatchesAtSourceIndexPath:[NSIndexPath indexPathForRow:(NSInteger)newRow
+                                                                      inSection:(NSInteger)section]]) {
+                [rows addIndex:newRow];
+            } else {
+                [rows removeIndex:newRow];
+            }
+        }];
+    
+        [newMatchingRows addObject:rows];
+    
+        // Deletes and reloads are counted among the old matching rows, inserts among the new.
+        [removed enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+            NSIndexPath *indexPath = [NSIndexPath indexPathForRow:(NSInteger)row inSection:(NSInteger)fromSection];
+    
+            if ([oldRows containsIndex:row] && ![movedFromIndexPaths containsObject:indexPath]) {
+                [deletedIndexPaths addObject:[NSIndexPath indexPathForRow:(NSInteger)[oldRows countOfIndexesInRange:NSMakeRange(0, row)]
+                                                                inSection:(NSInteger)fromSection]];
+            }
+        }];
+    
+        [added enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+            NSIndexPath *indexPath = [NSIndexPath indexPathForRow:(NSInteger)row inSection:(NSInteger)section];
+    
+            if ([rows containsIndex:row] && ![movedToIndexPaths containsObject:indexPath]) {
+                [insertedIndexPaths addObject:[NSIndexPath indexPathForRow:(NSInteger)[rows countOfIndexesInRange:NSMakeRange(0, row)]
+                                                                 inSection:(NSInteger)section]];
+            }
+        }];
+    
+        __block NSUInteger reloadIndex = [reloadedOldRows firstIndex];
+    
+        [reloadedNewRows enumerateIndexesUsingBlock:^(NSUInteger newRow, BOOL *stop) {
+            NSUInteger row = reloadIndex;
+            NSIndexPath *oldIndexPath = [NSIndexPath indexPathForRow:(NSInteger)[oldRows countOfIndexesInRange:NSMakeRange(0, row)]
+                                                           inSection:(NSInteger)fromSection];
+            NSIndexPath *newIndexPath = [NSIndexPath indexPathForRow:(NSInteger)[rows countOfIndexesInRange:NSMakeRange(0, newRow)]
+                                                           inSection:(NSInteger)section];
+    
+            reloadIndex = [reloadedOldRows indexGreaterThanIndex:reloadIndex];
+    
+            if ([wasMatching containsIndex:newRow] && [rows containsIndex:newRow]) {
+                [reloadedIndexPaths addObject:oldIndexPath];
+                [resizedIndexPaths addObject:newIndexPath];
+            } else if ([wasMatching containsIndex:newRow]) {
+                [deletedIndexPaths addObject:oldIndexPath];
+            } else if ([rows containsIndex:newRow]) {
+                [insertedIndexPaths addObject:newIndexPath];
+            }
+        }];
+    }
+    
+    // Moved rows stay moves while they pass the filter before and after.
+    NSMutableArray *moves = [NSMutableArray array];
+    
+    for (SSSectionedDiffMove *move in changes.moves) {
+        NSUInteger fromSection = (NSUInteger)move.fromIndexPath.section, fromRow = (NSUInteger)move.fromIndexPath.row;
+        NSUInteger toSection = (NSUInteger)move.toIndexPath.section, toRow = (NSUInteger)move.toIndexPath.row;
+        BOOL fromSurvives = ([changes sectionAfterChangesForSection:fromSection] != NSNotFound
+                             && ![changes.reloadedSections containsIndex:fromSection]);
+        BOOL toSurvives = (toSection < sectionCount && ![rebuiltSections containsIndex:toSection]);
+        NSIndexSet *oldRows = (fromSurvives ? oldMatchingRows[fromSection] : nil);
+        NSIndexSet *rows = (toSurvives ? newMatchingRows[toSection] : nil);
+        NSIndexPath *fromIndexPath = ([oldRows containsIndex:fromRow]
+                                      ? [NSIndexPath indexPathForRow:(NSInteger)[oldRows countOfIndexesInRange:NSMakeRange(0, fromRow)]
+                                                           inSection:(NSInteger)fromSection]
+                                      : nil);
+        NSIndexPath *toIndexPath = ([rows containsIndex:toRow]
+                                    ? [NSIndexPath indexPathForRow:(NSInteger)[rows countOfIndexesInRange:NSMakeRange(0, toRow)]
+                                                         inSection:(NSInteger)toSection]
+                                    : nil);
+    
+        if (fromIndexPath && toIndexPath) {
+            [moves addObject:@[ fromIndexPath, toIndexPath ]];
+        } else if (fromIndexPath) {
+            [deletedIndexPaths addObject:fromIndexPath];
+        } else if (toIndexPath) {
+            [insertedIndexPaths addObject:toIndexPath];
+        }
+    }
+    
+    NSUInteger changeCount = ([changes.deletedSections count] + [changes.insertedSections count]
+                              + [changes.reloadedSections count] + [changes.sectionMoves count]
+                              + [deletedIndexPaths count] + [insertedIndexPaths count]
+                              + [reloadedIndexPaths count] + [moves count]);
+    
+    if (changeCount == 0) {
+        self.matchingRows = newMatchingRows;
+        self.sourceRows = nil;
+        return;
+    }
+    
+    if ([self exceedsMaximumAnimatedChangeCount:changeCount]) {
+        self.matchingRows = newMatchingRows;
+        self.sourceRows = nil;
+        [self reloadData];
+        return;
+    }
+    
+    [self performBatchUpdates:^{
+        self.matchingRows = newMatchingRows;
+        self.sourceRows = nil;
+    
+        if ([changes.deletedSections count] > 0) {
+            [self deleteSectionsAtIndexes:changes.deletedSections];
+        }
+    
+        if ([changes.insertedSections count] > 0) {
+            [self insertSectionsAtIndexes:changes.insertedSections];
+        }
+    
+        if ([changes.reloadedSections count] > 0) {
+            [self reloadSectionsAtIndexes:changes.reloadedSections];
+        }
+    
+        for (SSArrayDiffMove *move in changes.sectionMoves) {
+            [self moveSectionAtIndex:(NSInteger)move.fromIndex toIndex:(NSInteger)move.toIndex];
+        }
+    
+        if ([deletedIndexPaths count] > 0) {
+            [self deleteCellsAtIndexPaths:deletedIndexPaths];
+        }
+    
+        if ([insertedIndexPaths count] > 0) {
+            [self insertCellsAtIndexPaths:insertedIndexPaths];
+        }
+    
+        if ([reloadedIndexPaths count] > 0) {
+            [self reloadCellsAtIndexPaths:reloadedIndexPaths];
+        }
+    
+        for (NSArray *move in moves) {
+            [self moveCellAtIndexPath:move[0] toIndexPath:move[1]];
+        }
+    }];
+    
+    // Within the batch, reloaded rows were only known by their old index paths.
+    [self invalidateSizesForItemsAtIndexPaths:resizedIndexPaths];
+}
+
+- (void)dataSourceDidReloadData:(SSBaseDataSource *)dataSource {
+    [self reloadMatchingRows];
+}
+
+@end
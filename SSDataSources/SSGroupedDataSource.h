@@ -0,0 +1,103 @@
+//
+//  SSGroupedDataSource.h
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSSectionedDataSource.h"
+
+// Block called to find the group of an item. May be called on a background queue,
+// so it should depend only on the item.
+typedef id (^SSItemGroupBlock) (id item);          // The item to group
+
+/**
+ * A sectioned data source that groups a flat array of items into sections,
+ * much as `sectionNameKeyPath` does for SSCoreDataSource.
+ *
+ * Each group becomes a section whose `sectionIdentifier` is the group; groups that are strings
+ * also become the section's header. Items keep their relative order within each section.
+ * Sections appear in the order their groups are first seen, or in the order of `groupComparator`.
+ *
+ * Updating the items animates only the section and item changes needed,
+ * as with -[SSSectionedDataSource applySections:].
+ */
+
+@interface SSGroupedDataSource : SSSectionedDataSource
+
+/**
+ *  Create a grouped data source.
+ *
+ *  @param items      the items to group
+ *  @param groupBlock block returning the group of each item. A nil group is grouped as NSNull.
+ *
+ *  @return an initialized data source
+ */
+- (instancetype) initWithItems:(NSArray *)items groupBlock:(SSItemGroupBlock)groupBlock;
+
+/**
+ *  Create a grouped data source.
+ *
+ *  @param items        the items to group
+ *  @param groupKeyPath key path of each item's group
+ *
+ *  @return an initialized data source
+ */
+- (instancetype) initWithItems:(NSArray *)items groupKeyPath:(NSString *)groupKeyPath;
+
+/**
+ * The block returning the group of each item.
+ */
+@property (nonatomic, copy, readonly) SSItemGroupBlock groupBlock;
+
+/**
+ * Optional comparator for ordering sections by their groups.
+ * Setting a new comparator animates sections into their new order.
+ */
+@property (nonatomic, copy) NSComparator groupComparator;
+
+#pragma mark - Updating items
+
+/**
+ * Replace all items in the data source, grouping them again.
+ */
+- (void) updateItems:(NSArray *)items;
+
+/**
+ *  As above, but the items are grouped and diffed on background queues
+ *  and the changes are then animated on the main thread. Large arrays of items
+ *  are grouped in parallel.
+ *
+ *  As with -[SSSectionedDataSource applySections:completion:], a newer update
+ *  supersedes an earlier one, and `groupBlock`, `itemIdentifierBlock` and `itemEqualityBlock`
+ *  must be safe to call from any thread.
+ *
+ *  @param items      the new items
+ *  @param completion optional block called on the main thread once the update
+ *                    has been applied (YES) or superseded by a newer update (NO)
+ */
+- (void) updateItems:(NSArray *)items completion:(void (^)(BOOL finished))completion;
+
+/**
+ *  Add an item to the end of its group's section, inserting the section if needed.
+ *
+ *  @param item the item to add
+ *
+ *  @return the item's index path
+ */
+- (NSIndexPath *) insertItem:(id)item;
+
+/**
+ *  Call after changing an item in a way that may change its group.
+ *  An item that changed groups is moved to the end of its new group's section,
+ *  inserting and removing sections as needed, and its cell, if visible, is configured again.
+ *  Otherwise its cell is reloaded.
+ *
+ *  @param indexPath the item's current index path
+ *
+ *  @return the item's new index path
+ */
+- (NSIndexPath *) regroupItemAtIndexPath:(NSIndexPath *)indexPath;
+
+@end
@@ -0,0 +1,292 @@
+//
+//  SSGroupedDataSource.m
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSDataSources.h"
+
+// Items are grouped in parallel, in chunks of this many, when there are at least two chunks.
+static const NSUInteger SSGroupedDataSourceChunkSize = 1024;
+
+static SSSection * SSGroupedDataSourceSection(id group, NSArray *items) {
+    SSSection *section = [SSSection sectionWithItems:items];
+    section.sectionIdentifier = group;
+    
+    if ([group isKindOfClass:[NSString class]]) {
+        section.header = group;
+    }
+    
+    return section;
+}
+
+// Index at which to insert a new section among `sections`.
+static NSUInteger SSGroupedDataSourceIndexForSection(NSArray *sections,
+                                                     SSSection *section,
+                                                     NSComparator groupComparator) {
+    if (!groupComparator) {
+        return [sections count];
+    }
+    
+    return [sections indexOfObject:section
+                     inSortedRange:NSMakeRange(0, [sections count])
+                           options:(NSBinarySearchingInsertionIndex | NSBinarySearchingLastEqual)
+                   usingComparator:^NSComparisonResult(SSSection *section1, SSSection *section2) {
+                       return groupComparator(section1.sectionIdentifier, section2.sectionIdentifier);
+                   }];
+}
+
+// The group of each item, in order.
+static NSArray * SSGroupedDataSourceGroups(NSArray *items, SSItemGroupBlock groupBlock) {
+    NSUInteger count = [items count];
+    NSUInteger chunkCount = (count + SSGroupedDataSourceChunkSize - 1) / SSGroupedDataSourceChunkSize;
+    NSMutableArray *groups = [NSMutableArray arrayWithCapacity:count];
+    
+    if (chunkCount < 2) {
+        for (id item in items) {
+            [groups addObject:(groupBlock(item) ?: [NSNull null])];
+        }
+    
+        return groups;
+    }
+    
+    NSArray * __strong *chunkGroups = (NSArray * __strong *)calloc(chunkCount, sizeof(NSArray *));
+    
+    dispatch_apply(chunkCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t chunk) {
+        NSUInteger start = chunk * SSGroupedDataSourceChunkSize;
+        NSUInteger end = MIN(start + SSGroupedDataSourceChunkSize, count);
+        NSMutableArray *groupsInChunk = [NSMutableArray arrayWithCapacity:end - start];
+    
+        for (NSUInteger i = start; i < end; i++) {
+            [groupsInChunk addObject:(groupBlock(items[i]) ?: [NSNull null])];
+        }
+    
+        chunkGroups[chunk] = groupsInChunk;
+    });
+    
+    for (NSUInteger chunk = 0; chunk < chunkCount; chunk++) {
+        [groups addObjectsFromArray:chunkGroups[chunk]];
+        chunkGroups[chunk] = nil;
+    }
+    
+    free(chunkGroups);
+    
+    return groups;
+}
+
+// Group items into sections. Safe to call on any queue.
+static NSArray * SSGroupedDataSourceSections(NSArray *items,
+                                             SSItemGroupBlock groupBlock,
+                                             NSComparator groupComparator) {
+    NSArray *groups = SSGroupedDataSourceGroups(items, groupBlock);
+    NSMapTable *itemsByGroup = [NSMapTable strongToStrongObjectsMapTable];
+    NSMutableArray *orderedGroups = [NSMutableArray array];
+    
+    [items enumerateObjectsUsingBlock:^(id item, NSUInteger index, BOOL *stop) {
+        id group = groups[index];
+        NSMutableArray *groupItems = [itemsByGroup objectForKey:group];
+    
+        if (!groupItems) {
+            groupItems = [NSMutableArray array];
+            [itemsByGroup setObject:groupItems forKey:group];
+            [orderedGroups addObject:group];
+        }
+    
+        [groupItems addObject:item];
+    }];
+    
+    if (groupComparator) {
+        [orderedGroups sortWithOptions:NSSortStable usingComparator:groupComparator];
+    }
+    
+    NSMutableArray *sections = [NSMutableArray arrayWithCapacity:[orderedGroups count]];
+    
+    for (id group in orderedGroups) {
+        [sections addObject:SSGroupedDataSourceSection(group, [itemsByGroup objectForKey:group])];
+    }
+    
+    return sections;
+}
+
+@interface SSGroupedDataSource ()
+
+- (id)groupOfItem:(id)item;
+
+// Copies of the current sections, which may be changed without affecting the data source.
+- (NSMutableArray *)copiedSections;
+
+// Implemented by SSSectionedDataSource
+- (void)applyDiff:(SSSectionedDiff *)diff withSections:(NSArray *)newSections;
+- (NSArray *)sectionsForBackgroundDiff;
+
+// Implemented by SSBaseDataSource
+- (void)_reconfigureCellAtIndexPath:(NSIndexPath *)indexPath;
+
+// Background diffing, implemented by SSBaseDataSource
+- (void)_performBackgroundDiff:(id (^)(void))diffBlock
+                         apply:(BOOL (^)(id diff))applyBlock
+                         retry:(void (^)(void))retryBlock
+                    completion:(void (^)(BOOL finished))completion;
+
+@end
+
+@implementation SSGroupedDataSource
+
+- (instancetype)initWithItems:(NSArray *)items groupBlock:(SSItemGroupBlock)groupBlock {
+    NSParameterAssert(groupBlock);
+    
+    if ((self = [self init])) {
+        _groupBlock = [groupBlock copy];
+    
+        NSArray *sections = SSGroupedDataSourceSections(items ?: @[], _groupBlock, nil);
+    
+        if ([sections count] > 0) {
+            [self insertSections:sections
+                       atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, [sections count])]];
+        }
+    }
+    
+    return self;
+}
+
+- (instancetype)initWithItems:(NSArray *)items groupKeyPath:(NSString *)groupKeyPath {
+    NSParameterAssert(groupKeyPath);
+    
+    NSString *keyPath = [groupKeyPath copy];
+    
+    return [self initWithItems:items groupBlock:^id(id item) {
+        return [item valueForKeyPath:keyPath];
+    }];
+}
+
+- (void)setGroupComparator:(NSComparator)groupComparator {
+    _groupComparator = [groupComparator copy];
+    
+    if (!_groupComparator || [self numberOfSections] < 2) {
+        return;
+    }
+    
+    NSComparator comparator = _groupComparator;
+    
+    [self applySections:[[self copiedSections] sortedArrayWithOptions:NSSortStable
+                                                      usingComparator:^NSComparisonResult(SSSection *section1,
+                                                                                          SSSection *section2) {
+        return comparator(section1.sectionIdentifier, section2.sectionIdentifier);
+    }]];
+}
+
+- (id)groupOfItem:(id)item {
+    return (self.groupBlock(item) ?: [NSNull null]);
+}
+
+- (NSMutableArray *)copiedSections {
+    NSMutableArray *sections = [NSMutableArray arrayWithCapacity:[self.sections count]];
+    
+    for (SSSection *section in self.sections) {
+        [sections addObject:[section copy]];
+    }
+    
+    return sections;
+}
+
+#pragma mark - Updating items
+
+- (void)updateItems:(NSArray *)items {
+    [self applySections:SSGroupedDataSourceSections(items ?: @[], self.groupBlock, self.groupComparator)];
+}
+
+- (void)updateItems:(NSArray *)items completion:(void (^)(BOOL))completion {
+    NSArray *newItems = ([items copy] ?: @[]);
+    NSArray *oldSections = [self sectionsForBackgroundDiff];
+    SSItemGroupBlock groupBlock = self.groupBlock;
+    NSComparator groupComparator = self.groupComparator;
+    SSItemIdentifierBlock identifierBlock = self.itemIdentifierBlock;
+    SSItemEqualityBlock equalityBlock = self.itemEqualityBlock;
+    __weak SSGroupedDataSource *weakSelf = self;
+    
+    [self _performBackgroundDiff:^id{
+        NSArray *sections = SSGroupedDataSourceSections(newItems, groupBlock, groupComparator);
+    
+        return @[ sections, [SSSectionedDiff diffFromSections:oldSections
+                                                   toSections:sections
+                                              identifierBlock:identifierBlock
+                                                equalityBlock:equalityBlock] ];
+    } apply:^BOOL(NSArray *sectionsAndDiff) {
+        [weakSelf applyDiff:sectionsAndDiff[1] withSections:sectionsAndDiff[0]];
+        return YES;
+    } retry:^{
+        [weakSelf updateItems:newItems completion:completion];
+    } completion:completion];
+}
+
+- (NSIndexPath *)insertItem:(id)item {
+    id group = [self groupOfItem:item];
+    NSUInteger sectionIndex = [self indexOfSectionWithIdentifier:group];
+    
+    if (sectionIndex == NSNotFound) {
+        SSSection *section = SSGroupedDataSourceSection(group, @[ item ]);
+    
+        sectionIndex = SSGroupedDataSourceIndexForSection(self.sections, section, self.groupComparator);
+        [self insertSection:section atIndex:(NSInteger)sectionIndex];
+    
+        return [NSIndexPath indexPathForRow:0 inSection:(NSInteger)sectionIndex];
+    }
+    
+    NSIndexPath *indexPath = [NSIndexPath indexPathForRow:(NSInteger)[self numberOfItemsInSection:(NSInteger)sectionIndex]
+                                                inSection:(NSInteger)sectionIndex];
+    
+    [self insertItem:item atIndexPath:indexPath];
+    
+    return indexPath;
+}
+
+- (NSIndexPath *)regroupItemAtIndexPath:(NSIndexPath *)indexPath {
+    SSSection *fromSection = [self sectionAtIndex:indexPath.section];
+    id item = [self itemAtIndexPath:indexPath];
+    id group = [self groupOfItem:item];
+    
+    if ([group isEqual:fromSection.sectionIdentifier]) {
+        [self reloadCellsAtIndexPaths:@[ indexPath ]];
+        return indexPath;
+    }
+    
+    NSUInteger toSectionIndex = [self indexOfSectionWithIdentifier:group];
+    NSInteger fromSectionIndex = indexPath.section;
+    
+    // A new group gets an empty section for the item to move into.
+    if (toSectionIndex == NSNotFound) {
+        SSSection *section = SSGroupedDataSourceSection(group, @[]);
+    
+        toSectionIndex = SSGroupedDataSourceIndexForSection(self.sections, section, self.groupComparator);
+        [self insertSection:section atIndex:(NSInteger)toSectionIndex];
+    
+        if ((NSInteger)toSectionIndex <= fromSectionIndex) {
+            fromSectionIndex++;
+        }
+    }
+    
+    SSSection *toSection = [self sectionAtIndex:(NSInteger)toSectionIndex];
+    NSIndexPath *newIndexPath = [NSIndexPath indexPathForRow:(NSInteger)[toSection numberOfItems]
+                                                   inSection:(NSInteger)toSectionIndex];
+    
+    [fromSection.items removeObjectAtIndex:(NSUInteger)indexPath.row];
+    [toSection.items addObject:item];
+    [self moveCellAtIndexPath:[NSIndexPath indexPathForRow:indexPath.row inSection:fromSectionIndex]
+                  toIndexPath:newIndexPath];
+    
+    if ([fromSection numberOfItems] == 0 && self.shouldRemoveEmptySections) {
+        [self removeSectionAtIndex:fromSectionIndex];
+    
+        if (fromSectionIndex < (NSInteger)toSectionIndex) {
+            newIndexPath = [NSIndexPath indexPathForRow:newIndexPath.row inSection:newIndexPath.section - 1];
+        }
+    }
+    
+    [self _reconfigureCellAtIndexPath:newIndexPath];
+    
+    return newIndexPath;
+}
+
+@end
@@ -0,0 +1,91 @@
+//
+//  SSItemSizeCache.h
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
+
+/**
+ * A cache of cell sizes keyed by item identifier and available width.
+ * An item may have a different size at each width, e.g. in portrait and landscape.
+ *
+ * Used by SSBaseDataSource, which removes sizes for items that are reloaded or replaced;
+ * see -[SSBaseDataSource sizeForItemAtIndexPath:width:]. Not thread-safe; use on the main thread.
+ */
+
+@interface SSItemSizeCache : NSObject
+
+/**
+ * Number of items with at least one cached size.
+ */
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/**
+ * Incremented whenever sizes are removed.
+ */
+@property (nonatomic, assign, readonly) NSUInteger invalidationCount;
+
+/**
+ * YES while any items are being measured; see `beginMeasuringIdentifiers:`.
+ */
+@property (nonatomic, assign, readonly, getter=isMeasuring) BOOL measuring;
+
+/**
+ *  Look up the size of an item.
+ *
+ *  @param size       on return, the cached size, if any
+ *  @param identifier identifier of the item
+ *  @param width      width for which the size was cached
+ *
+ *  @return YES if a size was cached for this item and width
+ */
+- (BOOL) getSize:(CGSize *)size forIdentifier:(id)identifier width:(CGFloat)width;
+
+/**
+ *  Cache the size of an item at a width.
+ *
+ *  @param size       the size of the item
+ *  @param identifier identifier of the item
+ *  @param width      the available width used to compute `size`
+ */
+- (void) setSize:(CGSize)size forIdentifier:(id)identifier width:(CGFloat)width;
+
+/**
+ *  Remove all sizes cached for an item.
+ *
+ *  @param identifier identifier of the item
+ */
+- (void) removeSizesForIdentifier:(id)identifier;
+
+/**
+ *  Remove all cached sizes.
+ */
+- (void) removeAllSizes;
+
+/**
+ *  Note that items are being measured away from the cache, e.g. on a background queue,
+ *  so that their sizes can be discarded if they are removed in the meantime.
+ *  Call `endMeasuringIdentifier:token:` once for each identifier.
+ *
+ *  @param identifiers identifiers of the items being measured
+ *
+ *  @return a token to pass to `endMeasuringIdentifier:token:`
+ */
+- (NSUInteger) beginMeasuringIdentifiers:(NSArray *)identifiers;
+
+/**
+ *  Finish measuring an item.
+ *
+ *  @param identifier identifier of the item
+ *  @param token      the token returned by `beginMeasuringIdentifiers:`
+ *
+ *  @return YES if the item's sizes weren't removed since it began to be measured,
+ *  so that its new size may be cached
+ */
+- (BOOL) endMeasuringIdentifier:(id)identifier token:(NSUInteger)token;
+
+@end
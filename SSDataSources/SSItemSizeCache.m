@@ -0,0 +1,147 @@
+//
+//  SSItemSizeCache.m
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSDataSources.h"
+
+@interface SSItemSizeCache ()
+
+// Item identifier -> NSMutableDictionary of width (NSNumber) -> size (NSValue).
+// A map table, as identifiers may be items that don't support copying.
+@property (nonatomic, strong) NSMapTable *sizes;
+
+@property (nonatomic, assign, readwrite) NSUInteger invalidationCount;
+
+// Identifiers of items being measured, and for those removed while being measured,
+// the invalidation count when they were last removed. nil until first needed.
+@property (nonatomic, strong) NSCountedSet *measuringIdentifiers;
+@property (nonatomic, strong) NSMapTable *measuringInvalidations;
+
+- (void) noteRemovalOfIdentifier:(id)identifier;
+
+@end
+
+@implementation SSItemSizeCache
+
+- (instancetype)init {
+    if ((self = [super init])) {
+        _sizes = [NSMapTable strongToStrongObjectsMapTable];
+    }
+    
+    return self;
+}
+
+- (NSUInteger)count {
+    return [self.sizes count];
+}
+
+- (BOOL)getSize:(CGSize *)size forIdentifier:(id)identifier width:(CGFloat)width {
+    if (!identifier) {
+        return NO;
+    }
+    
+    NSValue *value = [[self.sizes objectForKey:identifier] objectForKey:@(width)];
+    
+    if (!value) {
+        return NO;
+    }
+    
+    if (size) {
+        *size = [value CGSizeValue];
+    }
+    
+    return YES;
+}
+
+- (void)setSize:(CGSize)size forIdentifier:(id)identifier width:(CGFloat)width {
+    if (!identifier) {
+        return;
+    }
+    
+    NSMutableDictionary *sizesByWidth = [self.sizes objectForKey:identifier];
+    
+    if (!sizesByWidth) {
+        sizesByWidth = [NSMutableDictionary dictionaryWithCapacity:1];
+        [self.sizes setObject:sizesByWidth forKey:identifier];
+    }
+    
+    sizesByWidth[@(width)] = [NSValue valueWithCGSize:size];
+}
+
+- (void)removeSizesForIdentifier:(id)identifier {
+    if (!identifier) {
+        return;
+    }
+    
+    // An item being measured has no size yet, but the size on its way is stale all the same.
+    if ([self.measuringIdentifiers containsObject:identifier]) {
+        [self noteRemovalOfIdentifier:identifier];
+    }
+    
+    if (![self.sizes objectForKey:identifier]) {
+        return;
+    }
+    
+    [self.sizes removeObjectForKey:identifier];
+    self.invalidationCount++;
+}
+
+- (void)removeAllSizes {
+    for (id identifier in self.measuringIdentifiers) {
+        [self noteRemovalOfIdentifier:identifier];
+    }
+    
+    if ([self.sizes count] == 0) {
+        return;
+    }
+    
+    [self.sizes removeAllObjects];
+    self.invalidationCount++;
+}
+
+#pragma mark - Measuring
+
+- (BOOL)isMeasuring {
+    return [self.measuringIdentifiers count] > 0;
+}
+
+- (NSUInteger)beginMeasuringIdentifiers:(NSArray *)identifiers {
+    if (!self.measuringIdentifiers) {
+        self.measuringIdentifiers = [NSCountedSet set];
+        self.measuringInvalidations = [NSMapTable strongToStrongObjectsMapTable];
+    }
+    
+    for (id identifier in identifiers) {
+        [self.measuringIdentifiers addObject:identifier];
+    }
+    
+    return self.invalidationCount;
+}
+
+- (BOOL)endMeasuringIdentifier:(id)identifier token:(NSUInteger)token {
+    if (!identifier || ![self.measuringIdentifiers containsObject:identifier]) {
+        return NO;
+    }
+    
+    NSNumber *removal = [self.measuringInvalidations objectForKey:identifier];
+    
+    [self.measuringIdentifiers removeObject:identifier];
+    
+    if (![self.measuringIdentifiers containsObject:identifier]) {
+        [self.measuringInvalidations removeObjectForKey:identifier];
+    }
+    
+    return (!removal || [removal unsignedIntegerValue] <= token);
+}
+
+- (void)noteRemovalOfIdentifier:(id)identifier {
+    // Later than any token handed out so far.
+    self.invalidationCount++;
+    [self.measuringInvalidations setObject:@(self.invalidationCount) forKey:identifier];
+}
+
+@end
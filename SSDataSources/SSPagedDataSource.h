@@ -0,0 +1,107 @@
+//
+//  SSPagedDataSource.h
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSBaseDataSource.h"
+
+// Block called to load a page of items, e.g. from a server.
+// Call `completion` on the main thread with `range.length` items, or nil if the page failed to load.
+typedef void (^SSPageLoadBlock) (NSRange range,                          // The indexes of the items to load
+                                 void (^completion)(NSArray *items));    // Call with the loaded items
+
+/**
+ * A data source for a single-section table or collection view with a known,
+ * possibly very large number of items that are loaded a page at a time.
+ *
+ * Pages are requested with `pageLoadBlock` as cells near them are displayed or prefetched.
+ * Until its page loads, each item is represented by `placeholderItem`.
+ * A loaded page reloads its rows, but never changes the number of items,
+ * so scrolling is unaffected.
+ *
+ * At most `maximumNumberOfResidentPages` pages are kept in memory;
+ * the pages farthest from the most recently displayed item are discarded first
+ * and reloaded if needed again. Pages with visible rows are never discarded.
+ *
+ * A page that loads fewer items than requested shows placeholders for the rest
+ * and is requested again the next time it is needed.
+ */
+
+@interface SSPagedDataSource : SSBaseDataSource
+
+/**
+ *  Create a paged data source.
+ *
+ *  @param numberOfItems total number of items
+ *  @param pageSize      number of items in each page
+ *  @param pageLoadBlock block used to load pages. See block signature above.
+ *
+ *  @return an initialized data source
+ */
+- (instancetype) initWithNumberOfItems:(NSUInteger)numberOfItems
+                              pageSize:(NSUInteger)pageSize
+                         pageLoadBlock:(SSPageLoadBlock)pageLoadBlock;
+
+/**
+ * Number of items in each page.
+ */
+@property (nonatomic, assign, readonly) NSUInteger pageSize;
+
+/**
+ * Block used to load pages.
+ */
+@property (nonatomic, copy) SSPageLoadBlock pageLoadBlock;
+
+/**
+ * Item to display in place of items whose page has not yet loaded.
+ * Defaults to NSNull.
+ */
+@property (nonatomic, strong) id placeholderItem;
+
+/**
+ * Number of pages before and after the page containing a displayed item
+ * that are loaded ahead of time. Defaults to 1.
+ */
+@property (nonatomic, assign) NSUInteger preloadPageCount;
+
+/**
+ * Maximum number of pages to keep in memory. Never fewer than the pages
+ * needed around a displayed item; see `preloadPageCount`. Defaults to 10.
+ * Exceeded while more pages than this have visible rows.
+ */
+@property (nonatomic, assign) NSUInteger maximumNumberOfResidentPages;
+
+/**
+ * Indexes of the pages currently in memory, including pages that loaded
+ * fewer items than requested.
+ */
+@property (nonatomic, strong, readonly) NSIndexSet *residentPageIndexes;
+
+/**
+ *  Whether the item at an index has loaded.
+ *
+ *  @param index index of an item
+ *
+ *  @return NO if the item is represented by `placeholderItem`
+ */
+- (BOOL) isItemLoadedAtIndex:(NSUInteger)index;
+
+/**
+ *  Load the page containing an item and the pages around it, if they aren't already loaded or loading.
+ *  Called for you as cells are displayed and prefetched.
+ *
+ *  @param index index of an item that is or will soon be displayed
+ */
+- (void) loadPagesNearIndex:(NSUInteger)index;
+
+/**
+ *  Discard all pages, including those still loading, and reload the table or collection view.
+ *
+ *  @param numberOfItems the new total number of items
+ */
+- (void) resetWithNumberOfItems:(NSUInteger)numberOfItems;
+
+@end
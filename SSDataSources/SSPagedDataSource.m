@@ -0,0 +1,299 @@
+//
+//  SSPagedDataSource.m
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSDataSources.h"
+
+@interface SSPagedDataSource ()
+
+@property (nonatomic, assign) NSUInteger numberOfPagedItems;
+@property (nonatomic, assign, readwrite) NSUInteger pageSize;
+
+// Page index (NSNumber) -> NSArray of items
+@property (nonatomic, strong) NSMutableDictionary *pages;
+
+// Indexes of pages requested from `pageLoadBlock` that haven't completed.
+@property (nonatomic, strong) NSMutableIndexSet *loadingPageIndexes;
+
+// The page containing the most recently displayed item. Pages farthest from it are evicted first.
+@property (nonatomic, assign) NSUInteger anchorPageIndex;
+
+// Incremented by -resetWithNumberOfItems:, so pages requested earlier are ignored.
+@property (nonatomic, assign) NSUInteger generation;
+
+- (NSUInteger) numberOfPages;
+- (NSRange) rangeOfPageAtIndex:(NSUInteger)pageIndex;
+- (void) loadPageAtIndex:(NSUInteger)pageIndex;
+- (void) didLoadItems:(NSArray *)items forPageAtIndex:(NSUInteger)pageIndex;
+- (void) evictPages;
+- (NSIndexSet *) visiblePageIndexes;
+
+// Implemented by SSBaseDataSource
+- (BOOL) _wantsPrefetching;
+
+@end
+
+@implementation SSPagedDataSource
+
+- (instancetype)init {
+    return [self initWithNumberOfItems:0 pageSize:1 pageLoadBlock:nil];
+}
+
+- (instancetype)initWithNumberOfItems:(NSUInteger)numberOfItems
+                             pageSize:(NSUInteger)pageSize
+                        pageLoadBlock:(SSPageLoadBlock)pageLoadBlock {
+    
+    if ((self = [super init])) {
+        _numberOfPagedItems = numberOfItems;
+        _pageSize = MAX(pageSize, 1u);
+        _pageLoadBlock = [pageLoadBlock copy];
+        _placeholderItem = [NSNull null];
+        _preloadPageCount = 1;
+        _maximumNumberOfResidentPages = 10;
+        _pages = [NSMutableDictionary dictionary];
+        _loadingPageIndexes = [NSMutableIndexSet indexSet];
+    }
+    
+    return self;
+}
+
+- (void)dealloc {
+    self.pageLoadBlock = nil;
+}
+
+#pragma mark - SSBaseDataSource
+
+- (NSUInteger)numberOfSections {
+    return 1;
+}
+
+- (NSUInteger)numberOfItemsInSection:(NSInteger)section {
+    return self.numberOfPagedItems;
+}
+
+- (NSUInteger)numberOfItems {
+    return self.numberOfPagedItems;
+}
+
+- (id)itemAtIndexPath:(NSIndexPath *)indexPath {
+    if (!indexPath || (NSUInteger)indexPath.row >= self.numberOfPagedItems) {
+        return nil;
+    }
+    
+    NSUInteger index = (NSUInteger)indexPath.row;
+    NSArray *page = self.pages[@(index / self.pageSize)];
+    NSUInteger indexInPage = index % self.pageSize;
+    
+    return (indexInPage < [page count] ? page[indexInPage] : self.placeholderItem);
+}
+
+- (BOOL)_wantsPrefetching {
+    return YES;
+}
+
+- (void)prefetchItemsAtIndexPaths:(NSArray *)indexPaths {
+    for (NSIndexPath *indexPath in indexPaths) {
+        if ((NSUInteger)indexPath.row < self.numberOfPagedItems) {
+            [self loadPageAtIndex:(NSUInteger)indexPath.row / self.pageSize];
+        }
+    }
+    
+    [super prefetchItemsAtIndexPaths:indexPaths];
+}
+
+#pragma mark - UITableViewDataSource
+
+- (UITableViewCell *)tableView:(UITableView *)tv cellForRowAtIndexPath:(NSIndexPath *)indexPath {
+    [self loadPagesNearIndex:(NSUInteger)indexPath.row];
+    
+    return [super tableView:tv cellForRowAtIndexPath:indexPath];
+}
+
+#pragma mark - UICollectionViewDataSource
+
+- (UICollectionViewCell *)collectionView:(UICollectionView *)cv cellForItemAtIndexPath:(NSIndexPath *)indexPath {
+    [self loadPagesNearIndex:(NSUInteger)indexPath.item];
+    
+    return [super collectionView:cv cellForItemAtIndexPath:indexPath];
+}
+
+#pragma mark - Pages
+
+- (NSUInteger)numberOfPages {
+    return (self.numberOfPagedItems + self.pageSize - 1) / self.pageSize;
+}
+
+- (NSRange)rangeOfPageAtIndex:(NSUInteger)pageIndex {
+    NSUInteger location = pageIndex * self.pageSize;
+    
+    return NSMakeRange(location, MIN(self.pageSize, self.numberOfPagedItems - location));
+}
+
+- (NSIndexSet *)residentPageIndexes {
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+    
+    for (NSNumber *pageIndex in self.pages) {
+        [indexes addIndex:[pageIndex unsignedIntegerValue]];
+    }
+    
+    return indexes;
+}
+
+- (BOOL)isItemLoadedAtIndex:(NSUInteger)index {
+    NSArray *page = self.pages[@(index / self.pageSize)];
+    
+    return (index < self.numberOfPagedItems && (index % self.pageSize) < [page count]);
+}
+
+- (void)loadPagesNearIndex:(NSUInteger)index {
+    if (index >= self.numberOfPagedItems) {
+        return;
+    }
+    
+    NSUInteger pageIndex = index / self.pageSize;
+    NSUInteger firstPage = (pageIndex > self.preloadPageCount ? pageIndex - self.preloadPageCount : 0);
+    NSUInteger lastPage = MIN(pageIndex + self.preloadPageCount, [self numberOfPages] - 1);
+    
+    self.anchorPageIndex = pageIndex;
+    
+    // Load outwards from the displayed page, so the nearest pages are requested first.
+    [self loadPageAtIndex:pageIndex];
+    
+    for (NSUInteger distance = 1; distance <= self.preloadPageCount; distance++) {
+        if (pageIndex + distance <= lastPage) {
+            [self loadPageAtIndex:pageIndex + distance];
+        }
+        
+        if (pageIndex >= firstPage + distance) {
+            [self loadPageAtIndex:pageIndex - distance];
+        }
+    }
+}
+
+- (void)loadPageAtIndex:(NSUInteger)pageIndex {
+    // A page that came back short is requested again, so its placeholders can fill in.
+    if (!self.pageLoadBlock
+        || pageIndex >= [self numberOfPages]
+        || [self.pages[@(pageIndex)] count] >= [self rangeOfPageAtIndex:pageIndex].length
+        || [self.loadingPageIndexes containsIndex:pageIndex]) {
+        return;
+    }
+    
+    [self.loadingPageIndexes addIndex:pageIndex];
+    
+    NSUInteger generation = self.generation;
+    __weak SSPagedDataSource *weakSelf = self;
+    __block BOOL isRequesting = YES;
+    
+    void (^completion)(NSArray *) = ^(NSArray *items) {
+        void (^didLoad)(void) = ^{
+            SSPagedDataSource *strongSelf = weakSelf;
+            
+            if (strongSelf && strongSelf.generation == generation) {
+                [strongSelf didLoadItems:items forPageAtIndex:pageIndex];
+            }
+        };
+        
+        // Pages loaded synchronously, e.g. from a cache, would otherwise
+        // reload rows while the table or collection view is asking for a cell.
+        if (isRequesting) {
+            dispatch_async(dispatch_get_main_queue(), didLoad);
+        } else {
+            didLoad();
+        }
+    };
+    
+    self.pageLoadBlock([self rangeOfPageAtIndex:pageIndex], completion);
+    isRequesting = NO;
+}
+
+- (void)didLoadItems:(NSArray *)items forPageAtIndex:(NSUInteger)pageIndex {
+    [self.loadingPageIndexes removeIndex:pageIndex];
+    
+    if (!items) {
+        // Failed; we'll try again when the page is next needed.
+        return;
+    }
+    
+    NSRange range = [self rangeOfPageAtIndex:pageIndex];
+    
+    if ([items count] > range.length) {
+        items = [items subarrayWithRange:NSMakeRange(0, range.length)];
+    }
+    
+    self.pages[@(pageIndex)] = [items copy];
+    
+    [self evictPages];
+    
+    if (!self.pages[@(pageIndex)]) {
+        // Scrolled so far away in the meantime that the page was evicted immediately.
+        return;
+    }
+    
+    [self reloadCellsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(range.location, [items count])]
+                     inSection:0];
+}
+
+- (void)evictPages {
+    NSUInteger maximumPages = MAX(self.maximumNumberOfResidentPages, 2 * self.preloadPageCount + 1);
+    
+    if ([self.pages count] <= maximumPages) {
+        return;
+    }
+    
+    // Pages with rows on screen are kept, even beyond the maximum,
+    // so that no visible cell shows an item that is no longer loaded.
+    NSUInteger anchor = self.anchorPageIndex;
+    NSMutableIndexSet *keptPages = [[self visiblePageIndexes] mutableCopy];
+    [keptPages addIndex:anchor];
+    
+    while ([self.pages count] > maximumPages) {
+        NSNumber *farthestPage = nil;
+        NSUInteger farthestDistance = 0;
+        
+        for (NSNumber *page in self.pages) {
+            NSUInteger pageIndex = [page unsignedIntegerValue];
+            NSUInteger distance = (pageIndex > anchor ? pageIndex - anchor : anchor - pageIndex);
+            
+            if (![keptPages containsIndex:pageIndex] && (!farthestPage || distance > farthestDistance)) {
+                farthestPage = page;
+                farthestDistance = distance;
+            }
+        }
+        
+        if (!farthestPage) {
+            break;
+        }
+        
+        [self.pages removeObjectForKey:farthestPage];
+    }
+}
+
+- (NSIndexSet *)visiblePageIndexes {
+    NSArray *indexPaths = (self.tableView
+                           ? [self.tableView indexPathsForVisibleRows]
+                           : [self.collectionView indexPathsForVisibleItems]);
+    NSMutableIndexSet *pageIndexes = [NSMutableIndexSet indexSet];
+    
+    for (NSIndexPath *indexPath in indexPaths) {
+        [pageIndexes addIndex:[indexPath indexAtPosition:1] / self.pageSize];
+    }
+    
+    return pageIndexes;
+}
+
+- (void)resetWithNumberOfItems:(NSUInteger)numberOfItems {
+    self.generation++;
+    self.numberOfPagedItems = numberOfItems;
+    self.anchorPageIndex = 0;
+    [self.pages removeAllObjects];
+    [self.loadingPageIndexes removeAllIndexes];
+    
+    [self reloadData];
+}
+
+@end
@@ -0,0 +1,52 @@
+//
+//  SSPersistentArray.h
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * An immutable array stored as a tree of small chunks.
+ *
+ * Each of the `arrayBy...` methods returns a new array in O(log N) time that shares
+ * all but the changed chunks with the receiver, so keeping many versions of a large array is cheap.
+ * Looking up an object is also O(log N). Copying returns the receiver.
+ *
+ * Like any immutable array, a persistent array may be read from any thread.
+ */
+
+@interface SSPersistentArray : NSArray
+
+/**
+ *  Return a new array with an object inserted.
+ *
+ *  @param object the object to insert
+ *  @param index  index at which to insert it, at most `count`
+ *
+ *  @return a new array
+ */
+- (SSPersistentArray *) arrayByInsertingObject:(id)object atIndex:(NSUInteger)index;
+
+/**
+ *  Return a new array without the object at an index.
+ *
+ *  @param index index of the object to remove
+ *
+ *  @return a new array
+ */
+- (SSPersistentArray *) arrayByRemovingObjectAtIndex:(NSUInteger)index;
+
+/**
+ *  Return a new array with the object at an index replaced.
+ *
+ *  @param index  index of the object to replace
+ *  @param object the replacement
+ *
+ *  @return a new array
+ */
+- (SSPersistentArray *) arrayByReplacingObjectAtIndex:(NSUInteger)index withObject:(id)object;
+
+@end
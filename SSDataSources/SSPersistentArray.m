@@ -0,0 +1,291 @@
+//
+//  SSPersistentArray.m
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSDataSources.h"
+
+// Maximum number of objects in a leaf, or children of a branch.
+static const NSUInteger SSPersistentArrayChunkSize = 32;
+
+/**
+ * An immutable node of a persistent array. Leaves hold objects; branches hold nodes.
+ * Nodes are never modified once created, so any number of arrays may share them.
+ */
+@interface SSPersistentArrayNode : NSObject
+
+@property (nonatomic, copy, readonly) NSArray *children;
+@property (nonatomic, assign, readonly, getter=isLeaf) BOOL leaf;
+
+// Number of objects in this node and its descendants.
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+- (instancetype) initWithChildren:(NSArray *)children leaf:(BOOL)leaf;
+
+@end
+
+@implementation SSPersistentArrayNode
+
+- (instancetype)initWithChildren:(NSArray *)children leaf:(BOOL)leaf {
+    if ((self = [super init])) {
+        _children = [children copy];
+        _leaf = leaf;
+    
+        if (leaf) {
+            _count = [children count];
+        } else {
+            for (SSPersistentArrayNode *child in children) {
+                _count += child.count;
+            }
+        }
+    }
+    
+    return self;
+}
+
+@end
+
+#pragma mark - Node operations
+
+// Wrap children in one node, or two if there are too many for one.
+static NSArray * SSPersistentArrayNodesWithChildren(NSArray *children, BOOL leaf) {
+    if ([children count] <= SSPersistentArrayChunkSize) {
+        return @[ [[SSPersistentArrayNode alloc] initWithChildren:children leaf:leaf] ];
+    }
+    
+    NSUInteger half = [children count] / 2;
+    
+    return @[ [[SSPersistentArrayNode alloc] initWithChildren:[children subarrayWithRange:NSMakeRange(0, half)]
+                                                         leaf:leaf],
+              [[SSPersistentArrayNode alloc] initWithChildren:[children subarrayWithRange:NSMakeRange(half, [children count] - half)]
+                                                         leaf:leaf] ];
+}
+
+// Find the child of a branch holding `*index`, and make `*index` relative to that child.
+// With `inserting`, an index at the end of a child stays in that child.
+static NSUInteger SSPersistentArrayChildIndex(SSPersistentArrayNode *node, NSUInteger *index, BOOL inserting) {
+    NSArray *children = node.children;
+    NSUInteger lastChild = [children count] - 1;
+    
+    for (NSUInteger i = 0; i < lastChild; i++) {
+        NSUInteger childCount = [(SSPersistentArrayNode *)children[i] count];
+    
+        if (*index < childCount || (inserting && *index == childCount)) {
+            return i;
+        }
+    
+        *index -= childCount;
+    }
+    
+    return lastChild;
+}
+
+static NSArray * SSPersistentArrayNodeInsert(SSPersistentArrayNode *node, id object, NSUInteger index) {
+    NSMutableArray *children = [node.children mutableCopy];
+    
+    if (node.isLeaf) {
+        [children insertObject:object atIndex:index];
+    } else {
+        NSUInteger childIndex = SSPersistentArrayChildIndex(node, &index, YES);
+        NSArray *replacements = SSPersistentArrayNodeInsert(children[childIndex], object, index);
+    
+        [children replaceObjectsInRange:NSMakeRange(childIndex, 1) withObjectsFromArray:replacements];
+    }
+    
+    return SSPersistentArrayNodesWithChildren(children, node.isLeaf);
+}
+
+// Returns nil if the node is left empty.
+static SSPersistentArrayNode * SSPersistentArrayNodeRemove(SSPersistentArrayNode *node, NSUInteger index) {
+    NSMutableArray *children = [node.children mutableCopy];
+    
+    if (node.isLeaf) {
+        [children removeObjectAtIndex:index];
+    } else {
+        NSUInteger childIndex = SSPersistentArrayChildIndex(node, &index, NO);
+        SSPersistentArrayNode *child = SSPersistentArrayNodeRemove(children[childIndex], index);
+    
+        if (child) {
+            children[childIndex] = child;
+        } else {
+            [children removeObjectAtIndex:childIndex];
+        }
+    }
+    
+    return ([children count] > 0
+            ? [[SSPersistentArrayNode alloc] initWithChildren:children leaf:node.isLeaf]
+            : nil);
+}
+
+static SSPersistentArrayNode * SSPersistentArrayNodeReplace(SSPersistentArrayNode *node, NSUInteger index, id object) {
+    NSMutableArray *children = [node.children mutableCopy];
+    
+    if (node.isLeaf) {
+        children[index] = object;
+    } else {
+        NSUInteger childIndex = SSPersistentArrayChildIndex(node, &index, NO);
+    
+        children[childIndex] = SSPersistentArrayNodeReplace(children[childIndex], index, object);
+    }
+    
+    return [[SSPersistentArrayNode alloc] initWithChildren:children leaf:node.isLeaf];
+}
+
+static void SSPersistentArrayNodeGetObjects(SSPersistentArrayNode *node,
+                                            __unsafe_unretained id *objects,
+                                            NSRange range) {
+    if (node.isLeaf) {
+        [node.children getObjects:objects range:range];
+        return;
+    }
+    
+    NSUInteger offset = 0;
+    
+    for (SSPersistentArrayNode *child in node.children) {
+        NSRange childRange = NSIntersectionRange(range, NSMakeRange(offset, child.count));
+    
+        if (childRange.length > 0) {
+            SSPersistentArrayNodeGetObjects(child,
+                                            objects + (childRange.location - range.location),
+                                            NSMakeRange(childRange.location - offset, childRange.length));
+        }
+    
+        offset += child.count;
+    
+        if (offset >= NSMaxRange(range)) {
+            break;
+        }
+    }
+}
+
+#pragma mark -
+
+@interface SSPersistentArray ()
+
+// nil when empty.
+@property (nonatomic, strong) SSPersistentArrayNode *root;
+
+- (instancetype) initWithRoot:(SSPersistentArrayNode *)root;
+- (void) checkIndex:(NSUInteger)index count:(NSUInteger)count;
+
+@end
+
+@implementation SSPersistentArray
+
+- (instancetype)initWithRoot:(SSPersistentArrayNode *)root {
+    if ((self = [super init])) {
+        // A branch with one child is just its child.
+        while (root && !root.isLeaf && [root.children count] == 1) {
+            root = root.children[0];
+        }
+    
+        _root = root;
+    }
+    
+    return self;
+}
+
+- (instancetype)init {
+    return [self initWithRoot:nil];
+}
+
+- (instancetype)initWithObjects:(const id [])objects count:(NSUInteger)count {
+    NSMutableArray *nodes = [NSMutableArray array];
+    
+    for (NSUInteger i = 0; i < count; i += SSPersistentArrayChunkSize) {
+        NSArray *items = [NSArray arrayWithObjects:(objects + i)
+                                             count:MIN(SSPersistentArrayChunkSize, count - i)];
+    
+        [nodes addObject:[[SSPersistentArrayNode alloc] initWithChildren:items leaf:YES]];
+    }
+    
+    while ([nodes count] > 1) {
+        NSMutableArray *branches = [NSMutableArray array];
+    
+        for (NSUInteger i = 0; i < [nodes count]; i += SSPersistentArrayChunkSize) {
+            NSArray *children = [nodes subarrayWithRange:NSMakeRange(i, MIN(SSPersistentArrayChunkSize, [nodes count] - i))];
+    
+            [branches addObject:[[SSPersistentArrayNode alloc] initWithChildren:children leaf:NO]];
+        }
+    
+        nodes = branches;
+    }
+    
+    return [self initWithRoot:[nodes firstObject]];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    return self;
+}
+
+- (void)checkIndex:(NSUInteger)index count:(NSUInteger)count {
+    if (index >= count) {
+        [NSException raise:NSRangeException
+                    format:@"%@: index %lu beyond bounds [0 .. %ld]",
+                           NSStringFromClass([self class]), (unsigned long)index, (long)count - 1];
+    }
+}
+
+#pragma mark - NSArray
+
+- (NSUInteger)count {
+    return self.root.count;
+}
+
+- (id)objectAtIndex:(NSUInteger)index {
+    [self checkIndex:index count:[self count]];
+    
+    SSPersistentArrayNode *node = self.root;
+    
+    while (!node.isLeaf) {
+        node = node.children[SSPersistentArrayChildIndex(node, &index, NO)];
+    }
+    
+    return node.children[index];
+}
+
+- (void)getObjects:(__unsafe_unretained id [])objects range:(NSRange)range {
+    if (NSMaxRange(range) > [self count]) {
+        [self checkIndex:NSMaxRange(range) - 1 count:[self count]];
+    }
+    
+    if (range.length > 0) {
+        SSPersistentArrayNodeGetObjects(self.root, objects, range);
+    }
+}
+
+#pragma mark - Persistent operations
+
+- (SSPersistentArray *)arrayByInsertingObject:(id)object atIndex:(NSUInteger)index {
+    NSParameterAssert(object);
+    [self checkIndex:index count:[self count] + 1];
+    
+    if (!self.root) {
+        return [[SSPersistentArray alloc] initWithRoot:[[SSPersistentArrayNode alloc] initWithChildren:@[ object ]
+                                                                                                  leaf:YES]];
+    }
+    
+    NSArray *nodes = SSPersistentArrayNodeInsert(self.root, object, index);
+    
+    return [[SSPersistentArray alloc] initWithRoot:([nodes count] == 1
+                                                    ? nodes[0]
+                                                    : [[SSPersistentArrayNode alloc] initWithChildren:nodes leaf:NO])];
+}
+
+- (SSPersistentArray *)arrayByRemovingObjectAtIndex:(NSUInteger)index {
+    [self checkIndex:index count:[self count]];
+    
+    return [[SSPersistentArray alloc] initWithRoot:SSPersistentArrayNodeRemove(self.root, index)];
+}
+
+- (SSPersistentArray *)arrayByReplacingObjectAtIndex:(NSUInteger)index withObject:(id)object {
+    NSParameterAssert(object);
+    [self checkIndex:index count:[self count]];
+    
+    return [[SSPersistentArray alloc] initWithRoot:SSPersistentArrayNodeReplace(self.root, index, object)];
+}
+
+@end
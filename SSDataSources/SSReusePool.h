@@ -0,0 +1,71 @@
+//
+//  SSReusePool.h
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+
+// Block that creates and sets up a view to add to a reuse pool.
+typedef id (^SSReusableViewCreationBlock) (void);
+
+/**
+ * A pool of views created ahead of time for a table view, keyed by reuse identifier.
+ * UIKit's own reuse queue can't be filled in advance, so SSBaseTableCell and
+ * SSBaseHeaderFooterView take views from this pool before allocating new ones.
+ *
+ * You probably want +[SSBaseTableCell warmUpCells:forTableView:whenIdle:]
+ * rather than using this class directly. Use on the main thread.
+ */
+
+@interface SSReusePool : NSObject
+
+/**
+ *  The pool belonging to a view, created if needed. The pool lives as long as the view.
+ *
+ *  @param view a table view
+ *
+ *  @return the view's pool
+ */
++ (instancetype) poolForView:(UIView *)view;
+
+/**
+ *  Create views until the pool holds `count` views with an identifier.
+ *
+ *  @param count         number of views to keep ready
+ *  @param identifier    reuse identifier of the views
+ *  @param whenIdle      if YES, create one view each time the main run loop is about to sleep,
+ *                       rather than all of them now
+ *  @param creationBlock block that creates and sets up a view
+ */
+- (void) fillWithCount:(NSUInteger)count
+            identifier:(NSString *)identifier
+              whenIdle:(BOOL)whenIdle
+         creationBlock:(SSReusableViewCreationBlock)creationBlock;
+
+/**
+ *  Remove and return a view with an identifier.
+ *
+ *  @param identifier reuse identifier
+ *
+ *  @return a view, or nil if none are ready
+ */
+- (id) dequeueViewWithIdentifier:(NSString *)identifier;
+
+/**
+ *  Number of views ready with an identifier.
+ *
+ *  @param identifier reuse identifier
+ *
+ *  @return number of views
+ */
+- (NSUInteger) numberOfViewsWithIdentifier:(NSString *)identifier;
+
+/**
+ *  Discard all views and stop creating any more.
+ */
+- (void) removeAllViews;
+
+@end
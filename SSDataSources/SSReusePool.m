@@ -0,0 +1,185 @@
+//
+//  SSReusePool.m
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSDataSources.h"
+#import <objc/runtime.h>
+
+static const void *SSReusePoolKey = &SSReusePoolKey;
+
+@interface SSReusePool ()
+
+// Reuse identifier -> NSMutableArray of ready views
+@property (nonatomic, strong) NSMutableDictionary *views;
+
+// Reuse identifier -> NSNumber target count, for pools being filled when idle
+@property (nonatomic, strong) NSMutableDictionary *idleFillCounts;
+
+// Reuse identifier -> SSReusableViewCreationBlock, for pools being filled when idle
+@property (nonatomic, strong) NSMutableDictionary *idleCreationBlocks;
+
+@property (nonatomic, assign) CFRunLoopObserverRef idleObserver;
+
+- (void) addView:(id)view forIdentifier:(NSString *)identifier;
+- (void) createViewWhenIdle;
+- (void) stopObservingIdle;
+
+@end
+
+@implementation SSReusePool
+
++ (instancetype)poolForView:(UIView *)view {
+    SSReusePool *pool = objc_getAssociatedObject(view, SSReusePoolKey);
+    
+    if (!pool) {
+        pool = [self new];
+        objc_setAssociatedObject(view, SSReusePoolKey, pool, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    
+    return pool;
+}
+
+- (instancetype)init {
+    if ((self = [super init])) {
+        _views = [NSMutableDictionary dictionary];
+        _idleFillCounts = [NSMutableDictionary dictionary];
+        _idleCreationBlocks = [NSMutableDictionary dictionary];
+    }
+    
+    return self;
+}
+
+- (void)dealloc {
+    [self stopObservingIdle];
+}
+
+#pragma mark - Views
+
+- (void)fillWithCount:(NSUInteger)count
+           identifier:(NSString *)identifier
+             whenIdle:(BOOL)whenIdle
+        creationBlock:(SSReusableViewCreationBlock)creationBlock {
+    
+    if (!identifier || !creationBlock) {
+        return;
+    }
+    
+    if (whenIdle) {
+        if ([self numberOfViewsWithIdentifier:identifier] >= count) {
+            return;
+        }
+    
+        self.idleFillCounts[identifier] = @(count);
+        self.idleCreationBlocks[identifier] = [creationBlock copy];
+    
+        if (!self.idleObserver) {
+            __weak SSReusePool *weakSelf = self;
+    
+            // The default mode, so nothing is created while the user is scrolling.
+            self.idleObserver = CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault,
+                                                                   kCFRunLoopBeforeWaiting,
+                                                                   true,
+                                                                   0,
+                                                                   ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+                [weakSelf createViewWhenIdle];
+            });
+            CFRunLoopAddObserver(CFRunLoopGetMain(), self.idleObserver, kCFRunLoopDefaultMode);
+        }
+    
+        return;
+    }
+    
+    while ([self numberOfViewsWithIdentifier:identifier] < count) {
+        id view = creationBlock();
+    
+        if (!view) {
+            break;
+        }
+    
+        [self addView:view forIdentifier:identifier];
+    }
+}
+
+- (void)addView:(id)view forIdentifier:(NSString *)identifier {
+    NSMutableArray *views = self.views[identifier];
+    
+    if (!views) {
+        views = [NSMutableArray array];
+        self.views[identifier] = views;
+    }
+    
+    [views addObject:view];
+}
+
+- (id)dequeueViewWithIdentifier:(NSString *)identifier {
+    if (!identifier) {
+        return nil;
+    }
+    
+    NSMutableArray *views = self.views[identifier];
+    id view = [views lastObject];
+    
+    if (view) {
+        [views removeLastObject];
+    }
+    
+    return view;
+}
+
+- (NSUInteger)numberOfViewsWithIdentifier:(NSString *)identifier {
+    return (identifier ? [self.views[identifier] count] : 0);
+}
+
+- (void)removeAllViews {
+    [self.views removeAllObjects];
+    [self.idleFillCounts removeAllObjects];
+    [self.idleCreationBlocks removeAllObjects];
+    [self stopObservingIdle];
+}
+
+#pragma mark - Idle filling
+
+- (void)createViewWhenIdle {
+    NSString *identifier = [[self.idleFillCounts allKeys] firstObject];
+    
+    if (!identifier) {
+        [self stopObservingIdle];
+        return;
+    }
+    
+    NSUInteger count = [self.idleFillCounts[identifier] unsignedIntegerValue];
+    SSReusableViewCreationBlock creationBlock = self.idleCreationBlocks[identifier];
+    id view = ([self numberOfViewsWithIdentifier:identifier] < count ? creationBlock() : nil);
+    
+    if (view) {
+        [self addView:view forIdentifier:identifier];
+    }
+    
+    if (!view || [self numberOfViewsWithIdentifier:identifier] >= count) {
+        [self.idleFillCounts removeObjectForKey:identifier];
+        [self.idleCreationBlocks removeObjectForKey:identifier];
+    }
+    
+    if ([self.idleFillCounts count] == 0) {
+        [self stopObservingIdle];
+    } else {
+        // Come back for the next view once any other pending work is done.
+        CFRunLoopWakeUp(CFRunLoopGetMain());
+    }
+}
+
+- (void)stopObservingIdle {
+    if (!self.idleObserver) {
+        return;
+    }
+    
+    CFRunLoopObserverInvalidate(self.idleObserver);
+    CFRelease(self.idleObserver);
+    self.idleObserver = NULL;
+}
+
+@end
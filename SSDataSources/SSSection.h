@@ -15,6 +15,9 @@
  * plus a header and footer string.
  */
 
+// Optional block used to compute the items of a virtual section on demand.
+typedef id (^SSSectionItemProviderBlock) (NSUInteger index); // The index of the item
+
 @interface SSSection : NSObject <NSCopying>
 
 /**
@@ -33,10 +36,26 @@
 /**
  * Sometimes you just need a section with a given number of cells
  * and all the cell creation and configuration is handled with values stored elsewhere.
- * This method creates a section with the specified number of placeholder objects.
+ * This method creates a virtual section with the specified number of placeholder items:
+ * the item at each index is that index, as an NSNumber.
  */
 + (instancetype) sectionWithNumberOfItems:(NSUInteger)numberOfItems;
 
+/**
+ *  Create a virtual section whose items are computed on demand.
+ *  Only the number of items is stored, so a section of any size is created,
+ *  grown or shrunk in constant time.
+ *
+ *  @param numberOfItems number of items in the section
+ *  @param itemProvider  block that returns the item at an index, or nil
+ *  to use the index itself (as an NSNumber). Called each time an item is accessed,
+ *  so it should be fast and return equal items for the same index.
+ *
+ *  @return an initialized virtual section
+ */
++ (instancetype) sectionWithNumberOfItems:(NSUInteger)numberOfItems
+                             itemProvider:(SSSectionItemProviderBlock)itemProvider;
+
 /**
  *  Create a section with some placeholder items.
  *
@@ -62,6 +81,25 @@
  */
 - (id) itemAtIndex:(NSUInteger)index;
 
+/**
+ *  YES if this section stores only a number of items, computing each item as it is accessed.
+ *  See `sectionWithNumberOfItems:itemProvider:`.
+ *
+ *  A virtual section stays virtual while items are only added or removed via
+ *  `setNumberOfItems:` or removed from its end. Any other change to `items`,
+ *  such as inserting or replacing an item, stores all of its items in an array.
+ */
+- (BOOL) isVirtual;
+
+/**
+ *  Grow or shrink the section to the specified number of items.
+ *  Items are removed from the end. A virtual section simply changes its count;
+ *  otherwise, placeholder items are appended as with `sectionWithNumberOfItems:`.
+ *
+ *  @param numberOfItems the desired number of items
+ */
+- (void) setNumberOfItems:(NSUInteger)numberOfItems;
+
 /**
  *  Section items. You probably shouldn't mutate this directly;
  *  instead see SSSectionedDataSource's
@@ -90,6 +128,13 @@
  */
 @property (nonatomic, copy) NSString *footer;
 
+/**
+ * Optional title for this section in the table's section index,
+ * e.g. the first letter of its items. Sections with the same title share one entry,
+ * which scrolls to the first of them. See SSSectionedDataSource's `collation`.
+ */
+@property (nonatomic, copy) NSString *indexTitle;
+
 /**
  * Optional custom classes to use for header views.
  * Defaults to SSBaseHeaderFooterView.
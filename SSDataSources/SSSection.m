@@ -8,8 +8,153 @@
 
 #import "SSDataSources.h"
 
+/**
+ * A mutable array that stores only a count, computing each item with a block,
+ * until it is changed in a way that requires storing the items.
+ */
+@interface SSVirtualItemArray : NSMutableArray
+
+- (instancetype)initWithCount:(NSUInteger)count itemProvider:(SSSectionItemProviderBlock)itemProvider;
+
+@property (nonatomic, assign, readonly) NSUInteger virtualCount;
+@property (nonatomic, copy, readonly) SSSectionItemProviderBlock itemProvider;
+
+// All items, once the array is no longer virtual.
+@property (nonatomic, strong) NSMutableArray *storage;
+
+- (BOOL) isVirtual;
+- (void) setVirtualCount:(NSUInteger)count;
+- (void) materialize;
+
+@end
+
+@implementation SSVirtualItemArray
+
+- (instancetype)init {
+    return [self initWithCount:0 itemProvider:nil];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)numItems {
+    return [self initWithCount:0 itemProvider:nil];
+}
+
+- (instancetype)initWithCount:(NSUInteger)count itemProvider:(SSSectionItemProviderBlock)itemProvider {
+    if ((self = [super init])) {
+        _virtualCount = count;
+        _itemProvider = [itemProvider copy];
+    }
+    
+    return self;
+}
+
+- (BOOL)isVirtual {
+    return (self.storage == nil);
+}
+
+- (void)setVirtualCount:(NSUInteger)count {
+    NSAssert([self isVirtual], @"Array is no longer virtual");
+    _virtualCount = count;
+}
+
+- (void)materialize {
+    if (![self isVirtual]) {
+        return;
+    }
+    
+    NSMutableArray *storage = [NSMutableArray arrayWithCapacity:self.virtualCount];
+    
+    for (NSUInteger i = 0; i < self.virtualCount; i++) {
+        [storage addObject:[self objectAtIndex:i]];
+    }
+    
+    self.storage = storage;
+}
+
+#pragma mark - NSArray
+
+- (NSUInteger)count {
+    return ([self isVirtual] ? self.virtualCount : [self.storage count]);
+}
+
+- (id)objectAtIndex:(NSUInteger)index {
+    if (![self isVirtual]) {
+        return [self.storage objectAtIndex:index];
+    }
+    
+    if (index >= self.virtualCount) {
+        [NSException raise:NSRangeException
+                    format:@"Index %lu beyond bounds [0 .. %lu]",
+                           (unsigned long)index, (unsigned long)self.virtualCount];
+    }
+    
+    id item = (self.itemProvider ? self.itemProvider(index) : nil);
+    
+    return (item ?: @(index));
+}
+
+#pragma mark - NSMutableArray
+
+- (void)insertObject:(id)anObject atIndex:(NSUInteger)index {
+    [self materialize];
+    [self.storage insertObject:anObject atIndex:index];
+}
+
+- (void)removeObjectAtIndex:(NSUInteger)index {
+    if ([self isVirtual] && index + 1 == self.virtualCount) {
+        _virtualCount--;
+        return;
+    }
+    
+    [self materialize];
+    [self.storage removeObjectAtIndex:index];
+}
+
+- (void)addObject:(id)anObject {
+    [self materialize];
+    [self.storage addObject:anObject];
+}
+
+- (void)removeLastObject {
+    if ([self isVirtual] && self.virtualCount > 0) {
+        _virtualCount--;
+        return;
+    }
+    
+    [self materialize];
+    [self.storage removeLastObject];
+}
+
+- (void)replaceObjectAtIndex:(NSUInteger)index withObject:(id)anObject {
+    [self materialize];
+    [self.storage replaceObjectAtIndex:index withObject:anObject];
+}
+
+- (void)removeObjectsInRange:(NSRange)range {
+    if ([self isVirtual] && NSMaxRange(range) == self.virtualCount) {
+        _virtualCount = range.location;
+        return;
+    }
+    
+    [self materialize];
+    [self.storage removeObjectsInRange:range];
+}
+
+- (void)removeAllObjects {
+    if ([self isVirtual]) {
+        _virtualCount = 0;
+        return;
+    }
+    
+    [self.storage removeAllObjects];
+}
+
+@end
+
+#pragma mark -
+
 @interface SSSection ()
 
+@property (nonatomic, strong, readwrite) NSMutableArray *items;
 @property (nonatomic, assign, readwrite, getter=isExpanded) BOOL expanded;
 
 @end
@@ -66,22 +211,48 @@
                                   footer:(NSString *)footer
                               identifier:(id)identifier {
     
-    NSMutableArray *array = [NSMutableArray new];
+    SSSection *section = [self sectionWithNumberOfItems:numberOfItems itemProvider:nil];
     
-    for (NSUInteger i = 0; i < numberOfItems; i++) {
-        [array addObject:@(i)];
-    }
+    section.header = header;
+    section.footer = footer;
+    section.sectionIdentifier = identifier;
     
-    return [self sectionWithItems:array
-                           header:header
-                           footer:footer
-                       identifier:identifier];
+    return section;
+}
+
++ (instancetype)sectionWithNumberOfItems:(NSUInteger)numberOfItems
+                            itemProvider:(SSSectionItemProviderBlock)itemProvider {
+    
+    SSSection *section = [SSSection new];
+    section.items = [[SSVirtualItemArray alloc] initWithCount:numberOfItems
+                                                 itemProvider:itemProvider];
+    
+    return section;
 }
 
 - (NSUInteger)numberOfItems {
     return [self.items count];
 }
 
+- (BOOL)isVirtual {
+    return ([self.items isKindOfClass:[SSVirtualItemArray class]]
+            && [(SSVirtualItemArray *)self.items isVirtual]);
+}
+
+- (void)setNumberOfItems:(NSUInteger)numberOfItems {
+    NSUInteger currentCount = [self.items count];
+    
+    if (numberOfItems < currentCount) {
+        [self.items removeObjectsInRange:NSMakeRange(numberOfItems, currentCount - numberOfItems)];
+    } else if ([self isVirtual]) {
+        [(SSVirtualItemArray *)self.items setVirtualCount:numberOfItems];
+    } else {
+        for (NSUInteger i = currentCount; i < numberOfItems; i++) {
+            [self.items addObject:@(i)];
+        }
+    }
+}
+
 - (id)itemAtIndex:(NSUInteger)index {
     return self.items[index];
 }
@@ -89,9 +260,19 @@
 #pragma mark - NSCopying
 
 - (id)copyWithZone:(NSZone *)zone {
-    SSSection *newSection = [SSSection sectionWithItems:self.items];
+    SSSection *newSection;
+    
+    if ([self isVirtual]) {
+        SSVirtualItemArray *items = (SSVirtualItemArray *)self.items;
+        newSection = [SSSection sectionWithNumberOfItems:items.virtualCount
+                                            itemProvider:items.itemProvider];
+    } else {
+        newSection = [SSSection sectionWithItems:self.items];
+    }
+    
     newSection.header = self.header;
     newSection.footer = self.footer;
+    newSection.indexTitle = self.indexTitle;
     newSection.headerClass = self.headerClass;
     newSection.footerClass = self.footerClass;
     newSection.headerHeight = self.headerHeight;
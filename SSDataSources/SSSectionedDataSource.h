@@ -76,9 +76,49 @@
 /**
  * Return the index of the first section with a given identifier, or NSNotFound.
  * See `sectionIdentifier` in SSSection.
+ *
+ * The receiver indexes its sections by identifier, so lookups are constant time.
+ * Inserting, removing or moving sections re-indexes only the sections after the change,
+ * on the next lookup. If you change the identifier of a section already in the data source,
+ * call `reloadData`.
  */
 - (NSUInteger) indexOfSectionWithIdentifier:(id)identifier;
 
+/**
+ *  Return the indexes of the first sections with each of some identifiers.
+ *
+ *  @param identifiers an array of section identifiers
+ *
+ *  @return indexes of the sections found. Identifiers with no section are ignored.
+ */
+- (NSIndexSet *) indexesOfSectionsWithIdentifiers:(NSArray *)identifiers;
+
+#pragma mark - Global item indexes
+
+/**
+ * The receiver keeps running totals of the number of items in each section,
+ * so `numberOfItems` is constant time and the methods below are O(log n) in the number of sections.
+ */
+
+/**
+ *  Return the index path of the item at a position counting across all sections,
+ *  e.g. for jumping to the 500th item.
+ *
+ *  @param index a flat index less than `numberOfItems`
+ *
+ *  @return an index path, or nil if the index is out of bounds
+ */
+- (NSIndexPath *) indexPathForGlobalIndex:(NSUInteger)index;
+
+/**
+ *  Return the position of an item counting across all sections.
+ *
+ *  @param indexPath index path of an item
+ *
+ *  @return a flat index, or NSNotFound if the index path is out of bounds
+ */
+- (NSUInteger) globalIndexForIndexPath:(NSIndexPath *)indexPath;
+
 #pragma mark - Moving sections
 
 /**
@@ -109,6 +149,41 @@
  */
 - (void) insertSections:(NSArray *)sections atIndexes:(NSIndexSet *)indexes;
 
+#pragma mark - Replacing sections
+
+/**
+ * Replace all sections in the data source with a new set of sections.
+ *
+ * Sections are matched by `sectionIdentifier` and the items within each matched section
+ * are matched by `itemIdentifierBlock` (or by the items themselves, if not specified).
+ * The table or collection view then receives the required section inserts, deletes and moves,
+ * plus item inserts, deletes, moves (including between sections) and reloads,
+ * in a single batch update.
+ *
+ * Each item in the `sections` array should be an SSSection object or an array,
+ * as with `insertSections:atIndexes:`. Pass new SSSection objects rather than
+ * mutating the existing sections.
+ */
+- (void) applySections:(NSArray *)sections;
+
+/**
+ *  As above, but the old and new sections are diffed on a background queue
+ *  and the changes are then animated on the main thread.
+ *
+ *  If this method is called again before the diff completes, the earlier update
+ *  is dropped in favor of the newer one and its completion block receives NO.
+ *  If the sections are changed in any other way while the diff is being computed,
+ *  the update is applied as with `applySections:` instead.
+ *
+ *  `itemIdentifierBlock` and `itemEqualityBlock` are called on the background queue,
+ *  so they must be safe to call from any thread.
+ *
+ *  @param sections   the new sections
+ *  @param completion optional block called on the main thread once the update
+ *                    has been applied (YES) or superseded by a newer update (NO)
+ */
+- (void) applySections:(NSArray *)sections completion:(void (^)(BOOL finished))completion;
+
 #pragma mark - Inserting items
 
 /**
@@ -152,6 +227,9 @@
  *  @note if numberOfItems is 0 and shouldRemoveEmptySection is YES, the section will be
  *  removed.
  *
+ *  @note virtual sections (see +[SSSection sectionWithNumberOfItems:itemProvider:])
+ *  are adjusted in constant time.
+ *
  *  @return YES if one or more items were inserted or removed. NO if there was no action
  *  taken due to numberOfItems being equal to the current number of items in the section.
  */
@@ -191,6 +269,14 @@
  */
 - (void) removeSectionWithIdentifier:(id)identifier;
 
+/**
+ *  Remove the first section with each of the specified identifiers
+ *  in a single update. Identifiers with no section are ignored.
+ *
+ *  @param identifiers an array of section identifiers
+ */
+- (void) removeSectionsWithIdentifiers:(NSArray *)identifiers;
+
 #pragma mark - Removing items
 
 /**
@@ -208,6 +294,38 @@
  */
 - (void) removeItemsInRange:(NSRange)range inSection:(NSInteger)section;
 
+#pragma mark - Section index
+
+/**
+ * Optional collation for the table's section index, e.g. [UILocalizedIndexedCollation currentCollation].
+ * Each section's `indexTitle` should then be one of the collation's `sectionTitles`.
+ *
+ * If set, the section index shows all of the collation's titles, and a title without a section
+ * scrolls to the next title that has one. Otherwise, the section index shows the distinct
+ * `indexTitle`s of the sections, in order.
+ */
+@property (nonatomic, strong) UILocalizedIndexedCollation *collation;
+
+/**
+ * Titles for the table's section index, or nil if there is no index.
+ * Returned by `sectionIndexTitlesForTableView:`.
+ */
+- (NSArray *) sectionIndexTitles;
+
+/**
+ *  Return the section to scroll to when a title in the section index is tapped.
+ *  Returned by `tableView:sectionForSectionIndexTitle:atIndex:`.
+ *
+ *  Titles are kept indexed as sections change; only sections from the first one
+ *  inserted, removed, moved or reloaded since the last lookup are read again.
+ *  The lookup itself takes constant time.
+ *
+ *  @param index index of the title in `sectionIndexTitles`
+ *
+ *  @return a section
+ */
+- (NSInteger) sectionForSectionIndexTitleAtIndex:(NSInteger)index;
+
 #pragma mark - UITableViewDelegate helpers
 
 /**
@@ -15,6 +15,59 @@
 // Header/footer view helper
 - (SSBaseHeaderFooterView *)headerFooterViewWithClass:(Class)class;
 
+// Converts an array of SSSection objects and/or arrays of items into SSSection objects
+- (NSArray *)sectionsFromArray:(NSArray *)sectionObjects;
+
+// Replaces the receiver's sections, animating the changes described by `diff`
+- (void)applyDiff:(SSSectionedDiff *)diff withSections:(NSArray *)newSections;
+
+// Immutable stand-ins for the current sections, to diff against on another thread
+- (NSArray *)sectionsForBackgroundDiff;
+
+// Running totals of the number of items in each section, kept in step with each change,
+// including those made within a batch update or transaction.
+// nil until first needed, and after a reload; rebuilt on demand.
+@property (nonatomic, strong) SSCountTree *itemCounts;
+
+- (SSCountTree *)currentItemCounts;
+- (void)updateItemCountsForIndexPaths:(NSArray *)indexPaths;
+- (void)updateItemCountsInSections:(NSIndexSet *)sections;
+- (void)insertItemCountsForSections:(NSIndexSet *)sections;
+- (void)removeItemCountsForSections:(NSIndexSet *)sections;
+- (void)updateItemCountsWithChanges:(SSSectionedDiff *)changes;
+
+// Index of the first section with each identifier. Sections from `sectionIndexWatermark` on
+// have moved since they were indexed, so entries for them may be out of date.
+@property (nonatomic, strong) NSMapTable *sectionIndexes;
+@property (nonatomic, assign) NSUInteger sectionIndexWatermark;
+
+- (void)invalidateSectionIndexesFromIndex:(NSUInteger)index;
+- (void)updateSectionIndexes;
+- (BOOL)sectionAtIndex:(NSUInteger)index hasIdentifier:(id)identifier;
+
+// Distinct section index titles, in order, and the first section with each.
+// Like `sectionIndexes`, entries from `indexTitleWatermark` on may be out of date.
+@property (nonatomic, strong) NSMutableArray *indexTitles;
+@property (nonatomic, strong) NSMutableArray *indexTitleSections;
+@property (nonatomic, strong) NSMutableDictionary *indexTitlePositions;
+@property (nonatomic, assign) NSUInteger indexTitleWatermark;
+
+- (void)updateIndexTitles;
+
+// Background diffing, implemented by SSBaseDataSource
+- (void)_performBackgroundDiff:(id (^)(void))diffBlock
+                         apply:(BOOL (^)(id diff))applyBlock
+                         retry:(void (^)(void))retryBlock
+                    completion:(void (^)(BOOL finished))completion;
+- (void)_cancelBackgroundDiffs;
+
+// Implemented by SSBaseDataSource
+- (void)_invalidateSizesForItemsInSections:(NSIndexSet *)sections;
+- (BOOL)_hasCachedData;
+- (void)_removeCachedDataForItems:(NSArray *)items;
+- (void)_didApplyChanges:(SSSectionedDiff *)changes;
+- (NSArray *)_itemsInSection:(NSUInteger)section;
+
 @end
 
 @implementation SSSectionedDataSource
@@ -23,6 +76,10 @@
     if ((self = [super init])) {
         _sections = [NSMutableArray array];
         _shouldRemoveEmptySections = YES;
+        _sectionIndexes = [NSMapTable strongToStrongObjectsMapTable];
+        _indexTitles = [NSMutableArray array];
+        _indexTitleSections = [NSMutableArray array];
+        _indexTitlePositions = [NSMutableDictionary dictionary];
     }
     
     return self;
@@ -74,6 +131,17 @@
     return [[self sectionAtIndex:indexPath.section] itemAtIndex:(NSUInteger)indexPath.row];
 }
 
+- (NSArray *)_itemsInSection:(NSUInteger)section {
+    SSSection *sectionObject = [self sectionAtIndex:(NSInteger)section];
+    
+    // A virtual section's items are computed one at a time anyway.
+    return ([sectionObject isVirtual] ? nil : sectionObject.items);
+}
+
+- (NSUInteger)numberOfItems {
+    return [[self currentItemCounts] total];
+}
+
 #pragma mark - Section access
 
 - (SSSection *)sectionAtIndex:(NSInteger)index {
@@ -91,10 +159,321 @@
 }
 
 - (NSUInteger)indexOfSectionWithIdentifier:(id)identifier {
-    return [self.sections indexOfObjectPassingTest:^BOOL(SSSection *section,
-                                                         NSUInteger index,
-                                                         BOOL *stop) {
-        return [(id)section.sectionIdentifier isEqual:identifier];
+    if (!identifier) {
+        return NSNotFound;
+    }
+    
+    [self updateSectionIndexes];
+    
+    NSNumber *index = [self.sectionIndexes objectForKey:identifier];
+    
+    if (!index) {
+        return NSNotFound;
+    }
+    
+    if (![self sectionAtIndex:[index unsignedIntegerValue] hasIdentifier:identifier]) {
+        // That section has since been removed.
+        [self.sectionIndexes removeObjectForKey:identifier];
+        return NSNotFound;
+    }
+    
+    return [index unsignedIntegerValue];
+}
+
+- (NSIndexSet *)indexesOfSectionsWithIdentifiers:(NSArray *)identifiers {
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+    
+    for (id identifier in identifiers) {
+        NSUInteger index = [self indexOfSectionWithIdentifier:identifier];
+    
+        if (index != NSNotFound) {
+            [indexes addIndex:index];
+        }
+    }
+    
+    return indexes;
+}
+
+- (BOOL)sectionAtIndex:(NSUInteger)index hasIdentifier:(id)identifier {
+    return (index < [self.sections count]
+            && [(id)[self sectionAtIndex:(NSInteger)index].sectionIdentifier isEqual:identifier]);
+}
+
+- (void)invalidateSectionIndexesFromIndex:(NSUInteger)index {
+    self.sectionIndexWatermark = MIN(self.sectionIndexWatermark, index);
+    self.indexTitleWatermark = MIN(self.indexTitleWatermark, index);
+}
+
+- (void)updateSectionIndexes {
+    NSUInteger sectionCount = [self.sections count];
+    NSUInteger start = self.sectionIndexWatermark;
+    
+    if (start >= sectionCount) {
+        self.sectionIndexWatermark = sectionCount;
+        return;
+    }
+    
+    if (start == 0) {
+        [self.sectionIndexes removeAllObjects];
+    }
+    
+    // Sections before the watermark haven't moved, so only the rest need re-indexing.
+    // Entries for sections that were removed are left behind, and caught on lookup.
+    for (NSUInteger index = start; index < sectionCount; index++) {
+        id identifier = [self sectionAtIndex:(NSInteger)index].sectionIdentifier;
+    
+        if (!identifier) {
+            continue;
+        }
+    
+        NSNumber *existingIndex = [self.sectionIndexes objectForKey:identifier];
+    
+        if (existingIndex
+            && [existingIndex unsignedIntegerValue] < index
+            && [self sectionAtIndex:[existingIndex unsignedIntegerValue] hasIdentifier:identifier]) {
+            continue;
+        }
+    
+        [self.sectionIndexes setObject:@(index) forKey:identifier];
+    }
+    
+    self.sectionIndexWatermark = sectionCount;
+}
+
+#pragma mark - Section index
+
+- (NSArray *)sectionIndexTitles {
+    if (self.collation) {
+        return self.collation.sectionIndexTitles;
+    }
+    
+    [self updateIndexTitles];
+    
+    return ([self.indexTitles count] > 0 ? [self.indexTitles copy] : nil);
+}
+
+- (NSInteger)sectionForSectionIndexTitleAtIndex:(NSInteger)index {
+    [self updateIndexTitles];
+    
+    if (!self.collation) {
+        return (index >= 0 && (NSUInteger)index < [self.indexTitleSections count]
+                ? [self.indexTitleSections[(NSUInteger)index] integerValue]
+                : 0);
+    }
+    
+    NSArray *titles = self.collation.sectionTitles;
+    NSInteger collationSection = [self.collation sectionForSectionIndexTitleAtIndex:index];
+    
+    // A title without a section scrolls to the next title that has one.
+    for (NSUInteger i = (NSUInteger)MAX(collationSection, 0); i < [titles count]; i++) {
+        NSNumber *position = self.indexTitlePositions[titles[i]];
+    
+        if (position) {
+            return [self.indexTitleSections[[position unsignedIntegerValue]] integerValue];
+        }
+    }
+    
+    return MAX((NSInteger)[self numberOfSections] - 1, 0);
+}
+
+- (void)updateIndexTitles {
+    NSUInteger sectionCount = [self.sections count];
+    NSUInteger start = MIN(self.indexTitleWatermark, sectionCount);
+    
+    // Titles first seen at or after the watermark may have moved, so drop them.
+    NSUInteger firstStaleTitle = [self.indexTitleSections indexOfObject:@(start)
+                                                          inSortedRange:NSMakeRange(0, [self.indexTitleSections count])
+                                                                options:(NSBinarySearchingInsertionIndex | NSBinarySearchingFirstEqual)
+                                                        usingComparator:^NSComparisonResult(NSNumber *section1, NSNumber *section2) {
+                                                            return [section1 compare:section2];
+                                                        }];
+    NSRange staleRange = NSMakeRange(firstStaleTitle, [self.indexTitles count] - firstStaleTitle);
+    
+    [self.indexTitlePositions removeObjectsForKeys:[self.indexTitles subarrayWithRange:staleRange]];
+    [self.indexTitles removeObjectsInRange:staleRange];
+    [self.indexTitleSections removeObjectsInRange:staleRange];
+    
+    for (NSUInteger index = start; index < sectionCount; index++) {
+        NSString *title = [self sectionAtIndex:(NSInteger)index].indexTitle;
+    
+        if (!title || self.indexTitlePositions[title]) {
+            continue;
+        }
+    
+        self.indexTitlePositions[title] = @([self.indexTitles count]);
+        [self.indexTitles addObject:title];
+        [self.indexTitleSections addObject:@(index)];
+    }
+    
+    self.indexTitleWatermark = sectionCount;
+}
+
+#pragma mark - Global item indexes
+
+- (NSIndexPath *)indexPathForGlobalIndex:(NSUInteger)index {
+    NSUInteger row = 0;
+    NSUInteger section = [[self currentItemCounts] indexForPrefixSum:index
+                                                           remainder:&row];
+    
+    if (section == NSNotFound) {
+        return nil;
+    }
+    
+    return [NSIndexPath indexPathForRow:(NSInteger)row inSection:(NSInteger)section];
+}
+
+- (NSUInteger)globalIndexForIndexPath:(NSIndexPath *)indexPath {
+    SSCountTree *itemCounts = [self currentItemCounts];
+    
+    if (!indexPath
+        || indexPath.section < 0
+        || indexPath.row < 0
+        || (NSUInteger)indexPath.section >= [itemCounts count]
+        || (NSUInteger)indexPath.row >= [itemCounts valueAtIndex:(NSUInteger)indexPath.section]) {
+        return NSNotFound;
+    }
+    
+    return [itemCounts prefixSumBeforeIndex:(NSUInteger)indexPath.section] + (NSUInteger)indexPath.row;
+}
+
+- (SSCountTree *)currentItemCounts {
+    NSUInteger sectionCount = [self numberOfSections];
+    
+    if (self.itemCounts && [self.itemCounts count] == sectionCount) {
+        return self.itemCounts;
+    }
+    
+    NSUInteger *counts = malloc(sizeof(NSUInteger) * MAX(sectionCount, 1u));
+    
+    for (NSUInteger section = 0; section < sectionCount; section++) {
+        counts[section] = [self numberOfItemsInSection:(NSInteger)section];
+    }
+    
+    self.itemCounts = [[SSCountTree alloc] initWithValues:counts count:sectionCount];
+    free(counts);
+    
+    return self.itemCounts;
+}
+
+- (void)updateItemCountsForIndexPaths:(NSArray *)indexPaths {
+    NSMutableIndexSet *sections = [NSMutableIndexSet indexSet];
+    
+    for (NSIndexPath *indexPath in indexPaths) {
+        [sections addIndex:(NSUInteger)indexPath.section];
+    }
+    
+    [self updateItemCountsInSections:sections];
+}
+
+- (void)updateItemCountsInSections:(NSIndexSet *)sections {
+    SSCountTree *itemCounts = self.itemCounts;
+    
+    if (!itemCounts || [sections count] == 0) {
+        return;
+    }
+    
+    if ([itemCounts count] != [self numberOfSections]
+        || [sections lastIndex] >= [itemCounts count]) {
+        self.itemCounts = nil;
+        return;
+    }
+    
+    [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop) {
+        [itemCounts setValue:[self numberOfItemsInSection:(NSInteger)section]
+                     atIndex:section];
+    }];
+}
+
+- (void)insertItemCountsForSections:(NSIndexSet *)sections {
+    SSCountTree *itemCounts = self.itemCounts;
+    NSUInteger sectionCount = [self numberOfSections];
+    
+    if (!itemCounts || [sections count] == 0) {
+        return;
+    }
+    
+    if ([itemCounts count] + [sections count] != sectionCount
+        || [sections lastIndex] >= sectionCount) {
+        self.itemCounts = nil;
+        return;
+    }
+    
+    [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop) {
+        [itemCounts insertValue:[self numberOfItemsInSection:(NSInteger)section]
+                        atIndex:section];
+    }];
+}
+
+- (void)removeItemCountsForSections:(NSIndexSet *)sections {
+    SSCountTree *itemCounts = self.itemCounts;
+    
+    if (!itemCounts || [sections count] == 0) {
+        return;
+    }
+    
+    if ([sections lastIndex] >= [itemCounts count]
+        || [itemCounts count] - [sections count] != [self numberOfSections]) {
+        self.itemCounts = nil;
+        return;
+    }
+    
+    [sections enumerateIndexesWithOptions:NSEnumerationReverse
+                               usingBlock:^(NSUInteger section, BOOL *stop) {
+        [itemCounts removeValueAtIndex:section];
+    }];
+}
+
+- (void)updateItemCountsWithChanges:(SSSectionedDiff *)changes {
+    SSCountTree *itemCounts = self.itemCounts;
+    NSUInteger sectionCount = [self numberOfSections];
+    
+    if (!itemCounts) {
+        return;
+    }
+    
+    // The counts followed each change as it was made. Sections changed with
+    // index paths from before the update were counted against the wrong sections,
+    // so every section the update touched is counted again.
+    if ([itemCounts count] != sectionCount) {
+        self.itemCounts = nil;
+        return;
+    }
+    
+    NSMutableIndexSet *changedSections = [changes.addedSections mutableCopy];
+    
+    void (^addOldSection)(NSUInteger) = ^(NSUInteger oldSection) {
+        NSUInteger section = [changes sectionAfterChangesForSection:oldSection];
+    
+        if (section != NSNotFound) {
+            [changedSections addIndex:section];
+        }
+    };
+    
+    [changes.reloadedSections enumerateIndexesUsingBlock:^(NSUInteger oldSection, BOOL *stop) {
+        addOldSection(oldSection);
+    }];
+    
+    for (NSIndexPath *indexPath in changes.deletedIndexPaths) {
+        addOldSection((NSUInteger)indexPath.section);
+    }
+    
+    for (NSIndexPath *indexPath in changes.insertedIndexPaths) {
+        [changedSections addIndex:(NSUInteger)indexPath.section];
+    }
+    
+    for (SSSectionedDiffMove *move in changes.moves) {
+        addOldSection((NSUInteger)move.fromIndexPath.section);
+        [changedSections addIndex:(NSUInteger)move.toIndexPath.section];
+    }
+    
+    if ([changedSections count] > 0 && [changedSections lastIndex] >= sectionCount) {
+        self.itemCounts = nil;
+        return;
+    }
+    
+    [changedSections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop) {
+        [itemCounts setValue:[self numberOfItemsInSection:(NSInteger)section]
+                     atIndex:section];
     }];
 }
 
@@ -108,6 +487,17 @@
     return [self titleForFooterInSection:section];
 }
 
+- (NSArray *)sectionIndexTitlesForTableView:(UITableView *)tableView {
+    return [self sectionIndexTitles];
+}
+
+- (NSInteger)tableView:(UITableView *)tableView
+sectionForSectionIndexTitle:(NSString *)title
+               atIndex:(NSInteger)index {
+    
+    return [self sectionForSectionIndexTitleAtIndex:index];
+}
+
 - (void)tableView:(UITableView *)tableView 
 moveRowAtIndexPath:(NSIndexPath *)sourceIndexPath
       toIndexPath:(NSIndexPath *)destinationIndexPath {
@@ -116,7 +506,10 @@ moveRowAtIndexPath:(NSIndexPath *)sourceIndexPath
     [[self sectionAtIndex:sourceIndexPath.section].items removeObjectAtIndex:(NSUInteger)sourceIndexPath.row];
     [[self sectionAtIndex:destinationIndexPath.section].items insertObject:item
                                                                    atIndex:(NSUInteger)destinationIndexPath.row];
-  
+    [self invalidateItemIndexFromIndexPath:([sourceIndexPath compare:destinationIndexPath] == NSOrderedAscending
+                                            ? sourceIndexPath
+                                            : destinationIndexPath)];
+    [self updateItemCountsForIndexPaths:@[ sourceIndexPath, destinationIndexPath ]];
 }
 
 #pragma mark - Moving
@@ -128,6 +521,8 @@ moveRowAtIndexPath:(NSIndexPath *)sourceIndexPath
     [self.sections insertObject:section
                         atIndex:(NSUInteger)toIndex];
     
+    [self.itemCounts moveValueAtIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex];
+    [self invalidateSectionIndexesFromIndex:(NSUInteger)MIN(fromIndex, toIndex)];
     [super moveSectionAtIndex:fromIndex toIndex:toIndex];
 }
 
@@ -145,12 +540,12 @@ moveRowAtIndexPath:(NSIndexPath *)sourceIndexPath
     [self insertSectionsAtIndexes:[NSIndexSet indexSetWithIndex:(NSUInteger)index]];
 }
 
-- (void) insertSections:(NSArray *)newSections atIndexes:(NSIndexSet *)indexes {
+- (NSArray *)sectionsFromArray:(NSArray *)sectionObjects {
     NSMutableArray *mutableSections = [NSMutableArray array];
     
-    [newSections enumerateObjectsUsingBlock:^(id sectionObject,
-                                              NSUInteger sectionIndex,
-                                              BOOL *stop) {
+    [sectionObjects enumerateObjectsUsingBlock:^(id sectionObject,
+                                                 NSUInteger sectionIndex,
+                                                 BOOL *stop) {
         if ([sectionObject isKindOfClass:[SSSection class]])
             [mutableSections addObject:sectionObject];
         else if ([sectionObject isKindOfClass:[NSArray class]])
@@ -158,13 +553,143 @@ moveRowAtIndexPath:(NSIndexPath *)sourceIndexPath
         else
             NSLog(@"Invalid SSSectionedDataSource section object: %@", sectionObject);
     }];
-      
-    [self.sections insertObjects:mutableSections
+    
+    return mutableSections;
+}
+
+- (void) insertSections:(NSArray *)newSections atIndexes:(NSIndexSet *)indexes {
+    [self.sections insertObjects:[self sectionsFromArray:newSections]
                        atIndexes:indexes];
     
     [self insertSectionsAtIndexes:indexes];
 }
 
+#pragma mark - Replacing sections
+
+- (void)applySections:(NSArray *)newSections {
+    [self _cancelBackgroundDiffs];
+    
+    NSArray *sections = [self sectionsFromArray:newSections];
+    
+    SSSectionedDiff *diff = [SSSectionedDiff diffFromSections:[self.sections copy]
+                                                   toSections:sections
+                                              identifierBlock:self.itemIdentifierBlock
+                                                equalityBlock:self.itemEqualityBlock];
+    
+    [self applyDiff:diff withSections:sections];
+}
+
+- (void)applySections:(NSArray *)newSections completion:(void (^)(BOOL))completion {
+    NSArray *sections = [self sectionsFromArray:newSections];
+    NSArray *oldSections = [self sectionsForBackgroundDiff];
+    SSItemIdentifierBlock identifierBlock = self.itemIdentifierBlock;
+    SSItemEqualityBlock equalityBlock = self.itemEqualityBlock;
+    __weak SSSectionedDataSource *weakSelf = self;
+    
+    [self _performBackgroundDiff:^id{
+        return [SSSectionedDiff diffFromSections:oldSections
+                                      toSections:sections
+                                 identifierBlock:identifierBlock
+                                   equalityBlock:equalityBlock];
+    } apply:^BOOL(SSSectionedDiff *diff) {
+        [weakSelf applyDiff:diff withSections:sections];
+        return YES;
+    } retry:^{
+        [weakSelf applySections:sections completion:completion];
+    } completion:completion];
+}
+
+- (NSArray *)sectionsForBackgroundDiff {
+    SSDataSourceSnapshot *snapshot = [self snapshot];
+    NSMutableArray *sections = [NSMutableArray arrayWithCapacity:[self.sections count]];
+    
+    // Sections are mutable, so the diff reads their items from a snapshot, which shares
+    // their storage, instead of copying them here. Only sections whose visible items
+    // differ from their contents, e.g. collapsed ones, are copied.
+    [self.sections enumerateObjectsUsingBlock:^(SSSection *section, NSUInteger index, BOOL *stop) {
+        NSArray *items = [snapshot itemsInSection:index];
+    
+        if ([items count] != [section numberOfItems]) {
+            [sections addObject:[section copy]];
+            return;
+        }
+    
+        SSSection *standIn = [SSSection sectionWithNumberOfItems:[items count]
+                                                    itemProvider:^id(NSUInteger row) {
+                                                        return items[row];
+                                                    }];
+        standIn.header = section.header;
+        standIn.footer = section.footer;
+        standIn.sectionIdentifier = section.sectionIdentifier;
+        [sections addObject:standIn];
+    }];
+    
+    return sections;
+}
+
+- (void)applyDiff:(SSSectionedDiff *)diff withSections:(NSArray *)newSections {
+    [self invalidateSectionIndexesFromIndex:0];
+    
+    if (![diff hasChanges]) {
+        [self.sections setArray:newSections];
+        return;
+    }
+    
+    if ([self exceedsMaximumAnimatedChangeCount:diff.changeCount]) {
+        [self.sections setArray:newSections];
+        [self reloadData];
+        return;
+    }
+    
+    // Reloaded items keep their identifiers, but their contents changed,
+    // and deleted items won't be found at their index paths once the new sections are in place.
+    [self invalidateSizesForItemsAtIndexPaths:[diff.reloadedIndexPaths arrayByAddingObjectsFromArray:diff.deletedIndexPaths]];
+    [self _invalidateSizesForItemsInSections:diff.reloadedSections];
+    [self _invalidateSizesForItemsInSections:diff.deletedSections];
+    
+    [self performBatchUpdates:^{
+        [self.sections setArray:newSections];
+        
+        // The changes below are described in terms of the old sections, not the current ones.
+        self.itemCounts = nil;
+        
+        if ([diff.deletedSections count] > 0) {
+            [self deleteSectionsAtIndexes:diff.deletedSections];
+        }
+        
+        if ([diff.insertedSections count] > 0) {
+            [self insertSectionsAtIndexes:diff.insertedSections];
+        }
+        
+        if ([diff.reloadedSections count] > 0) {
+            [self reloadSectionsAtIndexes:diff.reloadedSections];
+        }
+        
+        for (SSArrayDiffMove *move in diff.sectionMoves) {
+            // Our own override of this method moves the section object as well.
+            [super moveSectionAtIndex:(NSInteger)move.fromIndex
+                              toIndex:(NSInteger)move.toIndex];
+        }
+        
+        if ([diff.deletedIndexPaths count] > 0) {
+            [self deleteCellsAtIndexPaths:diff.deletedIndexPaths];
+        }
+        
+        if ([diff.insertedIndexPaths count] > 0) {
+            [self insertCellsAtIndexPaths:diff.insertedIndexPaths];
+        }
+        
+        if ([diff.reloadedIndexPaths count] > 0) {
+            [self reloadCellsAtIndexPaths:diff.reloadedIndexPaths];
+        }
+        
+        for (SSSectionedDiffMove *move in diff.moves) {
+            [self moveCellAtIndexPath:move.fromIndexPath
+                          toIndexPath:move.toIndexPath];
+        }
+    }];
+}
+
 - (void)insertItem:(id)item atIndexPath:(NSIndexPath *)indexPath {
     [[self sectionAtIndex:indexPath.section].items insertObject:item
                                                         atIndex:(NSUInteger)indexPath.row];
@@ -179,8 +704,7 @@ moveRowAtIndexPath:(NSIndexPath *)sourceIndexPath
     [[self sectionAtIndex:section].items insertObjects:items
                                              atIndexes:indexes];
     
-    [self insertCellsAtIndexPaths:[self.class indexPathArrayWithIndexSet:indexes
-                                                               inSection:section]];
+    [self insertCellsAtIndexes:indexes inSection:section];
 }
 
 - (void)appendItems:(NSArray *)items toSection:(NSInteger)section {
@@ -188,15 +712,15 @@ moveRowAtIndexPath:(NSIndexPath *)sourceIndexPath
     
     [[self sectionAtIndex:section].items addObjectsFromArray:items];
     
-    [self insertCellsAtIndexPaths:[self.class indexPathArrayWithRange:NSMakeRange(sectionCount,
-                                                                                  [items count])
-                                                            inSection:section]];
+    [self insertCellsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(sectionCount, [items count])]
+                     inSection:section];
 }
 
 #pragma mark - Replacing
 
 - (void)replaceItemAtIndexPath:(NSIndexPath *)indexPath withItem:(id)item {
     
+    [self invalidateSizesForItemsAtIndexPaths:@[ indexPath ]];
     [[self sectionAtIndex:indexPath.section].items removeObjectAtIndex:(NSUInteger)indexPath.row];
     [[self sectionAtIndex:indexPath.section].items insertObject:item
                                                         atIndex:(NSUInteger)indexPath.row];
@@ -217,16 +741,16 @@ moveRowAtIndexPath:(NSIndexPath *)sourceIndexPath
         return YES;
     }
     
-    SSSection *section = [self sectionAtIndex:index];
-
-    if (numberOfItems > [section numberOfItems]) {
-        for (NSUInteger i = [section numberOfItems]; i < numberOfItems; i++) {
-            [section.items insertObject:@(i) atIndex:i];
-        }
-    } else {
-        [section.items removeObjectsInRange:NSMakeRange(numberOfItems, [section numberOfItems] - numberOfItems)];
+    // Items cut from the end won't be found again.
+    if (numberOfItems < [self numberOfItemsInSection:index] && [self _hasCachedData]) {
+        [self invalidateSizesForItemsAtIndexPaths:
+         [self.class indexPathArrayWithRange:NSMakeRange(numberOfItems, [self numberOfItemsInSection:index] - numberOfItems)
+                                   inSection:(NSInteger)index]];
     }
     
+    // Constant time for virtual sections.
+    [[self sectionAtIndex:index] setNumberOfItems:numberOfItems];
+    
     [self reloadSectionsAtIndexes:[NSIndexSet indexSetWithIndex:index]];
     
     return YES;
@@ -252,6 +776,7 @@ moveRowAtIndexPath:(NSIndexPath *)sourceIndexPath
 }
 
 - (void)removeSectionsAtIndexes:(NSIndexSet *)indexes {
+    [self _invalidateSizesForItemsInSections:indexes];
     [self.sections removeObjectsAtIndexes:indexes];
     [self deleteSectionsAtIndexes:indexes];
 }
@@ -264,6 +789,14 @@ moveRowAtIndexPath:(NSIndexPath *)sourceIndexPath
     }
 }
 
+- (void)removeSectionsWithIdentifiers:(NSArray *)identifiers {
+    NSIndexSet *indexes = [self indexesOfSectionsWithIdentifiers:identifiers];
+    
+    if ([indexes count] > 0) {
+        [self removeSectionsAtIndexes:indexes];
+    }
+}
+
 - (void)removeItemAtIndexPath:(NSIndexPath *)indexPath {
     [self removeItemsAtIndexes:[NSIndexSet indexSetWithIndex:(NSUInteger)indexPath.row]
                      inSection:indexPath.section];
@@ -275,26 +808,79 @@ moveRowAtIndexPath:(NSIndexPath *)sourceIndexPath
 }
 
 - (void)removeItemsAtIndexes:(NSIndexSet *)indexes inSection:(NSInteger)section {
+    if ([self _hasCachedData]) {
+        [self _removeCachedDataForItems:[[self sectionAtIndex:section].items objectsAtIndexes:indexes]];
+    }
+    
     [[self sectionAtIndex:section].items removeObjectsAtIndexes:indexes];
     
     if (self.shouldRemoveEmptySections && [self numberOfItemsInSection:section] == 0) {
         [self removeSectionAtIndex:section];
     } else {
-        [self deleteCellsAtIndexPaths:[self.class indexPathArrayWithIndexSet:indexes
-                                                                   inSection:section]];
+        [self deleteCellsAtIndexes:indexes inSection:section];
     }
 }
 
+#pragma mark - UITableView/UICollectionView Operations
+
+- (void)insertCellsAtIndexPaths:(NSArray *)indexPaths {
+    [self updateItemCountsForIndexPaths:indexPaths];
+    [super insertCellsAtIndexPaths:indexPaths];
+}
+
+- (void)deleteCellsAtIndexPaths:(NSArray *)indexPaths {
+    [self updateItemCountsForIndexPaths:indexPaths];
+    [super deleteCellsAtIndexPaths:indexPaths];
+}
+
+- (void)insertCellsAtIndexes:(NSIndexSet *)indexes inSection:(NSInteger)section {
+    [self updateItemCountsInSections:[NSIndexSet indexSetWithIndex:(NSUInteger)section]];
+    [super insertCellsAtIndexes:indexes inSection:section];
+}
+
+- (void)deleteCellsAtIndexes:(NSIndexSet *)indexes inSection:(NSInteger)section {
+    [self updateItemCountsInSections:[NSIndexSet indexSetWithIndex:(NSUInteger)section]];
+    [super deleteCellsAtIndexes:indexes inSection:section];
+}
+
+- (void)moveCellAtIndexPath:(NSIndexPath *)index1 toIndexPath:(NSIndexPath *)index2 {
+    [self updateItemCountsForIndexPaths:@[ index1, index2 ]];
+    [super moveCellAtIndexPath:index1 toIndexPath:index2];
+}
+
+- (void)insertSectionsAtIndexes:(NSIndexSet *)indexes {
+    [self insertItemCountsForSections:indexes];
+    [self invalidateSectionIndexesFromIndex:[indexes firstIndex]];
+    [super insertSectionsAtIndexes:indexes];
+}
+
+- (void)deleteSectionsAtIndexes:(NSIndexSet *)indexes {
+    [self removeItemCountsForSections:indexes];
+    [self invalidateSectionIndexesFromIndex:[indexes firstIndex]];
+    [super deleteSectionsAtIndexes:indexes];
+}
+
+- (void)reloadSectionsAtIndexes:(NSIndexSet *)indexes {
+    [self updateItemCountsInSections:indexes];
+    [self invalidateSectionIndexesFromIndex:[indexes firstIndex]];
+    [super reloadSectionsAtIndexes:indexes];
+}
+
+- (void)reloadData {
+    self.itemCounts = nil;
+    [self invalidateSectionIndexesFromIndex:0];
+    [super reloadData];
+}
+
+- (void)_didApplyChanges:(SSSectionedDiff *)changes {
+    [self updateItemCountsWithChanges:changes];
+    [super _didApplyChanges:changes];
+}
+
 #pragma mark - UITableViewDelegate helpers
 
 - (SSBaseHeaderFooterView *)headerFooterViewWithClass:(Class)class {
-    SSBaseHeaderFooterView *headerFooterView = [self.tableView dequeueReusableHeaderFooterViewWithIdentifier:
-                                                [class identifier]];
-    
-    if (!headerFooterView)
-        headerFooterView = [class new];
-    
-    return headerFooterView;
+    return [class viewForTableView:self.tableView];
 }
 
 - (SSBaseHeaderFooterView *)viewForHeaderInSection:(NSInteger)section {
@@ -0,0 +1,181 @@
+//
+//  SSSectionedDiff.h
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "SSArrayDiff.h"
+
+/**
+ * SSSectionedDiff computes the changes required to transform one array of `SSSection`s
+ * into another. Sections are matched by `sectionIdentifier`, then the items within
+ * each matched section are diffed, including items that move between sections.
+ *
+ * As with `SSArrayDiff`, deleted and reloaded sections and index paths refer to
+ * the old sections; inserted sections and index paths refer to the new sections.
+ */
+
+#pragma mark - SSSectionedDiffMove
+
+@interface SSSectionedDiffMove : NSObject
+
+/**
+ * Index path of the moved item in the old sections.
+ */
+@property (nonatomic, strong, readonly) NSIndexPath *fromIndexPath;
+
+/**
+ * Index path of the moved item in the new sections.
+ */
+@property (nonatomic, strong, readonly) NSIndexPath *toIndexPath;
+
+@end
+
+#pragma mark - SSSectionedDiff
+
+@interface SSSectionedDiff : NSObject
+
+/**
+ *  Compute the difference between two arrays of sections.
+ *
+ *  Sections without a `sectionIdentifier` are only matched with themselves;
+ *  pass new `SSSection` objects rather than mutating the existing ones.
+ *  A matched section whose header or footer changed is reloaded.
+ *
+ *  @param oldSections     the original array of SSSection objects
+ *  @param newSections     the updated array of SSSection objects
+ *  @param identifierBlock nil, or a block returning an identifier for each item
+ *  @param equalityBlock   nil, or a block comparing the contents of two matched items
+ *
+ *  @return a diff between the two arrays of sections
+ */
++ (instancetype) diffFromSections:(NSArray *)oldSections
+                       toSections:(NSArray *)newSections
+                  identifierBlock:(SSItemIdentifierBlock)identifierBlock
+                    equalityBlock:(SSItemEqualityBlock)equalityBlock;
+
+/**
+ * Indexes of old sections that were removed.
+ */
+@property (nonatomic, strong, readonly) NSIndexSet *deletedSections;
+
+/**
+ * Indexes of new sections that were added.
+ */
+@property (nonatomic, strong, readonly) NSIndexSet *insertedSections;
+
+/**
+ * Indexes of old sections that should be reloaded in their entirety.
+ */
+@property (nonatomic, strong, readonly) NSIndexSet *reloadedSections;
+
+/**
+ * An array of `SSArrayDiffMove` objects describing moved sections.
+ */
+@property (nonatomic, strong, readonly) NSArray *sectionMoves;
+
+/**
+ * Index paths in the old sections of items that were removed.
+ */
+@property (nonatomic, strong, readonly) NSArray *deletedIndexPaths;
+
+/**
+ * Index paths in the new sections of items that were added.
+ */
+@property (nonatomic, strong, readonly) NSArray *insertedIndexPaths;
+
+/**
+ * Index paths in the old sections of items whose contents changed.
+ */
+@property (nonatomic, strong, readonly) NSArray *reloadedIndexPaths;
+
+/**
+ * An array of `SSSectionedDiffMove` objects describing moved items,
+ * within a section or between sections.
+ */
+@property (nonatomic, strong, readonly) NSArray *moves;
+
+/**
+ * Total number of section and item changes in this diff.
+ */
+@property (nonatomic, assign, readonly) NSUInteger changeCount;
+
+/**
+ *  YES if applying this diff would change the table or collection view.
+ */
+- (BOOL) hasChanges;
+
+/**
+ * Indexes of old sections that leave their place, whether deleted or moved away.
+ */
+@property (nonatomic, strong, readonly) NSIndexSet *removedSections;
+
+/**
+ * Indexes of new sections that arrive in their place, whether inserted or moved there.
+ */
+@property (nonatomic, strong, readonly) NSIndexSet *addedSections;
+
+/**
+ *  YES if this diff can describe the change from a number of old sections
+ *  to a number of new sections, i.e. every section it refers to exists
+ *  and the sections removed and added account for the difference.
+ *
+ *  @param oldSectionCount number of sections before the changes
+ *  @param newSectionCount number of sections after the changes
+ */
+- (BOOL) isValidFromSectionCount:(NSUInteger)oldSectionCount
+                  toSectionCount:(NSUInteger)newSectionCount;
+
+/**
+ *  Find where a section ends up once this diff is applied.
+ *
+ *  @param section a section index in the old sections
+ *
+ *  @return the section's index in the new sections, or NSNotFound if it is deleted
+ */
+- (NSUInteger) sectionAfterChangesForSection:(NSUInteger)section;
+
+/**
+ *  Find where a section was before this diff is applied.
+ *
+ *  @param section a section index in the new sections
+ *
+ *  @return the section's index in the old sections, or NSNotFound if it was inserted
+ */
+- (NSUInteger) sectionBeforeChangesForSection:(NSUInteger)section;
+
+/**
+ *  Rows that leave an old section, whether deleted or moved away.
+ *
+ *  @param section a section index in the old sections
+ */
+- (NSIndexSet *) removedRowsInSection:(NSUInteger)section;
+
+/**
+ *  Rows that arrive in a new section, whether inserted or moved there.
+ *
+ *  @param section a section index in the new sections
+ */
+- (NSIndexSet *) addedRowsInSection:(NSUInteger)section;
+
+/**
+ *  Rows of an old section whose contents changed.
+ *
+ *  @param section a section index in the old sections
+ */
+- (NSIndexSet *) reloadedRowsInSection:(NSUInteger)section;
+
+/**
+ *  Find where a row that is neither deleted nor moved ends up once this diff is applied,
+ *  such as a reloaded row, which the diff only knows by its old index path.
+ *
+ *  @param indexPath an index path in the old sections
+ *
+ *  @return the row's index path in the new sections, or nil if it or its section is deleted
+ */
+- (NSIndexPath *) indexPathAfterChangesForIndexPath:(NSIndexPath *)indexPath;
+
+@end
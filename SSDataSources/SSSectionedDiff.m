@@ -0,0 +1,566 @@
+//
+//  SSSectionedDiff.m
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSDataSources.h"
+
+static inline BOOL SSObjectsAreEqual(id object1, id object2) {
+    return (object1 == object2 || [object1 isEqual:object2]);
+}
+
+static inline BOOL SSDiffItemsAreEqual(id oldItem, id newItem, SSItemEqualityBlock equalityBlock) {
+    if (oldItem == newItem) {
+        return YES;
+    }
+
+    return (equalityBlock ? equalityBlock(oldItem, newItem) : [oldItem isEqual:newItem]);
+}
+
+// Where an index lands after the indexes in `removed` are taken out of the old array
+// and those in `added` are put into the new one.
+static NSUInteger SSIndexAfterChanges(NSUInteger index, NSIndexSet *removed, NSIndexSet *added) {
+    NSUInteger newIndex = index - [removed countOfIndexesInRange:NSMakeRange(0, index)];
+
+    for (NSUInteger addedIndex = [added firstIndex];
+         addedIndex != NSNotFound && addedIndex <= newIndex;
+         addedIndex = [added indexGreaterThanIndex:addedIndex]) {
+        newIndex++;
+    }
+
+    return newIndex;
+}
+
+#pragma mark - SSSectionedDiffMove
+
+@interface SSSectionedDiffMove ()
+
+@property (nonatomic, strong, readwrite) NSIndexPath *fromIndexPath;
+@property (nonatomic, strong, readwrite) NSIndexPath *toIndexPath;
+
++ (instancetype) moveFromIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath;
+
+@end
+
+@implementation SSSectionedDiffMove
+
++ (instancetype)moveFromIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath {
+    SSSectionedDiffMove *move = [self new];
+    move.fromIndexPath = fromIndexPath;
+    move.toIndexPath = toIndexPath;
+
+    return move;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %@ -> %@>",
+            NSStringFromClass([self class]),
+            self.fromIndexPath,
+            self.toIndexPath];
+}
+
+@end
+
+#pragma mark - SSSectionedDiff
+
+@interface SSSectionedDiff ()
+
+@property (nonatomic, strong, readwrite) NSIndexSet *deletedSections;
+@property (nonatomic, strong, readwrite) NSIndexSet *insertedSections;
+@property (nonatomic, strong, readwrite) NSIndexSet *reloadedSections;
+@property (nonatomic, strong, readwrite) NSArray *sectionMoves;
+@property (nonatomic, strong, readwrite) NSArray *deletedIndexPaths;
+@property (nonatomic, strong, readwrite) NSArray *insertedIndexPaths;
+@property (nonatomic, strong, readwrite) NSArray *reloadedIndexPaths;
+@property (nonatomic, strong, readwrite) NSArray *moves;
+
+// The changes above grouped by section, built when first needed. Sections leave
+// from their old indexes and arrive at their new ones; removed and reloaded rows
+// are keyed by old section, added rows by new section.
+@property (nonatomic, strong) NSIndexSet *removedSectionIndexes;
+@property (nonatomic, strong) NSIndexSet *addedSectionIndexes;
+@property (nonatomic, strong) NSDictionary *movedSectionOrigins;
+@property (nonatomic, strong) NSDictionary *movedSectionDestinations;
+@property (nonatomic, strong) NSDictionary *removedRowsBySection;
+@property (nonatomic, strong) NSDictionary *addedRowsBySection;
+@property (nonatomic, strong) NSDictionary *reloadedRowsBySection;
+
+- (void) _indexChangesIfNeeded;
+- (void) _invalidateIndexedChanges;
+
+// An empty diff whose collections are mutable, to which the operations
+// of a batch update are added as they are sent to a table or collection view.
+// Deletes and reloads refer to index paths before the batch, inserts to index paths after it.
++ (instancetype) batchUpdateDiff;
+
+- (void) insertRowsAtIndexPaths:(NSArray *)indexPaths;
+- (void) deleteRowsAtIndexPaths:(NSArray *)indexPaths;
+- (void) reloadRowsAtIndexPaths:(NSArray *)indexPaths;
+- (void) moveRowAtIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath;
+
+- (void) insertSections:(NSIndexSet *)sections;
+- (void) deleteSections:(NSIndexSet *)sections;
+- (void) reloadSections:(NSIndexSet *)sections;
+- (void) moveSection:(NSUInteger)fromSection toSection:(NSUInteger)toSection;
+
+- (void) addChangesFromDiff:(SSSectionedDiff *)diff;
+
+@end
+
+@interface SSArrayDiffMove ()
+
++ (instancetype) moveFromIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex;
+
+@end
+
+@implementation SSSectionedDiff
+
++ (instancetype)diffFromSections:(NSArray *)oldSections
+                      toSections:(NSArray *)newSections
+                 identifierBlock:(SSItemIdentifierBlock)identifierBlock
+                   equalityBlock:(SSItemEqualityBlock)equalityBlock {
+
+    SSItemIdentifierBlock sectionIdentifierBlock = ^id(SSSection *section) {
+        return section.sectionIdentifier;
+    };
+
+    SSArrayDiff *sectionDiff = [SSArrayDiff diffFromArray:oldSections
+                                                  toArray:newSections
+                                          identifierBlock:sectionIdentifierBlock
+                                            equalityBlock:^BOOL(SSSection *oldSection, SSSection *newSection) {
+                                                return SSObjectsAreEqual(oldSection.header, newSection.header)
+                                                    && SSObjectsAreEqual(oldSection.footer, newSection.footer);
+                                            }];
+
+    NSUInteger oldSectionCount = [oldSections count];
+    NSUInteger newSectionCount = [newSections count];
+    NSUInteger *oldToNewSection = malloc(sizeof(NSUInteger) * MAX(oldSectionCount, 1u));
+    NSUInteger *newToOldSection = malloc(sizeof(NSUInteger) * MAX(newSectionCount, 1u));
+
+    [SSArrayDiff matchItemsInArray:oldSections
+                           toArray:newSections
+                   identifierBlock:sectionIdentifierBlock
+                          oldToNew:oldToNewSection
+                          newToOld:newToOldSection];
+
+    // Only items in sections that survive without being reloaded are diffed individually.
+    // Items in inserted, deleted and reloaded sections come and go with their section.
+    for (NSUInteger newSection = 0; newSection < newSectionCount; newSection++) {
+        NSUInteger oldSection = newToOldSection[newSection];
+
+        if (oldSection == NSNotFound) {
+            continue;
+        }
+
+        if ([sectionDiff.insertedIndexes containsIndex:newSection]
+            || [sectionDiff.reloadedIndexes containsIndex:oldSection]) {
+            newToOldSection[newSection] = NSNotFound;
+            oldToNewSection[oldSection] = NSNotFound;
+        }
+    }
+
+    for (NSUInteger oldSection = 0; oldSection < oldSectionCount; oldSection++) {
+        if ([sectionDiff.deletedIndexes containsIndex:oldSection]) {
+            oldToNewSection[oldSection] = NSNotFound;
+        }
+    }
+
+    // Flatten the tracked items so that items can be matched across sections.
+    NSMutableArray *oldItems = [NSMutableArray array];
+    NSMutableArray *newItems = [NSMutableArray array];
+    NSMutableData *oldPositions = [NSMutableData data];
+    NSUInteger *newSectionOffsets = malloc(sizeof(NSUInteger) * MAX(newSectionCount, 1u));
+
+    for (NSUInteger oldSection = 0; oldSection < oldSectionCount; oldSection++) {
+        if (oldToNewSection[oldSection] == NSNotFound) {
+            continue;
+        }
+
+        SSSection *section = oldSections[oldSection];
+
+        for (NSUInteger row = 0; row < [section numberOfItems]; row++) {
+            NSUInteger position[2] = { oldSection, row };
+
+            [oldItems addObject:[section itemAtIndex:row]];
+            [oldPositions appendBytes:position length:sizeof(position)];
+        }
+    }
+
+    for (NSUInteger newSection = 0; newSection < newSectionCount; newSection++) {
+        newSectionOffsets[newSection] = [newItems count];
+
+        if (newToOldSection[newSection] == NSNotFound) {
+            continue;
+        }
+
+        SSSection *section = newSections[newSection];
+
+        for (NSUInteger row = 0; row < [section numberOfItems]; row++) {
+            [newItems addObject:[section itemAtIndex:row]];
+        }
+    }
+
+    NSUInteger oldItemCount = [oldItems count];
+    NSUInteger newItemCount = [newItems count];
+    const NSUInteger *oldItemPositions = [oldPositions bytes];
+    NSUInteger *oldToNewItem = malloc(sizeof(NSUInteger) * MAX(oldItemCount, 1u));
+    NSUInteger *newToOldItem = malloc(sizeof(NSUInteger) * MAX(newItemCount, 1u));
+
+    [SSArrayDiff matchItemsInArray:oldItems
+                           toArray:newItems
+                   identifierBlock:identifierBlock
+                          oldToNew:oldToNewItem
+                          newToOld:newToOldItem];
+
+    NSMutableArray *deletedIndexPaths = [NSMutableArray array];
+    NSMutableArray *insertedIndexPaths = [NSMutableArray array];
+    NSMutableArray *reloadedIndexPaths = [NSMutableArray array];
+    NSMutableArray *moves = [NSMutableArray array];
+
+    for (NSUInteger index = 0; index < oldItemCount; index++) {
+        if (oldToNewItem[index] == NSNotFound) {
+            [deletedIndexPaths addObject:[NSIndexPath indexPathForRow:(NSInteger)oldItemPositions[2 * index + 1]
+                                                            inSection:(NSInteger)oldItemPositions[2 * index]]];
+        }
+    }
+
+    NSUInteger *sequence = malloc(sizeof(NSUInteger) * MAX(newItemCount, 1u));
+    NSUInteger *sequenceRows = malloc(sizeof(NSUInteger) * MAX(newItemCount, 1u));
+
+    for (NSUInteger newSection = 0; newSection < newSectionCount; newSection++) {
+        NSUInteger oldSection = newToOldSection[newSection];
+
+        if (oldSection == NSNotFound) {
+            continue;
+        }
+
+        NSUInteger rowCount = [(SSSection *)newSections[newSection] numberOfItems];
+        NSUInteger sequenceCount = 0;
+
+        for (NSUInteger row = 0; row < rowCount; row++) {
+            NSUInteger newIndex = newSectionOffsets[newSection] + row;
+            NSUInteger oldIndex = newToOldItem[newIndex];
+            NSIndexPath *newIndexPath = [NSIndexPath indexPathForRow:(NSInteger)row
+                                                           inSection:(NSInteger)newSection];
+
+            if (oldIndex == NSNotFound) {
+                [insertedIndexPaths addObject:newIndexPath];
+            } else if (oldItemPositions[2 * oldIndex] != oldSection) {
+                NSIndexPath *oldIndexPath = [NSIndexPath indexPathForRow:(NSInteger)oldItemPositions[2 * oldIndex + 1]
+                                                               inSection:(NSInteger)oldItemPositions[2 * oldIndex]];
+
+                if (SSDiffItemsAreEqual(oldItems[oldIndex], newItems[newIndex], equalityBlock)) {
+                    [moves addObject:[SSSectionedDiffMove moveFromIndexPath:oldIndexPath
+                                                                toIndexPath:newIndexPath]];
+                } else {
+                    [deletedIndexPaths addObject:oldIndexPath];
+                    [insertedIndexPaths addObject:newIndexPath];
+                }
+            } else {
+                sequence[sequenceCount] = oldIndex;
+                sequenceRows[sequenceCount] = row;
+                sequenceCount++;
+            }
+        }
+
+        NSIndexSet *stablePositions = [SSArrayDiff indexesOfStableElementsInSequence:sequence
+                                                                               count:sequenceCount];
+
+        for (NSUInteger position = 0; position < sequenceCount; position++) {
+            NSUInteger oldIndex = sequence[position];
+            NSUInteger newIndex = newSectionOffsets[newSection] + sequenceRows[position];
+            NSIndexPath *oldIndexPath = [NSIndexPath indexPathForRow:(NSInteger)oldItemPositions[2 * oldIndex + 1]
+                                                           inSection:(NSInteger)oldSection];
+            NSIndexPath *newIndexPath = [NSIndexPath indexPathForRow:(NSInteger)sequenceRows[position]
+                                                           inSection:(NSInteger)newSection];
+            BOOL changed = !SSDiffItemsAreEqual(oldItems[oldIndex], newItems[newIndex], equalityBlock);
+
+            if ([stablePositions containsIndex:position]) {
+                if (changed) {
+                    [reloadedIndexPaths addObject:oldIndexPath];
+                }
+            } else if (changed) {
+                [deletedIndexPaths addObject:oldIndexPath];
+                [insertedIndexPaths addObject:newIndexPath];
+            } else {
+                [moves addObject:[SSSectionedDiffMove moveFromIndexPath:oldIndexPath
+                                                            toIndexPath:newIndexPath]];
+            }
+        }
+    }
+
+    free(oldToNewSection);
+    free(newToOldSection);
+    free(newSectionOffsets);
+    free(oldToNewItem);
+    free(newToOldItem);
+    free(sequence);
+    free(sequenceRows);
+
+    SSSectionedDiff *diff = [self new];
+    diff.deletedSections = sectionDiff.deletedIndexes;
+    diff.insertedSections = sectionDiff.insertedIndexes;
+    diff.reloadedSections = sectionDiff.reloadedIndexes;
+    diff.sectionMoves = sectionDiff.moves;
+    diff.deletedIndexPaths = deletedIndexPaths;
+    diff.insertedIndexPaths = insertedIndexPaths;
+    diff.reloadedIndexPaths = reloadedIndexPaths;
+    diff.moves = moves;
+
+    return diff;
+}
+
+#pragma mark - Batch updates
+
++ (instancetype)batchUpdateDiff {
+    SSSectionedDiff *diff = [self new];
+    diff.deletedSections = [NSMutableIndexSet indexSet];
+    diff.insertedSections = [NSMutableIndexSet indexSet];
+    diff.reloadedSections = [NSMutableIndexSet indexSet];
+    diff.sectionMoves = [NSMutableArray array];
+    diff.deletedIndexPaths = [NSMutableArray array];
+    diff.insertedIndexPaths = [NSMutableArray array];
+    diff.reloadedIndexPaths = [NSMutableArray array];
+    diff.moves = [NSMutableArray array];
+
+    return diff;
+}
+
+- (void)insertRowsAtIndexPaths:(NSArray *)indexPaths {
+    [self _invalidateIndexedChanges];
+    [(NSMutableArray *)self.insertedIndexPaths addObjectsFromArray:indexPaths];
+}
+
+- (void)deleteRowsAtIndexPaths:(NSArray *)indexPaths {
+    [self _invalidateIndexedChanges];
+    [(NSMutableArray *)self.deletedIndexPaths addObjectsFromArray:indexPaths];
+}
+
+- (void)reloadRowsAtIndexPaths:(NSArray *)indexPaths {
+    [self _invalidateIndexedChanges];
+    [(NSMutableArray *)self.reloadedIndexPaths addObjectsFromArray:indexPaths];
+}
+
+- (void)moveRowAtIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath {
+    [self _invalidateIndexedChanges];
+    [(NSMutableArray *)self.moves addObject:[SSSectionedDiffMove moveFromIndexPath:fromIndexPath
+                                                                       toIndexPath:toIndexPath]];
+}
+
+- (void)insertSections:(NSIndexSet *)sections {
+    [self _invalidateIndexedChanges];
+    [(NSMutableIndexSet *)self.insertedSections addIndexes:sections];
+}
+
+- (void)deleteSections:(NSIndexSet *)sections {
+    [self _invalidateIndexedChanges];
+    [(NSMutableIndexSet *)self.deletedSections addIndexes:sections];
+}
+
+- (void)reloadSections:(NSIndexSet *)sections {
+    [self _invalidateIndexedChanges];
+    [(NSMutableIndexSet *)self.reloadedSections addIndexes:sections];
+}
+
+- (void)moveSection:(NSUInteger)fromSection toSection:(NSUInteger)toSection {
+    [self _invalidateIndexedChanges];
+    [(NSMutableArray *)self.sectionMoves addObject:[SSArrayDiffMove moveFromIndex:fromSection
+                                                                          toIndex:toSection]];
+}
+
+- (void)addChangesFromDiff:(SSSectionedDiff *)diff {
+    [self deleteSections:diff.deletedSections];
+    [self insertSections:diff.insertedSections];
+    [self reloadSections:diff.reloadedSections];
+    [(NSMutableArray *)self.sectionMoves addObjectsFromArray:diff.sectionMoves];
+    [self deleteRowsAtIndexPaths:diff.deletedIndexPaths];
+    [self insertRowsAtIndexPaths:diff.insertedIndexPaths];
+    [self reloadRowsAtIndexPaths:diff.reloadedIndexPaths];
+    [(NSMutableArray *)self.moves addObjectsFromArray:diff.moves];
+    [self _invalidateIndexedChanges];
+}
+
+- (NSUInteger)changeCount {
+    return [self.deletedSections count]
+         + [self.insertedSections count]
+         + [self.reloadedSections count]
+         + [self.sectionMoves count]
+         + [self.deletedIndexPaths count]
+         + [self.insertedIndexPaths count]
+         + [self.reloadedIndexPaths count]
+         + [self.moves count];
+}
+
+- (BOOL)hasChanges {
+    return [self changeCount] > 0;
+}
+
+#pragma mark - Mapping indexes
+
+- (void)_invalidateIndexedChanges {
+    self.removedSectionIndexes = nil;
+}
+
+- (void)_indexChangesIfNeeded {
+    if (self.removedSectionIndexes) {
+        return;
+    }
+
+    NSMutableIndexSet *removedSections = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *addedSections = [NSMutableIndexSet indexSet];
+    NSMutableDictionary *origins = [NSMutableDictionary dictionary];
+    NSMutableDictionary *destinations = [NSMutableDictionary dictionary];
+
+    [removedSections addIndexes:self.deletedSections];
+    [addedSections addIndexes:self.insertedSections];
+
+    for (SSArrayDiffMove *move in self.sectionMoves) {
+        [removedSections addIndex:move.fromIndex];
+        [addedSections addIndex:move.toIndex];
+        origins[@(move.toIndex)] = @(move.fromIndex);
+        destinations[@(move.fromIndex)] = @(move.toIndex);
+    }
+
+    NSMutableDictionary *removedRows = [NSMutableDictionary dictionary];
+    NSMutableDictionary *addedRows = [NSMutableDictionary dictionary];
+    NSMutableDictionary *reloadedRows = [NSMutableDictionary dictionary];
+
+    void (^addRow)(NSMutableDictionary *, NSIndexPath *) = ^(NSMutableDictionary *rows, NSIndexPath *indexPath) {
+        NSMutableIndexSet *indexes = rows[@(indexPath.section)];
+
+        if (!indexes) {
+            indexes = [NSMutableIndexSet indexSet];
+            rows[@(indexPath.section)] = indexes;
+        }
+
+        [indexes addIndex:(NSUInteger)indexPath.row];
+    };
+
+    for (NSIndexPath *indexPath in self.deletedIndexPaths) {
+        addRow(removedRows, indexPath);
+    }
+
+    for (NSIndexPath *indexPath in self.insertedIndexPaths) {
+        addRow(addedRows, indexPath);
+    }
+
+    for (NSIndexPath *indexPath in self.reloadedIndexPaths) {
+        addRow(reloadedRows, indexPath);
+    }
+
+    for (SSSectionedDiffMove *move in self.moves) {
+        addRow(removedRows, move.fromIndexPath);
+        addRow(addedRows, move.toIndexPath);
+    }
+
+    self.addedSectionIndexes = addedSections;
+    self.movedSectionOrigins = origins;
+    self.movedSectionDestinations = destinations;
+    self.removedRowsBySection = removedRows;
+    self.addedRowsBySection = addedRows;
+    self.reloadedRowsBySection = reloadedRows;
+    self.removedSectionIndexes = removedSections;
+}
+
+- (NSIndexSet *)removedSections {
+    [self _indexChangesIfNeeded];
+
+    return self.removedSectionIndexes;
+}
+
+- (NSIndexSet *)addedSections {
+    [self _indexChangesIfNeeded];
+
+    return self.addedSectionIndexes;
+}
+
+- (BOOL)isValidFromSectionCount:(NSUInteger)oldSectionCount toSectionCount:(NSUInteger)newSectionCount {
+    [self _indexChangesIfNeeded];
+
+    NSIndexSet *removedSections = self.removedSectionIndexes;
+    NSIndexSet *addedSections = self.addedSectionIndexes;
+
+    return (([removedSections count] == 0 || [removedSections lastIndex] < oldSectionCount)
+            && ([addedSections count] == 0 || [addedSections lastIndex] < newSectionCount)
+            && ([self.reloadedSections count] == 0 || [self.reloadedSections lastIndex] < oldSectionCount)
+            && oldSectionCount - [removedSections count] + [addedSections count] == newSectionCount);
+}
+
+- (NSUInteger)sectionAfterChangesForSection:(NSUInteger)section {
+    [self _indexChangesIfNeeded];
+
+    if ([self.removedSectionIndexes containsIndex:section]) {
+        NSNumber *newSection = self.movedSectionDestinations[@(section)];
+        return (newSection ? [newSection unsignedIntegerValue] : NSNotFound);
+    }
+
+    return SSIndexAfterChanges(section, self.removedSectionIndexes, self.addedSectionIndexes);
+}
+
+- (NSUInteger)sectionBeforeChangesForSection:(NSUInteger)section {
+    [self _indexChangesIfNeeded];
+
+    if ([self.addedSectionIndexes containsIndex:section]) {
+        NSNumber *oldSection = self.movedSectionOrigins[@(section)];
+        return (oldSection ? [oldSection unsignedIntegerValue] : NSNotFound);
+    }
+
+    // Undoing the changes maps new indexes back to old ones the same way.
+    return SSIndexAfterChanges(section, self.addedSectionIndexes, self.removedSectionIndexes);
+}
+
+- (NSIndexSet *)removedRowsInSection:(NSUInteger)section {
+    [self _indexChangesIfNeeded];
+
+    return self.removedRowsBySection[@(section)];
+}
+
+- (NSIndexSet *)addedRowsInSection:(NSUInteger)section {
+    [self _indexChangesIfNeeded];
+
+    return self.addedRowsBySection[@(section)];
+}
+
+- (NSIndexSet *)reloadedRowsInSection:(NSUInteger)section {
+    [self _indexChangesIfNeeded];
+
+    return self.reloadedRowsBySection[@(section)];
+}
+
+- (NSIndexPath *)indexPathAfterChangesForIndexPath:(NSIndexPath *)indexPath {
+    NSUInteger section = (NSUInteger)indexPath.section;
+    NSUInteger row = (NSUInteger)indexPath.row;
+    NSUInteger newSection = [self sectionAfterChangesForSection:section];
+
+    if (newSection == NSNotFound) {
+        return nil;
+    }
+
+    NSIndexSet *removedRows = [self removedRowsInSection:section];
+
+    if ([removedRows containsIndex:row]) {
+        return nil;
+    }
+
+    NSUInteger newRow = SSIndexAfterChanges(row, removedRows, [self addedRowsInSection:newSection]);
+
+    return [NSIndexPath indexPathForRow:(NSInteger)newRow inSection:(NSInteger)newSection];
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: sections -%@ +%@ ~%@ %@, items -%@ +%@ ~%@ %@>",
+            NSStringFromClass([self class]),
+            self.deletedSections,
+            self.insertedSections,
+            self.reloadedSections,
+            self.sectionMoves,
+            self.deletedIndexPaths,
+            self.insertedIndexPaths,
+            self.reloadedIndexPaths,
+            self.moves];
+}
+
+@end
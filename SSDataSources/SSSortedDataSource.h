@@ -0,0 +1,128 @@
+//
+//  SSSortedDataSource.h
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSBaseDataSource.h"
+
+/**
+ * Data source for single-sectioned table and collection views whose items
+ * are always kept in order, e.g. a leaderboard or a mailbox.
+ *
+ * Items are placed by binary search. Inserting, removing or repositioning an item
+ * is a single insert, delete or move; inserting many items at once merges them in
+ * linear time. Items that compare equal stay in the order they were added.
+ */
+
+@interface SSSortedDataSource : SSBaseDataSource
+
+/**
+ *  Create a sorted data source.
+ *
+ *  @param items      initial items, in any order
+ *  @param comparator comparator defining the order of items
+ *
+ *  @return an initialized data source
+ */
+- (instancetype) initWithItems:(NSArray *)items comparator:(NSComparator)comparator;
+
+/**
+ *  Create a sorted data source.
+ *
+ *  @param items           initial items, in any order
+ *  @param sortDescriptors an array of NSSortDescriptor objects defining the order of items
+ *
+ *  @return an initialized data source
+ */
+- (instancetype) initWithItems:(NSArray *)items sortDescriptors:(NSArray *)sortDescriptors;
+
+/**
+ * The comparator defining the order of items.
+ */
+@property (nonatomic, copy, readonly) NSComparator comparator;
+
+#pragma mark - Item access
+
+/**
+ * Returns all items in the data source, in order.
+ */
+- (NSArray *) allItems;
+
+/**
+ *  Find an item by binary search.
+ *
+ *  @param item an item equal (`isEqual:`) to an item in the data source,
+ *              which sorts in the same position
+ *
+ *  @return the item's index, or NSNotFound
+ */
+- (NSUInteger) indexOfItem:(id)item;
+
+#pragma mark - Adding items
+
+/**
+ *  Insert an item in order.
+ *
+ *  @param item the item to insert
+ *
+ *  @return the index at which the item was inserted
+ */
+- (NSUInteger) insertItem:(id)item;
+
+/**
+ *  Insert many items in order, in a single update.
+ *  The new items are sorted, then merged with the existing items in linear time.
+ *
+ *  @param items the items to insert, in any order
+ */
+- (void) insertItems:(NSArray *)items;
+
+/**
+ * Replace all items in the data source.
+ *
+ * As with -[SSArrayDataSource updateItems:], if you have specified an `itemIdentifierBlock`,
+ * the table or collection view receives only the required changes; otherwise it is reloaded.
+ */
+- (void) updateItems:(NSArray *)newItems;
+
+#pragma mark - Repositioning items
+
+/**
+ *  Call after changing an item in a way that may change its order,
+ *  e.g. a new high score. The item is moved to its new position and its cell,
+ *  if visible, is configured again.
+ *
+ *  @param index the item's current index
+ *
+ *  @return the item's new index
+ */
+- (NSUInteger) repositionItemAtIndex:(NSUInteger)index;
+
+#pragma mark - Removing items
+
+/**
+ *  Remove an item, found by binary search. See -indexOfItem:.
+ *
+ *  @param item the item to remove
+ */
+- (void) removeItem:(id)item;
+
+/**
+ * Remove the item at a given index.
+ */
+- (void) removeItemAtIndex:(NSUInteger)index;
+
+/**
+ * Remove the items at the specified indexes.
+ */
+- (void) removeItemsAtIndexes:(NSIndexSet *)indexes;
+
+/**
+ * Remove all items in the data source.
+ */
+- (void) clearItems;
+
+@end
@@ -0,0 +1,271 @@
+//
+//  SSSortedDataSource.m
+//  SSDataSources
+//
+//  Created by Jonathan Hersh on 10/17/26.
+//  Copyright (c) 2026 Splinesoft. All rights reserved.
+//
+
+#import "SSDataSources.h"
+
+@interface SSSortedDataSource ()
+
+@property (nonatomic, strong) NSMutableArray *items;
+@property (nonatomic, copy, readwrite) NSComparator comparator;
+
+// Index at which to insert an item among `items`, after any equal items.
+- (NSUInteger)insertionIndexForItem:(id)item inRange:(NSRange)range;
+
+// Implemented by SSBaseDataSource
+- (void)_reconfigureCellAtIndexPath:(NSIndexPath *)indexPath;
+- (BOOL)_hasCachedData;
+- (void)_removeCachedDataForItems:(NSArray *)items;
+- (NSArray *)_itemsInSection:(NSUInteger)section;
+
+@end
+
+@implementation SSSortedDataSource
+
+- (instancetype)initWithItems:(NSArray *)items comparator:(NSComparator)comparator {
+    NSParameterAssert(comparator);
+    
+    if ((self = [self init])) {
+        _comparator = [comparator copy];
+        _items = [[(items ?: @[]) sortedArrayWithOptions:NSSortStable
+                                         usingComparator:_comparator] mutableCopy];
+    }
+    
+    return self;
+}
+
+- (instancetype)initWithItems:(NSArray *)items sortDescriptors:(NSArray *)sortDescriptors {
+    NSArray *descriptors = [sortDescriptors copy];
+    
+    return [self initWithItems:items comparator:^NSComparisonResult(id item1, id item2) {
+        for (NSSortDescriptor *descriptor in descriptors) {
+            NSComparisonResult result = [descriptor compareObject:item1 toObject:item2];
+    
+            if (result != NSOrderedSame) {
+                return result;
+            }
+        }
+    
+        return NSOrderedSame;
+    }];
+}
+
+#pragma mark - SSBaseDataSource
+
+- (NSUInteger)numberOfSections {
+    return 1;
+}
+
+- (NSUInteger)numberOfItemsInSection:(NSInteger)section {
+    return [self.items count];
+}
+
+- (id)itemAtIndexPath:(NSIndexPath *)indexPath {
+    if (!indexPath || indexPath.row < 0 || (NSUInteger)indexPath.row >= [self.items count]) {
+        return nil;
+    }
+    
+    return self.items[(NSUInteger)indexPath.row];
+}
+
+- (NSArray *)_itemsInSection:(NSUInteger)section {
+    return self.items;
+}
+
+#pragma mark - Item access
+
+- (NSArray *)allItems {
+    return [self.items copy];
+}
+
+- (NSUInteger)insertionIndexForItem:(id)item inRange:(NSRange)range {
+    return [self.items indexOfObject:item
+                       inSortedRange:range
+                             options:(NSBinarySearchingInsertionIndex | NSBinarySearchingLastEqual)
+                     usingComparator:self.comparator];
+}
+
+- (NSUInteger)indexOfItem:(id)item {
+    if (!item) {
+        return NSNotFound;
+    }
+    
+    NSUInteger count = [self.items count];
+    NSUInteger index = [self.items indexOfObject:item
+                                   inSortedRange:NSMakeRange(0, count)
+                                         options:(NSBinarySearchingInsertionIndex | NSBinarySearchingFirstEqual)
+                                 usingComparator:self.comparator];
+    
+    // Several items may sort in the same position.
+    for (; index < count && self.comparator(self.items[index], item) == NSOrderedSame; index++) {
+        if ([self.items[index] isEqual:item]) {
+            return index;
+        }
+    }
+    
+    return NSNotFound;
+}
+
+#pragma mark - Adding items
+
+- (NSUInteger)insertItem:(id)item {
+    NSUInteger index = [self insertionIndexForItem:item inRange:NSMakeRange(0, [self.items count])];
+    
+    [self.items insertObject:item atIndex:index];
+    [self insertCellsAtIndexes:[NSIndexSet indexSetWithIndex:index] inSection:0];
+    
+    return index;
+}
+
+- (void)insertItems:(NSArray *)newItems {
+    if ([newItems count] == 0) {
+        return;
+    }
+    
+    if ([newItems count] == 1) {
+        [self insertItem:[newItems firstObject]];
+        return;
+    }
+    
+    NSArray *sortedItems = [newItems sortedArrayWithOptions:NSSortStable usingComparator:self.comparator];
+    NSArray *oldItems = self.items;
+    NSMutableArray *mergedItems = [NSMutableArray arrayWithCapacity:[oldItems count] + [sortedItems count]];
+    NSMutableIndexSet *insertedIndexes = [NSMutableIndexSet indexSet];
+    NSUInteger oldIndex = 0, newIndex = 0;
+    
+    while (oldIndex < [oldItems count] || newIndex < [sortedItems count]) {
+        // New items go after equal existing items.
+        BOOL takeNewItem = (oldIndex == [oldItems count]
+                            || (newIndex < [sortedItems count]
+                                && self.comparator(sortedItems[newIndex], oldItems[oldIndex]) == NSOrderedAscending));
+    
+        if (takeNewItem) {
+            [insertedIndexes addIndex:[mergedItems count]];
+            [mergedItems addObject:sortedItems[newIndex++]];
+        } else {
+            [mergedItems addObject:oldItems[oldIndex++]];
+        }
+    }
+    
+    self.items = mergedItems;
+    [self insertCellsAtIndexes:insertedIndexes inSection:0];
+}
+
+- (void)updateItems:(NSArray *)newItems {
+    NSArray *sortedItems = [(newItems ?: @[]) sortedArrayWithOptions:NSSortStable usingComparator:self.comparator];
+    
+    if (!self.itemIdentifierBlock) {
+        self.items = [sortedItems mutableCopy];
+        [self reloadData];
+        return;
+    }
+    
+    SSArrayDiff *diff = [SSArrayDiff diffFromArray:[self.items copy]
+                                           toArray:sortedItems
+                                   identifierBlock:self.itemIdentifierBlock
+                                     equalityBlock:self.itemEqualityBlock];
+    
+    if (![diff hasChanges]) {
+        self.items = [sortedItems mutableCopy];
+        return;
+    }
+    
+    if ([self exceedsMaximumAnimatedChangeCount:diff.changeCount]) {
+        self.items = [sortedItems mutableCopy];
+        [self reloadData];
+        return;
+    }
+    
+    // Reloaded items keep their identifiers, but their contents changed.
+    if ([self _hasCachedData]) {
+        [self invalidateSizesForItemsAtIndexPaths:[self.class indexPathArrayWithIndexSet:diff.reloadedIndexes
+                                                                               inSection:0]];
+    }
+    
+    // Deleted items won't be found at their index paths once the new items are in place.
+    if ([self _hasCachedData]) {
+        [self _removeCachedDataForItems:[self.items objectsAtIndexes:diff.deletedIndexes]];
+    }
+    
+    [self performBatchUpdates:^{
+        self.items = [sortedItems mutableCopy];
+    
+        [self deleteCellsAtIndexes:diff.deletedIndexes inSection:0];
+        [self insertCellsAtIndexes:diff.insertedIndexes inSection:0];
+        [self reloadCellsAtIndexes:diff.reloadedIndexes inSection:0];
+    
+        for (SSArrayDiffMove *move in diff.moves) {
+            [self moveCellAtIndexPath:[NSIndexPath indexPathForRow:(NSInteger)move.fromIndex inSection:0]
+                          toIndexPath:[NSIndexPath indexPathForRow:(NSInteger)move.toIndex inSection:0]];
+        }
+    }];
+}
+
+#pragma mark - Repositioning items
+
+- (NSUInteger)repositionItemAtIndex:(NSUInteger)index {
+    id item = self.items[index];
+    NSUInteger count = [self.items count];
+    NSIndexPath *indexPath = [NSIndexPath indexPathForRow:(NSInteger)index inSection:0];
+    
+    BOOL isInOrder = ((index == 0 || self.comparator(self.items[index - 1], item) != NSOrderedDescending)
+                      && (index + 1 == count || self.comparator(item, self.items[index + 1]) != NSOrderedDescending));
+    
+    if (isInOrder) {
+        [self reloadCellsAtIndexPaths:@[ indexPath ]];
+        return index;
+    }
+    
+    [self.items removeObjectAtIndex:index];
+    
+    // Only the items on the side the item moved towards need searching.
+    NSRange range = (self.comparator(item, self.items[index == 0 ? 0 : index - 1]) == NSOrderedAscending
+                     ? NSMakeRange(0, index)
+                     : NSMakeRange(index, count - 1 - index));
+    NSUInteger newIndex = [self insertionIndexForItem:item inRange:range];
+    NSIndexPath *newIndexPath = [NSIndexPath indexPathForRow:(NSInteger)newIndex inSection:0];
+    
+    [self.items insertObject:item atIndex:newIndex];
+    [self moveCellAtIndexPath:indexPath toIndexPath:newIndexPath];
+    [self _reconfigureCellAtIndexPath:newIndexPath];
+    
+    return newIndex;
+}
+
+#pragma mark - Removing items
+
+- (void)removeItem:(id)item {
+    NSUInteger index = [self indexOfItem:item];
+    
+    if (index != NSNotFound) {
+        [self removeItemAtIndex:index];
+    }
+}
+
+- (void)removeItemAtIndex:(NSUInteger)index {
+    [self removeItemsAtIndexes:[NSIndexSet indexSetWithIndex:index]];
+}
+
+- (void)removeItemsAtIndexes:(NSIndexSet *)indexes {
+    if ([indexes count] == 0) {
+        return;
+    }
+    
+    if ([self _hasCachedData]) {
+        [self _removeCachedDataForItems:[self.items objectsAtIndexes:indexes]];
+    }
+    
+    [self.items removeObjectsAtIndexes:indexes];
+    [self deleteCellsAtIndexes:indexes inSection:0];
+}
+
+- (void)clearItems {
+    [self.items removeAllObjects];
+    [self reloadData];
+}
+
+@end